@@ -33,6 +33,18 @@ if(FFT STREQUAL "FFTW3")
       message(FATAL_ERROR "Need OpenMP enabled FFTW3 library for FFT_THREADS")
     endif()
   endif()
+  # kspace_modify fft/single needs the single precision FFTW3 library,
+  # the single precision FFTs use KISS FFT if it is not found
+  if(NOT FFT_SINGLE)
+    find_package(FFTW3F QUIET)
+    if(FFTW3F_FOUND AND (NOT FFT_FFTW_THREADS OR FFTW3F_OMP_LIBRARIES))
+      target_compile_definitions(lammps PRIVATE -DFFT_FFTW3F)
+      target_link_libraries(lammps PRIVATE FFTW3F::FFTW3F)
+      if(FFT_FFTW_THREADS)
+        target_link_libraries(lammps PRIVATE FFTW3F::FFTW3F_OMP)
+      endif()
+    endif()
+  endif()
 elseif(FFT STREQUAL "MKL")
   find_package(MKL REQUIRED)
   target_compile_definitions(lammps PRIVATE -DFFT_MKL)
@@ -71,6 +71,7 @@ double eam_alloy_gpu_bytes();
 
 PairEAMAlloyGPU::PairEAMAlloyGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE)
 {
+  cacheflag = 0;
   respa_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
@@ -70,6 +70,7 @@ double eam_fs_gpu_bytes();
 
 PairEAMFSGPU::PairEAMFSGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE)
 {
+  cacheflag = 0;
   respa_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
@@ -68,6 +68,7 @@ double eam_gpu_bytes();
 
 PairEAMGPU::PairEAMGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE)
 {
+  cacheflag = 0;
   respa_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
@@ -95,6 +95,9 @@ PPPMGPU::PPPMGPU(LAMMPS *lmp) : PPPM(lmp)
   density_brick_gpu = vd_brick = nullptr;
   kspace_split = false;
   im_real_space = false;
+  r2c_support = 0;
+  gridsort_support = 0;
+  fft_single_support = 0;
 
   GPU_EXTRA::gpu_ready(lmp->modify, lmp->error);
 }
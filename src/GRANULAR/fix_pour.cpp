@@ -26,6 +26,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
+#include "near_bins.h"
 #include "random_park.h"
 #include "region.h"
 #include "region_block.h"
@@ -52,7 +53,7 @@ FixPour::FixPour(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg), radius_poly(nullptr), frac_poly(nullptr),
   idrigid(nullptr), idshake(nullptr), onemols(nullptr), molfrac(nullptr), coords(nullptr),
   imageflags(nullptr), fixrigid(nullptr), fixshake(nullptr), recvcounts(nullptr),
-  displs(nullptr), random(nullptr), random2(nullptr)
+  displs(nullptr), bins(nullptr), random(nullptr), random2(nullptr)
 {
   if (narg < 6) error->all(FLERR,"Illegal fix pour command");
 
@@ -294,6 +295,7 @@ FixPour::~FixPour()
   memory->destroy(imageflags);
   delete [] recvcounts;
   delete [] displs;
+  delete bins;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -472,6 +474,52 @@ void FixPour::pre_exchange()
   MPI_Allgatherv(ptr,4*ncount,MPI_DOUBLE,
                  xnear[0],recvcounts,displs,MPI_DOUBLE,world);
 
+  // bin nearby particles, inserted ones are added as they are accepted
+  // so each attempt only checks particles in nearby bins
+  // bin size = largest possible sum of radii of two particles
+  // binned volume covers insertion region and all nearby particles
+
+  double radmax = 0.0;
+  if (mode == ATOM) radmax = radius_max;
+  else
+    for (i = 0; i < nmol; i++)
+      radmax = MAX(radmax,onemols[i]->radiusflag ? onemols[i]->maxradius : 0.5);
+
+  double bboxlo[3],bboxhi[3];
+  if (domain->dimension == 3) {
+    if (region_style == 1) {
+      bboxlo[0] = xlo;
+      bboxhi[0] = xhi;
+      bboxlo[1] = ylo;
+      bboxhi[1] = yhi;
+    } else {
+      bboxlo[0] = xc - rc;
+      bboxhi[0] = xc + rc;
+      bboxlo[1] = yc - rc;
+      bboxhi[1] = yc + rc;
+    }
+    bboxlo[2] = lo_current;
+    bboxhi[2] = hi_current;
+  } else {
+    bboxlo[0] = xlo;
+    bboxhi[0] = xhi;
+    bboxlo[1] = lo_current;
+    bboxhi[1] = hi_current;
+    bboxlo[2] = bboxhi[2] = 0.0;
+  }
+
+  for (i = 0; i < nprevious; i++) {
+    radmax = MAX(radmax,xnear[i][3]);
+    for (m = 0; m < 3; m++) {
+      bboxlo[m] = MIN(bboxlo[m],xnear[i][m]);
+      bboxhi[m] = MAX(bboxhi[m],xnear[i][m]);
+    }
+  }
+
+  if (!bins) bins = new NearBins(lmp);
+  bins->setup(2.0*radmax,bboxlo,bboxhi,nprevious+nnew*natom_max);
+  for (i = 0; i < nprevious; i++) bins->add(xnear[i],xnear[i][3]);
+
   // insert new particles into xnear list, one by one
   // check against all nearby atoms and previously inserted ones
   // if there is an overlap then try again at same z (3d) or y (2d) coord
@@ -485,7 +533,7 @@ void FixPour::pre_exchange()
   //   store image flag modified due to PBC
 
   int success;
-  double radtmp,delx,dely,delz,rsq,radsum,rn,h;
+  double radtmp,rn,h;
   double coord[3];
 
   double denstmp;
@@ -552,20 +600,10 @@ void FixPour::pre_exchange()
       }
 
       // if any pair of atoms overlap, try again
-      // use minimum_image() to account for PBC
-
-      for (m = 0; m < natom; m++) {
-        for (i = 0; i < nnear; i++) {
-          delx = coords[m][0] - xnear[i][0];
-          dely = coords[m][1] - xnear[i][1];
-          delz = coords[m][2] - xnear[i][2];
-          domain->minimum_image(delx,dely,delz);
-          rsq = delx*delx + dely*dely + delz*delz;
-          radsum = coords[m][3] + xnear[i][3];
-          if (rsq <= radsum*radsum) break;
-        }
-        if (i < nnear) break;
-      }
+      // NearBins uses minimum_image() to account for PBC
+
+      for (m = 0; m < natom; m++)
+        if (bins->overlap(coords[m],coords[m][3])) break;
       if (m == natom) {
         success = 1;
         break;
@@ -579,13 +617,14 @@ void FixPour::pre_exchange()
     nsuccess++;
     nlocalprev = atom->nlocal;
 
-    // add all atoms in particle to xnear
+    // add all atoms in particle to xnear and to the bins
 
     for (m = 0; m < natom; m++) {
       xnear[nnear][0] = coords[m][0];
       xnear[nnear][1] = coords[m][1];
       xnear[nnear][2] = coords[m][2];
       xnear[nnear][3] = coords[m][3];
+      bins->add(coords[m],coords[m][3]);
       nnear++;
     }
 
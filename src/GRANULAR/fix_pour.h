@@ -64,6 +64,7 @@ class FixPour : public Fix {
 
   int me, nprocs;
   int *recvcounts, *displs;
+  class NearBins *bins;    // bins of nearby and inserted particles
   int nfreq, ninserted, nper;
   bigint nfirst;
   double lo_current, hi_current;
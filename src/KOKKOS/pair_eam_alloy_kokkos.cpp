@@ -43,6 +43,7 @@ using namespace LAMMPS_NS;
 template<class DeviceType>
 PairEAMAlloyKokkos<DeviceType>::PairEAMAlloyKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
+  cacheflag = 0;
   respa_enable = 0;
   one_coeff = 1;
   manybody_flag = 1;
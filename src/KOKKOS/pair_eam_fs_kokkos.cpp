@@ -43,6 +43,7 @@ using namespace LAMMPS_NS;
 template<class DeviceType>
 PairEAMFSKokkos<DeviceType>::PairEAMFSKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
+  cacheflag = 0;
   one_coeff = 1;
   manybody_flag = 1;
   respa_enable = 0;
@@ -37,6 +37,7 @@ using namespace LAMMPS_NS;
 template<class DeviceType>
 PairEAMKokkos<DeviceType>::PairEAMKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
+  cacheflag = 0;
   respa_enable = 0;
   single_enable = 0;
 
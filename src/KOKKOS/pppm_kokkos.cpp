@@ -68,6 +68,9 @@ PPPMKokkos<DeviceType>::PPPMKokkos(LAMMPS *lmp) : PPPM(lmp)
   pppmflag = 1;
   group_group_enable = 0;
   triclinic_support = 0;
+  r2c_support = 0;
+  gridsort_support = 0;
+  fft_single_support = 0;
 
   nfactors = 3;
   //factors = new int[nfactors];
@@ -181,6 +184,9 @@ void PPPMKokkos<DeviceType>::init()
 
   if (differentiation_flag == 1)
     error->all(FLERR,"Cannot (yet) use PPPM Kokkos with 'kspace_modify diff ad'");
+  if (collective_flag == 2)
+    error->all(FLERR,"Cannot (yet) use PPPM Kokkos with "
+               "'kspace_modify collective node'");
 
   triclinic_check();
   if (domain->triclinic && slabflag)
@@ -209,6 +209,8 @@ void RemapKokkos<DeviceType>::remap_3d_kokkos(typename FFT_AT::t_FFT_SCALAR_1d d
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
    usecollective        whether to use collective MPI or point-to-point
+                          the node-aware mode (2) of remap_3d is not
+                          supported, PPPMKokkos rejects it
    usecuda_aware        whether to use CUDA-Aware MPI or not
 ------------------------------------------------------------------------- */
 
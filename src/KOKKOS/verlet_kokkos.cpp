@@ -66,6 +66,8 @@ struct Zero {
 VerletKokkos::VerletKokkos(LAMMPS *lmp, int narg, char **arg) :
   Verlet(lmp, narg, arg)
 {
+  if (overlap) error->all(FLERR,"Run style verlet/kk does not support overlap yes");
+
   atomKK = (AtomKokkos *) atom;
 }
 
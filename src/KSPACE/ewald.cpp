@@ -27,6 +27,7 @@
 #include "error.h"
 #include "force.h"
 #include "math_const.h"
+#include "math_extra.h"
 #include "memory.h"
 #include "pair.h"
 
@@ -36,13 +37,14 @@ using namespace LAMMPS_NS;
 using namespace MathConst;
 
 #define SMALL 0.00001
+#define EWALD_BLOCK 64      // # of atoms whose eik rows are combined at once
 
 /* ---------------------------------------------------------------------- */
 
 Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   kxvecs(nullptr), kyvecs(nullptr), kzvecs(nullptr), ug(nullptr), eg(nullptr), vg(nullptr),
   ek(nullptr), sfacrl(nullptr), sfacim(nullptr), sfacrl_all(nullptr), sfacim_all(nullptr),
-  cs(nullptr), sn(nullptr), sfacrl_A(nullptr), sfacim_A(nullptr), sfacrl_A_all(nullptr),
+  cs(nullptr), sn(nullptr), dsfacrl(nullptr), dsfacim(nullptr), sfacrl_A(nullptr), sfacim_A(nullptr), sfacrl_A_all(nullptr),
   sfacim_A_all(nullptr), sfacrl_B(nullptr), sfacim_B(nullptr), sfacrl_B_all(nullptr),
   sfacim_B_all(nullptr)
 {
@@ -50,6 +52,7 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   kmax_created = 0;
   ewaldflag = 1;
   group_group_enable = 1;
+  energy_delta_enable = 1;
 
   accuracy_relative = 0.0;
 
@@ -399,37 +402,69 @@ void Ewald::compute(int eflag, int vflag)
   int nlocal = atom->nlocal;
 
   int kx,ky,kz;
-  double cypz,sypz,exprl,expim,partial,partial_peratom;
+  double cypz,sypz,exprl,expim,partial_peratom;
+  double ekx[EWALD_BLOCK],eky[EWALD_BLOCK],ekz[EWALD_BLOCK];
 
-  for (i = 0; i < nlocal; i++) {
-    ek[i][0] = 0.0;
-    ek[i][1] = 0.0;
-    ek[i][2] = 0.0;
-  }
+  // loop over blocks of atoms, so the cs/sn rows of a block stay in
+  //   cache while they are combined for all K-vectors
 
-  for (k = 0; k < kcount; k++) {
-    kx = kxvecs[k];
-    ky = kyvecs[k];
-    kz = kzvecs[k];
+  for (int ifrom = 0; ifrom < nlocal; ifrom += EWALD_BLOCK) {
+    const int ito = MIN(ifrom+EWALD_BLOCK,nlocal);
 
-    for (i = 0; i < nlocal; i++) {
-      cypz = cs[ky][1][i]*cs[kz][2][i] - sn[ky][1][i]*sn[kz][2][i];
-      sypz = sn[ky][1][i]*cs[kz][2][i] + cs[ky][1][i]*sn[kz][2][i];
-      exprl = cs[kx][0][i]*cypz - sn[kx][0][i]*sypz;
-      expim = sn[kx][0][i]*cypz + cs[kx][0][i]*sypz;
-      partial = expim*sfacrl_all[k] - exprl*sfacim_all[k];
-      ek[i][0] += partial*eg[k][0];
-      ek[i][1] += partial*eg[k][1];
-      ek[i][2] += partial*eg[k][2];
+    for (i = ifrom; i < ito; i++)
+      ekx[i-ifrom] = eky[i-ifrom] = ekz[i-ifrom] = 0.0;
+
+    for (k = 0; k < kcount; k++) {
+      kx = kxvecs[k];
+      ky = kyvecs[k];
+      kz = kzvecs[k];
+
+      const double * const csx = cs[kx][0];
+      const double * const snx = sn[kx][0];
+      const double * const csy = cs[ky][1];
+      const double * const sny = sn[ky][1];
+      const double * const csz = cs[kz][2];
+      const double * const snz = sn[kz][2];
+      const double sfrl = sfacrl_all[k];
+      const double sfim = sfacim_all[k];
+      const double egx = eg[k][0];
+      const double egy = eg[k][1];
+      const double egz = eg[k][2];
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+      for (i = ifrom; i < ito; i++) {
+        const double cypz = csy[i]*csz[i] - sny[i]*snz[i];
+        const double sypz = sny[i]*csz[i] + csy[i]*snz[i];
+        const double exprl = csx[i]*cypz - snx[i]*sypz;
+        const double expim = snx[i]*cypz + csx[i]*sypz;
+        const double partial = expim*sfrl - exprl*sfim;
+        ekx[i-ifrom] += partial*egx;
+        eky[i-ifrom] += partial*egy;
+        ekz[i-ifrom] += partial*egz;
+      }
 
       if (evflag_atom) {
-        partial_peratom = exprl*sfacrl_all[k] + expim*sfacim_all[k];
-        if (eflag_atom) eatom[i] += q[i]*ug[k]*partial_peratom;
-        if (vflag_atom)
-          for (j = 0; j < 6; j++)
-            vatom[i][j] += ug[k]*vg[k][j]*partial_peratom;
+        for (i = ifrom; i < ito; i++) {
+          cypz = csy[i]*csz[i] - sny[i]*snz[i];
+          sypz = sny[i]*csz[i] + csy[i]*snz[i];
+          exprl = csx[i]*cypz - snx[i]*sypz;
+          expim = snx[i]*cypz + csx[i]*sypz;
+          partial_peratom = exprl*sfrl + expim*sfim;
+          if (eflag_atom) eatom[i] += q[i]*ug[k]*partial_peratom;
+          if (vflag_atom)
+            for (j = 0; j < 6; j++)
+              vatom[i][j] += ug[k]*vg[k][j]*partial_peratom;
+        }
       }
     }
+
+    for (i = ifrom; i < ito; i++) {
+      ek[i][0] = ekx[i-ifrom];
+      ek[i][1] = eky[i-ifrom];
+      ek[i][2] = ekz[i-ifrom];
+    }
   }
 
   // convert E-field to force
@@ -487,13 +522,122 @@ void Ewald::compute(int eflag, int vflag)
   if (slabflag == 1) slabcorr();
 }
 
+/* ----------------------------------------------------------------------
+   store total structure factor and charge sums of current atoms
+   as reference state for subsequent energy_delta() calls
+------------------------------------------------------------------------- */
+
+void Ewald::setup_delta()
+{
+  qsum_qsq();
+  natoms_original = atom->natoms;
+
+  if (atom->nmax > nmax) {
+    memory->destroy(ek);
+    memory->destroy3d_offset(cs,-kmax_created);
+    memory->destroy3d_offset(sn,-kmax_created);
+    nmax = atom->nmax;
+    memory->create(ek,nmax,3,"ewald:ek");
+    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
+    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
+    kmax_created = kmax;
+  }
+
+  if (triclinic == 0)
+    eik_dot_r();
+  else
+    eik_dot_r_triclinic();
+
+  MPI_Allreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+
+  // same phase convention as eik_dot_r() and eik_dot_r_triclinic()
+
+  for (int i = 0; i < 3; i++) {
+    bvec[i][0] = bvec[i][1] = bvec[i][2] = 0.0;
+    if (triclinic == 0) bvec[i][i] = unitk[i];
+    else {
+      bvec[i][i] = 2.0*MY_PI;
+      x2lamdaT(&bvec[i][0],&bvec[i][0]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   change in long-range energy when the charges at n positions
+   change from qold to qnew, relative to the stored reference state
+   only the calling proc's sites are included, no communication
+   structure factor change is kept for accept_delta()
+------------------------------------------------------------------------- */
+
+double Ewald::energy_delta(int n, double **xsite, double *qold, double *qnew)
+{
+  int i,k;
+  double dq,arg,phase[3];
+
+  double dqsum = 0.0;
+  double dqsqsum = 0.0;
+
+  for (k = 0; k < kcount; k++) dsfacrl[k] = dsfacim[k] = 0.0;
+
+  for (i = 0; i < n; i++) {
+    dq = qnew[i] - qold[i];
+    dqsum += dq;
+    dqsqsum += qnew[i]*qnew[i] - qold[i]*qold[i];
+    if (dq == 0.0) continue;
+
+    phase[0] = MathExtra::dot3(bvec[0],xsite[i]);
+    phase[1] = MathExtra::dot3(bvec[1],xsite[i]);
+    phase[2] = MathExtra::dot3(bvec[2],xsite[i]);
+
+    for (k = 0; k < kcount; k++) {
+      arg = kxvecs[k]*phase[0] + kyvecs[k]*phase[1] + kzvecs[k]*phase[2];
+      dsfacrl[k] += dq*cos(arg);
+      dsfacim[k] += dq*sin(arg);
+    }
+  }
+
+  double de = 0.0;
+  for (k = 0; k < kcount; k++)
+    de += ug[k] * (dsfacrl[k]*(2.0*sfacrl_all[k] + dsfacrl[k]) +
+                   dsfacim[k]*(2.0*sfacim_all[k] + dsfacim[k]));
+
+  de -= g_ewald*dqsqsum/MY_PIS +
+    MY_PI2*dqsum*(2.0*qsum + dqsum) / (g_ewald*g_ewald*volume);
+
+  return qqrd2e*scale*de;
+}
+
+/* ----------------------------------------------------------------------
+   update reference state after an accepted MC move
+   flag = 1 on the one proc whose last energy_delta() was accepted
+   called by all procs after the atoms themselves have been changed
+------------------------------------------------------------------------- */
+
+void Ewald::accept_delta(int flag)
+{
+  if (!flag)
+    for (int k = 0; k < kcount; k++) dsfacrl[k] = dsfacim[k] = 0.0;
+
+  MPI_Allreduce(dsfacrl,sfacrl,kcount,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(dsfacim,sfacim,kcount,MPI_DOUBLE,MPI_SUM,world);
+
+  for (int k = 0; k < kcount; k++) {
+    sfacrl_all[k] += sfacrl[k];
+    sfacim_all[k] += sfacim[k];
+  }
+
+  qsum_qsq();
+  natoms_original = atom->natoms;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Ewald::eik_dot_r()
 {
   int i,k,l,m,n,ic;
   double cstr1,sstr1,cstr2,sstr2,cstr3,sstr3,cstr4,sstr4;
-  double sqk,clpm,slpm;
+  double sqk;
 
   double **x = atom->x;
   double *q = atom->q;
@@ -545,123 +689,172 @@ void Ewald::eik_dot_r()
     }
   }
 
-  // 1 = (k,l,0), 2 = (k,-l,0)
+  // structure factors of all remaining K-vectors
+  // loop over blocks of atoms, so the cs/sn rows of a block stay in
+  //   cache while they are combined for all K-vectors
 
-  for (k = 1; k <= kxmax; k++) {
-    for (l = 1; l <= kymax; l++) {
-      sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]);
-      if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[k][0][i]*cs[l][1][i] - sn[k][0][i]*sn[l][1][i]);
-          sstr1 += q[i]*(sn[k][0][i]*cs[l][1][i] + cs[k][0][i]*sn[l][1][i]);
-          cstr2 += q[i]*(cs[k][0][i]*cs[l][1][i] + sn[k][0][i]*sn[l][1][i]);
-          sstr2 += q[i]*(sn[k][0][i]*cs[l][1][i] - cs[k][0][i]*sn[l][1][i]);
-        }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
-      }
-    }
-  }
+  const int n1d = n;
+  for (k = n1d; k < kcount; k++) sfacrl[k] = sfacim[k] = 0.0;
 
-  // 1 = (0,l,m), 2 = (0,l,-m)
+  for (int ifrom = 0; ifrom < nlocal; ifrom += EWALD_BLOCK) {
+    const int ito = MIN(ifrom+EWALD_BLOCK,nlocal);
+    n = n1d;
 
-  for (l = 1; l <= kymax; l++) {
-    for (m = 1; m <= kzmax; m++) {
-      sqk = (l*unitk[1] * l*unitk[1]) + (m*unitk[2] * m*unitk[2]);
-      if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i]);
-          sstr1 += q[i]*(sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i]);
-          cstr2 += q[i]*(cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i]);
-          sstr2 += q[i]*(sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i]);
+    // 1 = (k,l,0), 2 = (k,-l,0)
+
+    for (k = 1; k <= kxmax; k++) {
+      const double * const csk = cs[k][0];
+      const double * const snk = sn[k][0];
+      for (l = 1; l <= kymax; l++) {
+        sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]);
+        if (sqk <= gsqmx) {
+          const double * const csl = cs[l][1];
+          const double * const snl = sn[l][1];
+          cstr1 = 0.0;
+          sstr1 = 0.0;
+          cstr2 = 0.0;
+          sstr2 = 0.0;
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:cstr1,sstr1,cstr2,sstr2)
+#endif
+          for (i = ifrom; i < ito; i++) {
+            cstr1 += q[i]*(csk[i]*csl[i] - snk[i]*snl[i]);
+            sstr1 += q[i]*(snk[i]*csl[i] + csk[i]*snl[i]);
+            cstr2 += q[i]*(csk[i]*csl[i] + snk[i]*snl[i]);
+            sstr2 += q[i]*(snk[i]*csl[i] - csk[i]*snl[i]);
+          }
+          sfacrl[n] += cstr1;
+          sfacim[n++] += sstr1;
+          sfacrl[n] += cstr2;
+          sfacim[n++] += sstr2;
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
       }
     }
-  }
 
-  // 1 = (k,0,m), 2 = (k,0,-m)
+    // 1 = (0,l,m), 2 = (0,l,-m)
 
-  for (k = 1; k <= kxmax; k++) {
-    for (m = 1; m <= kzmax; m++) {
-      sqk = (k*unitk[0] * k*unitk[0]) + (m*unitk[2] * m*unitk[2]);
-      if (sqk <= gsqmx) {
-        cstr1 = 0.0;
-        sstr1 = 0.0;
-        cstr2 = 0.0;
-        sstr2 = 0.0;
-        for (i = 0; i < nlocal; i++) {
-          cstr1 += q[i]*(cs[k][0][i]*cs[m][2][i] - sn[k][0][i]*sn[m][2][i]);
-          sstr1 += q[i]*(sn[k][0][i]*cs[m][2][i] + cs[k][0][i]*sn[m][2][i]);
-          cstr2 += q[i]*(cs[k][0][i]*cs[m][2][i] + sn[k][0][i]*sn[m][2][i]);
-          sstr2 += q[i]*(sn[k][0][i]*cs[m][2][i] - cs[k][0][i]*sn[m][2][i]);
+    for (l = 1; l <= kymax; l++) {
+      const double * const csl = cs[l][1];
+      const double * const snl = sn[l][1];
+      for (m = 1; m <= kzmax; m++) {
+        sqk = (l*unitk[1] * l*unitk[1]) + (m*unitk[2] * m*unitk[2]);
+        if (sqk <= gsqmx) {
+          const double * const csm = cs[m][2];
+          const double * const snm = sn[m][2];
+          cstr1 = 0.0;
+          sstr1 = 0.0;
+          cstr2 = 0.0;
+          sstr2 = 0.0;
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:cstr1,sstr1,cstr2,sstr2)
+#endif
+          for (i = ifrom; i < ito; i++) {
+            cstr1 += q[i]*(csl[i]*csm[i] - snl[i]*snm[i]);
+            sstr1 += q[i]*(snl[i]*csm[i] + csl[i]*snm[i]);
+            cstr2 += q[i]*(csl[i]*csm[i] + snl[i]*snm[i]);
+            sstr2 += q[i]*(snl[i]*csm[i] - csl[i]*snm[i]);
+          }
+          sfacrl[n] += cstr1;
+          sfacim[n++] += sstr1;
+          sfacrl[n] += cstr2;
+          sfacim[n++] += sstr2;
         }
-        sfacrl[n] = cstr1;
-        sfacim[n++] = sstr1;
-        sfacrl[n] = cstr2;
-        sfacim[n++] = sstr2;
       }
     }
-  }
 
-  // 1 = (k,l,m), 2 = (k,-l,m), 3 = (k,l,-m), 4 = (k,-l,-m)
+    // 1 = (k,0,m), 2 = (k,0,-m)
 
-  for (k = 1; k <= kxmax; k++) {
-    for (l = 1; l <= kymax; l++) {
+    for (k = 1; k <= kxmax; k++) {
+      const double * const csk = cs[k][0];
+      const double * const snk = sn[k][0];
       for (m = 1; m <= kzmax; m++) {
-        sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]) +
-          (m*unitk[2] * m*unitk[2]);
+        sqk = (k*unitk[0] * k*unitk[0]) + (m*unitk[2] * m*unitk[2]);
         if (sqk <= gsqmx) {
+          const double * const csm = cs[m][2];
+          const double * const snm = sn[m][2];
           cstr1 = 0.0;
           sstr1 = 0.0;
           cstr2 = 0.0;
           sstr2 = 0.0;
-          cstr3 = 0.0;
-          sstr3 = 0.0;
-          cstr4 = 0.0;
-          sstr4 = 0.0;
-          for (i = 0; i < nlocal; i++) {
-            clpm = cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i];
-            slpm = sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i];
-            cstr1 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr1 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i];
-            slpm = -sn[l][1][i]*cs[m][2][i] + cs[l][1][i]*sn[m][2][i];
-            cstr2 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr2 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] + sn[l][1][i]*sn[m][2][i];
-            slpm = sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i];
-            cstr3 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr3 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
-
-            clpm = cs[l][1][i]*cs[m][2][i] - sn[l][1][i]*sn[m][2][i];
-            slpm = -sn[l][1][i]*cs[m][2][i] - cs[l][1][i]*sn[m][2][i];
-            cstr4 += q[i]*(cs[k][0][i]*clpm - sn[k][0][i]*slpm);
-            sstr4 += q[i]*(sn[k][0][i]*clpm + cs[k][0][i]*slpm);
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:cstr1,sstr1,cstr2,sstr2)
+#endif
+          for (i = ifrom; i < ito; i++) {
+            cstr1 += q[i]*(csk[i]*csm[i] - snk[i]*snm[i]);
+            sstr1 += q[i]*(snk[i]*csm[i] + csk[i]*snm[i]);
+            cstr2 += q[i]*(csk[i]*csm[i] + snk[i]*snm[i]);
+            sstr2 += q[i]*(snk[i]*csm[i] - csk[i]*snm[i]);
+          }
+          sfacrl[n] += cstr1;
+          sfacim[n++] += sstr1;
+          sfacrl[n] += cstr2;
+          sfacim[n++] += sstr2;
+        }
+      }
+    }
+
+    // 1 = (k,l,m), 2 = (k,-l,m), 3 = (k,l,-m), 4 = (k,-l,-m)
+    // the four sign combinations share the products of the l and m terms
+
+    for (k = 1; k <= kxmax; k++) {
+      const double * const csk = cs[k][0];
+      const double * const snk = sn[k][0];
+      for (l = 1; l <= kymax; l++) {
+        const double * const csl = cs[l][1];
+        const double * const snl = sn[l][1];
+        for (m = 1; m <= kzmax; m++) {
+          sqk = (k*unitk[0] * k*unitk[0]) + (l*unitk[1] * l*unitk[1]) +
+            (m*unitk[2] * m*unitk[2]);
+          if (sqk <= gsqmx) {
+            const double * const csm = cs[m][2];
+            const double * const snm = sn[m][2];
+            cstr1 = 0.0;
+            sstr1 = 0.0;
+            cstr2 = 0.0;
+            sstr2 = 0.0;
+            cstr3 = 0.0;
+            sstr3 = 0.0;
+            cstr4 = 0.0;
+            sstr4 = 0.0;
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:cstr1,sstr1,cstr2,sstr2,cstr3,sstr3,cstr4,sstr4)
+#endif
+            for (i = ifrom; i < ito; i++) {
+              const double clcm = csl[i]*csm[i];
+              const double slsm = snl[i]*snm[i];
+              const double slcm = snl[i]*csm[i];
+              const double clsm = csl[i]*snm[i];
+              const double qcsk = q[i]*csk[i];
+              const double qsnk = q[i]*snk[i];
+
+              double clpm = clcm - slsm;
+              double slpm = slcm + clsm;
+              cstr1 += qcsk*clpm - qsnk*slpm;
+              sstr1 += qsnk*clpm + qcsk*slpm;
+
+              clpm = clcm + slsm;
+              slpm = -slcm + clsm;
+              cstr2 += qcsk*clpm - qsnk*slpm;
+              sstr2 += qsnk*clpm + qcsk*slpm;
+
+              slpm = slcm - clsm;
+              cstr3 += qcsk*clpm - qsnk*slpm;
+              sstr3 += qsnk*clpm + qcsk*slpm;
+
+              clpm = clcm - slsm;
+              slpm = -slcm - clsm;
+              cstr4 += qcsk*clpm - qsnk*slpm;
+              sstr4 += qsnk*clpm + qcsk*slpm;
+            }
+            sfacrl[n] += cstr1;
+            sfacim[n++] += sstr1;
+            sfacrl[n] += cstr2;
+            sfacim[n++] += sstr2;
+            sfacrl[n] += cstr3;
+            sfacim[n++] += sstr3;
+            sfacrl[n] += cstr4;
+            sfacim[n++] += sstr4;
           }
-          sfacrl[n] = cstr1;
-          sfacim[n++] = sstr1;
-          sfacrl[n] = cstr2;
-          sfacim[n++] = sstr2;
-          sfacrl[n] = cstr3;
-          sfacim[n++] = sstr3;
-          sfacrl[n] = cstr4;
-          sfacim[n++] = sstr4;
         }
       }
     }
@@ -1135,6 +1328,8 @@ void Ewald::allocate()
   sfacim = new double[kmax3d];
   sfacrl_all = new double[kmax3d];
   sfacim_all = new double[kmax3d];
+  dsfacrl = new double[kmax3d];
+  dsfacim = new double[kmax3d];
 }
 
 /* ----------------------------------------------------------------------
@@ -1155,6 +1350,8 @@ void Ewald::deallocate()
   delete [] sfacim;
   delete [] sfacrl_all;
   delete [] sfacim_all;
+  delete [] dsfacrl;
+  delete [] dsfacim;
 }
 
 /* ----------------------------------------------------------------------
@@ -1230,7 +1427,7 @@ double Ewald::memory_usage()
 {
   double bytes = 3 * kmax3d * sizeof(int);
   bytes += (double)(1 + 3 + 6) * kmax3d * sizeof(double);
-  bytes += (double)4 * kmax3d * sizeof(double);
+  bytes += (double)6 * kmax3d * sizeof(double);
   bytes += (double)nmax*3 * sizeof(double);
   bytes += (double)2 * (2*kmax+1)*3*nmax * sizeof(double);
   return bytes;
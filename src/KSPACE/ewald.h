@@ -36,6 +36,10 @@ class Ewald : public KSpace {
 
   void compute_group_group(int, int, int);
 
+  void setup_delta();
+  double energy_delta(int, double **, double *, double *);
+  void accept_delta(int);
+
  protected:
   int kxmax, kymax, kzmax;
   int kcount, kmax, kmax3d, kmax_created;
@@ -51,6 +55,11 @@ class Ewald : public KSpace {
   double *sfacrl, *sfacim, *sfacrl_all, *sfacim_all;
   double ***cs, ***sn;
 
+  // incremental energy for MC moves
+
+  double *dsfacrl, *dsfacim;    // structure factor change of last energy_delta()
+  double bvec[3][3];            // K-vector basis, K.x = sum kvec[i]*(bvec[i].x)
+
   // group-group interactions
 
   int group_allocate_flag;
@@ -45,6 +45,7 @@ EwaldDipole::EwaldDipole(LAMMPS *lmp) : Ewald(lmp),
 {
   ewaldflag = dipoleflag = 1;
   group_group_enable = 0;
+  energy_delta_enable = 0;
   tk = nullptr;
   vc = nullptr;
 }
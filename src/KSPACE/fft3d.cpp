@@ -25,6 +25,7 @@
 #include "remap.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 
 #if defined(_OPENMP)
@@ -220,6 +221,233 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
   }
 }
 
+/* ----------------------------------------------------------------------
+   Perform 3d real-to-complex FFT (forward)
+
+   Arguments:
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_r2c
+------------------------------------------------------------------------- */
+
+void fft_3d_r2c(FFT_SCALAR *in, FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *rdata;
+  FFT_DATA *data,*copy;
+
+  // pre-remap of real data to prepare for 1st FFTs if needed
+
+  if (plan->pre_plan) {
+    remap_3d(in,plan->rcopy,(FFT_SCALAR *) plan->scratch,plan->pre_plan);
+    rdata = plan->rcopy;
+  } else
+    rdata = in;
+
+  // 1d real-to-complex FFTs along fast axis
+  // these are out-of-place, so copy = loc for results
+
+  if (plan->r2c_target == 0) data = out;
+  else data = plan->copy;
+
+#if defined(FFT_MKL)
+  DftiComputeForward(plan->handle_fast,rdata,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft_r2c)(plan->plan_fast_r2c,rdata,data);
+#else
+  int total = plan->total1;
+  int length = plan->length1;
+  int clength = plan->clength1;
+
+  for (int offset = 0, coffset = 0; offset < total;
+       offset += length, coffset += clength)
+    kiss_fftr(plan->cfg_fast_r2c,&rdata[offset],&data[coffset]);
+#endif
+
+  // 1st mid-remap to prepare for 2nd FFTs
+
+  if (plan->mid1_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  // 1d FFTs along mid axis
+
+#if defined(FFT_MKL)
+  DftiComputeForward(plan->handle_mid,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft)(plan->plan_mid_forward,data,data);
+#else
+  total = plan->total2;
+  length = plan->length2;
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
+#endif
+
+  // 2nd mid-remap to prepare for 3rd FFTs
+
+  if (plan->mid2_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  // 1d FFTs along slow axis
+
+#if defined(FFT_MKL)
+  DftiComputeForward(plan->handle_slow,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft)(plan->plan_slow_forward,data,data);
+#else
+  total = plan->total3;
+  length = plan->length3;
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
+#endif
+
+  // post-remap to put data in output format
+
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+           (FFT_SCALAR *) plan->scratch, plan->post_plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d complex-to-real FFT (backward)
+   same steps as fft_3d_r2c() in reverse order, with the inverse remaps
+   input must be the half-complex output layout of the plan
+   input data is overwritten
+
+   Arguments:
+   in           starting address of complex input data on this proc
+   out          starting address of where real output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_r2c
+------------------------------------------------------------------------- */
+
+void fft_3d_c2r(FFT_DATA *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *rdata;
+  FFT_DATA *data,*copy;
+
+  // reverse post-remap to prepare for 3rd FFTs
+  // copy = loc for remap result, in is reused if big enough
+
+  if (plan->inv_post_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) in, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->inv_post_plan);
+  data = copy;
+
+  // 1d FFTs along slow axis
+
+#if defined(FFT_MKL)
+  DftiComputeBackward(plan->handle_slow,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft)(plan->plan_slow_backward,data,data);
+#else
+  int total = plan->total3;
+  int length = plan->length3;
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
+#endif
+
+  // reverse 2nd mid-remap to prepare for 2nd FFTs
+
+  if (plan->inv_mid2_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->inv_mid2_plan);
+  data = copy;
+
+  // 1d FFTs along mid axis
+
+#if defined(FFT_MKL)
+  DftiComputeBackward(plan->handle_mid,data);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft)(plan->plan_mid_backward,data,data);
+#else
+  total = plan->total2;
+  length = plan->length2;
+
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
+#endif
+
+  // reverse 1st mid-remap to prepare for 1st FFTs
+
+  if (plan->inv_mid1_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->inv_mid1_plan);
+  data = copy;
+
+  // 1d complex-to-real FFTs along fast axis
+  // these are out-of-place, so write to out only if no remap follows
+  //   and out does not hold the complex data
+
+  if (plan->inv_pre_plan || (void *) data == (void *) out) rdata = plan->rcopy;
+  else rdata = out;
+
+#if defined(FFT_MKL)
+  DftiComputeBackward(plan->handle_fast_c2r,data,rdata);
+#elif defined(FFT_FFTW3)
+  FFTW_API(execute_dft_c2r)(plan->plan_fast_c2r,data,rdata);
+#else
+  total = plan->total1;
+  length = plan->length1;
+  int clength = plan->clength1;
+
+  for (int offset = 0, coffset = 0; offset < total;
+       offset += length, coffset += clength)
+    kiss_fftri(plan->cfg_fast_c2r,&data[coffset],&rdata[offset]);
+#endif
+
+  // reverse pre-remap to put real data in output format if needed
+
+  if (plan->inv_pre_plan)
+    remap_3d(rdata,out,(FFT_SCALAR *) plan->scratch,plan->inv_pre_plan);
+  else if (rdata != out)
+    memcpy(out,rdata,plan->normnum*sizeof(FFT_SCALAR));
+
+  // scaling if required
+
+  if (plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = plan->normnum;
+    for (int i = 0; i < num; i++) out[i] *= norm;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   initialize fields only used by real-to-complex plans
+   so that fft_3d_destroy_plan() works for either kind of plan
+------------------------------------------------------------------------- */
+
+static void fft_3d_clear_real(struct fft_plan_3d *plan)
+{
+  plan->real = 0;
+  plan->clength1 = 0;
+  plan->inv_pre_plan = nullptr;
+  plan->inv_mid1_plan = nullptr;
+  plan->inv_mid2_plan = nullptr;
+  plan->inv_post_plan = nullptr;
+  plan->rcopy = nullptr;
+
+#if defined(FFT_MKL)
+  plan->handle_fast_c2r = nullptr;
+#elif defined(FFT_FFTW3)
+  plan->plan_fast_r2c = nullptr;
+  plan->plan_fast_c2r = nullptr;
+#else
+  plan->cfg_fast_r2c = nullptr;
+  plan->cfg_fast_c2r = nullptr;
+#endif
+}
+
 /* ----------------------------------------------------------------------
    Create plan for performing a 3d FFT
 
@@ -281,6 +509,7 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
+  fft_3d_clear_real(plan);
 
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
@@ -598,6 +827,401 @@ struct fft_plan_3d *fft_3d_create_plan(
   return plan;
 }
 
+/* ----------------------------------------------------------------------
+   Create plan for performing a 3d real-to-complex FFT (forward)
+     and its inverse complex-to-real FFT (backward)
+
+   the complex data only stores the nfast/2+1 non-redundant values
+     along the fast axis, the others follow from conjugate symmetry
+   forward = fft_3d_r2c(), backward = fft_3d_c2r() with the same plan
+   compared to fft_3d(), this halves the FFT work along the mid and
+     slow axes and the data volume of all remaps
+
+   Arguments:
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d matrix of real values
+   in_ilo,in_ihi        bounds of real data I own in fast index (0 to nfast-1)
+   in_jlo,in_jhi        bounds of real data I own in mid index
+   in_klo,in_khi        bounds of real data I own in slow index
+   out_ilo,out_ihi      bounds of complex data I own in fast index
+                          (0 to nfast/2)
+   out_jlo,out_jhi      bounds of complex data I own in mid index
+   out_klo,out_khi      bounds of complex data I own in slow index
+   scaled               0 = no scaling of backward result, 1 = scaling
+   nbuf                 returns size of internal storage buffers used by FFT
+   usecollective        use collective MPI operations for remapping data
+------------------------------------------------------------------------- */
+
+struct fft_plan_3d *fft_3d_create_plan_r2c(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi,
+       int out_ilo, int out_ihi, int out_jlo, int out_jhi,
+       int out_klo, int out_khi,
+       int scaled, int *nbuf, int usecollective)
+{
+  struct fft_plan_3d *plan;
+  int me,nprocs,nthreads;
+  int flag,remapflag;
+  int first_ilo,first_ihi,first_jlo,first_jhi,first_klo,first_khi;
+  int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
+  int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
+  int in_size,out_size,first_rsize,first_csize,second_size,third_size;
+  int copy_size,scratch_size;
+  int np1,np2,ip1,ip2;
+
+  // nfastc = # of complex values along fast axis
+
+  const int nfastc = nfast/2 + 1;
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+#if defined(_OPENMP)
+  nthreads = omp_get_max_threads();
+#else
+  nthreads = 1;
+#endif
+
+  bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+  plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
+  if (plan == nullptr) return nullptr;
+  fft_3d_clear_real(plan);
+  plan->real = 1;
+
+  // remap of real data from input distribution to layout of 1st FFTs
+  // not needed if all procs own entire fast axis initially
+
+  if (in_ilo == 0 && in_ihi == nfast-1)
+    flag = 0;
+  else
+    flag = 1;
+
+  MPI_Allreduce(&flag,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  if (remapflag == 0) {
+    first_jlo = in_jlo;
+    first_jhi = in_jhi;
+    first_klo = in_klo;
+    first_khi = in_khi;
+    plan->pre_plan = nullptr;
+  } else {
+    first_jlo = ip1*nmid/np1;
+    first_jhi = (ip1+1)*nmid/np1 - 1;
+    first_klo = ip2*nslow/np2;
+    first_khi = (ip2+1)*nslow/np2 - 1;
+    plan->pre_plan =
+      remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                           0,nfast-1,first_jlo,first_jhi,
+                           first_klo,first_khi,1,0,0,FFT_PRECISION,0);
+    if (plan->pre_plan == nullptr) return nullptr;
+    plan->inv_pre_plan =
+      remap_3d_create_plan(comm,0,nfast-1,first_jlo,first_jhi,
+                           first_klo,first_khi,
+                           in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                           1,0,0,FFT_PRECISION,0);
+    if (plan->inv_pre_plan == nullptr) return nullptr;
+  }
+
+  // 1d real-to-complex FFTs along fast axis
+  // first indices = complex distribution after 1st set of FFTs
+
+  first_ilo = 0;
+  first_ihi = nfastc - 1;
+
+  plan->length1 = nfast;
+  plan->clength1 = nfastc;
+  plan->total1 = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+
+  // remap from 1st to 2nd FFT, and its reverse
+
+  second_ilo = ip1*nfastc/np1;
+  second_ihi = (ip1+1)*nfastc/np1 - 1;
+  second_jlo = 0;
+  second_jhi = nmid - 1;
+  second_klo = ip2*nslow/np2;
+  second_khi = (ip2+1)*nslow/np2 - 1;
+  plan->mid1_plan =
+      remap_3d_create_plan(comm,
+                           first_ilo,first_ihi,first_jlo,first_jhi,
+                           first_klo,first_khi,
+                           second_ilo,second_ihi,second_jlo,second_jhi,
+                           second_klo,second_khi,2,1,0,FFT_PRECISION,
+                           usecollective);
+  if (plan->mid1_plan == nullptr) return nullptr;
+  plan->inv_mid1_plan =
+      remap_3d_create_plan(comm,
+                           second_jlo,second_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,
+                           first_jlo,first_jhi,first_klo,first_khi,
+                           first_ilo,first_ihi,2,2,0,FFT_PRECISION,
+                           usecollective);
+  if (plan->inv_mid1_plan == nullptr) return nullptr;
+
+  // 1d FFTs along mid axis
+
+  plan->length2 = nmid;
+  plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+
+  // remap from 2nd to 3rd FFT, and its reverse
+
+  third_ilo = ip1*nfastc/np1;
+  third_ihi = (ip1+1)*nfastc/np1 - 1;
+  third_jlo = ip2*nmid/np2;
+  third_jhi = (ip2+1)*nmid/np2 - 1;
+  third_klo = 0;
+  third_khi = nslow - 1;
+
+  plan->mid2_plan =
+    remap_3d_create_plan(comm,
+                         second_jlo,second_jhi,second_klo,second_khi,
+                         second_ilo,second_ihi,
+                         third_jlo,third_jhi,third_klo,third_khi,
+                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+  if (plan->mid2_plan == nullptr) return nullptr;
+  plan->inv_mid2_plan =
+    remap_3d_create_plan(comm,
+                         third_klo,third_khi,third_ilo,third_ihi,
+                         third_jlo,third_jhi,
+                         second_klo,second_khi,second_ilo,second_ihi,
+                         second_jlo,second_jhi,2,2,0,FFT_PRECISION,
+                         usecollective);
+  if (plan->inv_mid2_plan == nullptr) return nullptr;
+
+  // 1d FFTs along slow axis
+
+  plan->length3 = nslow;
+  plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+  // remap from 3rd FFT to final distribution, and its reverse
+
+  plan->post_plan =
+    remap_3d_create_plan(comm,
+                         third_klo,third_khi,third_ilo,third_ihi,
+                         third_jlo,third_jhi,
+                         out_klo,out_khi,out_ilo,out_ihi,
+                         out_jlo,out_jhi,2,1,0,FFT_PRECISION,0);
+  if (plan->post_plan == nullptr) return nullptr;
+  plan->inv_post_plan =
+    remap_3d_create_plan(comm,
+                         out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                         third_ilo,third_ihi,third_jlo,third_jhi,
+                         third_klo,third_khi,2,2,0,FFT_PRECISION,0);
+  if (plan->inv_post_plan == nullptr) return nullptr;
+
+  // configure plan memory pointers and allocate work space
+  // in_size = # of real values given to FFT by user
+  // out_size = # of complex values given to FFT by user
+  // first_rsize,first_csize = real and complex size of 1st FFT data
+  // second/third_size = amount of memory needed after mid1,mid2 remaps
+  // forward: complex results go to out if big enough, else to copy
+  // backward: complex results go to in (= out layout) if big enough
+  // sizes of copy and scratch are in complex values,
+  //   real remaps need half as many
+
+  in_size = (in_ihi-in_ilo+1) * (in_jhi-in_jlo+1) * (in_khi-in_klo+1);
+  out_size = (out_ihi-out_ilo+1) * (out_jhi-out_jlo+1) * (out_khi-out_klo+1);
+  first_rsize = nfast * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  first_csize = nfastc * (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  second_size = (second_ihi-second_ilo+1) * (second_jhi-second_jlo+1) *
+    (second_khi-second_klo+1);
+  third_size = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) *
+    (third_khi-third_klo+1);
+
+  copy_size = 0;
+  scratch_size = 0;
+
+  if (plan->pre_plan) {
+    scratch_size = MAX(scratch_size,(first_rsize+1)/2);
+    scratch_size = MAX(scratch_size,(in_size+1)/2);
+  }
+
+  // r2c FFTs cannot write to out if they read from it
+
+  if (plan->pre_plan && first_csize <= out_size)
+    plan->r2c_target = 0;
+  else {
+    plan->r2c_target = 1;
+    copy_size = MAX(copy_size,first_csize);
+  }
+
+  if (second_size <= out_size) {
+    plan->mid1_target = 0;
+    plan->inv_mid2_target = 0;
+  } else {
+    plan->mid1_target = 1;
+    plan->inv_mid2_target = 1;
+    copy_size = MAX(copy_size,second_size);
+  }
+  scratch_size = MAX(scratch_size,second_size);
+
+  if (third_size <= out_size) {
+    plan->mid2_target = 0;
+    plan->inv_post_target = 0;
+  } else {
+    plan->mid2_target = 1;
+    plan->inv_post_target = 1;
+    copy_size = MAX(copy_size,third_size);
+  }
+  scratch_size = MAX(scratch_size,third_size);
+
+  if (first_csize <= out_size)
+    plan->inv_mid1_target = 0;
+  else {
+    plan->inv_mid1_target = 1;
+    copy_size = MAX(copy_size,first_csize);
+  }
+  scratch_size = MAX(scratch_size,first_csize);
+  scratch_size = MAX(scratch_size,out_size);
+
+  // copy and rcopy always exist, FFTW plans are made with them
+
+  copy_size = MAX(copy_size,1);
+  *nbuf = copy_size + scratch_size + (first_rsize+1)/2;
+
+  plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_DATA));
+  if (plan->copy == nullptr) return nullptr;
+
+  plan->rcopy = (FFT_SCALAR *) calloc(MAX(first_rsize,1),sizeof(FFT_SCALAR));
+  if (plan->rcopy == nullptr) return nullptr;
+
+  if (scratch_size) {
+    plan->scratch = (FFT_DATA *) malloc(scratch_size*sizeof(FFT_DATA));
+    if (plan->scratch == nullptr) return nullptr;
+  }
+  else plan->scratch = nullptr;
+
+  // system specific pre-computation of 1d FFT coeffs
+
+#if defined(FFT_MKL)
+  DftiCreateDescriptor( &(plan->handle_fast), FFT_MKL_PREC, DFTI_REAL, 1,
+                        (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total1/nfast);
+  DftiSetValue(plan->handle_fast, DFTI_PLACEMENT,DFTI_NOT_INPLACE);
+  DftiSetValue(plan->handle_fast, DFTI_CONJUGATE_EVEN_STORAGE,
+               DFTI_COMPLEX_COMPLEX);
+  DftiSetValue(plan->handle_fast, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_fast, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfastc);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_fast);
+
+  DftiCreateDescriptor( &(plan->handle_fast_c2r), FFT_MKL_PREC, DFTI_REAL, 1,
+                        (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_fast_c2r, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total1/nfast);
+  DftiSetValue(plan->handle_fast_c2r, DFTI_PLACEMENT,DFTI_NOT_INPLACE);
+  DftiSetValue(plan->handle_fast_c2r, DFTI_CONJUGATE_EVEN_STORAGE,
+               DFTI_COMPLEX_COMPLEX);
+  DftiSetValue(plan->handle_fast_c2r, DFTI_INPUT_DISTANCE, (MKL_LONG)nfastc);
+  DftiSetValue(plan->handle_fast_c2r, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_fast_c2r, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_fast_c2r);
+
+  DftiCreateDescriptor( &(plan->handle_mid), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total2/nmid);
+  DftiSetValue(plan->handle_mid, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_mid, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_mid);
+
+  DftiCreateDescriptor( &(plan->handle_slow), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total3/nslow);
+  DftiSetValue(plan->handle_slow, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_slow, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_slow);
+
+#elif defined(FFT_FFTW3)
+#if defined(FFT_FFTW_THREADS)
+  if (nthreads > 1) {
+    FFTW_API(init_threads)();
+    FFTW_API(plan_with_nthreads)(nthreads);
+  }
+#endif
+
+  // r2c/c2r plans are out-of-place, so are made with distinct buffers
+
+  plan->plan_fast_r2c =
+    FFTW_API(plan_many_dft_r2c)(1, &nfast,plan->total1/plan->length1,
+                                plan->rcopy,&nfast,1,nfast,
+                                plan->copy,&nfastc,1,nfastc,
+                                FFTW_ESTIMATE);
+  plan->plan_fast_c2r =
+    FFTW_API(plan_many_dft_c2r)(1, &nfast,plan->total1/plan->length1,
+                                plan->copy,&nfastc,1,nfastc,
+                                plan->rcopy,&nfast,1,nfast,
+                                FFTW_ESTIMATE);
+  plan->plan_fast_forward = nullptr;
+  plan->plan_fast_backward = nullptr;
+  plan->plan_mid_forward =
+    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            FFTW_FORWARD,FFTW_ESTIMATE);
+  plan->plan_mid_backward =
+    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            nullptr,&nmid,1,plan->length2,
+                            FFTW_BACKWARD,FFTW_ESTIMATE);
+  plan->plan_slow_forward =
+    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            FFTW_FORWARD,FFTW_ESTIMATE);
+  plan->plan_slow_backward =
+    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            nullptr,&nslow,1,plan->length3,
+                            FFTW_BACKWARD,FFTW_ESTIMATE);
+
+#else /* FFT_KISS */
+
+  plan->cfg_fast_r2c = kiss_fftr_alloc(nfast,0);
+  plan->cfg_fast_c2r = kiss_fftr_alloc(nfast,1);
+  plan->cfg_fast_forward = nullptr;
+  plan->cfg_fast_backward = nullptr;
+
+  plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
+  plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
+
+  if (nslow == nmid) {
+    plan->cfg_slow_forward = plan->cfg_mid_forward;
+    plan->cfg_slow_backward = plan->cfg_mid_backward;
+  }
+  else {
+    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
+    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
+  }
+
+#endif
+
+  // normnum = # of real values, also used to copy c2r results
+
+  plan->scaled = scaled ? 1 : 0;
+  plan->norm = 1.0/(nfast*nmid*nslow);
+  plan->normnum = in_size;
+
+  return plan;
+}
+
 /* ----------------------------------------------------------------------
    Destroy a 3d fft plan
 ------------------------------------------------------------------------- */
@@ -608,21 +1232,32 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   if (plan->mid1_plan) remap_3d_destroy_plan(plan->mid1_plan);
   if (plan->mid2_plan) remap_3d_destroy_plan(plan->mid2_plan);
   if (plan->post_plan) remap_3d_destroy_plan(plan->post_plan);
+  if (plan->inv_pre_plan) remap_3d_destroy_plan(plan->inv_pre_plan);
+  if (plan->inv_mid1_plan) remap_3d_destroy_plan(plan->inv_mid1_plan);
+  if (plan->inv_mid2_plan) remap_3d_destroy_plan(plan->inv_mid2_plan);
+  if (plan->inv_post_plan) remap_3d_destroy_plan(plan->inv_post_plan);
 
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
+  if (plan->rcopy) free(plan->rcopy);
 
 #if defined(FFT_MKL)
   DftiFreeDescriptor(&(plan->handle_fast));
   DftiFreeDescriptor(&(plan->handle_mid));
   DftiFreeDescriptor(&(plan->handle_slow));
+  if (plan->handle_fast_c2r) DftiFreeDescriptor(&(plan->handle_fast_c2r));
 #elif defined(FFT_FFTW3)
   FFTW_API(destroy_plan)(plan->plan_slow_forward);
   FFTW_API(destroy_plan)(plan->plan_slow_backward);
   FFTW_API(destroy_plan)(plan->plan_mid_forward);
   FFTW_API(destroy_plan)(plan->plan_mid_backward);
-  FFTW_API(destroy_plan)(plan->plan_fast_forward);
-  FFTW_API(destroy_plan)(plan->plan_fast_backward);
+  if (plan->real) {
+    FFTW_API(destroy_plan)(plan->plan_fast_r2c);
+    FFTW_API(destroy_plan)(plan->plan_fast_c2r);
+  } else {
+    FFTW_API(destroy_plan)(plan->plan_fast_forward);
+    FFTW_API(destroy_plan)(plan->plan_fast_backward);
+  }
 #if defined(FFT_FFTW_THREADS)
   FFTW_API(cleanup_threads)();
 #endif
@@ -638,6 +1273,8 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   }
   free(plan->cfg_fast_forward);
   free(plan->cfg_fast_backward);
+  free(plan->cfg_fast_r2c);
+  free(plan->cfg_fast_c2r);
 #endif
 
   free(plan);
@@ -702,6 +1339,75 @@ void bifactor(int n, int *factor1, int *factor2)
   }
 }
 
+/* ----------------------------------------------------------------------
+   perform just the 1d FFTs needed by a 3d real-to-complex FFT
+   1st FFTs read/write the real values in rcopy, which are zero
+   skipped if data is too small for any of the complex FFTs
+------------------------------------------------------------------------- */
+
+static void fft_1d_only_real(FFT_DATA *data, int nsize, int flag,
+                             struct fft_plan_3d *plan)
+{
+  int total1 = plan->total1;
+  int length1 = plan->length1;
+  int ctotal1 = total1/length1 * plan->clength1;
+  int total2 = plan->total2;
+  int length2 = plan->length2;
+  int total3 = plan->total3;
+  int length3 = plan->length3;
+
+  if ((ctotal1 > nsize) || (total2 > nsize) || (total3 > nsize)) return;
+
+  FFT_SCALAR *rdata = plan->rcopy;
+
+#if defined(FFT_MKL)
+  if (flag == 1) {
+    DftiComputeForward(plan->handle_fast,rdata,data);
+    DftiComputeForward(plan->handle_mid,data);
+    DftiComputeForward(plan->handle_slow,data);
+  } else {
+    DftiComputeBackward(plan->handle_slow,data);
+    DftiComputeBackward(plan->handle_mid,data);
+    DftiComputeBackward(plan->handle_fast_c2r,data,rdata);
+  }
+#elif defined(FFT_FFTW3)
+  if (flag == 1) {
+    FFTW_API(execute_dft_r2c)(plan->plan_fast_r2c,rdata,data);
+    FFTW_API(execute_dft)(plan->plan_mid_forward,data,data);
+    FFTW_API(execute_dft)(plan->plan_slow_forward,data,data);
+  } else {
+    FFTW_API(execute_dft)(plan->plan_slow_backward,data,data);
+    FFTW_API(execute_dft)(plan->plan_mid_backward,data,data);
+    FFTW_API(execute_dft_c2r)(plan->plan_fast_c2r,data,rdata);
+  }
+#else
+  int clength1 = plan->clength1;
+  if (flag == 1) {
+    for (int offset = 0, coffset = 0; offset < total1;
+         offset += length1, coffset += clength1)
+      kiss_fftr(plan->cfg_fast_r2c,&rdata[offset],&data[coffset]);
+    for (int offset = 0; offset < total2; offset += length2)
+      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
+    for (int offset = 0; offset < total3; offset += length3)
+      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
+  } else {
+    for (int offset = 0; offset < total3; offset += length3)
+      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
+    for (int offset = 0; offset < total2; offset += length2)
+      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
+    for (int offset = 0, coffset = 0; offset < total1;
+         offset += length1, coffset += clength1)
+      kiss_fftri(plan->cfg_fast_c2r,&data[coffset],&rdata[offset]);
+  }
+#endif
+
+  if (flag == -1 && plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = MIN(plan->normnum,total1);
+    for (int i = 0; i < num; i++) rdata[i] *= norm;
+  }
+}
+
 /* ----------------------------------------------------------------------
    perform just the 1d FFTs needed by a 3d FFT, no data movement
    used for timing purposes
@@ -733,6 +1439,13 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
   int total3 = plan->total3;
   int length3 = plan->length3;
 
+  // real-to-complex plan: 1st FFTs go between rcopy and data
+
+  if (plan->real) {
+    fft_1d_only_real(data,nsize,flag,plan);
+    return;
+  }
+
 // fftw3 and Dfti in MKL encode the number of transforms
 // into the plan, so we cannot operate on a smaller data set
 
@@ -63,6 +63,8 @@ typedef struct {
 
 struct kiss_fft_state;
 typedef struct kiss_fft_state *kiss_fft_cfg;
+struct kiss_fftr_state;
+typedef struct kiss_fftr_state *kiss_fftr_cfg;
 #endif
 
 // -------------------------------------------------------------------------
@@ -95,6 +97,8 @@ typedef struct {
 
 struct kiss_fft_state;
 typedef struct kiss_fft_state *kiss_fft_cfg;
+struct kiss_fftr_state;
+typedef struct kiss_fftr_state *kiss_fftr_cfg;
 #endif
 
 #else
@@ -120,11 +124,26 @@ struct fft_plan_3d {
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
 
+  // real-to-complex plans only
+  // 1st FFTs are real <-> complex along the fast axis,
+  // inverse remaps run the forward ones in reverse for c2r
+
+  int real;                               // 1 for r2c/c2r plan, 0 for c2c
+  int clength1;                           // nfast/2+1 complex values per 1st FFT
+  struct remap_plan_3d *inv_pre_plan;     // reverse of pre_plan (real data)
+  struct remap_plan_3d *inv_mid1_plan;    // reverse of mid1_plan
+  struct remap_plan_3d *inv_mid2_plan;    // reverse of mid2_plan
+  struct remap_plan_3d *inv_post_plan;    // reverse of post_plan
+  FFT_SCALAR *rcopy;                      // real data in 1st FFT layout
+  int r2c_target;                         // where to put 1st FFT results
+  int inv_post_target, inv_mid2_target, inv_mid1_target;
+
   // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
   DFTI_DESCRIPTOR *handle_mid;
   DFTI_DESCRIPTOR *handle_slow;
+  DFTI_DESCRIPTOR *handle_fast_c2r;
 #elif defined(FFT_FFTW3)
   FFTW_API(plan) plan_fast_forward;
   FFTW_API(plan) plan_fast_backward;
@@ -132,6 +151,8 @@ struct fft_plan_3d {
   FFTW_API(plan) plan_mid_backward;
   FFTW_API(plan) plan_slow_forward;
   FFTW_API(plan) plan_slow_backward;
+  FFTW_API(plan) plan_fast_r2c;
+  FFTW_API(plan) plan_fast_c2r;
 #elif defined(FFT_KISS)
   kiss_fft_cfg cfg_fast_forward;
   kiss_fft_cfg cfg_fast_backward;
@@ -139,20 +160,26 @@ struct fft_plan_3d {
   kiss_fft_cfg cfg_mid_backward;
   kiss_fft_cfg cfg_slow_forward;
   kiss_fft_cfg cfg_slow_backward;
+  kiss_fftr_cfg cfg_fast_r2c;
+  kiss_fftr_cfg cfg_fast_c2r;
 #endif
 };
 
 // function prototypes
+// C++ linkage, so the single precision instance of these functions
+//   compiled by fft3d_single.cpp can coexist with this one
 
-extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
                                        int, int, int, int, int, int, int, int *, int);
+void fft_3d_r2c(FFT_SCALAR *, FFT_DATA *, struct fft_plan_3d *);
+void fft_3d_c2r(FFT_DATA *, FFT_SCALAR *, struct fft_plan_3d *);
+struct fft_plan_3d *fft_3d_create_plan_r2c(MPI_Comm, int, int, int, int, int, int, int, int, int,
+                                           int, int, int, int, int, int, int, int *, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
 void fft_1d_only(FFT_DATA *, int, int, struct fft_plan_3d *);
-}
 
 /* ERROR/WARNING messages:
 
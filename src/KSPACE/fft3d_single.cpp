@@ -0,0 +1,92 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   single precision instance of the 3d FFT and remap functions
+   fft3d.cpp and remap.cpp are compiled a second time with FFT_SINGLE
+     into namespace FFTSingle, so that kspace_modify fft/single can use
+     float grids and FFTs in a LAMMPS binary with double precision FFTs
+   nothing is compiled if FFT_SINGLE is defined, since the FFT_SCALAR
+     instance is single precision then
+------------------------------------------------------------------------- */
+
+#ifndef FFT_SINGLE
+
+#include "fft3d_single.h"
+
+// FFTW3 needs the separate single precision FFTW3 library
+// it is only linked if FFT_FFTW3F is defined, else use KISS FFT
+
+#if (defined(FFT_FFTW) || defined(FFT_FFTW3)) && !defined(FFT_FFTW3F)
+#undef FFT_FFTW
+#undef FFT_FFTW3
+#undef FFT_FFTW_THREADS
+#define FFT_KISS
+#endif
+
+#define FFT_SINGLE
+
+// include all system and FFT library headers used by fft3d.cpp,
+//   remap.cpp and kissfft.h here, so their include guards keep them
+//   out of the namespace below
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(FFT_MKL)
+#include "mkl_dfti.h"
+#elif defined(FFT_FFTW) || defined(FFT_FFTW3)
+#include "fftw3.h"
+#elif defined(KISS_FFT_USE_ALLOCA)
+#include <alloca.h>
+#endif
+
+namespace LAMMPS_NS {
+namespace FFTSingle {
+
+#include "fft3d.cpp"
+#include "remap.cpp"
+
+/* ----------------------------------------------------------------------
+   perform a 3d FFT of float data with a single precision plan
+   c2c FFT in either direction, or r2c FFT forward and c2r FFT backward
+------------------------------------------------------------------------- */
+
+void fft_3d_float(float *in, float *out, int flag, struct fft_plan_3d *plan)
+{
+  if (plan->real) {
+    if (flag == 1) fft_3d_r2c(in,(FFT_DATA *) out,plan);
+    else fft_3d_c2r((FFT_DATA *) in,out,plan);
+  } else fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
+}
+
+/* ----------------------------------------------------------------------
+   perform only the 1d FFTs of float data, for timing purposes
+------------------------------------------------------------------------- */
+
+void fft_1d_only_float(float *data, int nsize, int flag,
+                       struct fft_plan_3d *plan)
+{
+  fft_1d_only((FFT_DATA *) data,nsize,flag,plan);
+}
+
+}    // namespace FFTSingle
+}    // namespace LAMMPS_NS
+
+#endif
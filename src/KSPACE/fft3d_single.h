@@ -0,0 +1,47 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_FFT3D_SINGLE_H
+#define LMP_FFT3D_SINGLE_H
+
+#include <mpi.h>
+
+// single precision instance of the 3d FFT and remap functions
+// compiled by fft3d_single.cpp in addition to the FFT_SCALAR instance
+//   of fft3d.cpp and remap.cpp, unless FFT_SINGLE is defined
+// used by the FFT3d and Remap classes for kspace_modify fft/single,
+//   data is passed as float arrays, complex values as (re,im) pairs
+
+namespace LAMMPS_NS {
+namespace FFTSingle {
+
+  struct fft_plan_3d;
+  struct remap_plan_3d;
+
+  struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int,
+                                         int, int, int, int, int, int, int, int, int *, int);
+  struct fft_plan_3d *fft_3d_create_plan_r2c(MPI_Comm, int, int, int, int, int, int, int, int,
+                                             int, int, int, int, int, int, int, int, int *, int);
+  void fft_3d_destroy_plan(struct fft_plan_3d *);
+  void fft_3d_float(float *, float *, int, struct fft_plan_3d *);
+  void fft_1d_only_float(float *, int, int, struct fft_plan_3d *);
+
+  void remap_3d(float *, float *, float *, struct remap_plan_3d *);
+  struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int,
+                                             int, int, int, int, int, int, int, int, int);
+  void remap_3d_destroy_plan(struct remap_plan_3d *);
+
+}    // namespace FFTSingle
+}    // namespace LAMMPS_NS
+
+#endif
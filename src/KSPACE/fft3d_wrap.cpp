@@ -15,6 +15,7 @@
 #include "fft3d_wrap.h"
 
 #include "error.h"
+#include "fft3d_single.h"
 
 using namespace LAMMPS_NS;
 
@@ -25,12 +26,55 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
              int in_klo, int in_khi,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
-             int scaled, int permute, int *nbuf, int usecollective) : Pointers(lmp)
+             int scaled, int permute, int *nbuf, int usecollective,
+             int realflag, int precision) : Pointers(lmp)
 {
-  plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
-                            in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
-                            out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                            scaled,permute,nbuf,usecollective);
+  // realflag = 1 for real-to-complex FFT, in = real data, out = complex data
+  // forward = r2c and backward = c2r, using the same plan
+
+  if (realflag && permute)
+    error->all(FLERR,"Real-to-complex 3d FFT does not support permuted output");
+
+  plan = nullptr;
+
+  // precision = 1 with double precision FFT_SCALAR creates a plan
+  //   of the single precision FFT instance for float data
+
+#ifndef FFT_SINGLE
+  plan_single = nullptr;
+
+  if (precision == 1) {
+    if (realflag)
+      plan_single =
+        FFTSingle::fft_3d_create_plan_r2c(comm,nfast,nmid,nslow,
+                                          in_ilo,in_ihi,in_jlo,in_jhi,
+                                          in_klo,in_khi,
+                                          out_ilo,out_ihi,out_jlo,out_jhi,
+                                          out_klo,out_khi,scaled,nbuf,
+                                          usecollective);
+    else
+      plan_single =
+        FFTSingle::fft_3d_create_plan(comm,nfast,nmid,nslow,
+                                      in_ilo,in_ihi,in_jlo,in_jhi,
+                                      in_klo,in_khi,
+                                      out_ilo,out_ihi,out_jlo,out_jhi,
+                                      out_klo,out_khi,scaled,permute,nbuf,
+                                      usecollective);
+    if (plan_single == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
+    return;
+  }
+#endif
+
+  if (realflag)
+    plan = fft_3d_create_plan_r2c(comm,nfast,nmid,nslow,
+                                  in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                  out_ilo,out_ihi,out_jlo,out_jhi,
+                                  out_klo,out_khi,scaled,nbuf,usecollective);
+  else
+    plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
+                              in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                              out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                              scaled,permute,nbuf,usecollective);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
 }
 
@@ -38,14 +82,20 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
 
 FFT3d::~FFT3d()
 {
-  fft_3d_destroy_plan(plan);
+  if (plan) fft_3d_destroy_plan(plan);
+#ifndef FFT_SINGLE
+  if (plan_single) FFTSingle::fft_3d_destroy_plan(plan_single);
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
 
 void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
 {
-  fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
+  if (plan->real) {
+    if (flag == FORWARD) fft_3d_r2c(in,(FFT_DATA *) out,plan);
+    else fft_3d_c2r((FFT_DATA *) in,out,plan);
+  } else fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -54,3 +104,21 @@ void FFT3d::timing1d(FFT_SCALAR *in, int nsize, int flag)
 {
   fft_1d_only((FFT_DATA *) in,nsize,flag,plan);
 }
+
+#ifndef FFT_SINGLE
+
+/* ---------------------------------------------------------------------- */
+
+void FFT3d::compute(float *in, float *out, int flag)
+{
+  FFTSingle::fft_3d_float(in,out,flag,plan_single);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FFT3d::timing1d(float *in, int nsize, int flag)
+{
+  FFTSingle::fft_1d_only_float(in,nsize,flag,plan_single);
+}
+
+#endif
@@ -19,18 +19,34 @@
 
 namespace LAMMPS_NS {
 
+#ifndef FFT_SINGLE
+namespace FFTSingle {
+  struct fft_plan_3d;
+}
+#endif
+
 class FFT3d : protected Pointers {
  public:
   enum { FORWARD = 1, BACKWARD = -1 };
 
   FFT3d(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
-        int, int, int, int, int *, int);
+        int, int, int, int, int *, int, int realflag = 0, int precision = FFT_PRECISION);
   ~FFT3d();
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
   void timing1d(FFT_SCALAR *, int, int);
 
+#ifndef FFT_SINGLE
+  // float data for a plan created with precision = 1
+
+  void compute(float *, float *, int);
+  void timing1d(float *, int, int);
+#endif
+
  private:
   struct fft_plan_3d *plan;
+#ifndef FFT_SINGLE
+  struct FFTSingle::fft_plan_3d *plan_single;
+#endif
 };
 
 }    // namespace LAMMPS_NS
@@ -45,4 +61,8 @@ The FFT setup for the PPPM solver failed, typically due
 to lack of memory.  This is an unusual error.  Check the
 size of the FFT grid you are requesting.
 
+E: Real-to-complex 3d FFT does not support permuted output
+
+Self-explanatory.
+
 */
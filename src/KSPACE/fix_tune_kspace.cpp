@@ -18,8 +18,10 @@
 
 #include "fix_tune_kspace.h"
 
+#include "atom.h"
 #include "comm.h"
 #include "compute.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
 #include "info.h"
@@ -28,6 +30,7 @@
 #include "neighbor.h"
 #include "pair.h"
 #include "timer.h"
+#include "tokenizer.h"
 #include "update.h"
 
 #include <cmath>
@@ -37,6 +40,7 @@
 #define SWAP(a,b) {temp=(a);(a)=(b);(b)=temp;}
 #define SIGN(a,b) ((b) >= 0.0 ? fabs(a) : -fabs(a))
 #define GOLD 1.618034
+#define MAXLINE 256
 
 using namespace std;
 using namespace LAMMPS_NS;
@@ -45,14 +49,19 @@ using namespace FixConst;
 /* ---------------------------------------------------------------------- */
 
 FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
-  Fix(lmp, narg, arg),
+  Fix(lmp, narg, arg), cachefile(nullptr),
   acc_str(""), kspace_style(""), pair_style(""), base_pair_style("")
 {
-  if (narg < 3) error->all(FLERR,"Illegal fix tune/kspace command");
+  if (narg < 4) error->all(FLERR,"Illegal fix tune/kspace command");
 
   global_freq = 1;
   firststep = 0;
   niter = 0;
+  tuned = false;
+  kspace_order = 0;
+  norder = iorder = 0;
+  best_order = 0;
+  best_order_time = 0.0;
   niter_adjust_rcut = 0;
   keep_bracketing = true;
   first_brent_pass = true;
@@ -66,6 +75,24 @@ FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix tune/kspace command");
 
+  order_flag = 0;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"order") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/kspace command");
+      if (strcmp(arg[iarg+1],"yes") == 0) order_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) order_flag = 0;
+      else error->all(FLERR,"Illegal fix tune/kspace command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"cache") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/kspace command");
+      delete [] cachefile;
+      cachefile = utils::strdup(arg[iarg+1]);
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix tune/kspace command");
+  }
+
   // set up reneighboring
 
   force_reneighbor = 1;
@@ -74,6 +101,13 @@ FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
 
 /* ---------------------------------------------------------------------- */
 
+FixTuneKspace::~FixTuneKspace()
+{
+  delete [] cachefile;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int FixTuneKspace::setmask()
 {
   int mask = 0;
@@ -119,6 +153,7 @@ void FixTuneKspace::pre_exchange()
   if (!force->pair) return;
   if (next_reneighbor != update->ntimestep) return;
   next_reneighbor = update->ntimestep + nevery;
+  if (tuned) return;
 
   Info *info = new Info(lmp);
   bool has_msm = info->has_style("pair", base_pair_style + "/msm");
@@ -131,7 +166,20 @@ void FixTuneKspace::pre_exchange()
   if (utils::strmatch(force->kspace_style,"^msm")) msm_time = time;
 
   niter++;
-  if (niter == 1) {
+  bool cached = false;
+  if (niter == 1 && cachefile) {
+    store_old_kspace_settings();
+    signature = cache_signature();
+    cached = read_cache();
+  }
+
+  if (cached) {
+    // use settings tuned by a previous run
+    pair_style = base_pair_style + (kspace_style == "msm" ? "/msm" : "/long");
+    update_pair_style(pair_style,pair_cut_coul);
+    update_kspace_style(kspace_style,acc_str);
+    tuned = true;
+  } else if (niter == 1) {
     // test Ewald
     store_old_kspace_settings();
     pair_style = base_pair_style + "/long";
@@ -166,9 +214,13 @@ void FixTuneKspace::pre_exchange()
     }
     update_pair_style(pair_style,pair_cut_coul);
     update_kspace_style(kspace_style,acc_str);
-  } else {
+  } else if (!converged && !utils::strmatch(force->kspace_style,"^msm")) {
     adjust_rcut(time);
-  }
+  } else if (order_flag) {
+    adjust_order(time);
+  } else tuned = true;
+
+  if (tuned && cachefile && !cached) write_cache();
 
   last_spcpu = timer->elapsed(Timer::TOTAL);
 }
@@ -274,6 +326,7 @@ void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
   force->kspace->differentiation_flag = old_differentiation_flag;
   force->kspace->slabflag = old_slabflag;
   force->kspace->slab_volfactor = old_slab_volfactor;
+  if (kspace_order > 0) force->kspace->order = kspace_order;
 
   // initialize new kspace style, pair style, molecular styles
 
@@ -386,6 +439,156 @@ void FixTuneKspace::adjust_rcut(double time)
   update_kspace_style(kspace_style,acc_str);
 }
 
+/* ----------------------------------------------------------------------
+   find the fastest kspace order at the optimal real space cutoff
+   each order is timed for one interval, the grid size and
+     Ewald parameter are set by the kspace style for the given accuracy
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::adjust_order(double time)
+{
+  // first time through, time the current order and set up orders to test
+
+  if (norder == 0) {
+    best_order = force->kspace->order;
+    best_order_time = time;
+    if (utils::strmatch(force->kspace_style,"^pppm")) {
+      for (int i = 0; i < 5; i++)
+        if (i+3 != best_order) order_list[norder++] = i+3;
+    } else if (utils::strmatch(force->kspace_style,"^msm")) {
+      for (int i = 0; i < 4; i++)
+        if (2*i+4 != best_order) order_list[norder++] = 2*i+4;
+    }
+    iorder = -1;
+    if (norder == 0) {
+      tuned = true;
+      return;
+    }
+  } else if (time < best_order_time) {
+    best_order = force->kspace->order;
+    best_order_time = time;
+  }
+
+  iorder++;
+  if (iorder < norder) kspace_order = order_list[iorder];
+  else {
+    kspace_order = best_order;
+    tuned = true;
+    if (comm->me == 0)
+      utils::logmesg(lmp,"Selected kspace order: {}\n",kspace_order);
+  }
+
+  store_old_kspace_settings();
+  update_pair_style(pair_style,pair_cut_coul);
+  update_kspace_style(kspace_style,acc_str);
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"Kspace order: {}\n",force->kspace->order);
+}
+
+/* ----------------------------------------------------------------------
+   key of the system for the cache file
+   tuned settings depend on system size, box, charges, accuracy,
+     real space cutoff, and the parallel setup
+------------------------------------------------------------------------- */
+
+std::string FixTuneKspace::cache_signature()
+{
+  double *q = atom->q;
+  int nlocal = atom->nlocal;
+
+  double qsqsum_local = 0.0;
+  for (int i = 0; i < nlocal; i++) qsqsum_local += q[i]*q[i];
+  double qsqsum;
+  MPI_Allreduce(&qsqsum_local,&qsqsum,1,MPI_DOUBLE,MPI_SUM,world);
+
+  return fmt::format("{} {} {} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} {:.8g} "
+                     "{:.8g} {} {:.8g} {} {}",atom->natoms,comm->nprocs,
+                     comm->nthreads,domain->xprd,domain->yprd,domain->zprd,
+                     domain->xy,domain->xz,domain->yz,qsqsum,acc_str,
+                     pair_cut_coul,old_slabflag,base_pair_style);
+}
+
+/* ----------------------------------------------------------------------
+   look up tuned settings for this system in the cache file
+   each line is a signature followed by kspace style, cutoff, and order
+   the last matching line is used
+   return true if found and set kspace_style, pair_cut_coul, kspace_order
+------------------------------------------------------------------------- */
+
+bool FixTuneKspace::read_cache()
+{
+  int found = 0;
+  char style[64];
+  double cutoff = 0.0;
+  int order = 0;
+
+  if (comm->me == 0) {
+    FILE *fp = fopen(cachefile,"r");
+    if (fp) {
+      char line[MAXLINE];
+      const std::size_t nkey = signature.size();
+      while (fgets(line,MAXLINE,fp)) {
+        if (strncmp(line,signature.c_str(),nkey) != 0 || line[nkey] != ' ') continue;
+        try {
+          ValueTokenizer values(line+nkey);
+          std::string kstyle = values.next_string();
+          double kcut = values.next_double();
+          int korder = values.next_int();
+          if (kstyle.size() >= sizeof(style)) continue;
+          strcpy(style,kstyle.c_str());
+          cutoff = kcut;
+          order = korder;
+          found = 1;
+        } catch (TokenizerException &) {
+          continue;
+        }
+      }
+      fclose(fp);
+    }
+  }
+
+  MPI_Bcast(&found,1,MPI_INT,0,world);
+  if (!found) return false;
+
+  MPI_Bcast(style,64,MPI_CHAR,0,world);
+  MPI_Bcast(&cutoff,1,MPI_DOUBLE,0,world);
+  MPI_Bcast(&order,1,MPI_INT,0,world);
+
+  kspace_style = style;
+  pair_cut_coul = cutoff;
+  kspace_order = order;
+
+  if (comm->me == 0)
+    utils::logmesg(lmp,"Using tuned kspace settings from {}: {} with "
+                   "Coulomb cutoff {} and order {}\n",cachefile,
+                   kspace_style,pair_cut_coul,kspace_order);
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   append the settings now in use for this system to the cache file
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::write_cache()
+{
+  if (comm->me != 0) return;
+
+  FILE *fp = fopen(cachefile,"a");
+  if (fp == nullptr)
+    error->one(FLERR,fmt::format("Cannot open fix tune/kspace cache file {}",
+                                 cachefile));
+
+  std::string style = force->kspace_style;
+  if (utils::strmatch(style,"^ewald")) style = "ewald";
+  else if (utils::strmatch(style,"^pppm")) style = "pppm";
+  else if (utils::strmatch(style,"^msm")) style = "msm";
+
+  fmt::print(fp,"{} {} {:.8g} {}\n",signature,style,pair_cut_coul,
+             force->kspace->order);
+  fclose(fp);
+}
+
 /* ----------------------------------------------------------------------
    bracket a minimum using parabolic extrapolation
 ------------------------------------------------------------------------- */
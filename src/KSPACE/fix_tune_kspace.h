@@ -27,7 +27,7 @@ namespace LAMMPS_NS {
 class FixTuneKspace : public Fix {
  public:
   FixTuneKspace(class LAMMPS *, int, char **);
-  ~FixTuneKspace() {}
+  ~FixTuneKspace();
   int setmask();
   void init();
   void pre_exchange();
@@ -36,18 +36,32 @@ class FixTuneKspace : public Fix {
   void update_pair_style(const std::string &, double);
   void update_kspace_style(const std::string &, const std::string &);
   void adjust_rcut(double);
+  void adjust_order(double);
   void mnbrak();
   void brent0();
   void brent1();
   void brent2();
+  std::string cache_signature();
+  bool read_cache();
+  void write_cache();
 
  private:
   int nevery;
+  int order_flag;       // 1 if also optimize the kspace order
+  char *cachefile;      // file with tuned settings from previous runs
 
   int last_step;        // previous timestep when timing info was collected
   double last_spcpu;    // old elapsed CPU time value
   int firststep;        // 0 if this is the first time timing info is collected
   int niter;            // number of kspace switches
+  bool tuned;           // true once final settings are in use
+
+  int kspace_order;                // order set for new kspace style, 0 = default
+  int norder, iorder;              // # of orders to test, index of current one
+  int order_list[5];               // orders to test for current kspace style
+  int best_order;                  // fastest order so far
+  double best_order_time;          // time per step with fastest order
+  std::string signature;           // key of this system in cache file
 
   double ewald_time, pppm_time, msm_time;
   double pair_cut_coul;
@@ -100,6 +114,10 @@ E: Cannot use fix tune/kspace without a pair style
 
 This fix (tune/kspace) can only be used when a pair style has been specified.
 
+E: Cannot open fix tune/kspace cache file %s
+
+The cache file could not be opened for appending the tuned settings.
+
 E: Bad real space Coulomb cutoff in fix tune/kspace
 
 Fix tune/kspace tried to find the optimal real space Coulomb cutoff using
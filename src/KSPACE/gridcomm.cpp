@@ -156,6 +156,9 @@ GridComm::~GridComm()
   memory->sfree(copy);
 
   delete [] requests;
+
+  free_persistent();
+  memory->sfree(persist);
 }
 
 /* ----------------------------------------------------------------------
@@ -219,32 +222,43 @@ void GridComm::initialize(MPI_Comm gcomm,
   recv = nullptr;
   copy = nullptr;
   requests = nullptr;
+  nallbox = 0;
+  allbox = nullptr;
+  allproc = nullptr;
+  split[0] = split[1] = split[2] = 1;
+  offset_copy = 0;
+
+  npersist = maxpersist = 0;
+  persist = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
 
 void GridComm::setup(int &nbuf1, int &nbuf2)
 {
+  free_persistent();
+
   if (layout == REGULAR) setup_regular(nbuf1,nbuf2);
   else setup_tiled(nbuf1,nbuf2);
 }
 
 /* ----------------------------------------------------------------------
    setup comm for a regular grid of procs
-   each proc has 6 neighbors
-   comm pattern = series of swaps with one of those 6 procs
-   can be multiple swaps with same proc if ghost extent is large
-   swap may not be symmetric if both procs do not need same layers of ghosts
-   all procs perform same # of swaps in a direction, even if some don't need it
+   each proc exchanges directly with every proc whose owned cells overlap
+     its ghost cells, including edge and corner neighbors
+   comm pattern = post recvs for all my ghosts, send my owned, wait on recvs
+     same as for tiled layout, so all messages can be in flight at once
+   overlaps are found from the owned and ghost extents of all procs,
+     so both sides of each message know its size without extra comm
 ------------------------------------------------------------------------- */
 
 void GridComm::setup_regular(int &nbuf1, int &nbuf2)
 {
-  int nsent,sendfirst,sendlast,recvfirst,recvlast;
-  int sendplanes,recvplanes;
-  int notdoneme,notdone;
+  int i,m,p,ip;
+  int ghostbox[6],pbc[3],box[6],ubox[6];
 
   // notify 6 neighbor procs how many ghost grid planes I need from them
+  // only used by ghost_adjacent()
   // ghost xyz lo = # of my lower grid planes that proc xyz lo needs as its ghosts
   // ghost xyz hi = # of my upper grid planes that proc xyz hi needs as its ghosts
   // if this proc is its own neighbor across periodic bounary, value is from self
@@ -285,249 +299,262 @@ void GridComm::setup_regular(int &nbuf1, int &nbuf2)
                  &ghostzlo,1,MPI_INT,proczlo,0,gridcomm,MPI_STATUS_IGNORE);
   else ghostzlo = nplanes;
 
-  // setup swaps = exchange of grid data with one of 6 neighobr procs
-  // can be more than one in a direction if ghost region extends beyond neigh proc
-  // all procs have same swap count, but swapsize npack/nunpack can be empty
+  // allbox = owned and ghost extents of all procs
 
-  nswap = 0;
+  int mybox[12];
+  mybox[0] = inxlo;
+  mybox[1] = inxhi;
+  mybox[2] = inylo;
+  mybox[3] = inyhi;
+  mybox[4] = inzlo;
+  mybox[5] = inzhi;
+  mybox[6] = outxlo;
+  mybox[7] = outxhi;
+  mybox[8] = outylo;
+  mybox[9] = outyhi;
+  mybox[10] = outzlo;
+  mybox[11] = outzhi;
 
-  // send own grid pts to -x processor, recv ghost grid pts from +x processor
+  gather_regular(mybox);
 
-  nsent = 0;
-  sendfirst = inxlo;
-  sendlast = inxhi;
-  recvfirst = inxhi+1;
-  notdone = 1;
+  noverlap = maxoverlap = 0;
+  overlap = nullptr;
+  pbc[0] = pbc[1] = pbc[2] = 0;
 
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
+  // Send = overlap of my owned cells with ghost box of another proc
+  // split each other proc's ghost box at periodic boundaries
+  // the split order is the same as on the other proc, so the index
+  //   of the split piece tags each message between the same 2 procs
 
-    swap[nswap].sendproc = procxlo;
-    swap[nswap].recvproc = procxhi;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostxlo-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              sendfirst,sendfirst+sendplanes-1,inylo,inyhi,inzlo,inzhi);
+  int nsendmax = 0;
+  send = nullptr;
+  nsend = 0;
+
+  int ime = 0;
+  while (allproc[ime] != me) ime++;
+
+  for (ip = 0; ip < nallbox; ip++) {
+    if (ip == ime) continue;
+    p = allproc[ip];
+    for (i = 0; i < 6; i++) ghostbox[i] = allbox[ip][6+i];
+    noverlap = 0;
+    ghost_box_drop(ghostbox,pbc);
+    for (m = 0; m < noverlap; m++) {
+      if (!box_intersect(overlap[m].box,allbox[ime],box)) continue;
+      if (nsend == nsendmax) {
+        nsendmax += DELTA;
+        send = (Send *) memory->srealloc(send,nsendmax*sizeof(Send),"GridComm:send");
+      }
+      send[nsend].proc = p;
+      send[nsend].tag = m;
+      send[nsend].npack = indices(send[nsend].packlist,
+                                  box[0],box[1],box[2],box[3],box[4],box[5]);
+      nsend++;
+    }
+  }
 
-    if (procxlo != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,procxlo,0,
-                   &recvplanes,1,MPI_INT,procxhi,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
+  // Recv = overlap of my ghost box with owned cells of another proc
+  // Copy = overlap of my ghost box with my owned cells across a periodic boundary
+  // ghost cells are the pieces of my ghost box unwrapped by PBC
 
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              recvfirst,recvfirst+recvplanes-1,inylo,inyhi,inzlo,inzhi);
+  for (i = 0; i < 6; i++) ghostbox[i] = allbox[ime][6+i];
+  noverlap = 0;
+  ghost_box_drop(ghostbox,pbc);
 
-    nsent += sendplanes;
-    sendfirst += sendplanes;
-    sendlast += recvplanes;
-    recvfirst += recvplanes;
-    nswap++;
+  int nrecvmax = 0, ncopymax = 0;
+  recv = nullptr;
+  copy = nullptr;
+  nrecv = ncopy = 0;
 
-    if (nsent < ghostxlo) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
+  for (m = 0; m < noverlap; m++) {
+    for (ip = 0; ip < nallbox; ip++) {
+      p = allproc[ip];
+      if (p == me && overlap[m].pbc[0] == 0 && overlap[m].pbc[1] == 0 &&
+          overlap[m].pbc[2] == 0) continue;
+      if (!box_intersect(overlap[m].box,allbox[ip],box)) continue;
+
+      ubox[0] = box[0] + overlap[m].pbc[0] * nx;
+      ubox[1] = box[1] + overlap[m].pbc[0] * nx;
+      ubox[2] = box[2] + overlap[m].pbc[1] * ny;
+      ubox[3] = box[3] + overlap[m].pbc[1] * ny;
+      ubox[4] = box[4] + overlap[m].pbc[2] * nz;
+      ubox[5] = box[5] + overlap[m].pbc[2] * nz;
+
+      if (p == me) {
+        if (ncopy == ncopymax) {
+          ncopymax += DELTA;
+          copy = (Copy *) memory->srealloc(copy,ncopymax*sizeof(Copy),"GridComm:copy");
+        }
+        copy[ncopy].npack = indices(copy[ncopy].packlist,
+                                    box[0],box[1],box[2],box[3],box[4],box[5]);
+        copy[ncopy].nunpack = indices(copy[ncopy].unpacklist,
+                                      ubox[0],ubox[1],ubox[2],ubox[3],ubox[4],ubox[5]);
+        ncopy++;
+      } else {
+        if (nrecv == nrecvmax) {
+          nrecvmax += DELTA;
+          recv = (Recv *) memory->srealloc(recv,nrecvmax*sizeof(Recv),"GridComm:recv");
+        }
+        recv[nrecv].proc = p;
+        recv[nrecv].tag = m;
+        recv[nrecv].nunpack = indices(recv[nrecv].unpacklist,
+                                      ubox[0],ubox[1],ubox[2],ubox[3],ubox[4],ubox[5]);
+        nrecv++;
+      }
+    }
   }
 
-  // send own grid pts to +x processor, recv ghost grid pts from -x processor
-
-  nsent = 0;
-  sendfirst = inxlo;
-  sendlast = inxhi;
-  recvlast = inxlo-1;
-  notdone = 1;
-
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
-
-    swap[nswap].sendproc = procxhi;
-    swap[nswap].recvproc = procxlo;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostxhi-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              sendlast-sendplanes+1,sendlast,inylo,inyhi,inzlo,inzhi);
-
-    if (procxhi != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,procxhi,0,
-                   &recvplanes,1,MPI_INT,procxlo,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
-
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              recvlast-recvplanes+1,recvlast,inylo,inyhi,inzlo,inzhi);
-
-    nsent += sendplanes;
-    sendfirst -= recvplanes;
-    sendlast -= sendplanes;
-    recvlast -= recvplanes;
-    nswap++;
-
-    if (nsent < ghostxhi) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
-  }
+  // clean-up
 
-  // send own grid pts to -y processor, recv ghost grid pts from +y processor
-
-  nsent = 0;
-  sendfirst = inylo;
-  sendlast = inyhi;
-  recvfirst = inyhi+1;
-  notdone = 1;
-
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
-
-    swap[nswap].sendproc = procylo;
-    swap[nswap].recvproc = procyhi;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostylo-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              outxlo,outxhi,sendfirst,sendfirst+sendplanes-1,inzlo,inzhi);
-
-    if (procylo != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,procylo,0,
-                   &recvplanes,1,MPI_INT,procyhi,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
-
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              outxlo,outxhi,recvfirst,recvfirst+recvplanes-1,inzlo,inzhi);
-
-    nsent += sendplanes;
-    sendfirst += sendplanes;
-    sendlast += recvplanes;
-    recvfirst += recvplanes;
-    nswap++;
-
-    if (nsent < ghostylo) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
-  }
+  memory->destroy(allbox);
+  memory->destroy(allproc);
+  memory->sfree(overlap);
 
-  // send own grid pts to +y processor, recv ghost grid pts from -y processor
-
-  nsent = 0;
-  sendfirst = inylo;
-  sendlast = inyhi;
-  recvlast = inylo-1;
-  notdone = 1;
-
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
-
-    swap[nswap].sendproc = procyhi;
-    swap[nswap].recvproc = procylo;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostyhi-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              outxlo,outxhi,sendlast-sendplanes+1,sendlast,inzlo,inzhi);
-
-    if (procyhi != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,procyhi,0,
-                   &recvplanes,1,MPI_INT,procylo,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
-
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              outxlo,outxhi,recvlast-recvplanes+1,recvlast,inzlo,inzhi);
-
-    nsent += sendplanes;
-    sendfirst -= recvplanes;
-    sendlast -= sendplanes;
-    recvlast -= recvplanes;
-    nswap++;
-
-    if (nsent < ghostyhi) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
-  }
+  setup_buffers(nbuf1,nbuf2);
+}
+
+/* ----------------------------------------------------------------------
+   collect owned and ghost extents of all procs whose cells can overlap
+     with mine, for REGULAR layout
+   mybox = my owned extent (6 values) followed by my ghost extent (6 values)
+   a ghost extent spans at most hops[d] procs in dim d, set by the widest
+     ghost extent and the fewest owned cells of any proc in that dim
+   boxes are passed that many hops along x to both sides, then all boxes
+     collected so far along y, then along z, like ghost atoms in Comm
+   stop early in a dim if the boxes wrapped around the periodic procs
+   result: nallbox boxes in allbox, allproc = their procs in ascending order
+   also sets split[], which depends on the owned extents of all procs
+------------------------------------------------------------------------- */
 
-  // send own grid pts to -z processor, recv ghost grid pts from +z processor
-
-  nsent = 0;
-  sendfirst = inzlo;
-  sendlast = inzhi;
-  recvfirst = inzhi+1;
-  notdone = 1;
-
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
-
-    swap[nswap].sendproc = proczlo;
-    swap[nswap].recvproc = proczhi;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostzlo-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              outxlo,outxhi,outylo,outyhi,sendfirst,sendfirst+sendplanes-1);
-
-    if (proczlo != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,proczlo,0,
-                   &recvplanes,1,MPI_INT,proczhi,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
-
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              outxlo,outxhi,outylo,outyhi,recvfirst,recvfirst+recvplanes-1);
-
-    nsent += sendplanes;
-    sendfirst += sendplanes;
-    sendlast += recvplanes;
-    recvfirst += recvplanes;
-    nswap++;
-
-    if (nsent < ghostzlo) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
+void GridComm::gather_regular(int *mybox)
+{
+  int i,j,m,dim,hop;
+
+  // global max of ghost widths, owned cells beyond the global grid,
+  //   and min of # of owned cells in each dim (as max of negative values)
+
+  int ngrid[3] = {nx,ny,nz};
+  int flags[9],flagsall[9];
+  for (dim = 0; dim < 3; dim++) {
+    int lo = mybox[2*dim], hi = mybox[2*dim+1];
+    flags[3*dim] = MAX(lo - mybox[6+2*dim],mybox[7+2*dim] - hi);
+    flags[3*dim+1] = -(hi - lo + 1);
+    flags[3*dim+2] = (lo < 0 || hi >= ngrid[dim]) ? 1 : 0;
   }
+  MPI_Allreduce(flags,flagsall,9,MPI_INT,MPI_MAX,gridcomm);
+
+  // do not split ghost boxes in a dim where owned cells extend beyond
+  //   the global grid, as MSM does for non-periodic dims
+  // ghost cells there are owned by other procs without wrap-around
+
+  int hops[3];
+  for (dim = 0; dim < 3; dim++) {
+    int ghostmax = flagsall[3*dim];
+    int ownmin = -flagsall[3*dim+1];
+    if (ghostmax <= 0) hops[dim] = 0;
+    else if (ownmin <= 0) hops[dim] = nprocs;
+    else hops[dim] = (ghostmax-1)/ownmin + 1;
+    split[dim] = flagsall[3*dim+2] ? 0 : 1;
+  }
+
+  // boxes are stored as proc followed by 12 extents
+
+  int maxbox = DELTA;
+  int *boxes,*sendup,*senddown,*recvbuf;
+  memory->create(boxes,13*maxbox,"GridComm:boxes");
+  boxes[0] = me;
+  for (i = 0; i < 12; i++) boxes[1+i] = mybox[i];
+  int nbox = 1;
+
+  int procneigh[3][2] = {{procxlo,procxhi},{procylo,procyhi},{proczlo,proczhi}};
+  int maxbuf = 0;
+  sendup = senddown = recvbuf = nullptr;
+
+  for (dim = 0; dim < 3; dim++) {
+    int plo = procneigh[dim][0];
+    int phi = procneigh[dim][1];
+    if (plo == me || hops[dim] == 0) continue;
 
-  // send own grid pts to +z processor, recv ghost grid pts from -z processor
-
-  nsent = 0;
-  sendfirst = inzlo;
-  sendlast = inzhi;
-  recvlast = inzlo-1;
-  notdone = 1;
-
-  while (notdone) {
-    if (nswap == maxswap) grow_swap();
-
-    swap[nswap].sendproc = proczhi;
-    swap[nswap].recvproc = proczlo;
-    sendplanes = MIN(sendlast-sendfirst+1,ghostzhi-nsent);
-    swap[nswap].npack =
-      indices(swap[nswap].packlist,
-              outxlo,outxhi,outylo,outyhi,sendlast-sendplanes+1,sendlast);
-
-    if (proczhi != me)
-      MPI_Sendrecv(&sendplanes,1,MPI_INT,proczhi,0,
-                   &recvplanes,1,MPI_INT,proczlo,0,gridcomm,MPI_STATUS_IGNORE);
-    else recvplanes = sendplanes;
-
-    swap[nswap].nunpack =
-      indices(swap[nswap].unpacklist,
-              outxlo,outxhi,outylo,outyhi,recvlast-recvplanes+1,recvlast);
-
-    nsent += sendplanes;
-    sendfirst -= recvplanes;
-    sendlast -= sendplanes;
-    recvlast -= recvplanes;
-    nswap++;
-
-    if (nsent < ghostzhi) notdoneme = 1;
-    else notdoneme = 0;
-    MPI_Allreduce(&notdoneme,&notdone,1,MPI_INT,MPI_SUM,gridcomm);
+    // boxes sent up and down in the 1st hop = all collected so far
+    // in later hops, forward what was received in the previous hop
+
+    int nup = nbox, ndown = nbox;
+    if (13*nbox > maxbuf) {
+      maxbuf = 13*nbox;
+      memory->grow(sendup,maxbuf,"GridComm:sendup");
+      memory->grow(senddown,maxbuf,"GridComm:senddown");
+    }
+    for (i = 0; i < 13*nbox; i++) sendup[i] = senddown[i] = boxes[i];
+
+    for (hop = 0; hop < hops[dim]; hop++) {
+      int wrapped = 0;
+      for (int dir = 0; dir < 2; dir++) {
+        int sendproc = dir ? plo : phi;
+        int recvproc = dir ? phi : plo;
+        int &nsendbox = dir ? ndown : nup;
+        int *&sendbuf = dir ? senddown : sendup;
+        int nrecvbox;
+        MPI_Sendrecv(&nsendbox,1,MPI_INT,sendproc,0,
+                     &nrecvbox,1,MPI_INT,recvproc,0,gridcomm,MPI_STATUS_IGNORE);
+        if (13*nrecvbox > maxbuf) {
+          maxbuf = 13*nrecvbox;
+          memory->grow(sendup,maxbuf,"GridComm:sendup");
+          memory->grow(senddown,maxbuf,"GridComm:senddown");
+        }
+        memory->grow(recvbuf,MAX(13*nrecvbox,1),"GridComm:recvbuf");
+        MPI_Sendrecv(sendbuf,13*nsendbox,MPI_INT,sendproc,0,
+                     recvbuf,13*nrecvbox,MPI_INT,recvproc,0,gridcomm,MPI_STATUS_IGNORE);
+
+        // add boxes of procs not seen yet, forward all of them next hop
+
+        for (m = 0; m < nrecvbox; m++) {
+          int *rbox = &recvbuf[13*m];
+          if (rbox[0] == me) wrapped = 1;
+          for (j = 0; j < nbox; j++)
+            if (boxes[13*j] == rbox[0]) break;
+          if (j < nbox) continue;
+          if (nbox == maxbox) {
+            maxbox += DELTA;
+            memory->grow(boxes,13*maxbox,"GridComm:boxes");
+          }
+          for (i = 0; i < 13; i++) boxes[13*nbox+i] = rbox[i];
+          nbox++;
+        }
+        for (i = 0; i < 13*nrecvbox; i++) sendbuf[i] = recvbuf[i];
+        nsendbox = nrecvbox;
+      }
+
+      // all procs along this dim have been seen once my own box comes back
+      // every proc in the same row of procs sees this at the same hop
+
+      if (wrapped) break;
+    }
   }
 
-  // ngrid = max of any forward/reverse pack/unpack grid points
+  memory->destroy(sendup);
+  memory->destroy(senddown);
+  memory->destroy(recvbuf);
 
-  int ngrid = 0;
-  for (int i = 0; i < nswap; i++) {
-    ngrid = MAX(ngrid,swap[i].npack);
-    ngrid = MAX(ngrid,swap[i].nunpack);
+  // sort boxes by proc, so comm lists are in the same order as for all procs
+
+  int *order = new int[nbox];
+  for (m = 0; m < nbox; m++) order[m] = m;
+  for (m = 1; m < nbox; m++) {
+    int k = order[m];
+    for (j = m; j > 0 && boxes[13*order[j-1]] > boxes[13*k]; j--) order[j] = order[j-1];
+    order[j] = k;
+  }
+
+  nallbox = nbox;
+  memory->create(allbox,nallbox,12,"GridComm:allbox");
+  memory->create(allproc,nallbox,"GridComm:allproc");
+  for (m = 0; m < nallbox; m++) {
+    allproc[m] = boxes[13*order[m]];
+    for (i = 0; i < 12; i++) allbox[m][i] = boxes[13*order[m]+1+i];
   }
 
-  nbuf1 = nbuf2 = ngrid;
+  delete [] order;
+  memory->destroy(boxes);
 }
 
 /* ----------------------------------------------------------------------
@@ -622,6 +649,7 @@ void GridComm::setup_tiled(int &nbuf1, int &nbuf2)
 
   for (m = 0; m < nrecv_request; m++) {
     send[m].proc = rrequest[m].sender;
+    send[m].tag = rrequest[m].index;
     xlo = MAX(rrequest[m].box[0],inxlo);
     xhi = MIN(rrequest[m].box[1],inxhi);
     ylo = MAX(rrequest[m].box[2],inylo);
@@ -663,6 +691,7 @@ void GridComm::setup_tiled(int &nbuf1, int &nbuf2)
   for (i = 0; i < nrecv_response; i++) {
     m = rresponse[i].index;
     recv[i].proc = overlap[m].proc;
+    recv[i].tag = m;
     xlo = rresponse[i].box[0] + overlap[m].pbc[0] * nx;
     xhi = rresponse[i].box[1] + overlap[m].pbc[0] * nx;
     ylo = rresponse[i].box[2] + overlap[m].pbc[1] * ny;
@@ -702,25 +731,6 @@ void GridComm::setup_tiled(int &nbuf1, int &nbuf2)
     ncopy++;
   }
 
-  // set offsets for received data
-
-  int offset = 0;
-  for (m = 0; m < nsend; m++) {
-    send[m].offset = offset;
-    offset += send[m].npack;
-  }
-
-  offset = 0;
-  for (m = 0; m < nrecv; m++) {
-    recv[m].offset = offset;
-    offset += recv[m].nunpack;
-  }
-
-  // length of MPI requests vector is max of nsend, nrecv
-
-  int nrequest = MAX(nsend,nrecv);
-  requests = new MPI_Request[nrequest];
-
   // clean-up
 
   memory->sfree(rcbinfo);
@@ -732,28 +742,41 @@ void GridComm::setup_tiled(int &nbuf1, int &nbuf2)
   memory->sfree(sresponse);
   memory->sfree(rresponse);
 
-  // nbuf1 = largest pack or unpack in any Send or Recv or Copy
-  // nbuf2 = larget of sum of all packs or unpacks in Send or Recv
+  setup_buffers(nbuf1,nbuf2);
+}
 
-  nbuf1 = 0;
+/* ----------------------------------------------------------------------
+   set offsets of each message in the buffers and return buffer sizes
+   all Send messages are packed into buf1 at the same time,
+     followed by Copy data, all Recv messages arrive in buf2
+   for reverse comm, the roles of Send and Recv are swapped
+   nbuf1 = size of buf1 in grid pts, nbuf2 = size of buf2 in grid pts
+------------------------------------------------------------------------- */
 
-  for (m = 0; m < ncopy; m++) {
-    nbuf1 = MAX(nbuf1,copy[m].npack);
-    nbuf1 = MAX(nbuf1,copy[m].nunpack);
-  }
+void GridComm::setup_buffers(int &nbuf1, int &nbuf2)
+{
+  int m;
 
   int nbufs = 0;
   for (m = 0; m < nsend; m++) {
-    nbuf1 = MAX(nbuf1,send[m].npack);
+    send[m].offset = nbufs;
     nbufs += send[m].npack;
   }
 
   int nbufr = 0;
   for (m = 0; m < nrecv; m++) {
-    nbuf1 = MAX(nbuf1,recv[m].nunpack);
+    recv[m].offset = nbufr;
     nbufr += recv[m].nunpack;
   }
 
+  int ncopybuf = 0;
+  for (m = 0; m < ncopy; m++) {
+    ncopybuf = MAX(ncopybuf,copy[m].npack);
+    ncopybuf = MAX(ncopybuf,copy[m].nunpack);
+  }
+
+  offset_copy = MAX(nbufs,nbufr);
+  nbuf1 = offset_copy + ncopybuf;
   nbuf2 = MAX(nbufs,nbufr);
 }
 
@@ -763,8 +786,10 @@ void GridComm::setup_tiled(int &nbuf1, int &nbuf2)
      each lo/hi value may extend beyonw 0 to N-1 into another periodic image
    pbc = flags in each dim of which periodic image the caller box was in
    when a box straddles a periodic bounadry, split it in two
+     unless split is 0 for that dim
    when a box does not straddle, drop it down RCB tree
      add all the procs it overlaps with to Overlap list
+   for REGULAR layout, add the box itself to Overlap list with proc = -1
 ------------------------------------------------------------------------- */
 
 void GridComm::ghost_box_drop(int *box, int *pbc)
@@ -784,38 +809,49 @@ void GridComm::ghost_box_drop(int *box, int *pbc)
 
   int splitflag = 1;
 
-  if (box[0] < 0) {
+  if (split[0] && box[0] < 0) {
     newbox1[0] = 0;
     newbox2[0] = box[0] + nx;
     newbox2[1] = nx - 1;
     newpbc[0]--;
-  } else if (box[1] >= nx) {
+  } else if (split[0] && box[1] >= nx) {
     newbox1[1] = nx - 1;
     newbox2[0] = 0;
     newbox2[1] = box[1] - nx;
     newpbc[0]++;
-  } else if (box[2] < 0) {
+  } else if (split[1] && box[2] < 0) {
     newbox1[2] = 0;
     newbox2[2] = box[2] + ny;
     newbox2[3] = ny - 1;
     newpbc[1]--;
-  } else if (box[3] >= ny) {
+  } else if (split[1] && box[3] >= ny) {
     newbox1[3] = ny - 1;
     newbox2[2] = 0;
     newbox2[3] = box[3] - ny;
     newpbc[1]++;
-  } else if (box[4] < 0) {
+  } else if (split[2] && box[4] < 0) {
     newbox1[4] = 0;
     newbox2[4] = box[4] + nz;
     newbox2[5] = nz - 1;
     newpbc[2]--;
-  } else if (box[5] >= nz) {
+  } else if (split[2] && box[5] >= nz) {
     newbox1[5] = nz - 1;
     newbox2[4] = 0;
     newbox2[5] = box[5] - nz;
     newpbc[2]++;
 
-  // box is not split, drop on RCB tree
+  // box is not split
+  // for REGULAR layout, store it, caller finds the procs it overlaps
+
+  } else if (layout == REGULAR) {
+    splitflag = 0;
+    if (noverlap == maxoverlap) grow_overlap();
+    overlap[noverlap].proc = -1;
+    for (i = 0; i < 6; i++) overlap[noverlap].box[i] = box[i];
+    for (i = 0; i < 3; i++) overlap[noverlap].pbc[i] = pbc[i];
+    noverlap++;
+
+  // for TILED layout, drop on RCB tree
   // returns nprocs = # of procs it overlaps, including self
   // returns proc_overlap = list of proc IDs it overlaps
   // skip self overlap if no crossing of periodic boundaries
@@ -844,6 +880,22 @@ void GridComm::ghost_box_drop(int *box, int *pbc)
   }
 }
 
+/* ----------------------------------------------------------------------
+   intersect box with owned cells (first 6 values) of ibox
+   box and owned cells are wholly within the global grid
+   return 1 and overlap in obox if non-empty, else 0
+------------------------------------------------------------------------- */
+
+int GridComm::box_intersect(int *box, int *ibox, int *obox)
+{
+  for (int i = 0; i < 3; i++) {
+    obox[2*i] = MAX(box[2*i],ibox[2*i]);
+    obox[2*i+1] = MIN(box[2*i+1],ibox[2*i+1]);
+    if (obox[2*i] > obox[2*i+1]) return 0;
+  }
+  return 1;
+}
+
 /* ----------------------------------------------------------------------
    recursively drop a box down the RCB tree to find all procs it overlaps with
    box = 6 integers = (xlo,xhi,ylo,yhi,zlo,zhi)
@@ -929,83 +981,57 @@ int GridComm::ghost_adjacent_tiled()
 void GridComm::forward_comm_kspace(KSpace *kspace, int nper, int nbyte, int which,
                                    void *buf1, void *buf2, MPI_Datatype datatype)
 {
-  if (layout == REGULAR)
-    forward_comm_kspace_regular(kspace,nper,nbyte,which,buf1,buf2,datatype);
-  else
-    forward_comm_kspace_tiled(kspace,nper,nbyte,which,buf1,buf2,datatype);
+  forward_comm_kspace_start(kspace,nper,nbyte,which,buf1,buf2,datatype);
+  forward_comm_kspace_finish(kspace,nper,nbyte,which,buf1,buf2,datatype);
 }
 
 /* ----------------------------------------------------------------------
-   forward comm on regular grid of procs via list of swaps with 6 neighbor procs
+   start forward comm via Send/Recv lists of each neighbor proc
+   post all recvs, pack and start each send, perform all copies to self
 ------------------------------------------------------------------------- */
 
-void GridComm::
-forward_comm_kspace_regular(KSpace *kspace, int nper, int /*nbyte*/, int which,
-                            void *buf1, void *buf2, MPI_Datatype datatype)
+void GridComm::forward_comm_kspace_start(KSpace *kspace, int nper, int nbyte, int which,
+                                         void *vbuf1, void *buf2, MPI_Datatype datatype)
 {
   int m;
-  MPI_Request request;
-
-  for (m = 0; m < nswap; m++) {
-    if (swap[m].sendproc == me)
-      kspace->pack_forward_grid(which,buf2,swap[m].npack,swap[m].packlist);
-    else
-      kspace->pack_forward_grid(which,buf1,swap[m].npack,swap[m].packlist);
-
-    if (swap[m].sendproc != me) {
-      if (swap[m].nunpack) MPI_Irecv(buf2,nper*swap[m].nunpack,datatype,
-                                     swap[m].recvproc,0,gridcomm,&request);
-      if (swap[m].npack) MPI_Send(buf1,nper*swap[m].npack,datatype,
-                                  swap[m].sendproc,0,gridcomm);
-      if (swap[m].nunpack) MPI_Wait(&request,MPI_STATUS_IGNORE);
-    }
 
-    kspace->unpack_forward_grid(which,buf2,swap[m].nunpack,swap[m].unpacklist);
+  Persist *p = persistent(0,nper,nbyte,vbuf1,buf2,datatype);
+  char *buf1 = (char *) vbuf1;
+
+  if (nrecv) MPI_Startall(nrecv,p->rrequest);
+
+  for (m = 0; m < nsend; m++) {
+    kspace->pack_forward_grid(which,(void *) &buf1[nper*send[m].offset*nbyte],
+                              send[m].npack,send[m].packlist);
+    MPI_Start(&p->srequest[m]);
+  }
+
+  void *bufcopy = (void *) &buf1[nper*offset_copy*nbyte];
+  for (m = 0; m < ncopy; m++) {
+    kspace->pack_forward_grid(which,bufcopy,copy[m].npack,copy[m].packlist);
+    kspace->unpack_forward_grid(which,bufcopy,copy[m].nunpack,copy[m].unpacklist);
   }
 }
 
 /* ----------------------------------------------------------------------
-   forward comm on tiled grid decomp via Send/Recv lists of each neighbor proc
+   complete forward comm, unpack each recv as it arrives
 ------------------------------------------------------------------------- */
 
-void GridComm::
-forward_comm_kspace_tiled(KSpace *kspace, int nper, int nbyte, int which,
-                          void *buf1, void *vbuf2, MPI_Datatype datatype)
+void GridComm::forward_comm_kspace_finish(KSpace *kspace, int nper, int nbyte, int which,
+                                          void *buf1, void *vbuf2, MPI_Datatype datatype)
 {
-  int i,m,offset;
+  int i,m;
 
+  Persist *p = persistent(0,nper,nbyte,buf1,vbuf2,datatype);
   char *buf2 = (char *) vbuf2;
 
-  // post all receives
-
-  for (m = 0; m < nrecv; m++) {
-    offset = nper * recv[m].offset * nbyte;
-    MPI_Irecv((void *) &buf2[offset],nper*recv[m].nunpack,datatype,
-              recv[m].proc,0,gridcomm,&requests[m]);
-  }
-
-  // perform all sends to other procs
-
-  for (m = 0; m < nsend; m++) {
-    kspace->pack_forward_grid(which,buf1,send[m].npack,send[m].packlist);
-    MPI_Send(buf1,nper*send[m].npack,datatype,send[m].proc,0,gridcomm);
-  }
-
-  // perform all copies to self
-
-  for (m = 0; m < ncopy; m++) {
-    kspace->pack_forward_grid(which,buf1,copy[m].npack,copy[m].packlist);
-    kspace->unpack_forward_grid(which,buf1,copy[m].nunpack,copy[m].unpacklist);
-  }
-
-  // unpack all received data
-
   for (i = 0; i < nrecv; i++) {
-    MPI_Waitany(nrecv,requests,&m,MPI_STATUS_IGNORE);
-    offset = nper * recv[m].offset * nbyte;
-    kspace->unpack_forward_grid(which,(void *) &buf2[offset],
+    MPI_Waitany(nrecv,p->rrequest,&m,MPI_STATUS_IGNORE);
+    kspace->unpack_forward_grid(which,(void *) &buf2[nper*recv[m].offset*nbyte],
                                 recv[m].nunpack,recv[m].unpacklist);
   }
+
+  if (nsend) MPI_Waitall(nsend,p->srequest,MPI_STATUSES_IGNORE);
 }
 
 /* ----------------------------------------------------------------------
@@ -1015,83 +1041,133 @@ forward_comm_kspace_tiled(KSpace *kspace, int nper, int nbyte, int which,
 void GridComm::reverse_comm_kspace(KSpace *kspace, int nper, int nbyte, int which,
                                     void *buf1, void *buf2, MPI_Datatype datatype)
 {
-  if (layout == REGULAR)
-    reverse_comm_kspace_regular(kspace,nper,nbyte,which,buf1,buf2,datatype);
-  else
-    reverse_comm_kspace_tiled(kspace,nper,nbyte,which,buf1,buf2,datatype);
+  reverse_comm_kspace_start(kspace,nper,nbyte,which,buf1,buf2,datatype);
+  reverse_comm_kspace_finish(kspace,nper,nbyte,which,buf1,buf2,datatype);
 }
 
 /* ----------------------------------------------------------------------
-   reverse comm on regular grid of procs via list of swaps with 6 neighbor procs
+   start reverse comm via Send/Recv lists of each neighbor proc
+   post all recvs, pack and start each send, perform all copies to self
 ------------------------------------------------------------------------- */
 
-void GridComm::
-reverse_comm_kspace_regular(KSpace *kspace, int nper, int /*nbyte*/, int which,
-                            void *buf1, void *buf2, MPI_Datatype datatype)
+void GridComm::reverse_comm_kspace_start(KSpace *kspace, int nper, int nbyte, int which,
+                                         void *vbuf1, void *buf2, MPI_Datatype datatype)
 {
   int m;
-  MPI_Request request;
-
-  for (m = nswap-1; m >= 0; m--) {
-    if (swap[m].recvproc == me)
-      kspace->pack_reverse_grid(which,buf2,swap[m].nunpack,swap[m].unpacklist);
-    else
-      kspace->pack_reverse_grid(which,buf1,swap[m].nunpack,swap[m].unpacklist);
-
-    if (swap[m].recvproc != me) {
-      if (swap[m].npack) MPI_Irecv(buf2,nper*swap[m].npack,datatype,
-                                   swap[m].sendproc,0,gridcomm,&request);
-      if (swap[m].nunpack) MPI_Send(buf1,nper*swap[m].nunpack,datatype,
-                                     swap[m].recvproc,0,gridcomm);
-      if (swap[m].npack) MPI_Wait(&request,MPI_STATUS_IGNORE);
-    }
 
-    kspace->unpack_reverse_grid(which,buf2,swap[m].npack,swap[m].packlist);
+  Persist *p = persistent(1,nper,nbyte,vbuf1,buf2,datatype);
+  char *buf1 = (char *) vbuf1;
+
+  if (nsend) MPI_Startall(nsend,p->rrequest);
+
+  for (m = 0; m < nrecv; m++) {
+    kspace->pack_reverse_grid(which,(void *) &buf1[nper*recv[m].offset*nbyte],
+                              recv[m].nunpack,recv[m].unpacklist);
+    MPI_Start(&p->srequest[m]);
+  }
+
+  void *bufcopy = (void *) &buf1[nper*offset_copy*nbyte];
+  for (m = 0; m < ncopy; m++) {
+    kspace->pack_reverse_grid(which,bufcopy,copy[m].nunpack,copy[m].unpacklist);
+    kspace->unpack_reverse_grid(which,bufcopy,copy[m].npack,copy[m].packlist);
   }
 }
 
 /* ----------------------------------------------------------------------
-   reverse comm on tiled grid decomp via Send/Recv lists of each neighbor proc
+   complete reverse comm, unpack all recvs in a fixed order
+   so sums into owned cells are the same for every run
 ------------------------------------------------------------------------- */
 
-void GridComm::
-reverse_comm_kspace_tiled(KSpace *kspace, int nper, int nbyte, int which,
-                          void *buf1, void *vbuf2, MPI_Datatype datatype)
+void GridComm::reverse_comm_kspace_finish(KSpace *kspace, int nper, int nbyte, int which,
+                                          void *buf1, void *vbuf2, MPI_Datatype datatype)
 {
-  int i,m,offset;
+  int m;
 
+  Persist *p = persistent(1,nper,nbyte,buf1,vbuf2,datatype);
   char *buf2 = (char *) vbuf2;
 
-  // post all receives
+  if (nsend) MPI_Waitall(nsend,p->rrequest,MPI_STATUSES_IGNORE);
 
-  for (m = 0; m < nsend; m++) {
-    offset = nper * send[m].offset * nbyte;
-    MPI_Irecv((void *) &buf2[offset],nper*send[m].npack,datatype,
-              send[m].proc,0,gridcomm,&requests[m]);
-  }
+  for (m = 0; m < nsend; m++)
+    kspace->unpack_reverse_grid(which,(void *) &buf2[nper*send[m].offset*nbyte],
+                                send[m].npack,send[m].packlist);
 
-  // perform all sends to other procs
+  if (nrecv) MPI_Waitall(nrecv,p->srequest,MPI_STATUSES_IGNORE);
+}
 
-  for (m = 0; m < nrecv; m++) {
-    kspace->pack_reverse_grid(which,buf1,recv[m].nunpack,recv[m].unpacklist);
-    MPI_Send(buf1,nper*recv[m].nunpack,datatype,recv[m].proc,0,gridcomm);
+/* ----------------------------------------------------------------------
+   return persistent requests for a comm direction, buffers, and datums
+   create them the first time the combination is used
+   requests are bound to the Send/Recv lists, so are freed by setup()
+------------------------------------------------------------------------- */
+
+GridComm::Persist *GridComm::persistent(int reverse, int nper, int nbyte,
+                                        void *vbuf1, void *vbuf2,
+                                        MPI_Datatype datatype)
+{
+  int i,m;
+
+  for (i = 0; i < npersist; i++)
+    if (persist[i].reverse == reverse && persist[i].nper == nper &&
+        persist[i].datatype == datatype &&
+        persist[i].buf1 == vbuf1 && persist[i].buf2 == vbuf2)
+      return &persist[i];
+
+  if (npersist == maxpersist) {
+    maxpersist += DELTA;
+    persist = (Persist *)
+      memory->srealloc(persist,maxpersist*sizeof(Persist),"GridComm:persist");
   }
 
-  // perform all copies to self
+  Persist *p = &persist[npersist++];
+  p->reverse = reverse;
+  p->nper = nper;
+  p->datatype = datatype;
+  p->buf1 = vbuf1;
+  p->buf2 = vbuf2;
 
-  for (m = 0; m < ncopy; m++) {
-    kspace->pack_reverse_grid(which,buf1,copy[m].nunpack,copy[m].unpacklist);
-    kspace->unpack_reverse_grid(which,buf1,copy[m].npack,copy[m].packlist);
+  char *buf1 = (char *) vbuf1;
+  char *buf2 = (char *) vbuf2;
+
+  // forward comm: recv my ghost cells, send my owned cells
+  // reverse comm: recv sums for my owned cells, send my ghost cells
+
+  if (!reverse) {
+    p->rrequest = new MPI_Request[nrecv];
+    p->srequest = new MPI_Request[nsend];
+    for (m = 0; m < nrecv; m++)
+      MPI_Recv_init((void *) &buf2[nper*recv[m].offset*nbyte],nper*recv[m].nunpack,
+                    datatype,recv[m].proc,recv[m].tag,gridcomm,&p->rrequest[m]);
+    for (m = 0; m < nsend; m++)
+      MPI_Send_init((void *) &buf1[nper*send[m].offset*nbyte],nper*send[m].npack,
+                    datatype,send[m].proc,send[m].tag,gridcomm,&p->srequest[m]);
+  } else {
+    p->rrequest = new MPI_Request[nsend];
+    p->srequest = new MPI_Request[nrecv];
+    for (m = 0; m < nsend; m++)
+      MPI_Recv_init((void *) &buf2[nper*send[m].offset*nbyte],nper*send[m].npack,
+                    datatype,send[m].proc,send[m].tag,gridcomm,&p->rrequest[m]);
+    for (m = 0; m < nrecv; m++)
+      MPI_Send_init((void *) &buf1[nper*recv[m].offset*nbyte],nper*recv[m].nunpack,
+                    datatype,recv[m].proc,recv[m].tag,gridcomm,&p->srequest[m]);
   }
 
-  // unpack all received data
+  return p;
+}
 
-  for (i = 0; i < nsend; i++) {
-    MPI_Waitany(nsend,requests,&m,MPI_STATUS_IGNORE);
-    offset = nper * send[m].offset * nbyte;
-    kspace->unpack_reverse_grid(which,(void *) &buf2[offset],
-                                send[m].npack,send[m].packlist);
+/* ---------------------------------------------------------------------- */
+
+void GridComm::free_persistent()
+{
+  for (int i = 0; i < npersist; i++) {
+    int nr = persist[i].reverse ? nsend : nrecv;
+    int ns = persist[i].reverse ? nrecv : nsend;
+    for (int m = 0; m < nr; m++) MPI_Request_free(&persist[i].rrequest[m]);
+    for (int m = 0; m < ns; m++) MPI_Request_free(&persist[i].srequest[m]);
+    delete [] persist[i].rrequest;
+    delete [] persist[i].srequest;
   }
+  npersist = 0;
 }
 
 /* ----------------------------------------------------------------------
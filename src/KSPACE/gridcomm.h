@@ -30,6 +30,14 @@ class GridComm : protected Pointers {
   void forward_comm_kspace(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
   void reverse_comm_kspace(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
 
+  // split-phase comm, caller must not touch the buffers or the
+  // grid cells being communicated between start and finish
+
+  void forward_comm_kspace_start(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
+  void forward_comm_kspace_finish(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
+  void reverse_comm_kspace_start(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
+  void reverse_comm_kspace_finish(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
+
  protected:
   int me, nprocs;
   int layout;           // REGULAR or TILED
@@ -62,6 +70,7 @@ class GridComm : protected Pointers {
   int ghostzlo, ghostzhi;
 
   // swap = exchange of owned and ghost grid cells between 2 procs, including self
+  // only used by GridCommKokkos, GridComm uses Send/Recv/Copy for both layouts
 
   struct Swap {
     int sendproc;       // proc to send to for forward comm
@@ -77,10 +86,15 @@ class GridComm : protected Pointers {
 
   // -------------------------------------------
   // internal variables for TILED layout
+  // REGULAR layout uses Overlap and Send/Recv/Copy as well
   // -------------------------------------------
 
   int *overlap_procs;       // length of Nprocs in communicator
   MPI_Request *requests;    // length of max messages this proc receives
+  int nallbox;              // # of procs in allbox for REGULAR layout
+  int **allbox;             // owned + ghost extents of procs that can overlap with me
+  int *allproc;             // proc of each allbox entry, in ascending order
+  int split[3];             // 1 if ghost boxes are split at periodic bounds in a dim
 
   // RCB tree of cut info
   // each proc contributes one value, except proc 0
@@ -131,23 +145,27 @@ class GridComm : protected Pointers {
   // send = proc to send a subset of my owned cells to, for forward comm
   // for reverse comm, proc I receive ghost overlaps with my owned cells from
   // offset used in reverse comm to recv a message in middle of a large buffer
+  // tag = index of the overlap on the recv proc, unique between 2 procs
 
   struct Send {
     int proc;
     int npack;
     int *packlist;
     int offset;
+    int tag;
   };
 
   // recv = proc to recv a subset of my ghost cells from, for forward comm
   // for reverse comm, proc I send a subset of my ghost cells to
   // offset used in forward comm to recv a message in middle of a large buffer
+  // tag = index of my overlap, matches tag of the Send on the other proc
 
   struct Recv {
     int proc;
     int nunpack;
     int *unpacklist;
     int offset;
+    int tag;
   };
 
   int adjacent;    // 0 on a proc who receives ghosts from a non-neighbor proc
@@ -167,6 +185,23 @@ class GridComm : protected Pointers {
   Recv *recv;
   Copy *copy;
 
+  int offset_copy;    // offset in buf1 to pack Copy data, after all sends
+
+  // persistent requests for all Send and Recv messages
+  // one set per comm direction, caller buffers, and datums per grid pt
+
+  struct Persist {
+    int reverse;              // 0 for forward comm, 1 for reverse comm
+    int nper;                 // # of datums per grid pt
+    MPI_Datatype datatype;    // datum type
+    void *buf1, *buf2;        // caller send/recv buffers the requests use
+    MPI_Request *rrequest;    // recvs from procs that send to me
+    MPI_Request *srequest;    // sends to procs that recv from me
+  };
+
+  int npersist, maxpersist;
+  Persist *persist;
+
   // -------------------------------------------
   // internal methods
   // -------------------------------------------
@@ -174,17 +209,18 @@ class GridComm : protected Pointers {
   void initialize(MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int, int,
                   int, int, int, int, int, int, int, int, int, int, int, int, int);
   virtual void setup_regular(int &, int &);
+  void gather_regular(int *);
   virtual void setup_tiled(int &, int &);
+  void setup_buffers(int &, int &);
   void ghost_box_drop(int *, int *);
   void box_drop_grid(int *, int, int, int &, int *);
+  int box_intersect(int *, int *, int *);
 
   int ghost_adjacent_regular();
   int ghost_adjacent_tiled();
 
-  void forward_comm_kspace_regular(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
-  void forward_comm_kspace_tiled(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
-  void reverse_comm_kspace_regular(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
-  void reverse_comm_kspace_tiled(class KSpace *, int, int, int, void *, void *, MPI_Datatype);
+  Persist *persistent(int, int, int, void *, void *, MPI_Datatype);
+  void free_persistent();
 
   virtual void grow_swap();
   void grow_overlap();
@@ -496,4 +496,131 @@ static void kiss_fft(kiss_fft_cfg cfg, const FFT_DATA *fin, FFT_DATA *fout)
   kiss_fft_stride(cfg, fin, fout, 1);
 }
 
+/*
+  real-to-complex and complex-to-real FFTs, adapted from kiss_fftr.c
+  an even length real FFT is done as a half length complex FFT,
+  followed (forward) or preceded (inverse) by a twiddle pass
+  an odd length real FFT falls back to a full length complex FFT
+  the forward transform returns the nfft/2+1 non-redundant outputs,
+  the inverse transform is unnormalized and ignores the imaginary
+  parts of the zero and (for even nfft) Nyquist frequency inputs
+*/
+
+struct kiss_fftr_state {
+  kiss_fft_cfg substate;
+  FFT_DATA *tmpbuf;
+  FFT_DATA *super_twiddles;
+  int nfft;
+};
+
+static kiss_fftr_cfg kiss_fftr_alloc(int nfft, int inverse_fft)
+{
+  kiss_fftr_cfg st = nullptr;
+  const int odd = nfft & 1;
+  const int ncfft = odd ? nfft : nfft / 2;
+  const int nbuf = odd ? 2 * nfft : ncfft + ncfft / 2;
+  size_t subsize = 0;
+
+  kiss_fft_alloc(ncfft, inverse_fft, nullptr, &subsize);
+  size_t memneeded = sizeof(struct kiss_fftr_state) + subsize + sizeof(FFT_DATA) * nbuf;
+
+  st = (kiss_fftr_cfg) KISS_FFT_MALLOC(memneeded);
+  if (!st) return nullptr;
+
+  st->nfft = nfft;
+  st->substate = (kiss_fft_cfg) (st + 1);
+  st->tmpbuf = (FFT_DATA *) (((char *) st->substate) + subsize);
+  st->super_twiddles = st->tmpbuf + ncfft;
+  kiss_fft_alloc(ncfft, inverse_fft, st->substate, &subsize);
+
+  if (!odd) {
+    for (int i = 0; i < ncfft / 2; ++i) {
+      double phase = -M_PI * ((double) (i + 1) / ncfft + .5);
+      if (inverse_fft) phase *= -1;
+      kf_cexp(st->super_twiddles + i, phase);
+    }
+  }
+  return st;
+}
+
+static void kiss_fftr(kiss_fftr_cfg st, const kiss_fft_scalar *timedata, FFT_DATA *freqdata)
+{
+  const int nfft = st->nfft;
+  FFT_DATA *tmpbuf = st->tmpbuf;
+
+  if (nfft & 1) {
+    for (int k = 0; k < nfft; ++k) {
+      tmpbuf[k].re = timedata[k];
+      tmpbuf[k].im = 0.0;
+    }
+    kiss_fft(st->substate, tmpbuf, tmpbuf + nfft);
+    memcpy(freqdata, tmpbuf + nfft, sizeof(FFT_DATA) * (nfft / 2 + 1));
+    return;
+  }
+
+  const int ncfft = st->substate->nfft;
+  FFT_DATA fpnk, fpk, f1k, f2k, tw, tdc;
+
+  kiss_fft(st->substate, (const FFT_DATA *) timedata, tmpbuf);
+
+  tdc = tmpbuf[0];
+  freqdata[0].re = tdc.re + tdc.im;
+  freqdata[ncfft].re = tdc.re - tdc.im;
+  freqdata[0].im = freqdata[ncfft].im = 0;
+
+  for (int k = 1; k <= ncfft / 2; ++k) {
+    fpk = tmpbuf[k];
+    fpnk.re = tmpbuf[ncfft - k].re;
+    fpnk.im = -tmpbuf[ncfft - k].im;
+
+    C_ADD(f1k, fpk, fpnk);
+    C_SUB(f2k, fpk, fpnk);
+    C_MUL(tw, f2k, st->super_twiddles[k - 1]);
+
+    freqdata[k].re = HALF_OF(f1k.re + tw.re);
+    freqdata[k].im = HALF_OF(f1k.im + tw.im);
+    freqdata[ncfft - k].re = HALF_OF(f1k.re - tw.re);
+    freqdata[ncfft - k].im = HALF_OF(tw.im - f1k.im);
+  }
+}
+
+static void kiss_fftri(kiss_fftr_cfg st, const FFT_DATA *freqdata, kiss_fft_scalar *timedata)
+{
+  const int nfft = st->nfft;
+  FFT_DATA *tmpbuf = st->tmpbuf;
+
+  if (nfft & 1) {
+    tmpbuf[0].re = freqdata[0].re;
+    tmpbuf[0].im = 0.0;
+    for (int k = 1; k <= nfft / 2; ++k) {
+      tmpbuf[k] = freqdata[k];
+      tmpbuf[nfft - k].re = freqdata[k].re;
+      tmpbuf[nfft - k].im = -freqdata[k].im;
+    }
+    kiss_fft(st->substate, tmpbuf, tmpbuf + nfft);
+    for (int k = 0; k < nfft; ++k) timedata[k] = tmpbuf[nfft + k].re;
+    return;
+  }
+
+  const int ncfft = st->substate->nfft;
+  FFT_DATA fk, fnkc, fek, fok, tmp;
+
+  tmpbuf[0].re = freqdata[0].re + freqdata[ncfft].re;
+  tmpbuf[0].im = freqdata[0].re - freqdata[ncfft].re;
+
+  for (int k = 1; k <= ncfft / 2; ++k) {
+    fk = freqdata[k];
+    fnkc.re = freqdata[ncfft - k].re;
+    fnkc.im = -freqdata[ncfft - k].im;
+
+    C_ADD(fek, fk, fnkc);
+    C_SUB(tmp, fk, fnkc);
+    C_MUL(fok, tmp, st->super_twiddles[k - 1]);
+    C_ADD(tmpbuf[k], fek, fok);
+    C_SUB(tmpbuf[ncfft - k], fek, fok);
+    tmpbuf[ncfft - k].im *= -1;
+  }
+  kiss_fft(st->substate, tmpbuf, (FFT_DATA *) timedata);
+}
+
 #endif
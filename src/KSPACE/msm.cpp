@@ -27,11 +27,16 @@
 #include "math_const.h"
 #include "memory.h"
 #include "neighbor.h"
+#include "omp_compat.h"
 #include "pair.h"
 
 #include <cstring>
 #include <cmath>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
@@ -73,6 +78,9 @@ MSM::MSM(LAMMPS *lmp)
   nmax = 0;
   part2grid = nullptr;
 
+  rowsum = nullptr;
+  nthr_rowsum = maxrowsum = 0;
+
   g_direct = nullptr;
   g_direct_top = nullptr;
 
@@ -121,6 +129,7 @@ MSM::~MSM()
   if (peratom_allocate_flag) deallocate_peratom();
   deallocate_levels();
   memory->destroy(part2grid);
+  memory->destroy(rowsum);
   memory->destroy(g_direct);
   memory->destroy(g_direct_top);
   memory->destroy(v0_direct);
@@ -1595,193 +1604,211 @@ void MSM::direct(int n)
     memset(&(v5gridn[nzlo_out[n]][nylo_out[n]][nxlo_out[n]]),0,ngrid[n]*sizeof(double));
   }
 
-  int icx,icy,icz,ix,iy,iz,zk,zyk,k;
-  int ii,jj,kk;
-  int imin,imax,jmin,jmax,kmax;
-  double qtmp,qtmp2,gtmp;
-  double esum,v0sum,v1sum,v2sum,v3sum,v4sum,v5sum;
-  double **qk,**ek;
-  double *qkj,*ekj;
-
-  int nx = nxhi_direct - nxlo_direct + 1;
-  int ny = nyhi_direct - nylo_direct + 1;
-
-  // loop over inner grid points
-
-  for (icz = nzlo_in[n]; icz <= nzhi_in[n]; icz++) {
-
-    if (domain->zperiodic) {
-      kmax = nzhi_direct;
-    } else {
-      kmax = MIN(nzhi_direct,betaz[n] - icz);
-    }
-
-    for (icy = nylo_in[n]; icy <= nyhi_in[n]; icy++) {
-
-      if (domain->yperiodic) {
-        jmin = nylo_direct;
-        jmax = nyhi_direct;
-      } else {
-        jmin = MAX(nylo_direct,alpha[n] - icy);
-        jmax = MIN(nyhi_direct,betay[n] - icy);
-      }
-
-      for (icx = nxlo_in[n]; icx <= nxhi_in[n]; icx++) {
+  const int vflag_direct = vflag_either && !scalar_pressure_flag;
+  const int nx = nxhi_direct - nxlo_direct + 1;
+  const int ny = nyhi_direct - nylo_direct + 1;
+  const int nxrow = nxhi_in[n] - nxlo_in[n] + 1;
+  const int nzslab = nzhi_in[n] - nzlo_in[n] + 1;
+
+  // each center plane icz scatters into planes icz to icz+nzhi_direct
+  // split center planes into slabs at least nzhi_direct planes thick,
+  //   slabs of equal parity then never update the same plane and are
+  //   processed by all threads at once, one parity after the other
+
+  const int nthreads = comm->nthreads;
+  int slab = MAX(nzhi_direct,1);
+  slab = MAX(slab,(nzslab + 2*nthreads - 1) / (2*nthreads));
+  const int nslab = (nzslab + slab - 1) / slab;
+
+  // scratch for row sums of each thread, grown as needed
+
+  if (nthreads > nthr_rowsum || 7*nxrow > maxrowsum) {
+    nthr_rowsum = MAX(nthreads,nthr_rowsum);
+    maxrowsum = MAX(7*nxrow,maxrowsum);
+    memory->destroy(rowsum);
+    memory->create(rowsum,nthr_rowsum,maxrowsum,"msm:rowsum");
+  }
 
-        if (domain->xperiodic) {
-          imin = nxlo_direct;
-          imax = nxhi_direct;
+  double esum_all = 0.0;
+  double v0sum_all = 0.0, v1sum_all = 0.0, v2sum_all = 0.0;
+  double v3sum_all = 0.0, v4sum_all = 0.0, v5sum_all = 0.0;
+
+  for (int phase = 0; phase < 2; phase++) {
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE schedule(dynamic,1) \
+  LMP_SHARED(n,phase,slab,qgridn,egridn,g_directn,v0gridn,v1gridn,v2gridn, \
+             v3gridn,v4gridn,v5gridn,v0_directn,v1_directn,v2_directn, \
+             v3_directn,v4_directn,v5_directn) \
+  reduction(+:esum_all,v0sum_all,v1sum_all,v2sum_all,v3sum_all,v4sum_all,v5sum_all)
+#endif
+    for (int islab = phase; islab < nslab; islab += 2) {
+
+      // row sums of potential and virial for all centers of one grid row
+
+#if defined(_OPENMP)
+      double *esum = rowsum[omp_get_thread_num()];
+#else
+      double *esum = rowsum[0];
+#endif
+      double *v0sum = esum + nxrow;
+      double *v1sum = v0sum + nxrow;
+      double *v2sum = v1sum + nxrow;
+      double *v3sum = v2sum + nxrow;
+      double *v4sum = v3sum + nxrow;
+      double *v5sum = v4sum + nxrow;
+
+      const int izlo = nzlo_in[n] + islab*slab;
+      const int izhi = MIN(izlo + slab - 1,nzhi_in[n]);
+
+      for (int icz = izlo; icz <= izhi; icz++) {
+
+        int kmax;
+        if (domain->zperiodic) {
+          kmax = nzhi_direct;
         } else {
-          imin = MAX(nxlo_direct,alpha[n] - icx);
-          imax = MIN(nxhi_direct,betax[n] - icx);
+          kmax = MIN(nzhi_direct,betaz[n] - icz);
         }
 
-        qtmp = qgridn[icz][icy][icx]; // charge on center grid point
-
-        esum = 0.0;
-        if (vflag_either && !scalar_pressure_flag)
-          v0sum = v1sum = v2sum = v3sum = v4sum = v5sum = 0.0;
-
-        // use hemisphere to avoid double computation of pair-wise
-        //   interactions in direct sum (no computations in -z direction)
-
-        for (iz = 1; iz <= kmax; iz++) {
-          kk = icz+iz;
-          qk = qgridn[kk];
-          ek = egridn[kk];
-          zk = (iz + nzhi_direct)*ny;
-          for (iy = jmin; iy <= jmax; iy++) {
-            jj = icy+iy;
-            qkj = qk[jj];
-            ekj = ek[jj];
-            zyk = (zk + iy + nyhi_direct)*nx;
-            for (ix = imin; ix <= imax; ix++) {
-              ii = icx+ix;
-              qtmp2 = qkj[ii]; // charge on outer grid point
-              k = zyk + ix + nxhi_direct;
-              gtmp = g_directn[k];
-              esum += gtmp * qtmp2;
-              ekj[ii] += gtmp * qtmp;
+        for (int icy = nylo_in[n]; icy <= nyhi_in[n]; icy++) {
 
-              if (vflag_either && !scalar_pressure_flag) {
-                v0sum += v0_directn[k] * qtmp2;
-                v1sum += v1_directn[k] * qtmp2;
-                v2sum += v2_directn[k] * qtmp2;
-                v3sum += v3_directn[k] * qtmp2;
-                v4sum += v4_directn[k] * qtmp2;
-                v5sum += v5_directn[k] * qtmp2;
-              }
-            }
+          int jmin,jmax;
+          if (domain->yperiodic) {
+            jmin = nylo_direct;
+            jmax = nyhi_direct;
+          } else {
+            jmin = MAX(nylo_direct,alpha[n] - icy);
+            jmax = MIN(nyhi_direct,betay[n] - icy);
           }
-        }
-
-        // iz=0
-
-        iz = 0;
-        kk = icz+iz;
-        qk = qgridn[kk];
-        ek = egridn[kk];
-        zk = (iz + nzhi_direct)*ny;
-        for (iy = 1; iy <= jmax; iy++) {
-          jj = icy+iy;
-          qkj = qk[jj];
-          ekj = ek[jj];
-          zyk = (zk + iy + nyhi_direct)*nx;
-          for (ix = imin; ix <= imax; ix++) {
-            ii = icx+ix;
-            qtmp2 = qkj[ii];
-            k = zyk + ix + nxhi_direct;
-            gtmp = g_directn[k];
-            esum += gtmp * qtmp2;
-            ekj[ii] += gtmp * qtmp;
 
-            if (vflag_either && !scalar_pressure_flag) {
-              v0sum += v0_directn[k] * qtmp2;
-              v1sum += v1_directn[k] * qtmp2;
-              v2sum += v2_directn[k] * qtmp2;
-              v3sum += v3_directn[k] * qtmp2;
-              v4sum += v4_directn[k] * qtmp2;
-              v5sum += v5_directn[k] * qtmp2;
+          double *qc = &qgridn[icz][icy][nxlo_in[n]]; // charges on row centers
+
+          for (int m = 0; m < nxrow; m++) esum[m] = 0.0;
+          if (vflag_direct)
+            for (int m = 0; m < nxrow; m++)
+              v0sum[m] = v1sum[m] = v2sum[m] = v3sum[m] = v4sum[m] = v5sum[m] = 0.0;
+
+          // use hemisphere to avoid double computation of pair-wise
+          //   interactions in direct sum (no computations in -z direction,
+          //   no -y direction for iz=0, no -x direction for iz=0, iy=0)
+          // loop over the stencil row by row and apply each row to all
+          //   centers of the grid row, so it is reused while in cache
+
+          for (int iz = 0; iz <= kmax; iz++) {
+            double **qk = qgridn[icz+iz];
+            double **ek = egridn[icz+iz];
+            const int zk = (iz + nzhi_direct)*ny;
+            const int jlo = (iz == 0) ? 0 : jmin;
+
+            for (int iy = jlo; iy <= jmax; iy++) {
+              double *qkj = qk[icy+iy];
+              double *ekj = ek[icy+iy];
+              const int zyk = (zk + iy + nyhi_direct)*nx + nxhi_direct;
+              const double *gk = &g_directn[zyk];
+              const double *v0k = &v0_directn[zyk];
+              const double *v1k = &v1_directn[zyk];
+              const double *v2k = &v2_directn[zyk];
+              const double *v3k = &v3_directn[zyk];
+              const double *v4k = &v4_directn[zyk];
+              const double *v5k = &v5_directn[zyk];
+
+              for (int m = 0; m < nxrow; m++) {
+                const int icx = nxlo_in[n] + m;
+
+                int imin,imax;
+                if (domain->xperiodic) {
+                  imin = nxlo_direct;
+                  imax = nxhi_direct;
+                } else {
+                  imin = MAX(nxlo_direct,alpha[n] - icx);
+                  imax = MIN(nxhi_direct,betax[n] - icx);
+                }
+                if (iz == 0 && iy == 0) imin = 1;
+
+                const double qtmp = qc[m]; // charge on center grid point
+                double etmp = 0.0;
+                for (int ix = imin; ix <= imax; ix++) {
+                  const double gtmp = gk[ix];
+                  etmp += gtmp * qkj[icx+ix]; // charge on outer grid point
+                  ekj[icx+ix] += gtmp * qtmp;
+                }
+                esum[m] += etmp;
+
+                if (vflag_direct) {
+                  double v0tmp = 0.0, v1tmp = 0.0, v2tmp = 0.0;
+                  double v3tmp = 0.0, v4tmp = 0.0, v5tmp = 0.0;
+                  for (int ix = imin; ix <= imax; ix++) {
+                    const double qtmp2 = qkj[icx+ix];
+                    v0tmp += v0k[ix] * qtmp2;
+                    v1tmp += v1k[ix] * qtmp2;
+                    v2tmp += v2k[ix] * qtmp2;
+                    v3tmp += v3k[ix] * qtmp2;
+                    v4tmp += v4k[ix] * qtmp2;
+                    v5tmp += v5k[ix] * qtmp2;
+                  }
+                  v0sum[m] += v0tmp;
+                  v1sum[m] += v1tmp;
+                  v2sum[m] += v2tmp;
+                  v3sum[m] += v3tmp;
+                  v4sum[m] += v4tmp;
+                  v5sum[m] += v5tmp;
+                }
+              }
             }
           }
-        }
-
-        // iz=0, iy=0
-
-        iz = 0;
-        kk = icz+iz;
-        qk = qgridn[kk];
-        ek = egridn[kk];
-        zk = (iz + nzhi_direct)*ny;
-        iy = 0;
-        jj = icy+iy;
-        qkj = qk[jj];
-        ekj = ek[jj];
-        zyk = (zk + iy + nyhi_direct)*nx;
-        for (ix = 1; ix <= imax; ix++) {
-          ii = icx+ix;
-          qtmp2 = qkj[ii];
-          k = zyk + ix + nxhi_direct;
-          gtmp = g_directn[k];
-          esum += gtmp * qtmp2;
-          ekj[ii] += gtmp * qtmp;
-
-          if (vflag_either && !scalar_pressure_flag) {
-            v0sum += v0_directn[k] * qtmp2;
-            v1sum += v1_directn[k] * qtmp2;
-            v2sum += v2_directn[k] * qtmp2;
-            v3sum += v3_directn[k] * qtmp2;
-            v4sum += v4_directn[k] * qtmp2;
-            v5sum += v5_directn[k] * qtmp2;
-          }
-        }
 
-        // iz=0, iy=0, ix=0
+          // iz=0, iy=0, ix=0
 
-        iz = 0;
-        zk = (iz + nzhi_direct)*ny;
-        iy = 0;
-        zyk = (zk + iy + nyhi_direct)*nx;
-        ix = 0;
-        k = zyk + ix + nxhi_direct;
-        gtmp = g_directn[k];
-        esum += 0.5 * gtmp * qtmp;
-        egridn[icz][icy][icx] += 0.5 * gtmp * qtmp;
+          const double gself = g_directn[(nzhi_direct*ny + nyhi_direct)*nx + nxhi_direct];
+          double *ec = &egridn[icz][icy][nxlo_in[n]];
 
-        // virial is zero for iz=0, iy=0, ix=0
+          for (int m = 0; m < nxrow; m++) {
+            const double qtmp = qc[m];
+            esum[m] += 0.5 * gself * qtmp;
+            ec[m] += 0.5 * gself * qtmp;
 
-        // accumulate per-atom energy/virial
+            // virial is zero for iz=0, iy=0, ix=0
 
-        egridn[icz][icy][icx] += esum;
+            // accumulate per-atom energy/virial
 
-        if (vflag_atom && !scalar_pressure_flag) {
-          v0gridn[icz][icy][icx] += v0sum;
-          v1gridn[icz][icy][icx] += v1sum;
-          v2gridn[icz][icy][icx] += v2sum;
-          v3gridn[icz][icy][icx] += v3sum;
-          v4gridn[icz][icy][icx] += v4sum;
-          v5gridn[icz][icy][icx] += v5sum;
-        }
+            ec[m] += esum[m];
 
-        // accumulate total energy/virial
+            if (vflag_atom && !scalar_pressure_flag) {
+              const int icx = nxlo_in[n] + m;
+              v0gridn[icz][icy][icx] += v0sum[m];
+              v1gridn[icz][icy][icx] += v1sum[m];
+              v2gridn[icz][icy][icx] += v2sum[m];
+              v3gridn[icz][icy][icx] += v3sum[m];
+              v4gridn[icz][icy][icx] += v4sum[m];
+              v5gridn[icz][icy][icx] += v5sum[m];
+            }
 
-        if (evflag) {
-          qtmp = qgridn[icz][icy][icx];
-          if (eflag_global) energy += 2.0 * esum * qtmp;
-          if (vflag_global && !scalar_pressure_flag) {
-            virial[0] += 2.0 * v0sum * qtmp;
-            virial[1] += 2.0 * v1sum * qtmp;
-            virial[2] += 2.0 * v2sum * qtmp;
-            virial[3] += 2.0 * v3sum * qtmp;
-            virial[4] += 2.0 * v4sum * qtmp;
-            virial[5] += 2.0 * v5sum * qtmp;
+            // accumulate total energy/virial
+
+            if (evflag) {
+              if (eflag_global) esum_all += 2.0 * esum[m] * qtmp;
+              if (vflag_global && !scalar_pressure_flag) {
+                v0sum_all += 2.0 * v0sum[m] * qtmp;
+                v1sum_all += 2.0 * v1sum[m] * qtmp;
+                v2sum_all += 2.0 * v2sum[m] * qtmp;
+                v3sum_all += 2.0 * v3sum[m] * qtmp;
+                v4sum_all += 2.0 * v4sum[m] * qtmp;
+                v5sum_all += 2.0 * v5sum[m] * qtmp;
+              }
+            }
           }
         }
-
       }
     }
   }
 
+  energy += esum_all;
+  virial[0] += v0sum_all;
+  virial[1] += v1sum_all;
+  virial[2] += v2sum_all;
+  virial[3] += v3sum_all;
+  virial[4] += v4sum_all;
+  virial[5] += v5sum_all;
+
   // compute per-atom virial (if requested)
 
   if (vflag_atom)
@@ -1803,110 +1830,137 @@ void MSM::direct_peratom(int n)
   double ***v3gridn = v3grid[n];
   double ***v4gridn = v4grid[n];
   double ***v5gridn = v5grid[n];
+  double *v0_directn = v0_direct[n];
+  double *v1_directn = v1_direct[n];
+  double *v2_directn = v2_direct[n];
+  double *v3_directn = v3_direct[n];
+  double *v4_directn = v4_direct[n];
+  double *v5_directn = v5_direct[n];
 
-  int icx,icy,icz,ix,iy,iz,zk,zyk,k;
-  int ii,jj,kk;
-  int imin,imax,jmin,jmax,kmax;
-  double qtmp;
-
-  int nx = nxhi_direct - nxlo_direct + 1;
-  int ny = nyhi_direct - nylo_direct + 1;
+  const int nx = nxhi_direct - nxlo_direct + 1;
+  const int ny = nyhi_direct - nylo_direct + 1;
+  const int nzslab = nzhi_in[n] - nzlo_in[n] + 1;
 
-  // loop over inner grid points
+  // same slabs of center planes as in direct()
 
-  for (icz = nzlo_in[n]; icz <= nzhi_in[n]; icz++) {
+  const int nthreads = comm->nthreads;
+  int slab = MAX(nzhi_direct,1);
+  slab = MAX(slab,(nzslab + 2*nthreads - 1) / (2*nthreads));
+  const int nslab = (nzslab + slab - 1) / slab;
 
-    if (domain->zperiodic) {
-      kmax = nzhi_direct;
-    } else {
-      kmax = MIN(nzhi_direct,betaz[n] - icz);
-    }
+  for (int phase = 0; phase < 2; phase++) {
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE schedule(dynamic,1) \
+  LMP_SHARED(n,phase,slab,qgridn,v0gridn,v1gridn,v2gridn,v3gridn,v4gridn, \
+             v5gridn,v0_directn,v1_directn,v2_directn,v3_directn,v4_directn, \
+             v5_directn)
+#endif
+    for (int islab = phase; islab < nslab; islab += 2) {
+      int icx,icy,icz,ix,iy,iz,zk,zyk,k;
+      int ii,jj,kk;
+      int imin,imax,jmin,jmax,kmax;
+      double qtmp;
 
-    for (icy = nylo_in[n]; icy <= nyhi_in[n]; icy++) {
+      const int izlo = nzlo_in[n] + islab*slab;
+      const int izhi = MIN(izlo + slab - 1,nzhi_in[n]);
 
-      if (domain->yperiodic) {
-        jmin = nylo_direct;
-        jmax = nyhi_direct;
-      } else {
-        jmin = MAX(nylo_direct,alpha[n] - icy);
-        jmax = MIN(nyhi_direct,betay[n] - icy);
-      }
+      // loop over inner grid points
 
-      for (icx = nxlo_in[n]; icx <= nxhi_in[n]; icx++) {
+      for (icz = izlo; icz <= izhi; icz++) {
 
-        if (domain->xperiodic) {
-          imin = nxlo_direct;
-          imax = nxhi_direct;
+        if (domain->zperiodic) {
+          kmax = nzhi_direct;
         } else {
-          imin = MAX(nxlo_direct,alpha[n] - icx);
-          imax = MIN(nxhi_direct,betax[n] - icx);
+          kmax = MIN(nzhi_direct,betaz[n] - icz);
         }
 
-        qtmp = qgridn[icz][icy][icx]; // center grid point
+        for (icy = nylo_in[n]; icy <= nyhi_in[n]; icy++) {
 
-        // use hemisphere to avoid double computation of pair-wise
-        //   interactions in direct sum (no computations in -z direction)
+          if (domain->yperiodic) {
+            jmin = nylo_direct;
+            jmax = nyhi_direct;
+          } else {
+            jmin = MAX(nylo_direct,alpha[n] - icy);
+            jmax = MIN(nyhi_direct,betay[n] - icy);
+          }
 
-        for (iz = 1; iz <= kmax; iz++) {
-          kk = icz+iz;
-          zk = (iz + nzhi_direct)*ny;
-          for (iy = jmin; iy <= jmax; iy++) {
+          for (icx = nxlo_in[n]; icx <= nxhi_in[n]; icx++) {
+
+            if (domain->xperiodic) {
+              imin = nxlo_direct;
+              imax = nxhi_direct;
+            } else {
+              imin = MAX(nxlo_direct,alpha[n] - icx);
+              imax = MIN(nxhi_direct,betax[n] - icx);
+            }
+
+            qtmp = qgridn[icz][icy][icx]; // center grid point
+
+            // use hemisphere to avoid double computation of pair-wise
+            //   interactions in direct sum (no computations in -z direction)
+
+            for (iz = 1; iz <= kmax; iz++) {
+              kk = icz+iz;
+              zk = (iz + nzhi_direct)*ny;
+              for (iy = jmin; iy <= jmax; iy++) {
+                jj = icy+iy;
+                zyk = (zk + iy + nyhi_direct)*nx;
+                for (ix = imin; ix <= imax; ix++) {
+                  ii = icx+ix;
+                  k = zyk + ix + nxhi_direct;
+                  v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
+                  v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
+                  v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
+                  v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
+                  v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
+                  v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
+                }
+              }
+            }
+
+            // iz=0
+
+            iz = 0;
+            kk = icz+iz;
+            zk = (iz + nzhi_direct)*ny;
+            for (iy = 1; iy <= jmax; iy++) {
+              jj = icy+iy;
+              zyk = (zk + iy + nyhi_direct)*nx;
+              for (ix = imin; ix <= imax; ix++) {
+                ii = icx+ix;
+                k = zyk + ix + nxhi_direct;
+                v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
+                v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
+                v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
+                v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
+                v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
+                v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
+              }
+            }
+
+            // iz=0, iy=0
+
+            iz = 0;
+            kk = icz+iz;
+            zk = (iz + nzhi_direct)*ny;
+            iy = 0;
             jj = icy+iy;
             zyk = (zk + iy + nyhi_direct)*nx;
-            for (ix = imin; ix <= imax; ix++) {
+            for (ix = 1; ix <= imax; ix++) {
               ii = icx+ix;
               k = zyk + ix + nxhi_direct;
-              v0gridn[kk][jj][ii] += v0_direct[n][k] * qtmp;
-              v1gridn[kk][jj][ii] += v1_direct[n][k] * qtmp;
-              v2gridn[kk][jj][ii] += v2_direct[n][k] * qtmp;
-              v3gridn[kk][jj][ii] += v3_direct[n][k] * qtmp;
-              v4gridn[kk][jj][ii] += v4_direct[n][k] * qtmp;
-              v5gridn[kk][jj][ii] += v5_direct[n][k] * qtmp;
+              v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
+              v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
+              v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
+              v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
+              v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
+              v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
             }
-          }
-        }
 
-        // iz=0
+            // virial is zero for iz=0, iy=0, ix=0
 
-        iz = 0;
-        kk = icz+iz;
-        zk = (iz + nzhi_direct)*ny;
-        for (iy = 1; iy <= jmax; iy++) {
-          jj = icy+iy;
-          zyk = (zk + iy + nyhi_direct)*nx;
-          for (ix = imin; ix <= imax; ix++) {
-            ii = icx+ix;
-            k = zyk + ix + nxhi_direct;
-            v0gridn[kk][jj][ii] += v0_direct[n][k] * qtmp;
-            v1gridn[kk][jj][ii] += v1_direct[n][k] * qtmp;
-            v2gridn[kk][jj][ii] += v2_direct[n][k] * qtmp;
-            v3gridn[kk][jj][ii] += v3_direct[n][k] * qtmp;
-            v4gridn[kk][jj][ii] += v4_direct[n][k] * qtmp;
-            v5gridn[kk][jj][ii] += v5_direct[n][k] * qtmp;
           }
         }
-
-        // iz=0, iy=0
-
-        iz = 0;
-        kk = icz+iz;
-        zk = (iz + nzhi_direct)*ny;
-        iy = 0;
-        jj = icy+iy;
-        zyk = (zk + iy + nyhi_direct)*nx;
-        for (ix = 1; ix <= imax; ix++) {
-          ii = icx+ix;
-          k = zyk + ix + nxhi_direct;
-          v0gridn[kk][jj][ii] += v0_direct[n][k] * qtmp;
-          v1gridn[kk][jj][ii] += v1_direct[n][k] * qtmp;
-          v2gridn[kk][jj][ii] += v2_direct[n][k] * qtmp;
-          v3gridn[kk][jj][ii] += v3_direct[n][k] * qtmp;
-          v4gridn[kk][jj][ii] += v4_direct[n][k] * qtmp;
-          v5gridn[kk][jj][ii] += v5_direct[n][k] * qtmp;
-       }
-
-        // virial is zero for iz=0, iy=0, ix=0
-
       }
     }
   }
@@ -1914,6 +1968,9 @@ void MSM::direct_peratom(int n)
 
 /* ----------------------------------------------------------------------
    MSM direct sum procedure for top grid level (nonperiodic systems only)
+   not threaded: the stencil of each center plane reaches across the
+     whole top grid, so no two slabs of planes could be updated at once,
+     and the coarsest grid is a small part of the cost
 ------------------------------------------------------------------------- */
 
 void MSM::direct_top(int n)
@@ -2150,6 +2207,7 @@ void MSM::direct_top(int n)
    MSM direct sum procedure for top grid level, solve Poisson's
    equation to get per-atom virial, separate method used for performance
    reasons
+   not threaded for the same reason as direct_top()
 ------------------------------------------------------------------------- */
 
 void MSM::direct_peratom_top(int n)
@@ -2297,51 +2355,64 @@ void MSM::restriction(int n)
     k++;
   }
 
-  int ip,jp,kp,ic,jc,kc,i,j;
-  int ii,jj,kk;
-  double phiz,phizy,q2sum;
+  const int ratiox = static_cast<int> (delxinv[n]/delxinv[n+1]);
+  const int ratioy = static_cast<int> (delyinv[n]/delyinv[n+1]);
+  const int ratioz = static_cast<int> (delzinv[n]/delzinv[n+1]);
 
   // zero out charge on coarser grid
 
   memset(&(qgrid2[nzlo_out[n+1]][nylo_out[n+1]][nxlo_out[n+1]]),0,ngrid[n+1]*sizeof(double));
 
-  for (kp = nzlo_in[n+1]; kp <= nzhi_in[n+1]; kp++)
-    for (jp = nylo_in[n+1]; jp <= nyhi_in[n+1]; jp++)
-      for (ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
+  // each coarse grid point gathers from the finer grid,
+  //   so threads can work on separate coarse grid rows
+
+  const int nyrow = nyhi_in[n+1] - nylo_in[n+1] + 1;
+  const int nrow = (nzhi_in[n+1] - nzlo_in[n+1] + 1) * nyrow;
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,index,qgrid1,qgrid2) \
+  schedule(static)
+#endif
+  for (int irow = 0; irow < nrow; irow++) {
+    const int kp = nzlo_in[n+1] + irow / nyrow;
+    const int jp = nylo_in[n+1] + irow % nyrow;
+    const int kc = kp * ratioz;
+    const int jc = jp * ratioy;
+
+    for (int ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
 
-        ic = ip * static_cast<int> (delxinv[n]/delxinv[n+1]);
-        jc = jp * static_cast<int> (delyinv[n]/delyinv[n+1]);
-        kc = kp * static_cast<int> (delzinv[n]/delzinv[n+1]);
+      const int ic = ip * ratiox;
 
-        q2sum = 0.0;
+      double q2sum = 0.0;
 
-        for (k=0; k<=p+1; k++) {
-          kk = kc+index[k];
-          if (!domain->zperiodic) {
-            if (kk < alpha[n]) continue;
-            if (kk > betaz[n]) break;
+      for (int k=0; k<=p+1; k++) {
+        const int kk = kc+index[k];
+        if (!domain->zperiodic) {
+          if (kk < alpha[n]) continue;
+          if (kk > betaz[n]) break;
+        }
+        const double phiz = phi1d[2][k];
+        for (int j=0; j<=p+1; j++) {
+          const int jj = jc+index[j];
+          if (!domain->yperiodic) {
+            if (jj < alpha[n]) continue;
+            if (jj > betay[n]) break;
           }
-          phiz = phi1d[2][k];
-          for (j=0; j<=p+1; j++) {
-            jj = jc+index[j];
-            if (!domain->yperiodic) {
-              if (jj < alpha[n]) continue;
-              if (jj > betay[n]) break;
-            }
-            phizy = phi1d[1][j]*phiz;
-            for (i=0; i<=p+1; i++) {
-              ii = ic+index[i];
-              if (!domain->xperiodic) {
-                if (ii < alpha[n]) continue;
-                if (ii > betax[n]) break;
-              }
-              q2sum += qgrid1[kk][jj][ii] *
-                phi1d[0][i]*phizy;
+          const double phizy = phi1d[1][j]*phiz;
+          for (int i=0; i<=p+1; i++) {
+            const int ii = ic+index[i];
+            if (!domain->xperiodic) {
+              if (ii < alpha[n]) continue;
+              if (ii > betax[n]) break;
             }
+            q2sum += qgrid1[kk][jj][ii] *
+              phi1d[0][i]*phizy;
           }
         }
-        qgrid2[kp][jp][ip] += q2sum;
       }
+      qgrid2[kp][jp][ip] += q2sum;
+    }
+  }
   delete[] index;
 }
 
@@ -2381,68 +2452,91 @@ void MSM::prolongation(int n)
     k++;
   }
 
-  int ip,jp,kp,ic,jc,kc,i,j;
-  int ii,jj,kk;
-  double phiz,phizy,phi3d;
-  double etmp2,v0tmp2,v1tmp2,v2tmp2,v3tmp2,v4tmp2,v5tmp2;
-
-  for (kp = nzlo_in[n+1]; kp <= nzhi_in[n+1]; kp++)
-    for (jp = nylo_in[n+1]; jp <= nyhi_in[n+1]; jp++)
-      for (ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
-
-        ic = ip * static_cast<int> (delxinv[n]/delxinv[n+1]);
-        jc = jp * static_cast<int> (delyinv[n]/delyinv[n+1]);
-        kc = kp * static_cast<int> (delzinv[n]/delzinv[n+1]);
-
-        etmp2 = egrid2[kp][jp][ip];
-
-        if (vflag_atom) {
-          v0tmp2 = v0grid2[kp][jp][ip];
-          v1tmp2 = v1grid2[kp][jp][ip];
-          v2tmp2 = v2grid2[kp][jp][ip];
-          v3tmp2 = v3grid2[kp][jp][ip];
-          v4tmp2 = v4grid2[kp][jp][ip];
-          v5tmp2 = v5grid2[kp][jp][ip];
-        }
-
-        for (k=0; k<=p+1; k++) {
-          kk = kc+index[k];
-          if (!domain->zperiodic) {
-            if (kk < alpha[n]) continue;
-            if (kk > betaz[n]) break;
-          }
-          phiz = phi1d[2][k];
-          for (j=0; j<=p+1; j++) {
-            jj = jc+index[j];
-            if (!domain->yperiodic) {
-              if (jj < alpha[n]) continue;
-              if (jj > betay[n]) break;
+  const int ratiox = static_cast<int> (delxinv[n]/delxinv[n+1]);
+  const int ratioy = static_cast<int> (delyinv[n]/delyinv[n+1]);
+  const int ratioz = static_cast<int> (delzinv[n]/delzinv[n+1]);
+
+  // each coarse plane kp scatters into fine planes kp*ratioz-p to kp*ratioz+p
+  // split coarse planes into slabs thick enough that slabs of equal
+  //   parity never update the same fine plane, these are processed by
+  //   all threads at once, one parity after the other
+
+  const int nthreads = comm->nthreads;
+  const int nzslab = nzhi_in[n+1] - nzlo_in[n+1] + 1;
+  int slab = MAX(2*p/ratioz,1);
+  slab = MAX(slab,(nzslab + 2*nthreads - 1) / (2*nthreads));
+  const int nslab = (nzslab + slab - 1) / slab;
+
+  for (int phase = 0; phase < 2; phase++) {
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE schedule(dynamic,1) \
+  LMP_SHARED(n,phase,slab,index,egrid1,egrid2,v0grid1,v0grid2,v1grid1,v1grid2, \
+             v2grid1,v2grid2,v3grid1,v3grid2,v4grid1,v4grid2,v5grid1,v5grid2)
+#endif
+    for (int islab = phase; islab < nslab; islab += 2) {
+      const int kplo = nzlo_in[n+1] + islab*slab;
+      const int kphi = MIN(kplo + slab - 1,nzhi_in[n+1]);
+
+      for (int kp = kplo; kp <= kphi; kp++)
+        for (int jp = nylo_in[n+1]; jp <= nyhi_in[n+1]; jp++)
+          for (int ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
+
+            const int ic = ip * ratiox;
+            const int jc = jp * ratioy;
+            const int kc = kp * ratioz;
+
+            const double etmp2 = egrid2[kp][jp][ip];
+
+            double v0tmp2,v1tmp2,v2tmp2,v3tmp2,v4tmp2,v5tmp2;
+            if (vflag_atom) {
+              v0tmp2 = v0grid2[kp][jp][ip];
+              v1tmp2 = v1grid2[kp][jp][ip];
+              v2tmp2 = v2grid2[kp][jp][ip];
+              v3tmp2 = v3grid2[kp][jp][ip];
+              v4tmp2 = v4grid2[kp][jp][ip];
+              v5tmp2 = v5grid2[kp][jp][ip];
             }
-            phizy = phi1d[1][j]*phiz;
-            for (i=0; i<=p+1; i++) {
-              ii = ic+index[i];
-              if (!domain->xperiodic) {
-                if (ii < alpha[n]) continue;
-                if (ii > betax[n]) break;
-              }
-              phi3d = phi1d[0][i]*phizy;
-
-              egrid1[kk][jj][ii] += etmp2 * phi3d;
 
-              if (vflag_atom) {
-                v0grid1[kk][jj][ii] += v0tmp2 * phi3d;
-                v1grid1[kk][jj][ii] += v1tmp2 * phi3d;
-                v2grid1[kk][jj][ii] += v2tmp2 * phi3d;
-                v3grid1[kk][jj][ii] += v3tmp2 * phi3d;
-                v4grid1[kk][jj][ii] += v4tmp2 * phi3d;
-                v5grid1[kk][jj][ii] += v5tmp2 * phi3d;
+            for (int k=0; k<=p+1; k++) {
+              const int kk = kc+index[k];
+              if (!domain->zperiodic) {
+                if (kk < alpha[n]) continue;
+                if (kk > betaz[n]) break;
+              }
+              const double phiz = phi1d[2][k];
+              for (int j=0; j<=p+1; j++) {
+                const int jj = jc+index[j];
+                if (!domain->yperiodic) {
+                  if (jj < alpha[n]) continue;
+                  if (jj > betay[n]) break;
+                }
+                const double phizy = phi1d[1][j]*phiz;
+                for (int i=0; i<=p+1; i++) {
+                  const int ii = ic+index[i];
+                  if (!domain->xperiodic) {
+                    if (ii < alpha[n]) continue;
+                    if (ii > betax[n]) break;
+                  }
+                  const double phi3d = phi1d[0][i]*phizy;
+
+                  egrid1[kk][jj][ii] += etmp2 * phi3d;
+
+                  if (vflag_atom) {
+                    v0grid1[kk][jj][ii] += v0tmp2 * phi3d;
+                    v1grid1[kk][jj][ii] += v1tmp2 * phi3d;
+                    v2grid1[kk][jj][ii] += v2tmp2 * phi3d;
+                    v3grid1[kk][jj][ii] += v3tmp2 * phi3d;
+                    v4grid1[kk][jj][ii] += v4tmp2 * phi3d;
+                    v5grid1[kk][jj][ii] += v5tmp2 * phi3d;
+                  }
+
+                }
               }
-
             }
-          }
-        }
 
-      }
+          }
+    }
+  }
   delete[] index;
 }
 
@@ -3445,6 +3539,10 @@ double MSM::memory_usage()
 
   bytes += (double)(ngcall_buf1 + ngcall_buf2) * npergrid * sizeof(double);
 
+  // per-thread row sums of direct()
+
+  bytes += (double)nthr_rowsum * maxrowsum * sizeof(double);
+
   for (int n=0; n<levels; n++)
     if (active_flag[n])
       bytes += (double)(ngc_buf1[n] + ngc_buf2[n]) * npergrid * sizeof(double);
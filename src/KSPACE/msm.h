@@ -94,6 +94,10 @@ class MSM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  double **rowsum;     // per-thread row sums of potential and virial
+  int nthr_rowsum;     // # of threads rowsum is allocated for
+  int maxrowsum;       // length of rowsum for each thread
+
   int triclinic;
   double *boxlo;
 
@@ -49,6 +49,7 @@ using namespace MathSpecial;
 #define LARGE 10000.0
 #define SMALL 0.00001
 #define EPS_HOC 1.0e-7
+#define GRIDBATCH 8
 
 enum{REVERSE_RHO};
 enum{FORWARD_IK,FORWARD_AD,FORWARD_IK_PERATOM,FORWARD_AD_PERATOM};
@@ -67,19 +68,24 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   factors(nullptr), density_brick(nullptr), vdx_brick(nullptr), vdy_brick(nullptr), vdz_brick(nullptr),
   u_brick(nullptr), v0_brick(nullptr), v1_brick(nullptr), v2_brick(nullptr), v3_brick(nullptr),
   v4_brick(nullptr), v5_brick(nullptr), greensfn(nullptr), vg(nullptr), fkx(nullptr), fky(nullptr),
-  fkz(nullptr), density_fft(nullptr), work1(nullptr), work2(nullptr), gf_b(nullptr), rho1d(nullptr),
+  fkz(nullptr), kxweight(nullptr), density_fft(nullptr), work1(nullptr), work2(nullptr),
+  density_fft_single(nullptr), work1_single(nullptr), work2_single(nullptr), gf_b(nullptr), rho1d(nullptr),
   rho_coeff(nullptr), drho1d(nullptr), drho_coeff(nullptr),
   sf_precoeff1(nullptr), sf_precoeff2(nullptr), sf_precoeff3(nullptr),
   sf_precoeff4(nullptr), sf_precoeff5(nullptr), sf_precoeff6(nullptr),
   acons(nullptr), fft1(nullptr), fft2(nullptr), remap(nullptr), gc(nullptr),
   gc_buf1(nullptr), gc_buf2(nullptr), density_A_brick(nullptr), density_B_brick(nullptr), density_A_fft(nullptr),
-  density_B_fft(nullptr), part2grid(nullptr), boxlo(nullptr)
+  density_B_fft(nullptr), part2grid(nullptr), gridsort(nullptr), gridcount(nullptr),
+  vd_brick(nullptr), rho1d_batch(nullptr), boxlo(nullptr)
 {
   peratom_allocate_flag = 0;
   group_allocate_flag = 0;
 
   pppmflag = 1;
   group_group_enable = 1;
+  r2c_support = 1;
+  gridsort_support = 1;
+  fft_single_support = 1;
   triclinic = domain->triclinic;
 
   nfactors = 3;
@@ -91,19 +97,23 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
 
-  nfft_both = 0;
+  nfft_both = nkfft = nwork = 0;
   nxhi_in = nxlo_in = nxhi_out = nxlo_out = 0;
   nyhi_in = nylo_in = nyhi_out = nylo_out = 0;
   nzhi_in = nzlo_in = nzhi_out = nzlo_out = 0;
 
   density_brick = vdx_brick = vdy_brick = vdz_brick = nullptr;
   density_fft = nullptr;
+  density_fft_single = nullptr;
+  rho2fft = 0;
   u_brick = nullptr;
   v0_brick = v1_brick = v2_brick = v3_brick = v4_brick = v5_brick = nullptr;
   greensfn = nullptr;
   work1 = work2 = nullptr;
+  work1_single = work2_single = nullptr;
   vg = nullptr;
   fkx = fky = fkz = nullptr;
+  kxweight = nullptr;
 
   sf_precoeff1 = sf_precoeff2 = sf_precoeff3 =
     sf_precoeff4 = sf_precoeff5 = sf_precoeff6 = nullptr;
@@ -122,6 +132,11 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   nmax = 0;
   part2grid = nullptr;
 
+  maxsort = 0;
+  gridsort = gridcount = nullptr;
+  vd_brick = nullptr;
+  rho1d_batch = nullptr;
+
   // define acons coefficients for estimation of kspace errors
   // see JCP 109, pg 7698 for derivation of coefficients
   // higher order coefficients may be computed if needed
@@ -178,6 +193,7 @@ PPPM::~PPPM()
   if (peratom_allocate_flag) deallocate_peratom();
   if (group_allocate_flag) deallocate_groups();
   memory->destroy(part2grid);
+  memory->destroy(gridsort);
   memory->destroy(acons);
 }
 
@@ -202,6 +218,9 @@ void PPPM::init()
   if (domain->triclinic && slabflag)
     error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and "
                "slab correction");
+  if (domain->triclinic && r2c_flag)
+    error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and "
+               "kspace_modify fft/r2c");
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use PPPM with 2d simulation");
 
@@ -347,7 +366,8 @@ void PPPM::init()
                        estimated_accuracy);
     mesg += fmt::format("  estimated relative force accuracy = {:.8g}\n",
                        estimated_accuracy/two_charge_force);
-    mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
+    if (fft_single_flag) mesg += "  using single precision " LMP_FFT_SINGLE_LIB "\n";
+    else mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
     utils::logmesg(lmp,mesg);
@@ -439,7 +459,7 @@ void PPPM::setup()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++) {
     for (j = nylo_fft; j <= nyhi_fft; j++) {
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         sqk = fkx[i]*fkx[i] + fky[j]*fky[j] + fkz[k]*fkz[k];
         if (sqk == 0.0) {
           vg[n][0] = 0.0;
@@ -462,10 +482,49 @@ void PPPM::setup()
     }
   }
 
+  if (r2c_flag) r2c_nyquist();
+
   if (differentiation_flag == 1) compute_gf_ad();
   else compute_gf_ik();
 }
 
+/* ----------------------------------------------------------------------
+   real-to-complex FFTs store only kx = 0 to nx/2, the -kx modes are
+     implied by Hermitian symmetry of the transformed real data
+   c2c FFTs discard the imaginary part of the result, which cancels
+     contributions of k that are odd under k -> -k
+   at a Nyquist index k and -k are the same grid pt, so zero the
+     wavevector components and virial coeffs that would be odd there
+------------------------------------------------------------------------- */
+
+void PPPM::r2c_nyquist()
+{
+  int i,j,k,n;
+  int nyqx,nyqy,nyqz;
+
+  n = 0;
+  for (k = nzlo_fft; k <= nzhi_fft; k++) {
+    nyqz = (2*k == nz_pppm);
+    for (j = nylo_fft; j <= nyhi_fft; j++) {
+      nyqy = (2*j == ny_pppm);
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+        nyqx = (2*i == nx_pppm);
+        if (nyqx != nyqy) vg[n][3] = 0.0;
+        if (nyqx != nyqz) vg[n][4] = 0.0;
+        if (nyqy != nyqz) vg[n][5] = 0.0;
+        n++;
+      }
+    }
+  }
+
+  for (i = nxlo_fft; i <= nxhi_kfft; i++)
+    if (2*i == nx_pppm) fkx[i] = 0.0;
+  for (j = nylo_fft; j <= nyhi_fft; j++)
+    if (2*j == ny_pppm) fky[j] = 0.0;
+  for (k = nzlo_fft; k <= nzhi_fft; k++)
+    if (2*k == nz_pppm) fkz[k] = 0.0;
+}
+
 /* ----------------------------------------------------------------------
    adjust PPPM coeffs, called initially and whenever volume has changed
    for a triclinic system
@@ -636,11 +695,20 @@ void PPPM::compute(int eflag, int vflag)
 
   // all procs communicate density values from their ghost cells
   //   to fully sum contribution in their 3d bricks
+  // owned density is copied to the FFT grid while messages are in flight,
+  //   received ghost values are then summed into both grids
   // remap from 3d decomposition to FFT decomposition
 
-  gc->reverse_comm_kspace(this,1,sizeof(FFT_SCALAR),REVERSE_RHO,
-                          gc_buf1,gc_buf2,MPI_FFT_SCALAR);
-  brick2fft();
+  gc->reverse_comm_kspace_start(this,1,sizeof(FFT_SCALAR),REVERSE_RHO,
+                                gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+  copy_brick2fft();
+  rho2fft = 1;
+  gc->reverse_comm_kspace_finish(this,1,sizeof(FFT_SCALAR),REVERSE_RHO,
+                                 gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+  rho2fft = 0;
+  if (fft_single_flag)
+    remap->perform(density_fft_single,density_fft_single,work1_single);
+  else remap->perform(density_fft,density_fft,work1);
 
   // compute potential gradient on my FFT grid and
   //   portion of e_long on this proc's FFT grid
@@ -660,14 +728,15 @@ void PPPM::compute(int eflag, int vflag)
                             gc_buf1,gc_buf2,MPI_FFT_SCALAR);
 
   // extra per-atom energy/virial communication
+  // overlapped with the force calculation, which does not use these grids
 
   if (evflag_atom) {
     if (differentiation_flag == 1 && vflag_atom)
-      gc->forward_comm_kspace(this,6,sizeof(FFT_SCALAR),FORWARD_AD_PERATOM,
-                              gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+      gc->forward_comm_kspace_start(this,6,sizeof(FFT_SCALAR),FORWARD_AD_PERATOM,
+                                    gc_buf1,gc_buf2,MPI_FFT_SCALAR);
     else if (differentiation_flag == 0)
-      gc->forward_comm_kspace(this,7,sizeof(FFT_SCALAR),FORWARD_IK_PERATOM,
-                              gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+      gc->forward_comm_kspace_start(this,7,sizeof(FFT_SCALAR),FORWARD_IK_PERATOM,
+                                    gc_buf1,gc_buf2,MPI_FFT_SCALAR);
   }
 
   // calculate the force on my particles
@@ -676,7 +745,15 @@ void PPPM::compute(int eflag, int vflag)
 
   // extra per-atom energy/virial communication
 
-  if (evflag_atom) fieldforce_peratom();
+  if (evflag_atom) {
+    if (differentiation_flag == 1 && vflag_atom)
+      gc->forward_comm_kspace_finish(this,6,sizeof(FFT_SCALAR),FORWARD_AD_PERATOM,
+                                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    else if (differentiation_flag == 0)
+      gc->forward_comm_kspace_finish(this,7,sizeof(FFT_SCALAR),FORWARD_IK_PERATOM,
+                                     gc_buf1,gc_buf2,MPI_FFT_SCALAR);
+    fieldforce_peratom();
+  }
 
   // sum global energy across procs and add in volume-dependent term
 
@@ -745,11 +822,25 @@ void PPPM::allocate()
   memory->create3d_offset(density_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
                           nxlo_out,nxhi_out,"pppm:density_brick");
 
-  memory->create(density_fft,nfft_both,"pppm:density_fft");
+  // FFT grids are float arrays with kspace_modify fft/single
+
+  if (fft_single_flag) {
+    memory->create(density_fft_single,nfft_both,"pppm:density_fft_single");
+    memory->create(work1_single,nwork,"pppm:work1_single");
+    memory->create(work2_single,nwork,"pppm:work2_single");
+  } else {
+    memory->create(density_fft,nfft_both,"pppm:density_fft");
+    memory->create(work1,nwork,"pppm:work1");
+    memory->create(work2,nwork,"pppm:work2");
+  }
   memory->create(greensfn,nfft_both,"pppm:greensfn");
-  memory->create(work1,2*nfft_both,"pppm:work1");
-  memory->create(work2,2*nfft_both,"pppm:work2");
   memory->create(vg,nfft_both,6,"pppm:vg");
+  memory->create1d_offset(kxweight,nxlo_fft,nxhi_kfft,"pppm:kxweight");
+
+  for (int i = nxlo_fft; i <= nxhi_kfft; i++) {
+    if (r2c_flag && i > 0 && 2*i != nx_pppm) kxweight[i] = 2.0;
+    else kxweight[i] = 1.0;
+  }
 
   if (triclinic == 0) {
     memory->create1d_offset(fkx,nxlo_fft,nxhi_fft,"pppm:fkx");
@@ -791,27 +882,55 @@ void PPPM::allocate()
   memory->create2d_offset(drho_coeff,order,(1-order)/2,order/2,
                           "pppm:drho_coeff");
 
+  // grid-sorted mapping needs per-cell offsets and batched weights
+  // ik differentiation also interpolates from an interleaved E-field brick
+
+  if (gridsort_flag) {
+    memory->create(gridcount,ngrid+1,"pppm:gridcount");
+    memory->create(rho1d_batch,3,order*GRIDBATCH,"pppm:rho1d_batch");
+    if (differentiation_flag == 0)
+      memory->create(vd_brick,3*ngrid,"pppm:vd_brick");
+  }
+
   // create 2 FFTs and a Remap
   // 1st FFT keeps data in FFT decomposition
   // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
+  // for real-to-complex FFTs, the real data is the input of each plan
+  //   and the half-length complex k-space data in FFT decomposition
+  //   is the output, backward c2r FFTs go from output to input
 
-  int tmp;
+  // FFTs and remap are performed in single precision for fft/single
 
-  fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+  int tmp;
+  int precision = fft_single_flag ? 1 : FFT_PRECISION;
+
+  if (r2c_flag) {
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,precision);
+
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1,precision);
+  } else {
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,0,precision);
 
-  fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     0,0,&tmp,collective_flag,0,precision);
+  }
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+                    1,0,0,precision,collective_flag);
 
   // create ghost grid object for rho and electric field communication
   // also create 2 bufs for ghost grid cell comm, passed to GridComm methods
@@ -855,7 +974,11 @@ void PPPM::deallocate()
   memory->destroy(greensfn);
   memory->destroy(work1);
   memory->destroy(work2);
+  memory->destroy(density_fft_single);
+  memory->destroy(work1_single);
+  memory->destroy(work2_single);
   memory->destroy(vg);
+  memory->destroy1d_offset(kxweight,nxlo_fft);
 
   if (triclinic == 0) {
     memory->destroy1d_offset(fkx,nxlo_fft);
@@ -873,6 +996,9 @@ void PPPM::deallocate()
   memory->destroy2d_offset(drho1d,-order_allocated/2);
   memory->destroy2d_offset(rho_coeff,(1-order_allocated)/2);
   memory->destroy2d_offset(drho_coeff,(1-order_allocated)/2);
+  memory->destroy(gridcount);
+  memory->destroy(rho1d_batch);
+  memory->destroy(vd_brick);
 
   delete fft1;
   delete fft2;
@@ -1486,6 +1612,24 @@ void PPPM::set_grid_local()
   int nfft_brick = (nxhi_in-nxlo_in+1) * (nyhi_in-nylo_in+1) *
     (nzhi_in-nzlo_in+1);
   nfft_both = MAX(nfft,nfft_brick);
+
+  // k-space pts in FFT decomposition
+  // r2c FFTs only keep kx = 0 to nx/2 of each x-pencil
+  // nwork = FFT work array length, interleaved complex k-space values
+  //   or real values in either decomposition
+
+  if (r2c_flag) nxhi_kfft = nx_pppm/2;
+  else nxhi_kfft = nxhi_fft;
+  nkfft = (nxhi_kfft-nxlo_fft+1) * (nyhi_fft-nylo_fft+1) *
+    (nzhi_fft-nzlo_fft+1);
+
+  if (r2c_flag) {
+    nwork = MAX(2*nkfft,nfft_both);
+    fft_stride = 1;
+  } else {
+    nwork = 2*nfft_both;
+    fft_stride = 2;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -1552,7 +1696,7 @@ void PPPM::compute_gf_ik()
       lper = l - ny_pppm*(2*l/ny_pppm);
       sny = square(sin(0.5*unitky*lper*yprd/ny_pppm));
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         snx = square(sin(0.5*unitkx*kper*xprd/nx_pppm));
 
@@ -1728,7 +1872,7 @@ void PPPM::compute_gf_ad()
       argy = 0.5*qy*yprd/ny_pppm;
       wy = powsinxx(argy,twoorder);
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         qx = unitkx*kper;
         snx = square(sin(0.5*qx*xprd/nx_pppm));
@@ -1742,21 +1886,21 @@ void PPPM::compute_gf_ad()
           numerator = MY_4PI/sqk;
           denominator = gf_denom(snx,sny,snz);
           greensfn[n] = numerator*sx*sy*sz*wx*wy*wz/denominator;
-          sf_coeff[0] += sf_precoeff1[n]*greensfn[n];
-          sf_coeff[1] += sf_precoeff2[n]*greensfn[n];
-          sf_coeff[2] += sf_precoeff3[n]*greensfn[n];
-          sf_coeff[3] += sf_precoeff4[n]*greensfn[n];
-          sf_coeff[4] += sf_precoeff5[n]*greensfn[n];
-          sf_coeff[5] += sf_precoeff6[n]*greensfn[n];
+          sf_coeff[0] += kxweight[k]*sf_precoeff1[n]*greensfn[n];
+          sf_coeff[1] += kxweight[k]*sf_precoeff2[n]*greensfn[n];
+          sf_coeff[2] += kxweight[k]*sf_precoeff3[n]*greensfn[n];
+          sf_coeff[3] += kxweight[k]*sf_precoeff4[n]*greensfn[n];
+          sf_coeff[4] += kxweight[k]*sf_precoeff5[n]*greensfn[n];
+          sf_coeff[5] += kxweight[k]*sf_precoeff6[n]*greensfn[n];
           n++;
         } else {
           greensfn[n] = 0.0;
-          sf_coeff[0] += sf_precoeff1[n]*greensfn[n];
-          sf_coeff[1] += sf_precoeff2[n]*greensfn[n];
-          sf_coeff[2] += sf_precoeff3[n]*greensfn[n];
-          sf_coeff[3] += sf_precoeff4[n]*greensfn[n];
-          sf_coeff[4] += sf_precoeff5[n]*greensfn[n];
-          sf_coeff[5] += sf_precoeff6[n]*greensfn[n];
+          sf_coeff[0] += kxweight[k]*sf_precoeff1[n]*greensfn[n];
+          sf_coeff[1] += kxweight[k]*sf_precoeff2[n]*greensfn[n];
+          sf_coeff[2] += kxweight[k]*sf_precoeff3[n]*greensfn[n];
+          sf_coeff[3] += kxweight[k]*sf_precoeff4[n]*greensfn[n];
+          sf_coeff[4] += kxweight[k]*sf_precoeff5[n]*greensfn[n];
+          sf_coeff[5] += kxweight[k]*sf_precoeff6[n]*greensfn[n];
           n++;
         }
       }
@@ -1790,8 +1934,8 @@ void PPPM::compute_gf_ad()
 
 void PPPM::compute_sf_precoeff()
 {
-  int i,k,l,m,n;
-  int nx,ny,nz,kper,lper,mper;
+  int i,k,l,m,n,isym,nsym;
+  int nx,ny,nz,kper,lper,mper,kp,lp,mp;
   double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
   double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
   double u0,u1,u2,u3,u4,u5,u6;
@@ -1804,56 +1948,81 @@ void PPPM::compute_sf_precoeff()
     for (l = nylo_fft; l <= nyhi_fft; l++) {
       lper = l - ny_pppm*(2*l/ny_pppm);
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
 
         sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
-        for (i = 0; i < 5; i++) {
-
-          qx0 = MY_2PI*(kper+nx_pppm*(i-2));
-          qx1 = MY_2PI*(kper+nx_pppm*(i-1));
-          qx2 = MY_2PI*(kper+nx_pppm*(i  ));
-          wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
-          wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
-          wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
-
-          qy0 = MY_2PI*(lper+ny_pppm*(i-2));
-          qy1 = MY_2PI*(lper+ny_pppm*(i-1));
-          qy2 = MY_2PI*(lper+ny_pppm*(i  ));
-          wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
-          wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
-          wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
-
-          qz0 = MY_2PI*(mper+nz_pppm*(i-2));
-          qz1 = MY_2PI*(mper+nz_pppm*(i-1));
-          qz2 = MY_2PI*(mper+nz_pppm*(i  ));
-
-          wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
-          wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
-          wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
-        }
 
-        for (nx = 0; nx < 5; nx++) {
-          for (ny = 0; ny < 5; ny++) {
-            for (nz = 0; nz < 5; nz++) {
-              u0 = wx0[nx]*wy0[ny]*wz0[nz];
-              u1 = wx1[nx]*wy0[ny]*wz0[nz];
-              u2 = wx2[nx]*wy0[ny]*wz0[nz];
-              u3 = wx0[nx]*wy1[ny]*wz0[nz];
-              u4 = wx0[nx]*wy2[ny]*wz0[nz];
-              u5 = wx0[nx]*wy0[ny]*wz1[nz];
-              u6 = wx0[nx]*wy0[ny]*wz2[nz];
-
-              sum1 += u0*u1;
-              sum2 += u0*u2;
-              sum3 += u0*u3;
-              sum4 += u0*u4;
-              sum5 += u0*u5;
-              sum6 += u0*u6;
+        // r2c FFTs store k but not -k, so average over both grid pts
+        // Nyquist indices are their own partner
+
+        nsym = r2c_flag ? 2 : 1;
+        for (isym = 0; isym < nsym; isym++) {
+          kp = kper;
+          lp = lper;
+          mp = mper;
+          if (isym) {
+            if (2*k != nx_pppm) kp = -kper;
+            if (2*l != ny_pppm) lp = -lper;
+            if (2*m != nz_pppm) mp = -mper;
+          }
+
+          for (i = 0; i < 5; i++) {
+
+            qx0 = MY_2PI*(kp+nx_pppm*(i-2));
+            qx1 = MY_2PI*(kp+nx_pppm*(i-1));
+            qx2 = MY_2PI*(kp+nx_pppm*(i  ));
+            wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
+            wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
+            wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
+
+            qy0 = MY_2PI*(lp+ny_pppm*(i-2));
+            qy1 = MY_2PI*(lp+ny_pppm*(i-1));
+            qy2 = MY_2PI*(lp+ny_pppm*(i  ));
+            wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
+            wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
+            wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
+
+            qz0 = MY_2PI*(mp+nz_pppm*(i-2));
+            qz1 = MY_2PI*(mp+nz_pppm*(i-1));
+            qz2 = MY_2PI*(mp+nz_pppm*(i  ));
+
+            wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
+            wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
+            wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
+          }
+
+          for (nx = 0; nx < 5; nx++) {
+            for (ny = 0; ny < 5; ny++) {
+              for (nz = 0; nz < 5; nz++) {
+                u0 = wx0[nx]*wy0[ny]*wz0[nz];
+                u1 = wx1[nx]*wy0[ny]*wz0[nz];
+                u2 = wx2[nx]*wy0[ny]*wz0[nz];
+                u3 = wx0[nx]*wy1[ny]*wz0[nz];
+                u4 = wx0[nx]*wy2[ny]*wz0[nz];
+                u5 = wx0[nx]*wy0[ny]*wz1[nz];
+                u6 = wx0[nx]*wy0[ny]*wz2[nz];
+
+                sum1 += u0*u1;
+                sum2 += u0*u2;
+                sum3 += u0*u3;
+                sum4 += u0*u4;
+                sum5 += u0*u5;
+                sum6 += u0*u6;
+              }
             }
           }
         }
 
+        if (r2c_flag) {
+          sum1 *= 0.5;
+          sum2 *= 0.5;
+          sum3 *= 0.5;
+          sum4 *= 0.5;
+          sum5 *= 0.5;
+          sum6 *= 0.5;
+        }
+
         // store values
 
         sf_precoeff1[n] = sum1;
@@ -1925,6 +2094,11 @@ void PPPM::make_rho()
   int l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
 
+  if (gridsort_flag) {
+    make_rho_sorted();
+    return;
+  }
+
   // clear 3d density array
 
   memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
@@ -1966,25 +2140,153 @@ void PPPM::make_rho()
   }
 }
 
+/* ----------------------------------------------------------------------
+   sort my particles by the grid cell they were mapped to in part2grid
+   stable counting sort, so particles in a cell stay in index order
+   gridsort = particle indices ordered by grid cell
+------------------------------------------------------------------------- */
+
+void PPPM::sort_grid()
+{
+  int i,m,icell;
+
+  int nlocal = atom->nlocal;
+
+  if (nlocal > maxsort) {
+    maxsort = atom->nmax;
+    memory->destroy(gridsort);
+    memory->create(gridsort,maxsort,"pppm:gridsort");
+  }
+
+  const int nxout = nxhi_out - nxlo_out + 1;
+  const int nyout = nyhi_out - nylo_out + 1;
+
+  // count particles in each cell, shifted by one so the prefix sum
+  //   yields the offset of each cell into gridsort
+
+  memset(gridcount,0,(ngrid+1)*sizeof(int));
+
+  for (i = 0; i < nlocal; i++) {
+    icell = ((part2grid[i][2]-nzlo_out)*nyout + part2grid[i][1]-nylo_out)*nxout +
+      part2grid[i][0]-nxlo_out;
+    gridcount[icell+1]++;
+  }
+
+  for (m = 1; m <= ngrid; m++) gridcount[m] += gridcount[m-1];
+
+  for (i = 0; i < nlocal; i++) {
+    icell = ((part2grid[i][2]-nzlo_out)*nyout + part2grid[i][1]-nylo_out)*nxout +
+      part2grid[i][0]-nxlo_out;
+    gridsort[gridcount[icell]++] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create discretized "density" on my 3d brick like make_rho(),
+   but loop over particles in grid cell order and compute their
+   rho1d weights GRIDBATCH particles at a time
+   neighboring particles then update the same, cached, grid points
+------------------------------------------------------------------------- */
+
+void PPPM::make_rho_sorted()
+{
+  int i,j,l,m,n,nx,ny,nz,my,mz,ibatch,nbatch;
+  FFT_SCALAR x0,y0,z0;
+  FFT_SCALAR dx[GRIDBATCH],dy[GRIDBATCH],dz[GRIDBATCH];
+  FFT_SCALAR *dens;
+  const FFT_SCALAR *rx,*ry,*rz;
+
+  memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
+         ngrid*sizeof(FFT_SCALAR));
+
+  sort_grid();
+
+  double *q = atom->q;
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+
+  for (ibatch = 0; ibatch < nlocal; ibatch += GRIDBATCH) {
+    nbatch = MIN(GRIDBATCH,nlocal-ibatch);
+
+    // distances to "lower left" grid pt, unused batch slots are zero
+
+    for (j = 0; j < GRIDBATCH; j++) {
+      if (j < nbatch) {
+        i = gridsort[ibatch+j];
+        dx[j] = part2grid[i][0]+shiftone - (x[i][0]-boxlo[0])*delxinv;
+        dy[j] = part2grid[i][1]+shiftone - (x[i][1]-boxlo[1])*delyinv;
+        dz[j] = part2grid[i][2]+shiftone - (x[i][2]-boxlo[2])*delzinv;
+      } else dx[j] = dy[j] = dz[j] = ZEROF;
+    }
+
+    compute_rho1d_batch(dx,dy,dz);
+
+    for (j = 0; j < nbatch; j++) {
+      i = gridsort[ibatch+j];
+      nx = part2grid[i][0];
+      ny = part2grid[i][1];
+      nz = part2grid[i][2];
+      rx = &rho1d_batch[0][j];
+      ry = &rho1d_batch[1][j];
+      rz = &rho1d_batch[2][j];
+
+      z0 = delvolinv * q[i];
+      for (n = 0; n < order; n++) {
+        mz = n+nlower+nz;
+        y0 = z0*rz[n*GRIDBATCH];
+        for (m = 0; m < order; m++) {
+          my = m+nlower+ny;
+          x0 = y0*ry[m*GRIDBATCH];
+          dens = &density_brick[mz][my][nx+nlower];
+          for (l = 0; l < order; l++)
+            dens[l] += x0*rx[l*GRIDBATCH];
+        }
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    remap density from 3d brick decomposition to FFT decomposition
 ------------------------------------------------------------------------- */
 
 void PPPM::brick2fft()
 {
-  int n,ix,iy,iz;
-
-  // copy grabs inner portion of density from 3d brick
   // remap could be done as pre-stage of FFT,
   //   but this works optimally on only double values, not complex values
 
+  copy_brick2fft();
+  if (fft_single_flag)
+    remap->perform(density_fft_single,density_fft_single,work1_single);
+  else remap->perform(density_fft,density_fft,work1);
+}
+
+/* ----------------------------------------------------------------------
+   copy inner portion of density from 3d brick to FFT grid
+------------------------------------------------------------------------- */
+
+void PPPM::copy_brick2fft()
+{
+  if (fft_single_flag) copy_brick2fft(density_fft_single);
+  else copy_brick2fft(density_fft);
+}
+
+/* ----------------------------------------------------------------------
+   copy inner portion of density from 3d brick to FFT grid of type T
+   T = float with kspace_modify fft/single, else FFT_SCALAR
+   arguments of the templated methods replace the FFT_SCALAR FFT grids
+------------------------------------------------------------------------- */
+
+template <class T>
+void PPPM::copy_brick2fft(T *density_fft)
+{
+  int n,ix,iy,iz;
+
   n = 0;
   for (iz = nzlo_in; iz <= nzhi_in; iz++)
     for (iy = nylo_in; iy <= nyhi_in; iy++)
       for (ix = nxlo_in; ix <= nxhi_in; ix++)
         density_fft[n++] = density_brick[iz][iy][ix];
-
-  remap->perform(density_fft,density_fft,work1);
 }
 
 /* ----------------------------------------------------------------------
@@ -2003,40 +2305,65 @@ void PPPM::poisson()
 
 void PPPM::poisson_ik()
 {
-  int i,j,k,n;
+  if (fft_single_flag)
+    poisson_ik(density_fft_single,work1_single,work2_single);
+  else poisson_ik(density_fft,work1,work2);
+}
+
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for ik on FFT grids of type T
+------------------------------------------------------------------------- */
+
+template <class T>
+void PPPM::poisson_ik(T *density_fft, T *work1, T *work2)
+{
+  int i,j,k,m,n;
   double eng;
 
   // transform charge density (r -> k)
+  // real-to-complex FFT reads the real density directly
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  if (r2c_flag) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
-  // global energy and virial contribution
+  // global energy and virial contribution, accumulated in double precision
 
   double scaleinv = 1.0/(nx_pppm*ny_pppm*nz_pppm);
   double s2 = scaleinv*scaleinv;
 
+  // kxweight = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+
   if (eflag_global || vflag_global) {
     if (vflag_global) {
-      n = 0;
-      for (i = 0; i < nfft; i++) {
-        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
-        if (eflag_global) energy += eng;
-        n += 2;
-      }
+      n = m = 0;
+      for (k = nzlo_fft; k <= nzhi_fft; k++)
+        for (j = nylo_fft; j <= nyhi_fft; j++)
+          for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+            eng = s2 * kxweight[i] * greensfn[m] *
+              ((double) work1[n]*work1[n] + (double) work1[n+1]*work1[n+1]);
+            for (int iv = 0; iv < 6; iv++) virial[iv] += eng*vg[m][iv];
+            if (eflag_global) energy += eng;
+            n += 2;
+            m++;
+          }
     } else {
-      n = 0;
-      for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        n += 2;
-      }
+      n = m = 0;
+      for (k = nzlo_fft; k <= nzhi_fft; k++)
+        for (j = nylo_fft; j <= nyhi_fft; j++)
+          for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+            energy += s2 * kxweight[i] * greensfn[m] *
+              ((double) work1[n]*work1[n] + (double) work1[n+1]*work1[n+1]);
+            n += 2;
+            m++;
+          }
     }
   }
 
@@ -2044,19 +2371,19 @@ void PPPM::poisson_ik()
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
 
   // extra FFTs for per-atom energy/virial
 
-  if (evflag_atom) poisson_peratom();
+  if (evflag_atom) poisson_peratom(work1,work2);
 
   // triclinic system
 
   if (triclinic) {
-    poisson_ik_triclinic();
+    poisson_ik_triclinic(work1,work2);
     return;
   }
 
@@ -2069,7 +2396,7 @@ void PPPM::poisson_ik()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work2[n] = -fkx[i]*work1[n+1];
         work2[n+1] = fkx[i]*work1[n];
         n += 2;
@@ -2082,7 +2409,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdx_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // y direction gradient
@@ -2090,7 +2417,7 @@ void PPPM::poisson_ik()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work2[n] = -fky[j]*work1[n+1];
         work2[n+1] = fky[j]*work1[n];
         n += 2;
@@ -2103,7 +2430,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdy_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // z direction gradient
@@ -2111,7 +2438,7 @@ void PPPM::poisson_ik()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work2[n] = -fkz[k]*work1[n+1];
         work2[n+1] = fkz[k]*work1[n];
         n += 2;
@@ -2124,7 +2451,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdz_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 }
 
@@ -2132,7 +2459,8 @@ void PPPM::poisson_ik()
    FFT-based Poisson solver for ik for a triclinic system
 ------------------------------------------------------------------------- */
 
-void PPPM::poisson_ik_triclinic()
+template <class T>
+void PPPM::poisson_ik_triclinic(T *work1, T *work2)
 {
   int i,j,k,n;
 
@@ -2204,40 +2532,65 @@ void PPPM::poisson_ik_triclinic()
 
 void PPPM::poisson_ad()
 {
-  int i,j,k,n;
+  if (fft_single_flag)
+    poisson_ad(density_fft_single,work1_single,work2_single);
+  else poisson_ad(density_fft,work1,work2);
+}
+
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for ad on FFT grids of type T
+------------------------------------------------------------------------- */
+
+template <class T>
+void PPPM::poisson_ad(T *density_fft, T *work1, T *work2)
+{
+  int i,j,k,m,n;
   double eng;
 
   // transform charge density (r -> k)
+  // real-to-complex FFT reads the real density directly
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  if (r2c_flag) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
-  // global energy and virial contribution
+  // global energy and virial contribution, accumulated in double precision
 
   double scaleinv = 1.0/(nx_pppm*ny_pppm*nz_pppm);
   double s2 = scaleinv*scaleinv;
 
+  // kxweight = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+
   if (eflag_global || vflag_global) {
     if (vflag_global) {
-      n = 0;
-      for (i = 0; i < nfft; i++) {
-        eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
-        if (eflag_global) energy += eng;
-        n += 2;
-      }
+      n = m = 0;
+      for (k = nzlo_fft; k <= nzhi_fft; k++)
+        for (j = nylo_fft; j <= nyhi_fft; j++)
+          for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+            eng = s2 * kxweight[i] * greensfn[m] *
+              ((double) work1[n]*work1[n] + (double) work1[n+1]*work1[n+1]);
+            for (int iv = 0; iv < 6; iv++) virial[iv] += eng*vg[m][iv];
+            if (eflag_global) energy += eng;
+            n += 2;
+            m++;
+          }
     } else {
-      n = 0;
-      for (i = 0; i < nfft; i++) {
-        energy +=
-          s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
-        n += 2;
-      }
+      n = m = 0;
+      for (k = nzlo_fft; k <= nzhi_fft; k++)
+        for (j = nylo_fft; j <= nyhi_fft; j++)
+          for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+            energy += s2 * kxweight[i] * greensfn[m] *
+              ((double) work1[n]*work1[n] + (double) work1[n+1]*work1[n+1]);
+            n += 2;
+            m++;
+          }
     }
   }
 
@@ -2245,17 +2598,17 @@ void PPPM::poisson_ad()
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
 
   // extra FFTs for per-atom energy/virial
 
-  if (vflag_atom) poisson_peratom();
+  if (vflag_atom) poisson_peratom(work1,work2);
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n];
     work2[n+1] = work1[n+1];
     n += 2;
@@ -2268,7 +2621,7 @@ void PPPM::poisson_ad()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         u_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 }
 
@@ -2277,6 +2630,17 @@ void PPPM::poisson_ad()
 ------------------------------------------------------------------------- */
 
 void PPPM::poisson_peratom()
+{
+  if (fft_single_flag) poisson_peratom(work1_single,work2_single);
+  else poisson_peratom(work1,work2);
+}
+
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for per-atom energy/virial on FFT grids of type T
+------------------------------------------------------------------------- */
+
+template <class T>
+void PPPM::poisson_peratom(T *work1, T *work2)
 {
   int i,j,k,n;
 
@@ -2284,7 +2648,7 @@ void PPPM::poisson_peratom()
 
   if (eflag_atom && differentiation_flag != 1) {
     n = 0;
-    for (i = 0; i < nfft; i++) {
+    for (i = 0; i < nkfft; i++) {
       work2[n] = work1[n];
       work2[n+1] = work1[n+1];
       n += 2;
@@ -2297,7 +2661,7 @@ void PPPM::poisson_peratom()
       for (j = nylo_in; j <= nyhi_in; j++)
         for (i = nxlo_in; i <= nxhi_in; i++) {
           u_brick[k][j][i] = work2[n];
-          n += 2;
+          n += fft_stride;
         }
   }
 
@@ -2306,7 +2670,7 @@ void PPPM::poisson_peratom()
   if (!vflag_atom) return;
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][0];
     work2[n+1] = work1[n+1]*vg[i][0];
     n += 2;
@@ -2319,11 +2683,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][1];
     work2[n+1] = work1[n+1]*vg[i][1];
     n += 2;
@@ -2336,11 +2700,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][2];
     work2[n+1] = work1[n+1]*vg[i][2];
     n += 2;
@@ -2353,11 +2717,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][3];
     work2[n+1] = work1[n+1]*vg[i][3];
     n += 2;
@@ -2370,11 +2734,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][4];
     work2[n+1] = work1[n+1]*vg[i][4];
     n += 2;
@@ -2387,11 +2751,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work2[n] = work1[n]*vg[i][5];
     work2[n+1] = work1[n+1]*vg[i][5];
     n += 2;
@@ -2404,7 +2768,7 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5_brick[k][j][i] = work2[n];
-        n += 2;
+        n += fft_stride;
       }
 }
 
@@ -2428,6 +2792,11 @@ void PPPM::fieldforce_ik()
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
 
+  if (gridsort_flag) {
+    fieldforce_ik_sorted();
+    return;
+  }
+
   // loop over my charges, interpolate electric field from nearby grid points
   // (nx,ny,nz) = global coords of grid pt to "lower left" of charge
   // (dx,dy,dz) = distance to "lower left" grid pt
@@ -2476,6 +2845,93 @@ void PPPM::fieldforce_ik()
   }
 }
 
+/* ----------------------------------------------------------------------
+   interpolate E-field & force on my particles like fieldforce_ik(),
+   but in the grid cell order set by make_rho_sorted() and from a
+   single brick with interleaved x,y,z field components
+------------------------------------------------------------------------- */
+
+void PPPM::fieldforce_ik_sorted()
+{
+  int i,j,l,m,n,nx,ny,nz,my,mz,ibatch,nbatch;
+  FFT_SCALAR x0,y0,z0;
+  FFT_SCALAR ekx,eky,ekz;
+  FFT_SCALAR dx[GRIDBATCH],dy[GRIDBATCH],dz[GRIDBATCH];
+  const FFT_SCALAR *rx,*ry,*rz,*vd;
+
+  // interleave the 3 E-field bricks, including ghost cells
+
+  const FFT_SCALAR *vdx = &vdx_brick[nzlo_out][nylo_out][nxlo_out];
+  const FFT_SCALAR *vdy = &vdy_brick[nzlo_out][nylo_out][nxlo_out];
+  const FFT_SCALAR *vdz = &vdz_brick[nzlo_out][nylo_out][nxlo_out];
+
+  for (i = 0; i < ngrid; i++) {
+    vd_brick[3*i] = vdx[i];
+    vd_brick[3*i+1] = vdy[i];
+    vd_brick[3*i+2] = vdz[i];
+  }
+
+  const int nxout = nxhi_out - nxlo_out + 1;
+  const int nyout = nyhi_out - nylo_out + 1;
+
+  double *q = atom->q;
+  double **x = atom->x;
+  double **f = atom->f;
+  int nlocal = atom->nlocal;
+
+  const double qscale = qqrd2e * scale;
+
+  for (ibatch = 0; ibatch < nlocal; ibatch += GRIDBATCH) {
+    nbatch = MIN(GRIDBATCH,nlocal-ibatch);
+
+    for (j = 0; j < GRIDBATCH; j++) {
+      if (j < nbatch) {
+        i = gridsort[ibatch+j];
+        dx[j] = part2grid[i][0]+shiftone - (x[i][0]-boxlo[0])*delxinv;
+        dy[j] = part2grid[i][1]+shiftone - (x[i][1]-boxlo[1])*delyinv;
+        dz[j] = part2grid[i][2]+shiftone - (x[i][2]-boxlo[2])*delzinv;
+      } else dx[j] = dy[j] = dz[j] = ZEROF;
+    }
+
+    compute_rho1d_batch(dx,dy,dz);
+
+    for (j = 0; j < nbatch; j++) {
+      i = gridsort[ibatch+j];
+      nx = part2grid[i][0];
+      ny = part2grid[i][1];
+      nz = part2grid[i][2];
+      rx = &rho1d_batch[0][j];
+      ry = &rho1d_batch[1][j];
+      rz = &rho1d_batch[2][j];
+
+      ekx = eky = ekz = ZEROF;
+      for (n = 0; n < order; n++) {
+        mz = n+nlower+nz;
+        z0 = rz[n*GRIDBATCH];
+        for (m = 0; m < order; m++) {
+          my = m+nlower+ny;
+          y0 = z0*ry[m*GRIDBATCH];
+          vd = &vd_brick[3*(((mz-nzlo_out)*nyout + my-nylo_out)*nxout +
+                            nx+nlower-nxlo_out)];
+          for (l = 0; l < order; l++) {
+            x0 = y0*rx[l*GRIDBATCH];
+            ekx -= x0*vd[3*l];
+            eky -= x0*vd[3*l+1];
+            ekz -= x0*vd[3*l+2];
+          }
+        }
+      }
+
+      // convert E-field to force
+
+      const double qfactor = qscale * q[i];
+      f[i][0] += qfactor*ekx;
+      f[i][1] += qfactor*eky;
+      if (slabflag != 2) f[i][2] += qfactor*ekz;
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ad
 ------------------------------------------------------------------------- */
@@ -2775,6 +3231,25 @@ void PPPM::unpack_reverse_grid(int flag, void *vbuf, int nlist, int *list)
     FFT_SCALAR *dest = &density_brick[nzlo_out][nylo_out][nxlo_out];
     for (int i = 0; i < nlist; i++)
       dest[list[i]] += buf[i];
+
+    // list holds owned cells as offsets into the brick with ghosts,
+    //   convert them to offsets into the FFT grid of owned cells
+
+    if (rho2fft) {
+      const int nxout = nxhi_out - nxlo_out + 1;
+      const int nyout = nyhi_out - nylo_out + 1;
+      const int nxin = nxhi_in - nxlo_in + 1;
+      const int nyin = nyhi_in - nylo_in + 1;
+      int ix,iy,iz;
+      for (int i = 0; i < nlist; i++) {
+        ix = list[i] % nxout + nxlo_out - nxlo_in;
+        iy = (list[i]/nxout) % nyout + nylo_out - nylo_in;
+        iz = list[i]/(nxout*nyout) + nzlo_out - nzlo_in;
+        if (fft_single_flag)
+          density_fft_single[(iz*nyin + iy)*nxin + ix] += buf[i];
+        else density_fft[(iz*nyin + iy)*nxin + ix] += buf[i];
+      }
+    }
   }
 }
 
@@ -2841,6 +3316,39 @@ void PPPM::compute_rho1d(const FFT_SCALAR &dx, const FFT_SCALAR &dy,
   }
 }
 
+/* ----------------------------------------------------------------------
+   charge assignment into rho1d_batch for GRIDBATCH particles at once
+   dx,dy,dz = distances of particles from their "lower left" grid points
+   rho1d_batch[dim][k*GRIDBATCH+j] = weight k-nlower of particle j
+   the fixed-length inner loops are meant to be vectorized
+------------------------------------------------------------------------- */
+
+void PPPM::compute_rho1d_batch(const FFT_SCALAR *dx, const FFT_SCALAR *dy,
+                               const FFT_SCALAR *dz)
+{
+  int j,k,l;
+  FFT_SCALAR r1[GRIDBATCH],r2[GRIDBATCH],r3[GRIDBATCH];
+
+  for (k = 0; k < order; k++) {
+    for (j = 0; j < GRIDBATCH; j++) r1[j] = r2[j] = r3[j] = ZEROF;
+
+    for (l = order-1; l >= 0; l--) {
+      const FFT_SCALAR coeff = rho_coeff[l][k+nlower];
+      for (j = 0; j < GRIDBATCH; j++) {
+        r1[j] = coeff + r1[j]*dx[j];
+        r2[j] = coeff + r2[j]*dy[j];
+        r3[j] = coeff + r3[j]*dz[j];
+      }
+    }
+
+    for (j = 0; j < GRIDBATCH; j++) {
+      rho1d_batch[0][k*GRIDBATCH+j] = r1[j];
+      rho1d_batch[1][k*GRIDBATCH+j] = r2[j];
+      rho1d_batch[2][k*GRIDBATCH+j] = r3[j];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    charge assignment into drho1d
    dx,dy,dz = distance of particle from "lower left" grid point
@@ -2997,10 +3505,24 @@ void PPPM::slabcorr()
 ------------------------------------------------------------------------- */
 
 int PPPM::timing_1d(int n, double &time1d)
+{
+  if (fft_single_flag) time1d = time_fft_1d(n,work1_single);
+  else time1d = time_fft_1d(n,work1);
+
+  if (differentiation_flag) return 2;
+  return 4;
+}
+
+/* ----------------------------------------------------------------------
+   return time of the 1d FFTs for N timesteps on an FFT grid of type T
+------------------------------------------------------------------------- */
+
+template <class T>
+double PPPM::time_fft_1d(int n, T *work1)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < nwork; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = MPI_Wtime();
@@ -3016,27 +3538,39 @@ int PPPM::timing_1d(int n, double &time1d)
 
   MPI_Barrier(world);
   time2 = MPI_Wtime();
-  time1d = time2 - time1;
+  return time2 - time1;
+}
+
+/* ----------------------------------------------------------------------
+   perform and time the 3d FFTs required for N timesteps
+------------------------------------------------------------------------- */
+
+int PPPM::timing_3d(int n, double &time3d)
+{
+  if (fft_single_flag) time3d = time_fft_3d(n,work1_single,work2_single);
+  else time3d = time_fft_3d(n,work1,work2);
 
   if (differentiation_flag) return 2;
   return 4;
 }
 
 /* ----------------------------------------------------------------------
-   perform and time the 3d FFTs required for N timesteps
+   return time of the 3d FFTs for N timesteps on FFT grids of type T
 ------------------------------------------------------------------------- */
 
-int PPPM::timing_3d(int n, double &time3d)
+template <class T>
+double PPPM::time_fft_3d(int n, T *work1, T *work2)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < nwork; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = MPI_Wtime();
 
   for (int i = 0; i < n; i++) {
-    fft1->compute(work1,work1,FFT3d::FORWARD);
+    if (r2c_flag) fft1->compute(work1,work2,FFT3d::FORWARD);
+    else fft1->compute(work1,work1,FFT3d::FORWARD);
     fft2->compute(work1,work1,FFT3d::BACKWARD);
     if (differentiation_flag != 1) {
       fft2->compute(work1,work1,FFT3d::BACKWARD);
@@ -3046,10 +3580,7 @@ int PPPM::timing_3d(int n, double &time3d)
 
   MPI_Barrier(world);
   time2 = MPI_Wtime();
-  time3d = time2 - time1;
-
-  if (differentiation_flag) return 2;
-  return 4;
+  return time2 - time1;
 }
 
 /* ----------------------------------------------------------------------
@@ -3068,10 +3599,22 @@ double PPPM::memory_usage()
     bytes += (double)4 * nbrick * sizeof(FFT_SCALAR);
   }
 
+  if (gridsort_flag) {
+    bytes += (double)maxsort * sizeof(int);
+    bytes += (double)(ngrid+1) * sizeof(int);
+    if (differentiation_flag == 0)
+      bytes += (double)3 * ngrid * sizeof(FFT_SCALAR);
+  }
+
   if (triclinic) bytes += (double)3 * nfft_both * sizeof(double);
   bytes += (double)6 * nfft_both * sizeof(double);
   bytes += (double)nfft_both * sizeof(double);
-  bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR);
+
+  // FFT grids, float arrays with kspace_modify fft/single
+
+  int fftbytes = fft_single_flag ? sizeof(float) : sizeof(FFT_SCALAR);
+  bytes += (double)nfft_both * fftbytes;
+  bytes += (double)2 * nwork * fftbytes;
 
   if (peratom_allocate_flag)
     bytes += (double)6 * nbrick * sizeof(FFT_SCALAR);
@@ -3105,6 +3648,12 @@ void PPPM::compute_group_group(int groupbit_A, int groupbit_B, int AA_flag)
   if (differentiation_flag)
     error->all(FLERR,"Cannot (yet) use kspace_modify "
                "diff ad with compute group/group");
+  if (r2c_flag)
+    error->all(FLERR,"Cannot (yet) use kspace_modify "
+               "fft/r2c with compute group/group");
+  if (fft_single_flag)
+    error->all(FLERR,"Cannot (yet) use kspace_modify "
+               "fft/single with compute group/group");
 
   if (!group_allocate_flag) allocate_groups();
 
@@ -32,6 +32,15 @@ KSpaceStyle(pppm,PPPM);
 #define LMP_FFT_LIB "KISS FFT"
 #endif
 
+// single precision FFTs of kspace_modify fft/single use KISS FFT
+//   if FFTW3 is not linked with its single precision library
+
+#if defined(FFT_FFTW3) && !defined(FFT_FFTW3F) && !defined(FFT_SINGLE)
+#define LMP_FFT_SINGLE_LIB "KISS FFT"
+#else
+#define LMP_FFT_SINGLE_LIB LMP_FFT_LIB
+#endif
+
 #ifdef FFT_SINGLE
 typedef float FFT_SCALAR;
 #define LMP_FFT_PREC "single"
@@ -77,6 +86,9 @@ class PPPM : public KSpace {
   int nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft;
   int nlower, nupper;
   int ngrid, nfft, nfft_both;
+  int nxhi_kfft, nkfft;    // x extent and # of k-space pts in FFT decomposition
+  int nwork;               // length of FFT work arrays
+  int fft_stride;          // 2 if c2c FFTs return complex data, 1 if c2r
 
   FFT_SCALAR ***density_brick;
   FFT_SCALAR ***vdx_brick, ***vdy_brick, ***vdz_brick;
@@ -86,8 +98,11 @@ class PPPM : public KSpace {
   double *greensfn;
   double **vg;
   double *fkx, *fky, *fkz;
+  double *kxweight;    // 2 for kx modes with implied -kx partner, else 1
   FFT_SCALAR *density_fft;
   FFT_SCALAR *work1, *work2;
+  float *density_fft_single;             // replace density_fft, work1, work2
+  float *work1_single, *work2_single;    //   with kspace_modify fft/single
 
   double *gf_b;
   FFT_SCALAR **rho1d, **rho_coeff, **drho1d, **drho_coeff;
@@ -104,6 +119,7 @@ class PPPM : public KSpace {
 
   FFT_SCALAR *gc_buf1, *gc_buf2;
   int ngc_buf1, ngc_buf2, npergrid;
+  int rho2fft;    // 1 if reverse comm of density also sums into density_fft
 
   // group-group interactions
 
@@ -114,6 +130,14 @@ class PPPM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  // grid-sorted particle mapping
+
+  int *gridsort;              // local atom indices in grid cell order
+  int *gridcount;             // per grid cell offsets into gridsort
+  int maxsort;                // allocated length of gridsort
+  FFT_SCALAR *vd_brick;       // interleaved vdx,vdy,vdz for sorted ik
+  FFT_SCALAR **rho1d_batch;   // rho1d weights for a batch of atoms
+
   double *boxlo;
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
@@ -139,24 +163,42 @@ class PPPM : public KSpace {
   virtual void compute_gf_ik();
   virtual void compute_gf_ad();
   void compute_sf_precoeff();
+  void r2c_nyquist();
 
   virtual void particle_map();
   virtual void make_rho();
   virtual void brick2fft();
+  void copy_brick2fft();
 
   virtual void poisson();
   virtual void poisson_ik();
   virtual void poisson_ad();
 
+  // FFT grid operations templated on the precision of the FFT grids,
+  //   FFT_SCALAR or float with kspace_modify fft/single
+
+  template <class T> void copy_brick2fft(T *);
+  template <class T> void poisson_ik(T *, T *, T *);
+  template <class T> void poisson_ad(T *, T *, T *);
+  template <class T> void poisson_peratom(T *, T *);
+  template <class T> void poisson_ik_triclinic(T *, T *);
+  template <class T> double time_fft_1d(int, T *);
+  template <class T> double time_fft_3d(int, T *, T *);
+
   virtual void fieldforce();
   virtual void fieldforce_ik();
   virtual void fieldforce_ad();
 
+  void sort_grid();
+  void make_rho_sorted();
+  void fieldforce_ik_sorted();
+
   virtual void poisson_peratom();
   virtual void fieldforce_peratom();
   void procs2grid2d(int, int, int, int *, int *);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
   void compute_drho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
+  void compute_rho1d_batch(const FFT_SCALAR *, const FFT_SCALAR *, const FFT_SCALAR *);
   void compute_rho_coeff();
   virtual void slabcorr();
 
@@ -172,7 +214,6 @@ class PPPM : public KSpace {
   int triclinic;    // domain settings, orthog or triclinic
   void setup_triclinic();
   void compute_gf_ik_triclinic();
-  void poisson_ik_triclinic();
   void poisson_groups_triclinic();
 
   // group-group interactions
@@ -234,6 +275,10 @@ E: Cannot (yet) use PPPM with triclinic box and slab correction
 
 This feature is not yet supported.
 
+E: Cannot (yet) use PPPM with triclinic box and kspace_modify fft/r2c
+
+This feature is not yet supported.
+
 E: Cannot use PPPM with 2d simulation
 
 The kspace style pppm cannot be used in 2d simulations.  You can use
@@ -352,6 +397,14 @@ E: Cannot (yet) use kspace_modify diff ad with compute group/group
 
 This option is not yet supported.
 
+E: Cannot (yet) use kspace_modify fft/r2c with compute group/group
+
+This option is not yet supported.
+
+E: Cannot (yet) use kspace_modify fft/single with compute group/group
+
+This option is not yet supported.
+
 U: Cannot (yet) use PPPM with triclinic box and TIP4P
 
 This feature is not yet supported.
@@ -52,6 +52,7 @@ PPPMCG::PPPMCG(LAMMPS *lmp) : PPPM(lmp),
 {
   num_charged = -1;
   group_group_enable = 1;
+  gridsort_support = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -47,6 +47,7 @@ using namespace MathSpecial;
 
 enum{REVERSE_MU};
 enum{FORWARD_MU,FORWARD_MU_PERATOM};
+enum{OP_FIELD,OP_GRADIENT,OP_VIRIAL};
 
 #ifdef FFT_SINGLE
 #define ZEROF 0.0f
@@ -76,6 +77,9 @@ PPPMDipole::PPPMDipole(LAMMPS *lmp) : PPPM(lmp),
 {
   dipoleflag = 1;
   group_group_enable = 0;
+  r2c_support = 1;
+  gridsort_support = 0;
+  fft_single_support = 0;
 
   gc_dipole = nullptr;
 }
@@ -326,7 +330,7 @@ void PPPMDipole::setup()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++) {
     for (j = nylo_fft; j <= nyhi_fft; j++) {
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         sqk = fkx[i]*fkx[i] + fky[j]*fky[j] + fkz[k]*fkz[k];
         if (sqk == 0.0) {
           vg[n][0] = 0.0;
@@ -542,11 +546,17 @@ void PPPMDipole::allocate()
   memory->create(densityz_fft_dipole,nfft_both,"pppm_dipole:densityz_fft_dipole");
 
   memory->create(greensfn,nfft_both,"pppm_dipole:greensfn");
-  memory->create(work1,2*nfft_both,"pppm_dipole:work1");
-  memory->create(work2,2*nfft_both,"pppm_dipole:work2");
-  memory->create(work3,2*nfft_both,"pppm_dipole:work3");
-  memory->create(work4,2*nfft_both,"pppm_dipole:work4");
+  memory->create(work1,nwork,"pppm_dipole:work1");
+  memory->create(work2,nwork,"pppm_dipole:work2");
+  memory->create(work3,nwork,"pppm_dipole:work3");
+  memory->create(work4,nwork,"pppm_dipole:work4");
   memory->create(vg,nfft_both,6,"pppm_dipole:vg");
+  memory->create1d_offset(kxweight,nxlo_fft,nxhi_kfft,"pppm_dipole:kxweight");
+
+  for (int i = nxlo_fft; i <= nxhi_kfft; i++) {
+    if (r2c_flag && i > 0 && 2*i != nx_pppm) kxweight[i] = 2.0;
+    else kxweight[i] = 1.0;
+  }
 
   memory->create1d_offset(fkx,nxlo_fft,nxhi_fft,"pppm_dipole:fkx");
   memory->create1d_offset(fky,nylo_fft,nyhi_fft,"pppm_dipole:fky");
@@ -586,18 +596,33 @@ void PPPMDipole::allocate()
   // 1st FFT keeps data in FFT decomposition
   // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
+  // for real-to-complex FFTs, the real data is the input of each plan
+  //   and the half-length complex k-space data in FFT decomposition
+  //   is the output, backward c2r FFTs go from output to input
 
   int tmp;
 
-  fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
-
-  fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+  if (r2c_flag) {
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1);
+
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag,1);
+  } else {
+    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     0,0,&tmp,collective_flag);
+
+    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                     0,0,&tmp,collective_flag);
+  }
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
@@ -646,6 +671,7 @@ void PPPMDipole::deallocate()
 
   memory->destroy(work3);
   memory->destroy(work4);
+  memory->destroy1d_offset(kxweight,nxlo_fft);
 
   delete gc_dipole;
 }
@@ -993,7 +1019,7 @@ void PPPMDipole::compute_gf_dipole()
       lper = l - ny_pppm*(2*l/ny_pppm);
       sny = square(sin(0.5*unitky*lper*yprd/ny_pppm));
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         snx = square(sin(0.5*unitkx*kper*xprd/nx_pppm));
 
@@ -1277,66 +1303,84 @@ void PPPMDipole::brick2fft_dipole()
 
 void PPPMDipole::poisson_ik_dipole()
 {
-  int i,j,k,n,ii;
-  double eng;
+  int i,j,k,n,ii,p,npass;
+  int nyqx,nyqy,nyqz;
+  double eng,wt,fx,fy,fz,sx,sy,sz;
   double wreal,wimg;
 
   // transform dipole density (r -> k)
+  // r2c FFTs take the real density directly
+
+  if (r2c_flag) {
+    fft1->compute(densityx_fft_dipole,work1,FFT3d::FORWARD);
+    fft1->compute(densityy_fft_dipole,work2,FFT3d::FORWARD);
+    fft1->compute(densityz_fft_dipole,work3,FFT3d::FORWARD);
+  } else {
+    n = 0;
+    for (i = 0; i < nfft; i++) {
+      work1[n] = densityx_fft_dipole[i];
+      work1[n+1] = ZEROF;
+      work2[n] = densityy_fft_dipole[i];
+      work2[n+1] = ZEROF;
+      work3[n] = densityz_fft_dipole[i];
+      work3[n+1] = ZEROF;
+      n += 2;
+    }
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n] = densityx_fft_dipole[i];
-    work1[n+1] = ZEROF;
-    work2[n] = densityy_fft_dipole[i];
-    work2[n+1] = ZEROF;
-    work3[n] = densityz_fft_dipole[i];
-    work3[n+1] = ZEROF;
-    n += 2;
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work2,work2,FFT3d::FORWARD);
+    fft1->compute(work3,work3,FFT3d::FORWARD);
   }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
-  fft1->compute(work2,work2,FFT3d::FORWARD);
-  fft1->compute(work3,work3,FFT3d::FORWARD);
-
   // global energy and virial contribution
+  // kxweight = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+  // with r2c FFTs, the partner of a k-space pt with Nyquist components
+  //   has those wavevector components negated, so average over both
 
   double scaleinv = 1.0/(nx_pppm*ny_pppm*nz_pppm);
   double s2 = scaleinv*scaleinv;
 
   if (eflag_global || vflag_global) {
-    if (vflag_global) {
-      n = 0;
-      ii = 0;
-      for (k = nzlo_fft; k <= nzhi_fft; k++)
-        for (j = nylo_fft; j <= nyhi_fft; j++)
-          for (i = nxlo_fft; i <= nxhi_fft; i++) {
-            wreal = (work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-            wimg = (work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-            eng = s2 * greensfn[ii] * (wreal*wreal + wimg*wimg);
-            for (int jj = 0; jj < 6; jj++) virial[jj] += eng*vg[ii][jj];
-            virial[0] += 2.0*s2*greensfn[ii]*fkx[i]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[1] += 2.0*s2*greensfn[ii]*fky[j]*(work2[n]*wreal + work2[n+1]*wimg);
-            virial[2] += 2.0*s2*greensfn[ii]*fkz[k]*(work3[n]*wreal + work3[n+1]*wimg);
-            virial[3] += 2.0*s2*greensfn[ii]*fky[j]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[4] += 2.0*s2*greensfn[ii]*fkz[k]*(work1[n]*wreal + work1[n+1]*wimg);
-            virial[5] += 2.0*s2*greensfn[ii]*fkz[k]*(work2[n]*wreal + work2[n+1]*wimg);
+    n = 0;
+    ii = 0;
+    for (k = nzlo_fft; k <= nzhi_fft; k++) {
+      nyqz = r2c_flag && (2*k == nz_pppm);
+      for (j = nylo_fft; j <= nyhi_fft; j++) {
+        nyqy = r2c_flag && (2*j == ny_pppm);
+        for (i = nxlo_fft; i <= nxhi_kfft; i++) {
+          nyqx = r2c_flag && (2*i == nx_pppm);
+          npass = (nyqx || nyqy || nyqz) ? 2 : 1;
+          wt = s2 * kxweight[i] / npass;
+          for (p = 0; p < npass; p++) {
+            sx = (p && nyqx) ? -1.0 : 1.0;
+            sy = (p && nyqy) ? -1.0 : 1.0;
+            sz = (p && nyqz) ? -1.0 : 1.0;
+            fx = sx*fkx[i];
+            fy = sy*fky[j];
+            fz = sz*fkz[k];
+            wreal = (work1[n]*fx + work2[n]*fy + work3[n]*fz);
+            wimg = (work1[n+1]*fx + work2[n+1]*fy + work3[n+1]*fz);
+            eng = wt * greensfn[ii] * (wreal*wreal + wimg*wimg);
+            if (vflag_global) {
+              virial[0] += eng*vg[ii][0];
+              virial[1] += eng*vg[ii][1];
+              virial[2] += eng*vg[ii][2];
+              virial[3] += eng*sx*sy*vg[ii][3];
+              virial[4] += eng*sx*sz*vg[ii][4];
+              virial[5] += eng*sy*sz*vg[ii][5];
+              virial[0] += 2.0*wt*greensfn[ii]*fx*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[1] += 2.0*wt*greensfn[ii]*fy*(work2[n]*wreal + work2[n+1]*wimg);
+              virial[2] += 2.0*wt*greensfn[ii]*fz*(work3[n]*wreal + work3[n+1]*wimg);
+              virial[3] += 2.0*wt*greensfn[ii]*fy*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[4] += 2.0*wt*greensfn[ii]*fz*(work1[n]*wreal + work1[n+1]*wimg);
+              virial[5] += 2.0*wt*greensfn[ii]*fz*(work2[n]*wreal + work2[n+1]*wimg);
+            }
             if (eflag_global) energy += eng;
-            ii++;
-            n += 2;
-          }
-    } else {
-      n = 0;
-      ii = 0;
-      for (k = nzlo_fft; k <= nzhi_fft; k++)
-        for (j = nylo_fft; j <= nyhi_fft; j++)
-          for (i = nxlo_fft; i <= nxhi_fft; i++) {
-            wreal = (work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
-            wimg = (work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
-            energy +=
-            s2 * greensfn[ii] * (wreal*wreal + wimg*wimg);
-            ii++;
-            n += 2;
           }
+          ii++;
+          n += 2;
+        }
+      }
     }
   }
 
@@ -1344,7 +1388,7 @@ void PPPMDipole::poisson_ik_dipole()
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nkfft; i++) {
     work1[n]   *= scaleinv * greensfn[i];
     work1[n+1] *= scaleinv * greensfn[i];
     work2[n]   *= scaleinv * greensfn[i];
@@ -1366,12 +1410,13 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
         work4[n+1] = fkx[i]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_FIELD,0,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1379,7 +1424,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         ux_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Ey
@@ -1387,12 +1432,13 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
         work4[n+1] = fky[j]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_FIELD,1,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1400,7 +1446,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         uy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Ez
@@ -1408,12 +1454,13 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(work1[n]*fkx[i] + work2[n]*fky[j] + work3[n]*fkz[k]);
         work4[n+1] = fkz[k]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_FIELD,2,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1421,7 +1468,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         uz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vxx
@@ -1429,7 +1476,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fkx[i]*fkx[i]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fkx[i]*fkx[i]*(work1[n]*fkx[i] +
@@ -1437,6 +1484,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,0,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1444,7 +1492,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdxx_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vyy
@@ -1452,7 +1500,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fky[j]*fky[j]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fky[j]*fky[j]*(work1[n]*fkx[i] +
@@ -1460,6 +1508,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,1,1);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1467,7 +1516,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdyy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vzz
@@ -1475,7 +1524,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fkz[k]*fkz[k]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fkz[k]*fkz[k]*(work1[n]*fkx[i] +
@@ -1483,6 +1532,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,2,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1490,7 +1540,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdzz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vxy
@@ -1498,7 +1548,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fkx[i]*fky[j]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fkx[i]*fky[j]*(work1[n]*fkx[i] +
@@ -1506,6 +1556,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,0,1);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1513,7 +1564,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdxy_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vxz
@@ -1521,7 +1572,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fkx[i]*fkz[k]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fkx[i]*fkz[k]*(work1[n]*fkx[i] +
@@ -1529,6 +1580,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,0,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1536,7 +1588,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdxz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // Vyz
@@ -1544,7 +1596,7 @@ void PPPMDipole::poisson_ik_dipole()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = -fky[j]*fkz[k]*(work1[n+1]*fkx[i] +
                                    work2[n+1]*fky[j] + work3[n+1]*fkz[k]);
         work4[n+1] = fky[j]*fkz[k]*(work1[n]*fkx[i] +
@@ -1552,6 +1604,7 @@ void PPPMDipole::poisson_ik_dipole()
         n += 2;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_GRADIENT,1,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1559,7 +1612,7 @@ void PPPMDipole::poisson_ik_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdyz_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 }
 
@@ -1581,7 +1634,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
         work4[n+1] = fkx[i]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1590,6 +1643,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1597,7 +1651,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V0y
@@ -1606,7 +1660,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
         work4[n+1] = fky[j]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1615,6 +1669,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1622,7 +1677,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V0z
@@ -1631,7 +1686,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][0]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkx[i]*work1[n]);
         work4[n+1] = fkz[k]*(vg[ii][0]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1640,6 +1695,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,0);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1647,7 +1703,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V1x
@@ -1656,7 +1712,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
         work4[n+1] = fkx[i]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1665,6 +1721,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,1);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1672,7 +1729,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V1y
@@ -1681,7 +1738,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
         work4[n+1] = fky[j]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1690,6 +1747,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,1);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1697,7 +1755,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V1z
@@ -1706,7 +1764,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][1]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work2[n]);
         work4[n+1] = fkz[k]*(vg[ii][1]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1715,6 +1773,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,1);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1722,7 +1781,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V2x
@@ -1731,7 +1790,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
         work4[n+1] = fkx[i]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1740,6 +1799,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1747,7 +1807,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V2y
@@ -1756,7 +1816,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
         work4[n+1] = fky[j]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1765,6 +1825,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1772,7 +1833,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V2z
@@ -1781,7 +1842,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][2]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work3[n]);
         work4[n+1] = fkz[k]*(vg[ii][2]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1790,6 +1851,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,2);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1797,7 +1859,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V3x
@@ -1806,7 +1868,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
         work4[n+1] = fkx[i]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1815,6 +1877,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,3);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1822,7 +1885,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V3y
@@ -1831,7 +1894,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
         work4[n+1] = fky[j]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1840,6 +1903,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,3);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1847,7 +1911,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V3z
@@ -1856,7 +1920,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][3]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fky[j]*work1[n]);
         work4[n+1] = fkz[k]*(vg[ii][3]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1865,6 +1929,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,3);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1872,7 +1937,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V4x
@@ -1881,7 +1946,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
         work4[n+1] = fkx[i]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1890,6 +1955,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,4);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1897,7 +1963,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V4y
@@ -1906,7 +1972,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
         work4[n+1] = fky[j]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1915,6 +1981,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,4);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1922,7 +1989,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V4z
@@ -1931,7 +1998,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][4]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work1[n]);
         work4[n+1] = fkz[k]*(vg[ii][4]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1940,6 +2007,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,4);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1947,7 +2015,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V5x
@@ -1956,7 +2024,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkx[i]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
         work4[n+1] = fkx[i]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1965,6 +2033,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,0,5);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1972,7 +2041,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5x_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V5y
@@ -1981,7 +2050,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fky[j]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
         work4[n+1] = fky[j]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -1990,6 +2059,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,1,5);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -1997,7 +2067,7 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5y_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 
   // V5z
@@ -2006,7 +2076,7 @@ void PPPMDipole::poisson_peratom_dipole()
   ii = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kfft; i++) {
         work4[n] = fkz[k]*(vg[ii][5]*(work1[n]*fkx[i] + work2[n]*fky[j] +
                                       work3[n]*fkz[k]) + 2.0*fkz[k]*work2[n]);
         work4[n+1] = fkz[k]*(vg[ii][5]*(work1[n+1]*fkx[i] + work2[n+1]*fky[j] +
@@ -2015,6 +2085,7 @@ void PPPMDipole::poisson_peratom_dipole()
         ii++;
       }
 
+  if (r2c_flag) r2c_nyquist_dipole(OP_VIRIAL,2,5);
   fft2->compute(work4,work4,FFT3d::BACKWARD);
 
   n = 0;
@@ -2022,10 +2093,70 @@ void PPPMDipole::poisson_peratom_dipole()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5z_brick_dipole[k][j][i] = work4[n];
-        n += 2;
+        n += fft_stride;
       }
 }
 
+/* ----------------------------------------------------------------------
+   r2c FFTs store only kx = 0 to nx/2, c2r FFTs take the data at -k to be
+     the complex conjugate of the data at k
+   the operators are not linear in the wavevector, so at k-space pts with
+     Nyquist components, where -k has those components of k negated,
+     the c2c result is the average of the operator for k and -k
+   replace the operator in work4 at those pts by this average
+   op = OP_FIELD: f_a (f.mu), OP_GRADIENT: i f_a f_b (f.mu),
+   OP_VIRIAL: f_a (vg_b (f.mu) + 2 f_p mu_q) for per-atom virial component b
+------------------------------------------------------------------------- */
+
+void PPPMDipole::r2c_nyquist_dipole(int op, int a, int b)
+{
+  int i,j,k,n,ii;
+  int nyqx,nyqy,nyqz;
+  double f[3],vgb,wreal,wimg,opreal,opimg;
+  FFT_SCALAR *mu[3] = {work1,work2,work3};
+
+  // components p,q of the 2 f_p mu_q term of per-atom virial component b
+
+  static const int vp[6] = {0,1,2,1,2,2};
+  static const int vq[6] = {0,1,2,0,0,1};
+
+  ii = 0;
+  for (k = nzlo_fft; k <= nzhi_fft; k++) {
+    nyqz = (2*k == nz_pppm);
+    for (j = nylo_fft; j <= nyhi_fft; j++) {
+      nyqy = (2*j == ny_pppm);
+      for (i = nxlo_fft; i <= nxhi_kfft; i++, ii++) {
+        nyqx = (2*i == nx_pppm);
+        if (!nyqx && !nyqy && !nyqz) continue;
+
+        f[0] = nyqx ? -fkx[i] : fkx[i];
+        f[1] = nyqy ? -fky[j] : fky[j];
+        f[2] = nyqz ? -fkz[k] : fkz[k];
+        n = 2*ii;
+        wreal = work1[n]*f[0] + work2[n]*f[1] + work3[n]*f[2];
+        wimg = work1[n+1]*f[0] + work2[n+1]*f[1] + work3[n+1]*f[2];
+
+        if (op == OP_FIELD) {
+          opreal = f[a]*wreal;
+          opimg = f[a]*wimg;
+        } else if (op == OP_GRADIENT) {
+          opreal = -f[a]*f[b]*wimg;
+          opimg = f[a]*f[b]*wreal;
+        } else {
+          vgb = vg[ii][b];
+          if ((b == 3 && nyqx != nyqy) || (b == 4 && nyqx != nyqz) ||
+              (b == 5 && nyqy != nyqz)) vgb = -vgb;
+          opreal = f[a]*(vgb*wreal + 2.0*f[vp[b]]*mu[vq[b]][n]);
+          opimg = f[a]*(vgb*wimg + 2.0*f[vp[b]]*mu[vq[b]][n+1]);
+        }
+
+        work4[n] = 0.5*(work4[n] + opreal);
+        work4[n+1] = 0.5*(work4[n+1] + opimg);
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get electric field & force on my particles for ik
 ------------------------------------------------------------------------- */
@@ -2440,7 +2571,7 @@ int PPPMDipole::timing_1d(int n, double &time1d)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < nwork; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = MPI_Wtime();
@@ -2475,15 +2606,21 @@ int PPPMDipole::timing_3d(int n, double &time3d)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < nwork; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = MPI_Wtime();
 
   for (int i = 0; i < n; i++) {
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
-    fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
+    if (r2c_flag) {
+      fft1->compute(work1,work2,FFT3d::FFT3d::FORWARD);
+      fft1->compute(work1,work2,FFT3d::FFT3d::FORWARD);
+      fft1->compute(work1,work2,FFT3d::FFT3d::FORWARD);
+    } else {
+      fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
+      fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
+      fft1->compute(work1,work1,FFT3d::FFT3d::FORWARD);
+    }
     fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
     fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
     fft2->compute(work1,work1,FFT3d::FFT3d::BACKWARD);
@@ -2514,9 +2651,9 @@ double PPPMDipole::memory_usage()
     (nzhi_out-nzlo_out+1);
   bytes += (double)6 * nfft_both * sizeof(double);   // vg
   bytes += (double)nfft_both * sizeof(double);       // greensfn
-  bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR); // work*2*2
   bytes += (double)9 * nbrick * sizeof(FFT_SCALAR);  // ubrick*3 + vdbrick*6
-  bytes += (double)nfft_both*7 * sizeof(FFT_SCALAR); // density_ffx*3 + work*2*2
+  bytes += (double)nfft_both*3 * sizeof(FFT_SCALAR); // density_fft*3
+  bytes += (double)nwork*4 * sizeof(FFT_SCALAR);     // work*4
 
   if (peratom_allocate_flag)
     bytes += (double)21 * nbrick * sizeof(FFT_SCALAR);
@@ -85,6 +85,7 @@ class PPPMDipole : public PPPM {
   void brick2fft_dipole();
   void poisson_ik_dipole();
   void poisson_peratom_dipole();
+  void r2c_nyquist_dipole(int, int, int);
   void fieldforce_ik_dipole();
   void fieldforce_peratom_dipole();
   double final_accuracy_dipole();
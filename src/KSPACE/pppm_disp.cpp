@@ -109,6 +109,7 @@ PPPMDisp::PPPMDisp(LAMMPS *lmp) : KSpace(lmp),
    part2grid(nullptr), part2grid_6(nullptr), boxlo(nullptr)
 {
   triclinic_support = 0;
+  r2c_support = 1;
   pppmflag = dispersionflag = 1;
 
   nfactors = 3;
@@ -120,6 +121,8 @@ PPPMDisp::PPPMDisp(LAMMPS *lmp) : KSpace(lmp),
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
   nfft_both = nfft_both_6 = 0;
+  nkfft = nkfft_6 = 0;
+  r2c_flag_6 = 0;
   nxhi_in = nxlo_in = nxhi_out = nxlo_out = 0;
   nyhi_in = nylo_in = nyhi_out = nylo_out = 0;
   nzhi_in = nzlo_in = nzhi_out = nzlo_out = 0;
@@ -577,6 +580,7 @@ void PPPMDisp::init()
 
   // allocate K-space dependent memory
 
+  set_kfft();
   allocate();
 
   // pre-compute Green's function denomiator expansion
@@ -588,7 +592,7 @@ void PPPMDisp::init()
     if (differentiation_flag == 1)
       compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,
                           nxlo_fft,nylo_fft,nzlo_fft,
-                          nxhi_fft,nyhi_fft,nzhi_fft,
+                          nxhi_kfft,nyhi_fft,nzhi_fft,r2c_flag,
                           sf_precoeff1,sf_precoeff2,sf_precoeff3,
                           sf_precoeff4,sf_precoeff5,sf_precoeff6);
   }
@@ -598,7 +602,7 @@ void PPPMDisp::init()
     if (differentiation_flag == 1)
       compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,
                           nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
-                          nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
+                          nxhi_kfft_6,nyhi_fft_6,nzhi_fft_6,r2c_flag_6,
                           sf_precoeff1_6,sf_precoeff2_6,sf_precoeff3_6,
                           sf_precoeff4_6,sf_precoeff5_6,sf_precoeff6_6);
   }
@@ -681,7 +685,7 @@ void PPPMDisp::setup()
     n = 0;
     for (k = nzlo_fft; k <= nzhi_fft; k++) {
       for (j = nylo_fft; j <= nyhi_fft; j++) {
-        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+        for (i = nxlo_fft; i <= nxhi_kfft; i++) {
           sqk = fkx[i]*fkx[i] + fky[j]*fky[j] + fkz[k]*fkz[k];
           if (sqk == 0.0) {
             vg[n][0] = 0.0;
@@ -750,7 +754,7 @@ void PPPMDisp::setup()
     n = 0;
     for (k = nzlo_fft_6; k <= nzhi_fft_6; k++) {
       for (j = nylo_fft_6; j <= nyhi_fft_6; j++) {
-        for (i = nxlo_fft_6; i <= nxhi_fft_6; i++) {
+        for (i = nxlo_fft_6; i <= nxhi_kfft_6; i++) {
           sqk = fkx_6[i]*fkx_6[i] + fky_6[j]*fky_6[j] + fkz_6[k]*fkz_6[k];
           if (sqk == 0.0) {
             vg_6[n][0] = 0.0;
@@ -833,6 +837,7 @@ void PPPMDisp::setup_grid()
   // check if grid communication is now overlapping if not allowed
   // don't invoke allocate_peratom(), compute() will allocate when needed
 
+  set_kfft();
   allocate();
 
   if (function[0]) {
@@ -855,7 +860,7 @@ void PPPMDisp::setup_grid()
     if (differentiation_flag == 1)
       compute_sf_precoeff(nx_pppm,ny_pppm,nz_pppm,order,
                           nxlo_fft,nylo_fft,nzlo_fft,
-                          nxhi_fft,nyhi_fft,nzhi_fft,
+                          nxhi_kfft,nyhi_fft,nzhi_fft,r2c_flag,
                           sf_precoeff1,sf_precoeff2,sf_precoeff3,
                           sf_precoeff4,sf_precoeff5,sf_precoeff6);
   }
@@ -865,7 +870,7 @@ void PPPMDisp::setup_grid()
     if (differentiation_flag == 1)
       compute_sf_precoeff(nx_pppm_6,ny_pppm_6,nz_pppm_6,order_6,
                           nxlo_fft_6,nylo_fft_6,nzlo_fft_6,
-                          nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
+                          nxhi_kfft_6,nyhi_fft_6,nzhi_fft_6,r2c_flag_6,
                           sf_precoeff1_6,sf_precoeff2_6,sf_precoeff3_6,
                           sf_precoeff4_6,sf_precoeff5_6,sf_precoeff6_6);
   }
@@ -937,7 +942,7 @@ void PPPMDisp::compute(int eflag, int vflag)
               density_brick,density_fft,work1,remap);
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1,work2,density_fft,fft1,fft2,
+      poisson_ad(work1,work2,density_fft,fft1,fft2,r2c_flag,
                  nx_pppm,ny_pppm,nz_pppm,nfft,
                  nxlo_fft,nylo_fft,nzlo_fft,nxhi_fft,nyhi_fft,nzhi_fft,
                  nxlo_in,nylo_in,nzlo_in,nxhi_in,nyhi_in,nzhi_in,
@@ -955,7 +960,7 @@ void PPPMDisp::compute(int eflag, int vflag)
                                 gc_buf1,gc_buf2,MPI_FFT_SCALAR);
 
     } else {
-      poisson_ik(work1,work2,density_fft,fft1,fft2,
+      poisson_ik(work1,work2,density_fft,fft1,fft2,r2c_flag,
                  nx_pppm,ny_pppm,nz_pppm,nfft,
                  nxlo_fft,nylo_fft,nzlo_fft,nxhi_fft,nyhi_fft,nzhi_fft,
                  nxlo_in,nylo_in,nzlo_in,nxhi_in,nyhi_in,nzhi_in,
@@ -995,7 +1000,7 @@ void PPPMDisp::compute(int eflag, int vflag)
               density_brick_g,density_fft_g,work1_6,remap_6);
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1_6,work2_6,density_fft_g,fft1_6,fft2_6,
+      poisson_ad(work1_6,work2_6,density_fft_g,fft1_6,fft2_6,r2c_flag_6,
                  nx_pppm_6,ny_pppm_6,nz_pppm_6,nfft_6,
                  nxlo_fft_6,nylo_fft_6,nzlo_fft_6,nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                  nxlo_in_6,nylo_in_6,nzlo_in_6,nxhi_in_6,nyhi_in_6,nzhi_in_6,
@@ -1014,7 +1019,7 @@ void PPPMDisp::compute(int eflag, int vflag)
                                  gc6_buf1,gc6_buf2,MPI_FFT_SCALAR);
 
     } else {
-      poisson_ik(work1_6,work2_6,density_fft_g,fft1_6,fft2_6,
+      poisson_ik(work1_6,work2_6,density_fft_g,fft1_6,fft2_6,r2c_flag_6,
                  nx_pppm_6,ny_pppm_6,nz_pppm_6,nfft_6,
                  nxlo_fft_6,nylo_fft_6,nzlo_fft_6,nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                  nxlo_in_6,nylo_in_6,nzlo_in_6,nxhi_in_6,nyhi_in_6,nzhi_in_6,
@@ -1054,7 +1059,7 @@ void PPPMDisp::compute(int eflag, int vflag)
     brick2fft_a();
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1_6,work2_6,density_fft_a3,fft1_6,fft2_6,
+      poisson_ad(work1_6,work2_6,density_fft_a3,fft1_6,fft2_6,r2c_flag_6,
                  nx_pppm_6,ny_pppm_6,nz_pppm_6,nfft_6,
                  nxlo_fft_6,nylo_fft_6,nzlo_fft_6,nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                  nxlo_in_6,nylo_in_6,nzlo_in_6,nxhi_in_6,nyhi_in_6,nzhi_in_6,
@@ -1088,7 +1093,7 @@ void PPPMDisp::compute(int eflag, int vflag)
                                  gc6_buf1,gc6_buf2,MPI_FFT_SCALAR);
 
     }  else {
-      poisson_ik(work1_6,work2_6,density_fft_a3,fft1_6,fft2_6,
+      poisson_ik(work1_6,work2_6,density_fft_a3,fft1_6,fft2_6,r2c_flag_6,
                  nx_pppm_6,ny_pppm_6,nz_pppm_6,nfft_6,
                  nxlo_fft_6,nylo_fft_6,nzlo_fft_6,nxhi_fft_6,nyhi_fft_6,nzhi_fft_6,
                  nxlo_in_6,nylo_in_6,nzlo_in_6,nxhi_in_6,nyhi_in_6,nzhi_in_6,
@@ -1738,17 +1743,33 @@ void _noopt PPPMDisp::allocate()
     }
     memory->create(density_fft,nfft_both,"pppm/disp:density_fft");
 
+    // r2c FFTs transform real density_fft values to half-length complex
+    // fft2 maps them back (c2r) to real values in the brick decomposition,
+    //   so it is set up with the brick as real input and k-space as output
+
     int tmp;
 
-    fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     0,0,&tmp,collective_flag);
+    if (r2c_flag) {
+      fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag,1);
 
-    fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                     0,0,&tmp,collective_flag);
+      fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                       nxlo_fft,nxhi_kfft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag,1);
+    } else {
+      fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       0,0,&tmp,collective_flag);
+
+      fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
+                       nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                       0,0,&tmp,collective_flag);
+    }
 
     remap = new Remap(lmp,world,
                       nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
@@ -1820,17 +1841,31 @@ void _noopt PPPMDisp::allocate()
 
     int tmp;
 
-    fft1_6 =
-      new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                0,0,&tmp,collective_flag);
+    if (r2c_flag_6) {
+      fft1_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_fft_6,nxhi_kfft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag,1);
+
+      fft2_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  nxlo_fft_6,nxhi_kfft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag,1);
+    } else {
+      fft1_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  0,0,&tmp,collective_flag);
 
-    fft2_6 =
-      new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
-                nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
-                nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
-                0,0,&tmp,collective_flag);
+      fft2_6 =
+        new FFT3d(lmp,world,nx_pppm_6,ny_pppm_6,nz_pppm_6,
+                  nxlo_fft_6,nxhi_fft_6,nylo_fft_6,nyhi_fft_6,nzlo_fft_6,nzhi_fft_6,
+                  nxlo_in_6,nxhi_in_6,nylo_in_6,nyhi_in_6,nzlo_in_6,nzhi_in_6,
+                  0,0,&tmp,collective_flag);
+    }
 
     remap_6 =
       new Remap(lmp,world,
@@ -2844,6 +2879,32 @@ void PPPMDisp::set_fft_parameters(int& nx_p, int& ny_p, int& nz_p,
   nfb = MAX(nf,nfft_brick);
 }
 
+/* ----------------------------------------------------------------------
+   set k-space extent of the FFT decompositions
+   r2c FFTs only keep kx = 0 to nx/2 of each x-pencil
+   arithmetic and no mixing pack 2 dispersion densities into one
+     complex FFT, so the dispersion grid keeps c2c FFTs for those
+------------------------------------------------------------------------- */
+
+void PPPMDisp::set_kfft()
+{
+  r2c_flag_6 = r2c_flag && !function[2] && !function[3];
+
+  if (function[0]) {
+    if (r2c_flag) nxhi_kfft = nx_pppm/2;
+    else nxhi_kfft = nxhi_fft;
+    nkfft = (nxhi_kfft-nxlo_fft+1) * (nyhi_fft-nylo_fft+1) *
+      (nzhi_fft-nzlo_fft+1);
+  }
+
+  if (function[1] + function[2] + function[3]) {
+    if (r2c_flag_6) nxhi_kfft_6 = nx_pppm_6/2;
+    else nxhi_kfft_6 = nxhi_fft_6;
+    nkfft_6 = (nxhi_kfft_6-nxlo_fft_6+1) * (nyhi_fft_6-nylo_fft_6+1) *
+      (nzhi_fft_6-nzlo_fft_6+1);
+  }
+}
+
 /* ----------------------------------------------------------------------
    check if all factors of n are in list of factors
    return 1 if yes, 0 if no
@@ -3794,7 +3855,7 @@ void PPPMDisp::compute_gf()
       if (argy != 0.0) wy = pow(sin(argy)/argy,order);
       wy *= wy;
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         qx = unitkx*kper;
         snx = sin(0.5*qx*xprd/nx_pppm);
@@ -3824,7 +3885,7 @@ void PPPMDisp::compute_gf()
 
 void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
                                    int nxlo_ft, int nylo_ft, int nzlo_ft,
-                                   int nxhi_ft, int nyhi_ft, int nzhi_ft,
+                                   int nxhi_ft, int nyhi_ft, int nzhi_ft, int r2c,
                                    double *sf_pre1, double *sf_pre2, double *sf_pre3,
                                    double *sf_pre4, double *sf_pre5, double *sf_pre6)
 {
@@ -3847,7 +3908,7 @@ void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
   double unitky = (2.0*MY_PI/yprd);
   double unitkz = (2.0*MY_PI/zprd_slab);
 
-  int nx,ny,nz,kper,lper,mper;
+  int nx,ny,nz,kper,lper,mper,kp,lp,mp,isym,nsym;
   double argx,argy,argz;
   double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
   double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
@@ -3867,69 +3928,94 @@ void PPPMDisp::compute_sf_precoeff(int nxp, int nyp, int nzp, int ord,
         kper = k - nxp*(2*k/nxp);
 
         sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
-        for (i = -nb; i <= nb; i++) {
-
-          qx0 = unitkx*(kper+nxp*i);
-          qx1 = unitkx*(kper+nxp*(i+1));
-          qx2 = unitkx*(kper+nxp*(i+2));
-          wx0[i+2] = 1.0;
-          wx1[i+2] = 1.0;
-          wx2[i+2] = 1.0;
-          argx = 0.5*qx0*xprd/nxp;
-          if (argx != 0.0) wx0[i+2] = pow(sin(argx)/argx,ord);
-          argx = 0.5*qx1*xprd/nxp;
-          if (argx != 0.0) wx1[i+2] = pow(sin(argx)/argx,ord);
-          argx = 0.5*qx2*xprd/nxp;
-          if (argx != 0.0) wx2[i+2] = pow(sin(argx)/argx,ord);
-
-          qy0 = unitky*(lper+nyp*i);
-          qy1 = unitky*(lper+nyp*(i+1));
-          qy2 = unitky*(lper+nyp*(i+2));
-          wy0[i+2] = 1.0;
-          wy1[i+2] = 1.0;
-          wy2[i+2] = 1.0;
-          argy = 0.5*qy0*yprd/nyp;
-          if (argy != 0.0) wy0[i+2] = pow(sin(argy)/argy,ord);
-          argy = 0.5*qy1*yprd/nyp;
-          if (argy != 0.0) wy1[i+2] = pow(sin(argy)/argy,ord);
-          argy = 0.5*qy2*yprd/nyp;
-          if (argy != 0.0) wy2[i+2] = pow(sin(argy)/argy,ord);
-
-          qz0 = unitkz*(mper+nzp*i);
-          qz1 = unitkz*(mper+nzp*(i+1));
-          qz2 = unitkz*(mper+nzp*(i+2));
-          wz0[i+2] = 1.0;
-          wz1[i+2] = 1.0;
-          wz2[i+2] = 1.0;
-          argz = 0.5*qz0*zprd_slab/nzp;
-          if (argz != 0.0) wz0[i+2] = pow(sin(argz)/argz,ord);
-          argz = 0.5*qz1*zprd_slab/nzp;
-          if (argz != 0.0) wz1[i+2] = pow(sin(argz)/argz,ord);
-           argz = 0.5*qz2*zprd_slab/nzp;
-          if (argz != 0.0) wz2[i+2] = pow(sin(argz)/argz,ord);
-        }
 
-        for (nx = 0; nx <= 4; nx++) {
-          for (ny = 0; ny <= 4; ny++) {
-            for (nz = 0; nz <= 4; nz++) {
-              u0 = wx0[nx]*wy0[ny]*wz0[nz];
-              u1 = wx1[nx]*wy0[ny]*wz0[nz];
-              u2 = wx2[nx]*wy0[ny]*wz0[nz];
-              u3 = wx0[nx]*wy1[ny]*wz0[nz];
-              u4 = wx0[nx]*wy2[ny]*wz0[nz];
-              u5 = wx0[nx]*wy0[ny]*wz1[nz];
-              u6 = wx0[nx]*wy0[ny]*wz2[nz];
-
-              sum1 += u0*u1;
-              sum2 += u0*u2;
-              sum3 += u0*u3;
-              sum4 += u0*u4;
-              sum5 += u0*u5;
-              sum6 += u0*u6;
+        // r2c FFTs store k but not -k, so average over both grid pts
+        // Nyquist indices are their own partner
+
+        nsym = r2c ? 2 : 1;
+        for (isym = 0; isym < nsym; isym++) {
+          kp = kper;
+          lp = lper;
+          mp = mper;
+          if (isym) {
+            if (2*k != nxp) kp = -kper;
+            if (2*l != nyp) lp = -lper;
+            if (2*m != nzp) mp = -mper;
+          }
+
+          for (i = -nb; i <= nb; i++) {
+
+            qx0 = unitkx*(kp+nxp*i);
+            qx1 = unitkx*(kp+nxp*(i+1));
+            qx2 = unitkx*(kp+nxp*(i+2));
+            wx0[i+2] = 1.0;
+            wx1[i+2] = 1.0;
+            wx2[i+2] = 1.0;
+            argx = 0.5*qx0*xprd/nxp;
+            if (argx != 0.0) wx0[i+2] = pow(sin(argx)/argx,ord);
+            argx = 0.5*qx1*xprd/nxp;
+            if (argx != 0.0) wx1[i+2] = pow(sin(argx)/argx,ord);
+            argx = 0.5*qx2*xprd/nxp;
+            if (argx != 0.0) wx2[i+2] = pow(sin(argx)/argx,ord);
+
+            qy0 = unitky*(lp+nyp*i);
+            qy1 = unitky*(lp+nyp*(i+1));
+            qy2 = unitky*(lp+nyp*(i+2));
+            wy0[i+2] = 1.0;
+            wy1[i+2] = 1.0;
+            wy2[i+2] = 1.0;
+            argy = 0.5*qy0*yprd/nyp;
+            if (argy != 0.0) wy0[i+2] = pow(sin(argy)/argy,ord);
+            argy = 0.5*qy1*yprd/nyp;
+            if (argy != 0.0) wy1[i+2] = pow(sin(argy)/argy,ord);
+            argy = 0.5*qy2*yprd/nyp;
+            if (argy != 0.0) wy2[i+2] = pow(sin(argy)/argy,ord);
+
+            qz0 = unitkz*(mp+nzp*i);
+            qz1 = unitkz*(mp+nzp*(i+1));
+            qz2 = unitkz*(mp+nzp*(i+2));
+            wz0[i+2] = 1.0;
+            wz1[i+2] = 1.0;
+            wz2[i+2] = 1.0;
+            argz = 0.5*qz0*zprd_slab/nzp;
+            if (argz != 0.0) wz0[i+2] = pow(sin(argz)/argz,ord);
+            argz = 0.5*qz1*zprd_slab/nzp;
+            if (argz != 0.0) wz1[i+2] = pow(sin(argz)/argz,ord);
+            argz = 0.5*qz2*zprd_slab/nzp;
+            if (argz != 0.0) wz2[i+2] = pow(sin(argz)/argz,ord);
+          }
+
+          for (nx = 0; nx <= 4; nx++) {
+            for (ny = 0; ny <= 4; ny++) {
+              for (nz = 0; nz <= 4; nz++) {
+                u0 = wx0[nx]*wy0[ny]*wz0[nz];
+                u1 = wx1[nx]*wy0[ny]*wz0[nz];
+                u2 = wx2[nx]*wy0[ny]*wz0[nz];
+                u3 = wx0[nx]*wy1[ny]*wz0[nz];
+                u4 = wx0[nx]*wy2[ny]*wz0[nz];
+                u5 = wx0[nx]*wy0[ny]*wz1[nz];
+                u6 = wx0[nx]*wy0[ny]*wz2[nz];
+
+                sum1 += u0*u1;
+                sum2 += u0*u2;
+                sum3 += u0*u3;
+                sum4 += u0*u4;
+                sum5 += u0*u5;
+                sum6 += u0*u6;
+              }
             }
           }
         }
 
+        if (r2c) {
+          sum1 *= 0.5;
+          sum2 *= 0.5;
+          sum3 *= 0.5;
+          sum4 *= 0.5;
+          sum5 *= 0.5;
+          sum6 *= 0.5;
+        }
+
         // store values
 
         sf_pre1[n] = sum1;
@@ -4004,7 +4090,7 @@ void PPPMDisp::compute_gf_6()
       if (argy != 0.0) wy = pow(sin(argy)/argy,order_6);
       wy *= wy;
 
-      for (k = nxlo_fft_6; k <= nxhi_fft_6; k++) {
+      for (k = nxlo_fft_6; k <= nxhi_kfft_6; k++) {
         kper = k - nx_pppm_6*(2*k/nx_pppm_6);
         qx = unitkx*kper;
         snx = sin(0.5*unitkx*kper*xprd/nx_pppm_6);
@@ -4050,16 +4136,21 @@ void PPPMDisp::compute_sf_coeff()
 
   for (i = 0; i <= 5; i++) sf_coeff[i] = 0.0;
 
+  // kxw = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+
+  double kxw;
+
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
     for (l = nylo_fft; l <= nyhi_fft; l++) {
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
-        sf_coeff[0] += sf_precoeff1[n]*greensfn[n];
-        sf_coeff[1] += sf_precoeff2[n]*greensfn[n];
-        sf_coeff[2] += sf_precoeff3[n]*greensfn[n];
-        sf_coeff[3] += sf_precoeff4[n]*greensfn[n];
-        sf_coeff[4] += sf_precoeff5[n]*greensfn[n];
-        sf_coeff[5] += sf_precoeff6[n]*greensfn[n];
+      for (k = nxlo_fft; k <= nxhi_kfft; k++) {
+        kxw = (r2c_flag && k > 0 && 2*k != nx_pppm) ? 2.0 : 1.0;
+        sf_coeff[0] += kxw*sf_precoeff1[n]*greensfn[n];
+        sf_coeff[1] += kxw*sf_precoeff2[n]*greensfn[n];
+        sf_coeff[2] += kxw*sf_precoeff3[n]*greensfn[n];
+        sf_coeff[3] += kxw*sf_precoeff4[n]*greensfn[n];
+        sf_coeff[4] += kxw*sf_precoeff5[n]*greensfn[n];
+        sf_coeff[5] += kxw*sf_precoeff6[n]*greensfn[n];
         ++n;
       }
     }
@@ -4107,16 +4198,21 @@ void PPPMDisp::compute_sf_coeff_6()
 
   for (i = 0; i <= 5; i++) sf_coeff_6[i] = 0.0;
 
+  // kxw = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+
+  double kxw;
+
   n = 0;
   for (m = nzlo_fft_6; m <= nzhi_fft_6; m++) {
     for (l = nylo_fft_6; l <= nyhi_fft_6; l++) {
-      for (k = nxlo_fft_6; k <= nxhi_fft_6; k++) {
-        sf_coeff_6[0] += sf_precoeff1_6[n]*greensfn_6[n];
-        sf_coeff_6[1] += sf_precoeff2_6[n]*greensfn_6[n];
-        sf_coeff_6[2] += sf_precoeff3_6[n]*greensfn_6[n];
-        sf_coeff_6[3] += sf_precoeff4_6[n]*greensfn_6[n];
-        sf_coeff_6[4] += sf_precoeff5_6[n]*greensfn_6[n];
-        sf_coeff_6[5] += sf_precoeff6_6[n]*greensfn_6[n];
+      for (k = nxlo_fft_6; k <= nxhi_kfft_6; k++) {
+        kxw = (r2c_flag_6 && k > 0 && 2*k != nx_pppm_6) ? 2.0 : 1.0;
+        sf_coeff_6[0] += kxw*sf_precoeff1_6[n]*greensfn_6[n];
+        sf_coeff_6[1] += kxw*sf_precoeff2_6[n]*greensfn_6[n];
+        sf_coeff_6[2] += kxw*sf_precoeff3_6[n]*greensfn_6[n];
+        sf_coeff_6[3] += kxw*sf_precoeff4_6[n]*greensfn_6[n];
+        sf_coeff_6[4] += kxw*sf_precoeff5_6[n]*greensfn_6[n];
+        sf_coeff_6[5] += kxw*sf_precoeff6_6[n]*greensfn_6[n];
         ++n;
       }
     }
@@ -4580,7 +4676,7 @@ void PPPMDisp::make_rho_none()
 
 void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
                           FFT_SCALAR* dfft, LAMMPS_NS::FFT3d* ft1,
-                          LAMMPS_NS::FFT3d* ft2,
+                          LAMMPS_NS::FFT3d* ft2, int r2c,
                           int nx_p, int ny_p, int nz_p, int nft,
                           int nxlo_ft, int nylo_ft, int nzlo_ft,
                           int nxhi_ft, int nyhi_ft, int nzhi_ft,
@@ -4597,25 +4693,57 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
                           FFT_SCALAR*** v3_pa, FFT_SCALAR*** v4_pa, FFT_SCALAR*** v5_pa)
 
 {
-  int i,j,k,n;
-  double eng;
+  int i,j,k,m,n;
+  double eng,kxw;
+
+  // r2c FFTs only keep kx = 0 to nx/2 of each x-pencil
+
+  const int nxhi_kft = r2c ? nx_p/2 : nxhi_ft;
+  const int nkft = (nxhi_kft-nxlo_ft+1) * (nyhi_ft-nylo_ft+1) * (nzhi_ft-nzlo_ft+1);
 
   // transform charge/dispersion density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nft; i++) {
-    wk1[n++] = dfft[i];
-    wk1[n++] = ZEROF;
-  }
+  if (r2c) ft1->compute(dfft,wk1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nft; i++) {
+      wk1[n++] = dfft[i];
+      wk1[n++] = ZEROF;
+    }
 
-  ft1->compute(wk1,wk1,FFT3d::FORWARD);
+    ft1->compute(wk1,wk1,FFT3d::FORWARD);
+  }
 
   // if requested, compute energy and virial contribution
 
   double scaleinv = 1.0/(nx_p*ny_p*nz_p);
   double s2 = scaleinv*scaleinv;
 
-  if (eflag_global || vflag_global) {
+  if ((eflag_global || vflag_global) && r2c) {
+
+    // kxw = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+    // vcoeff2 holds the off-diagonal virial coeffs averaged over k and -k
+
+    n = 0;
+    m = 0;
+    for (k = nzlo_ft; k <= nzhi_ft; k++)
+      for (j = nylo_ft; j <= nyhi_ft; j++)
+        for (i = nxlo_ft; i <= nxhi_kft; i++) {
+          kxw = (i > 0 && 2*i != nx_p) ? 2.0 : 1.0;
+          eng = s2 * kxw * gfn[m] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+          if (vflag_global) {
+            vir[0] += eng*vcoeff[m][0];
+            vir[1] += eng*vcoeff[m][1];
+            vir[2] += eng*vcoeff[m][2];
+            vir[3] += eng*vcoeff2[m][0];
+            vir[4] += eng*vcoeff2[m][1];
+            vir[5] += eng*vcoeff2[m][2];
+          }
+          if (eflag_global) egy += eng;
+          m++;
+          n += 2;
+        }
+  } else if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
       for (i = 0; i < nft; i++) {
@@ -4638,7 +4766,7 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nft; i++) {
+  for (i = 0; i < nkft; i++) {
     wk1[n++] *= scaleinv * gfn[i];
     wk1[n++] *= scaleinv * gfn[i];
   }
@@ -4647,6 +4775,54 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   // FFT leaves data in 3d brick decomposition
   // copy it into inner portion of vdx,vdy,vdz arrays
 
+  // c2r FFTs return a single real field, so transform each gradient
+  //   and the per-atom energy separately
+  // 0.5*(k-k2) vanishes at Nyquist indices, as in the c2c fields
+
+  if (r2c) {
+    FFT_SCALAR ***v_brick[3] = {vx_brick,vy_brick,vz_brick};
+    double fk;
+
+    for (int d = 0; d < 3; d++) {
+      n = 0;
+      for (k = nzlo_ft; k <= nzhi_ft; k++)
+        for (j = nylo_ft; j <= nyhi_ft; j++)
+          for (i = nxlo_ft; i <= nxhi_kft; i++) {
+            if (d == 0) fk = 0.5*(kx[i]-kx2[i]);
+            else if (d == 1) fk = 0.5*(ky[j]-ky2[j]);
+            else fk = 0.5*(kz[k]-kz2[k]);
+            wk2[n] = -fk*wk1[n+1];
+            wk2[n+1] = fk*wk1[n];
+            n += 2;
+          }
+
+      ft2->compute(wk2,wk2,FFT3d::BACKWARD);
+
+      n = 0;
+      for (k = nzlo_i; k <= nzhi_i; k++)
+        for (j = nylo_i; j <= nyhi_i; j++)
+          for (i = nxlo_i; i <= nxhi_i; i++)
+            v_brick[d][k][j][i] = wk2[n++];
+    }
+
+    if (eflag_atom) {
+      for (i = 0; i < 2*nkft; i++) wk2[i] = wk1[i];
+
+      ft2->compute(wk2,wk2,FFT3d::BACKWARD);
+
+      n = 0;
+      for (k = nzlo_i; k <= nzhi_i; k++)
+        for (j = nylo_i; j <= nyhi_i; j++)
+          for (i = nxlo_i; i <= nxhi_i; i++)
+            u_pa[k][j][i] = wk2[n++];
+    }
+
+    if (vflag_atom) poisson_peratom(wk1,wk2,ft2,r2c,vcoeff,vcoeff2,nkft,
+                                    nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
+                                    v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
+    return;
+  }
+
   // x & y direction gradient
 
   n = 0;
@@ -4714,7 +4890,7 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
         }
   }
 
-  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,vcoeff,vcoeff2,nft,
+  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,r2c,vcoeff,vcoeff2,nkft,
                                   nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
                                   v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
 }
@@ -4725,7 +4901,7 @@ void PPPMDisp::poisson_ik(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
 
 void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
                           FFT_SCALAR* dfft, LAMMPS_NS::FFT3d* ft1,LAMMPS_NS::FFT3d* ft2,
-                          int nx_p, int ny_p, int nz_p, int nft,
+                          int r2c, int nx_p, int ny_p, int nz_p, int nft,
                           int nxlo_ft, int nylo_ft, int nzlo_ft,
                           int nxhi_ft, int nyhi_ft, int nzhi_ft,
                           int nxlo_i, int nylo_i, int nzlo_i,
@@ -4737,25 +4913,57 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
                           FFT_SCALAR*** v3_pa, FFT_SCALAR*** v4_pa,
                           FFT_SCALAR*** v5_pa)
 {
-  int i,j,k,n;
-  double eng;
+  int i,j,k,m,n;
+  double eng,kxw;
+
+  // r2c FFTs only keep kx = 0 to nx/2 of each x-pencil
+
+  const int nxhi_kft = r2c ? nx_p/2 : nxhi_ft;
+  const int nkft = (nxhi_kft-nxlo_ft+1) * (nyhi_ft-nylo_ft+1) * (nzhi_ft-nzlo_ft+1);
 
   // transform charge/dispersion density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nft; i++) {
-    wk1[n++] = dfft[i];
-    wk1[n++] = ZEROF;
-  }
+  if (r2c) ft1->compute(dfft,wk1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nft; i++) {
+      wk1[n++] = dfft[i];
+      wk1[n++] = ZEROF;
+    }
 
-  ft1->compute(wk1,wk1,FFT3d::FORWARD);
+    ft1->compute(wk1,wk1,FFT3d::FORWARD);
+  }
 
   // if requested, compute energy and virial contribution
 
   double scaleinv = 1.0/(nx_p*ny_p*nz_p);
   double s2 = scaleinv*scaleinv;
 
-  if (eflag_global || vflag_global) {
+  if ((eflag_global || vflag_global) && r2c) {
+
+    // kxw = 2 for kx modes whose -kx partner is not stored by r2c FFTs
+    // vcoeff2 holds the off-diagonal virial coeffs averaged over k and -k
+
+    n = 0;
+    m = 0;
+    for (k = nzlo_ft; k <= nzhi_ft; k++)
+      for (j = nylo_ft; j <= nyhi_ft; j++)
+        for (i = nxlo_ft; i <= nxhi_kft; i++) {
+          kxw = (i > 0 && 2*i != nx_p) ? 2.0 : 1.0;
+          eng = s2 * kxw * gfn[m] * (wk1[n]*wk1[n] + wk1[n+1]*wk1[n+1]);
+          if (vflag_global) {
+            vir[0] += eng*vcoeff[m][0];
+            vir[1] += eng*vcoeff[m][1];
+            vir[2] += eng*vcoeff[m][2];
+            vir[3] += eng*vcoeff2[m][0];
+            vir[4] += eng*vcoeff2[m][1];
+            vir[5] += eng*vcoeff2[m][2];
+          }
+          if (eflag_global) egy += eng;
+          m++;
+          n += 2;
+        }
+  } else if (eflag_global || vflag_global) {
     if (vflag_global) {
       n = 0;
       for (i = 0; i < nft; i++) {
@@ -4778,31 +4986,33 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nft; i++) {
+  for (i = 0; i < nkft; i++) {
     wk1[n++] *= scaleinv * gfn[i];
     wk1[n++] *= scaleinv * gfn[i];
   }
 
   n = 0;
-  for (k = nzlo_ft; k <= nzhi_ft; k++)
-    for (j = nylo_ft; j <= nyhi_ft; j++)
-      for (i = nxlo_ft; i <= nxhi_ft; i++) {
-        wk2[n] = wk1[n];
-        wk2[n+1] = wk1[n+1];
-        n += 2;
-     }
+  for (i = 0; i < nkft; i++) {
+    wk2[n] = wk1[n];
+    wk2[n+1] = wk1[n+1];
+    n += 2;
+  }
 
   ft2->compute(wk2,wk2,FFT3d::BACKWARD);
 
+  // c2r FFTs return real values, c2c FFTs interleaved complex values
+
+  const int stride = r2c ? 1 : 2;
+
   n = 0;
   for (k = nzlo_i; k <= nzhi_i; k++)
     for (j = nylo_i; j <= nyhi_i; j++)
       for (i = nxlo_i; i <= nxhi_i; i++) {
         u_pa[k][j][i] = wk2[n];
-        n += 2;
+        n += stride;
       }
 
-  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,vcoeff,vcoeff2,nft,
+  if (vflag_atom) poisson_peratom(wk1,wk2,ft2,r2c,vcoeff,vcoeff2,nkft,
                                   nxlo_i,nylo_i,nzlo_i,nxhi_i,nyhi_i,nzhi_i,
                                   v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa);
 }
@@ -4812,7 +5022,7 @@ void PPPMDisp::poisson_ad(FFT_SCALAR* wk1, FFT_SCALAR* wk2,
 ------------------------------------------------------------------------- */
 
 void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, LAMMPS_NS::FFT3d* ft2,
-                               double** vcoeff, double** vcoeff2, int nft,
+                               int r2c, double** vcoeff, double** vcoeff2, int nft,
                                int nxlo_i, int nylo_i, int nzlo_i,
                                int nxhi_i, int nyhi_i, int nzhi_i,
                                FFT_SCALAR*** v0_pa, FFT_SCALAR*** v1_pa,
@@ -4820,9 +5030,37 @@ void PPPMDisp::poisson_peratom(FFT_SCALAR* wk1, FFT_SCALAR* wk2, LAMMPS_NS::FFT3
                                FFT_SCALAR*** v3_pa, FFT_SCALAR*** v4_pa,
                                FFT_SCALAR*** v5_pa)
 {
+  int n, i, j, k;
+
+  // c2r FFTs return a single real field, so transform each term separately
+  // vcoeff2 holds the off-diagonal coeffs averaged over k and -k
+
+  if (r2c) {
+    FFT_SCALAR ***v_pa[6] = {v0_pa,v1_pa,v2_pa,v3_pa,v4_pa,v5_pa};
+    double vc;
+
+    for (int t = 0; t < 6; t++) {
+      n = 0;
+      for (i = 0; i < nft; i++) {
+        vc = (t < 3) ? vcoeff[i][t] : vcoeff2[i][t-3];
+        wk2[n] = wk1[n]*vc;
+        wk2[n+1] = wk1[n+1]*vc;
+        n += 2;
+      }
+
+      ft2->compute(wk2,wk2,FFT3d::BACKWARD);
+
+      n = 0;
+      for (k = nzlo_i; k <= nzhi_i; k++)
+        for (j = nylo_i; j <= nyhi_i; j++)
+          for (i = nxlo_i; i <= nxhi_i; i++)
+            v_pa[t][k][j][i] = wk2[n++];
+    }
+    return;
+  }
+
  // v0 & v1 term
 
-  int n, i, j, k;
   n = 0;
   for (i = 0; i < nft; i++) {
     wk2[n] = wk1[n]*vcoeff[i][0] + wk1[n+1]*vcoeff[i][1];
@@ -8256,7 +8494,8 @@ int PPPMDisp::timing_3d(int n, double &time3d)
 
   if (function[0]) {
     for (int i = 0; i < n; i++) {
-      fft1->compute(work1,work1,FFT3d::FORWARD);
+      if (r2c_flag) fft1->compute(work1,work2,FFT3d::FORWARD);
+      else fft1->compute(work1,work1,FFT3d::FORWARD);
       fft2->compute(work1,work1,FFT3d::BACKWARD);
       if (differentiation_flag != 1) {
         fft2->compute(work1,work1,FFT3d::BACKWARD);
@@ -8274,7 +8513,8 @@ int PPPMDisp::timing_3d(int n, double &time3d)
 
   if (function[1] + function[2] + function[3]) {
     for (int i = 0; i < n; i++) {
-      fft1_6->compute(work1_6,work1_6,FFT3d::FORWARD);
+      if (r2c_flag_6) fft1_6->compute(work1_6,work2_6,FFT3d::FORWARD);
+      else fft1_6->compute(work1_6,work1_6,FFT3d::FORWARD);
       fft2_6->compute(work1_6,work1_6,FFT3d::BACKWARD);
       if (differentiation_flag != 1) {
         fft2_6->compute(work1_6,work1_6,FFT3d::BACKWARD);
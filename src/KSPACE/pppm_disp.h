@@ -87,6 +87,7 @@ class PPPMDisp : public KSpace {
   int nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft;
   int nlower, nupper;
   int ngrid, nfft, nfft_both;
+  int nxhi_kfft, nkfft;    // x extent and # of k-space pts in FFT decomposition
 
   double shift_6, shiftone_6;
   int nxlo_in_6, nylo_in_6, nzlo_in_6, nxhi_in_6, nyhi_in_6, nzhi_in_6;
@@ -94,6 +95,8 @@ class PPPMDisp : public KSpace {
   int nxlo_fft_6, nylo_fft_6, nzlo_fft_6, nxhi_fft_6, nyhi_fft_6, nzhi_fft_6;
   int nlower_6, nupper_6;
   int ngrid_6, nfft_6, nfft_both_6;
+  int nxhi_kfft_6, nkfft_6;
+  int r2c_flag_6;    // 1 if dispersion grid uses r2c FFTs
 
   // the following variables are needed for every structure factor
 
@@ -254,11 +257,12 @@ class PPPMDisp : public KSpace {
   void compute_gf_denom(double *, int);
   double gf_denom(double, double, double, double *, int);
 
-  void compute_sf_precoeff(int, int, int, int, int, int, int, int, int, int, double *, double *,
-                           double *, double *, double *, double *);
-  void compute_gf();
+  void compute_sf_precoeff(int, int, int, int, int, int, int, int, int, int, int, double *,
+                           double *, double *, double *, double *, double *);
+  void set_kfft();
+  virtual void compute_gf();
   void compute_sf_coeff();
-  void compute_gf_6();
+  virtual void compute_gf_6();
   void compute_sf_coeff_6();
 
   virtual void particle_map(double, double, double, double, int **, int, int, int, int, int, int,
@@ -277,7 +281,7 @@ class PPPMDisp : public KSpace {
 
   virtual void poisson_ik(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *,
                           LAMMPS_NS::FFT3d *, int, int, int, int, int, int, int, int, int, int, int,
-                          int, int, int, int, int, double &, double *, double *, double *, double *,
+                          int, int, int, int, int, int, double &, double *, double *, double *, double *,
                           double *, double *, double *, FFT_SCALAR ***, FFT_SCALAR ***,
                           FFT_SCALAR ***, double *, double **, double **, FFT_SCALAR ***,
                           FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
@@ -285,12 +289,12 @@ class PPPMDisp : public KSpace {
 
   virtual void poisson_ad(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *,
                           LAMMPS_NS::FFT3d *, int, int, int, int, int, int, int, int, int, int, int,
-                          int, int, int, int, int, double &, double *, double *, double **,
+                          int, int, int, int, int, int, double &, double *, double *, double **,
                           double **, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
                           FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***);
 
-  virtual void poisson_peratom(FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *, double **, double **,
-                               int, int, int, int, int, int, int, FFT_SCALAR ***, FFT_SCALAR ***,
+  virtual void poisson_peratom(FFT_SCALAR *, FFT_SCALAR *, LAMMPS_NS::FFT3d *, int, double **,
+                               double **, int, int, int, int, int, int, int, FFT_SCALAR ***, FFT_SCALAR ***,
                                FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***);
   virtual void poisson_2s_ik(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR ***, FFT_SCALAR ***,
                              FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***, FFT_SCALAR ***,
@@ -44,6 +44,7 @@ PPPMTIP4P::PPPMTIP4P(LAMMPS *lmp) : PPPM(lmp)
 {
   triclinic_support = 1;
   tip4pflag = 1;
+  gridsort_support = 0;
 }
 
 /* ---------------------------------------------------------------------- */
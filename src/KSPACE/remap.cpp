@@ -15,6 +15,7 @@
 #include "remap.h"
 
 #include <cstdlib>
+#include <cstring>
 
 #define PACK_DATA FFT_SCALAR
 
@@ -65,7 +66,7 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
 {
   // use point-to-point communication
 
-  if (!plan->usecollective) {
+  if (plan->usecollective == 0) {
     int i,isend,irecv;
     FFT_SCALAR *scratch;
 
@@ -112,7 +113,7 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
 
   // use All2Allv collective for remap communication
 
-  } else {
+  } else if (plan->usecollective == 1) {
     if (plan->commringlen > 0) {
       int isend,irecv;
 
@@ -201,6 +202,82 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
       free(packedSendBuffer);
       free(packedRecvBuffer);
     }
+
+  // use node-aware hierarchical all-to-all for remap communication
+  // all data is packed from in before any is unpacked to out
+
+  } else {
+    struct remap_node_3d *node = plan->node;
+    int i,m,isend,irecv,offset;
+    FFT_SCALAR *scratch;
+
+    if (plan->memory == 0)
+      scratch = buf;
+    else
+      scratch = plan->scratch;
+
+    // pack all sends in node order, and self data into scratch space
+
+    offset = 0;
+    for (m = 0; m < plan->nsend; m++) {
+      isend = node->send_order[m];
+      plan->pack(&in[plan->send_offset[isend]],&node->sendbuf[offset],
+                 &plan->packplan[isend]);
+      offset += plan->send_size[isend];
+    }
+
+    if (plan->self) {
+      isend = plan->nsend;
+      irecv = plan->nrecv;
+      plan->pack(&in[plan->send_offset[isend]],
+                 &scratch[plan->recv_bufloc[irecv]],
+                 &plan->packplan[isend]);
+    }
+
+    // gather sends on node leader, exchange between leaders, scatter recvs
+    // leader reorders data by destination node and by destination proc
+
+    MPI_Gatherv(node->sendbuf,node->sendsize,MPI_FFT_SCALAR,
+                node->buf1,node->gather_cnts,node->gather_displs,
+                MPI_FFT_SCALAR,0,node->nodecomm);
+
+    if (node->leadercomm != MPI_COMM_NULL) {
+      for (i = 0; i < node->ncopy_send; i++) {
+        int *block = &node->copy_send[3*i];
+        memcpy(&node->buf2[block[1]],&node->buf1[block[0]],
+               block[2]*sizeof(FFT_SCALAR));
+      }
+
+      MPI_Alltoallv(node->buf2,node->send_cnts,node->send_displs,
+                    MPI_FFT_SCALAR,node->buf1,node->recv_cnts,
+                    node->recv_displs,MPI_FFT_SCALAR,node->leadercomm);
+
+      for (i = 0; i < node->ncopy_recv; i++) {
+        int *block = &node->copy_recv[3*i];
+        memcpy(&node->buf2[block[1]],&node->buf1[block[0]],
+               block[2]*sizeof(FFT_SCALAR));
+      }
+    }
+
+    MPI_Scatterv(node->buf2,node->scatter_cnts,node->scatter_displs,
+                 MPI_FFT_SCALAR,node->recvbuf,node->recvsize,
+                 MPI_FFT_SCALAR,0,node->nodecomm);
+
+    // unpack self data and all recvs
+
+    if (plan->self) {
+      irecv = plan->nrecv;
+      plan->unpack(&scratch[plan->recv_bufloc[irecv]],
+                   &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+    }
+
+    offset = 0;
+    for (m = 0; m < plan->nrecv; m++) {
+      irecv = node->recv_order[m];
+      plan->unpack(&node->recvbuf[offset],&out[plan->recv_offset[irecv]],
+                   &plan->unpackplan[irecv]);
+      offset += plan->recv_size[irecv];
+    }
   }
 }
 
@@ -227,6 +304,9 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
    usecollective        whether to use collective MPI or point-to-point
+                          0 = point-to-point
+                          1 = MPI_Alltoallv collective
+                          2 = node-aware hierarchical all-to-all
 ------------------------------------------------------------------------- */
 
 struct remap_plan_3d *remap_3d_create_plan(
@@ -254,6 +334,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   plan = (struct remap_plan_3d *) malloc(sizeof(struct remap_plan_3d));
   if (plan == nullptr) return nullptr;
   plan->usecollective = usecollective;
+  plan->node = nullptr;
 
   // store parameters in local data structs
 
@@ -343,7 +424,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // plan->nsend = # of sends not including self
 
   if (nsend && plan->send_proc[nsend-1] == me) {
-    if (plan->usecollective) // for collectives include self in nsend list
+    if (plan->usecollective == 1) // for collectives include self in nsend list
       plan->nsend = nsend;
     else
       plan->nsend = nsend - 1;
@@ -455,7 +536,7 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   // create sub-comm rank list
 
-  if (plan->usecollective) {
+  if (plan->usecollective == 1) {
     plan->commringlist = nullptr;
 
     // merge recv and send rank lists
@@ -560,10 +641,17 @@ struct remap_plan_3d *remap_3d_create_plan(
   // for collectives include self in the nsend list
 
   if (nrecv && plan->recv_proc[nrecv-1] == me) {
-    if (plan->usecollective) plan->nrecv = nrecv;
+    if (plan->usecollective == 1) plan->nrecv = nrecv;
     else plan->nrecv = nrecv - 1;
   } else plan->nrecv = nrecv;
 
+  // setup gather, exchange, and scatter for node-aware all-to-all
+
+  if (plan->usecollective == 2) {
+    plan->node = remap_3d_node_setup(comm,inarray,outarray,nqty,plan);
+    if (plan->node == nullptr) return nullptr;
+  }
+
   // init remaining fields in remap plan
 
   plan->memory = memory;
@@ -607,7 +695,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // communicator for the plan based off an MPI_Group created with
   // ranks from the commringlist
 
-  if ((plan->usecollective && (plan->commringlen > 0))) {
+  if ((plan->usecollective == 1) && (plan->commringlen > 0)) {
     MPI_Group orig_group, new_group;
     MPI_Comm_group(comm, &orig_group);
     MPI_Group_incl(orig_group, plan->commringlen,
@@ -618,11 +706,11 @@ struct remap_plan_3d *remap_3d_create_plan(
   // if using collective and the comm ring list is empty create
   // a communicator for the plan with an empty group
 
-  else if ((plan->usecollective) && (plan->commringlen == 0)) {
+  else if ((plan->usecollective == 1) && (plan->commringlen == 0)) {
     MPI_Comm_create(comm, MPI_GROUP_EMPTY, &plan->comm);
   }
 
-  // not using collective - dup comm
+  // not using Alltoallv collective - dup comm
 
   else MPI_Comm_dup(comm,&plan->comm);
 
@@ -639,14 +727,16 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
 {
   // free MPI communicator
 
-  if (!((plan->usecollective) && (plan->commringlen == 0)))
+  if (!((plan->usecollective == 1) && (plan->commringlen == 0)))
     MPI_Comm_free(&plan->comm);
 
-  if (plan->usecollective) {
+  if (plan->usecollective == 1) {
     if (plan->commringlist != nullptr)
       free(plan->commringlist);
   }
 
+  if (plan->node) remap_3d_node_destroy(plan->node);
+
   // free internal arrays
 
   if (plan->nsend || plan->self) {
@@ -700,3 +790,294 @@ int remap_3d_collide(struct extent_3d *block1, struct extent_3d *block2,
 
   return 1;
 }
+
+/* ----------------------------------------------------------------------
+   size of message from proc with block1 to proc with block2
+------------------------------------------------------------------------- */
+
+static int remap_3d_size(struct extent_3d *block1, struct extent_3d *block2,
+                         int nqty)
+{
+  struct extent_3d overlap;
+  if (!remap_3d_collide(block1,block2,&overlap)) return 0;
+  return nqty*overlap.isize*overlap.jsize*overlap.ksize;
+}
+
+/* ----------------------------------------------------------------------
+   Create node-aware all-to-all for a remap plan
+
+   Arguments:
+   comm                 MPI communicator for the P procs which own the data
+   inarray              input extents of all procs
+   outarray             output extents of all procs
+   nqty                 # of datums per element
+   plan                 remap plan with point-to-point send/recv lists
+
+   messages between procs are ordered by node, then by proc rank,
+     so each proc and its node leader can compute the same layout
+     from the extents of all procs without further communication
+   self data is not part of the all-to-all
+------------------------------------------------------------------------- */
+
+struct remap_node_3d *remap_3d_node_setup(MPI_Comm comm,
+                                          struct extent_3d *inarray,
+                                          struct extent_3d *outarray,
+                                          int nqty, struct remap_plan_3d *plan)
+{
+  struct remap_node_3d *node;
+  int i,m,n,iproc,jproc,inode,jnode,size,me,nprocs,noderank,nodesize;
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+  node = (struct remap_node_3d *) calloc(1,sizeof(struct remap_node_3d));
+  if (node == nullptr) return nullptr;
+
+  // split comm into procs on the same node and a comm of node leaders
+  // node index of a proc = rank of its node leader in leader comm
+
+  MPI_Comm_split_type(comm,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,
+                      &node->nodecomm);
+  MPI_Comm_rank(node->nodecomm,&noderank);
+  MPI_Comm_size(node->nodecomm,&nodesize);
+  MPI_Comm_split(comm,(noderank == 0) ? 0 : MPI_UNDEFINED,me,
+                 &node->leadercomm);
+
+  int mynode = 0;
+  if (noderank == 0) MPI_Comm_rank(node->leadercomm,&mynode);
+  MPI_Bcast(&mynode,1,MPI_INT,0,node->nodecomm);
+
+  int *nodeof = (int *) malloc(nprocs*sizeof(int));
+  if (nodeof == nullptr) return nullptr;
+  MPI_Allgather(&mynode,1,MPI_INT,nodeof,1,MPI_INT,comm);
+
+  // list of procs sorted by node, then by rank
+  // procs of node I are nodeprocs[nodefirst[I]] to nodeprocs[nodefirst[I+1]-1]
+
+  int nnodes = 0;
+  for (iproc = 0; iproc < nprocs; iproc++)
+    nnodes = MAX(nnodes,nodeof[iproc]+1);
+
+  int *nodefirst = (int *) calloc(nnodes+1,sizeof(int));
+  int *nodeprocs = (int *) malloc(nprocs*sizeof(int));
+  if (nodefirst == nullptr || nodeprocs == nullptr) return nullptr;
+
+  for (iproc = 0; iproc < nprocs; iproc++) nodefirst[nodeof[iproc]+1]++;
+  for (inode = 0; inode < nnodes; inode++)
+    nodefirst[inode+1] += nodefirst[inode];
+  for (iproc = 0; iproc < nprocs; iproc++)
+    nodeprocs[nodefirst[nodeof[iproc]]++] = iproc;
+  for (inode = nnodes; inode > 0; inode--)
+    nodefirst[inode] = nodefirst[inode-1];
+  nodefirst[0] = 0;
+
+  // order of my sends and recvs, excluding self
+  // index maps a proc to its entry in the plan's send or recv list
+
+  int *index = (int *) malloc(nprocs*sizeof(int));
+  if (index == nullptr) return nullptr;
+
+  node->send_order = (int *) malloc(MAX(plan->nsend,1)*sizeof(int));
+  node->recv_order = (int *) malloc(MAX(plan->nrecv,1)*sizeof(int));
+  if (node->send_order == nullptr || node->recv_order == nullptr)
+    return nullptr;
+
+  for (iproc = 0; iproc < nprocs; iproc++) index[iproc] = -1;
+  for (i = 0; i < plan->nsend; i++) index[plan->send_proc[i]] = i;
+  n = 0;
+  node->sendsize = 0;
+  for (m = 0; m < nprocs; m++) {
+    i = index[nodeprocs[m]];
+    if (i < 0) continue;
+    node->send_order[n++] = i;
+    node->sendsize += plan->send_size[i];
+  }
+
+  for (iproc = 0; iproc < nprocs; iproc++) index[iproc] = -1;
+  for (i = 0; i < plan->nrecv; i++) index[plan->recv_proc[i]] = i;
+  n = 0;
+  node->recvsize = 0;
+  for (m = 0; m < nprocs; m++) {
+    i = index[nodeprocs[m]];
+    if (i < 0) continue;
+    node->recv_order[n++] = i;
+    node->recvsize += plan->recv_size[i];
+  }
+
+  node->sendbuf = (FFT_SCALAR *) malloc(MAX(node->sendsize,1)*sizeof(FFT_SCALAR));
+  node->recvbuf = (FFT_SCALAR *) malloc(MAX(node->recvsize,1)*sizeof(FFT_SCALAR));
+  if (node->sendbuf == nullptr || node->recvbuf == nullptr) return nullptr;
+
+  // node leader sets up gather, reordering, exchange, and scatter
+  // gathered data of each proc on node is ordered by destination node
+  // leader sends to each node are ordered by source proc, then dest proc
+  // scattered data to each proc on node is ordered by source node and proc
+
+  if (noderank == 0) {
+    int *local = &nodeprocs[nodefirst[mynode]];
+
+    node->gather_cnts = (int *) calloc(nodesize,sizeof(int));
+    node->gather_displs = (int *) calloc(nodesize,sizeof(int));
+    node->scatter_cnts = (int *) calloc(nodesize,sizeof(int));
+    node->scatter_displs = (int *) calloc(nodesize,sizeof(int));
+    node->send_cnts = (int *) calloc(nnodes,sizeof(int));
+    node->send_displs = (int *) calloc(nnodes,sizeof(int));
+    node->recv_cnts = (int *) calloc(nnodes,sizeof(int));
+    node->recv_displs = (int *) calloc(nnodes,sizeof(int));
+    int *blocksize = (int *) calloc(nodesize*nnodes,sizeof(int));
+    if (node->gather_cnts == nullptr || node->gather_displs == nullptr ||
+        node->scatter_cnts == nullptr || node->scatter_displs == nullptr ||
+        node->send_cnts == nullptr || node->send_displs == nullptr ||
+        node->recv_cnts == nullptr || node->recv_displs == nullptr ||
+        blocksize == nullptr) return nullptr;
+
+    // sizes of data from each proc on my node to each node
+
+    for (i = 0; i < nodesize; i++) {
+      iproc = local[i];
+      for (m = 0; m < nprocs; m++) {
+        jproc = nodeprocs[m];
+        if (jproc == iproc) continue;
+        size = remap_3d_size(&inarray[iproc],&outarray[jproc],nqty);
+        blocksize[i*nnodes+nodeof[jproc]] += size;
+        node->gather_cnts[i] += size;
+        node->send_cnts[nodeof[jproc]] += size;
+      }
+    }
+
+    // sizes of data from each node to each proc on my node
+
+    for (inode = 0; inode < nnodes; inode++)
+      for (m = nodefirst[inode]; m < nodefirst[inode+1]; m++) {
+        iproc = nodeprocs[m];
+        for (i = 0; i < nodesize; i++) {
+          jproc = local[i];
+          if (jproc == iproc) continue;
+          size = remap_3d_size(&inarray[iproc],&outarray[jproc],nqty);
+          node->recv_cnts[inode] += size;
+          node->scatter_cnts[i] += size;
+        }
+      }
+
+    for (i = 1; i < nodesize; i++) {
+      node->gather_displs[i] = node->gather_displs[i-1] + node->gather_cnts[i-1];
+      node->scatter_displs[i] = node->scatter_displs[i-1] + node->scatter_cnts[i-1];
+    }
+    for (inode = 1; inode < nnodes; inode++) {
+      node->send_displs[inode] = node->send_displs[inode-1] + node->send_cnts[inode-1];
+      node->recv_displs[inode] = node->recv_displs[inode-1] + node->recv_cnts[inode-1];
+    }
+
+    int nsendtotal = node->send_displs[nnodes-1] + node->send_cnts[nnodes-1];
+    int nrecvtotal = node->recv_displs[nnodes-1] + node->recv_cnts[nnodes-1];
+    size = MAX(MAX(nsendtotal,nrecvtotal),1);
+    node->buf1 = (FFT_SCALAR *) malloc(size*sizeof(FFT_SCALAR));
+    node->buf2 = (FFT_SCALAR *) malloc(size*sizeof(FFT_SCALAR));
+
+    // reorder gathered blocks of each proc by destination node
+
+    node->copy_send = (int *) malloc(3*MAX(nodesize*nnodes,1)*sizeof(int));
+    if (node->buf1 == nullptr || node->buf2 == nullptr ||
+        node->copy_send == nullptr) return nullptr;
+
+    int *sendpos = (int *) malloc(nnodes*sizeof(int));
+    if (sendpos == nullptr) return nullptr;
+    for (jnode = 0; jnode < nnodes; jnode++)
+      sendpos[jnode] = node->send_displs[jnode];
+
+    n = 0;
+    for (i = 0; i < nodesize; i++) {
+      int gatherpos = node->gather_displs[i];
+      for (jnode = 0; jnode < nnodes; jnode++) {
+        size = blocksize[i*nnodes+jnode];
+        if (size == 0) continue;
+        node->copy_send[3*n] = gatherpos;
+        node->copy_send[3*n+1] = sendpos[jnode];
+        node->copy_send[3*n+2] = size;
+        gatherpos += size;
+        sendpos[jnode] += size;
+        n++;
+      }
+    }
+    node->ncopy_send = n;
+
+    // reorder received messages by destination proc
+    // each message from another node is its own block
+
+    n = 0;
+    for (inode = 0; inode < nnodes; inode++)
+      for (m = nodefirst[inode]; m < nodefirst[inode+1]; m++) {
+        iproc = nodeprocs[m];
+        for (i = 0; i < nodesize; i++)
+          if (local[i] != iproc &&
+              remap_3d_size(&inarray[iproc],&outarray[local[i]],nqty)) n++;
+      }
+
+    node->copy_recv = (int *) malloc(3*MAX(n,1)*sizeof(int));
+    int *scatterpos = (int *) malloc(nodesize*sizeof(int));
+    if (node->copy_recv == nullptr || scatterpos == nullptr) return nullptr;
+    for (i = 0; i < nodesize; i++) scatterpos[i] = node->scatter_displs[i];
+
+    n = 0;
+    for (inode = 0; inode < nnodes; inode++) {
+      int recvpos = node->recv_displs[inode];
+      for (m = nodefirst[inode]; m < nodefirst[inode+1]; m++) {
+        iproc = nodeprocs[m];
+        for (i = 0; i < nodesize; i++) {
+          jproc = local[i];
+          if (jproc == iproc) continue;
+          size = remap_3d_size(&inarray[iproc],&outarray[jproc],nqty);
+          if (size == 0) continue;
+          node->copy_recv[3*n] = recvpos;
+          node->copy_recv[3*n+1] = scatterpos[i];
+          node->copy_recv[3*n+2] = size;
+          recvpos += size;
+          scatterpos[i] += size;
+          n++;
+        }
+      }
+    }
+    node->ncopy_recv = n;
+
+    free(blocksize);
+    free(sendpos);
+    free(scatterpos);
+  }
+
+  free(nodeof);
+  free(nodefirst);
+  free(nodeprocs);
+  free(index);
+
+  return node;
+}
+
+/* ----------------------------------------------------------------------
+   Destroy node-aware all-to-all of a remap plan
+------------------------------------------------------------------------- */
+
+void remap_3d_node_destroy(struct remap_node_3d *node)
+{
+  MPI_Comm_free(&node->nodecomm);
+  if (node->leadercomm != MPI_COMM_NULL) MPI_Comm_free(&node->leadercomm);
+
+  free(node->send_order);
+  free(node->recv_order);
+  free(node->sendbuf);
+  free(node->recvbuf);
+
+  free(node->gather_cnts);
+  free(node->gather_displs);
+  free(node->scatter_cnts);
+  free(node->scatter_displs);
+  free(node->send_cnts);
+  free(node->send_displs);
+  free(node->recv_cnts);
+  free(node->recv_displs);
+  free(node->copy_send);
+  free(node->copy_recv);
+  free(node->buf1);
+  free(node->buf2);
+
+  free(node);
+}
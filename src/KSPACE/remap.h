@@ -11,6 +11,9 @@
    See the README file in the top-level LAMMPS directory.
 ------------------------------------------------------------------------- */
 
+#ifndef LMP_REMAP_H
+#define LMP_REMAP_H
+
 #include <mpi.h>
 
 #ifdef FFT_SINGLE
@@ -45,9 +48,43 @@ struct remap_plan_3d {
   int self;                           // whether I send/recv with myself
   int memory;                         // user provides scratch space or not
   MPI_Comm comm;                      // group of procs performing remap
-  int usecollective;                  // use collective or point-to-point MPI
+  int usecollective;                  // 0 = point-to-point MPI, 1 = MPI_Alltoallv
+                                      // 2 = node-aware hierarchical all-to-all
   int commringlen;                    // length of commringlist
   int *commringlist;                  // ranks on communication ring of this plan
+  struct remap_node_3d *node;         // node-aware all-to-all info if usecollective = 2
+};
+
+// details of a node-aware hierarchical all-to-all
+// sends of all procs on a node are gathered by the node leader,
+// exchanged between node leaders, then scattered to the procs on the node
+
+struct remap_node_3d {
+  MPI_Comm nodecomm;       // procs sharing memory on my node
+  MPI_Comm leadercomm;     // node leaders, MPI_COMM_NULL if not a leader
+  int *send_order;         // my send messages in node order
+  int *recv_order;         // my recv messages in node order
+  int sendsize;            // total size of my sends
+  int recvsize;            // total size of my recvs
+  FFT_SCALAR *sendbuf;     // my packed sends in node order
+  FFT_SCALAR *recvbuf;     // my recvs in node order
+
+  // only set on node leader
+
+  int *gather_cnts;        // size of sends of each proc on node
+  int *gather_displs;      // offset of sends of each proc in buf1
+  int *scatter_cnts;       // size of recvs of each proc on node
+  int *scatter_displs;     // offset of recvs of each proc in buf2
+  int *send_cnts;          // size of leader message to each node
+  int *send_displs;        // offset of leader message to each node in buf2
+  int *recv_cnts;          // size of leader message from each node
+  int *recv_displs;        // offset of leader message from each node in buf1
+  int ncopy_send;          // # of blocks reordered from gathered to sent data
+  int *copy_send;          // from,to,size triplet of each block
+  int ncopy_recv;          // # of blocks reordered from received to scattered data
+  int *copy_recv;          // from,to,size triplet of each block
+  FFT_SCALAR *buf1;        // gathered data, then leader recvs
+  FFT_SCALAR *buf2;        // leader sends, then data to scatter
 };
 
 // collision between 2 regions
@@ -65,3 +102,8 @@ struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, in
                                            int, int, int, int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
 int remap_3d_collide(struct extent_3d *, struct extent_3d *, struct extent_3d *);
+struct remap_node_3d *remap_3d_node_setup(MPI_Comm, struct extent_3d *, struct extent_3d *, int,
+                                          struct remap_plan_3d *);
+void remap_3d_node_destroy(struct remap_node_3d *);
+
+#endif
@@ -15,6 +15,7 @@
 #include "remap_wrap.h"
 
 #include "error.h"
+#include "fft3d_single.h"
 
 using namespace LAMMPS_NS;
 
@@ -28,6 +29,29 @@ Remap::Remap(LAMMPS *lmp, MPI_Comm comm,
              int nqty, int permute, int memory,
              int precision, int usecollective) : Pointers(lmp)
 {
+  plan = nullptr;
+
+  // precision = 1 with double precision FFT_SCALAR creates a plan
+  //   of the single precision remap instance for float data
+
+#ifndef FFT_SINGLE
+  plan_single = nullptr;
+
+  if (precision == 1) {
+    plan_single =
+      FFTSingle::remap_3d_create_plan(comm,
+                                      in_ilo,in_ihi,in_jlo,in_jhi,
+                                      in_klo,in_khi,
+                                      out_ilo,out_ihi,out_jlo,out_jhi,
+                                      out_klo,out_khi,
+                                      nqty,permute,memory,precision,
+                                      usecollective);
+    if (plan_single == nullptr)
+      error->one(FLERR,"Could not create 3d remap plan");
+    return;
+  }
+#endif
+
   plan = remap_3d_create_plan(comm,
                               in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                               out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
@@ -39,7 +63,10 @@ Remap::Remap(LAMMPS *lmp, MPI_Comm comm,
 
 Remap::~Remap()
 {
-  remap_3d_destroy_plan(plan);
+  if (plan) remap_3d_destroy_plan(plan);
+#ifndef FFT_SINGLE
+  if (plan_single) FFTSingle::remap_3d_destroy_plan(plan_single);
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -48,3 +75,14 @@ void Remap::perform(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf)
 {
   remap_3d(in,out,buf,plan);
 }
+
+#ifndef FFT_SINGLE
+
+/* ---------------------------------------------------------------------- */
+
+void Remap::perform(float *in, float *out, float *buf)
+{
+  FFTSingle::remap_3d(in,out,buf,plan_single);
+}
+
+#endif
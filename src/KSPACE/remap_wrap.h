@@ -19,6 +19,12 @@
 
 namespace LAMMPS_NS {
 
+#ifndef FFT_SINGLE
+namespace FFTSingle {
+  struct remap_plan_3d;
+}
+#endif
+
 class Remap : protected Pointers {
  public:
   Remap(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
@@ -26,8 +32,17 @@ class Remap : protected Pointers {
   ~Remap();
   void perform(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *);
 
+#ifndef FFT_SINGLE
+  // float data for a plan created with precision = 1
+
+  void perform(float *, float *, float *);
+#endif
+
  private:
   struct remap_plan_3d *plan;
+#ifndef FFT_SINGLE
+  struct FFTSingle::remap_plan_3d *plan_single;
+#endif
 };
 
 }    // namespace LAMMPS_NS
@@ -67,6 +67,11 @@ PairAIREBO::PairAIREBO(LAMMPS *lmp)
   ipage = nullptr;
   pgsize = oneatom = 0;
 
+  skin_ncalls = -1;
+  skinpage = nullptr;
+  skin_numneigh = nullptr;
+  skin_firstneigh = nullptr;
+
   nC = nH = nullptr;
   map = nullptr;
   manybody_flag = 1;
@@ -86,6 +91,9 @@ PairAIREBO::~PairAIREBO()
   memory->destroy(REBO_numneigh);
   memory->sfree(REBO_firstneigh);
   delete [] ipage;
+  memory->destroy(skin_numneigh);
+  memory->sfree(skin_firstneigh);
+  delete skinpage;
   memory->destroy(nC);
   memory->destroy(nH);
   delete [] pvector;
@@ -260,7 +268,15 @@ void PairAIREBO::init_style()
     ipage = new MyPage<int>[nmypage];
     for (int i = 0; i < nmypage; i++)
       ipage[i].init(oneatom,pgsize,PGDELTA);
+
+    delete skinpage;
+    skinpage = new MyPage<int>;
+    skinpage->init(oneatom,pgsize,PGDELTA);
   }
+
+  // force rebuild of skin list at start of run, skin may have changed
+
+  skin_ncalls = -1;
 }
 
 /* ----------------------------------------------------------------------
@@ -347,7 +363,7 @@ double PairAIREBO::init_one(int i, int j)
 void PairAIREBO::REBO_neigh()
 {
   int i,j,ii,jj,n,allnum,jnum,itype,jtype;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,dS;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,dS,wij;
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *neighptr;
 
@@ -358,13 +374,19 @@ void PairAIREBO::REBO_neigh()
     maxlocal = atom->nmax;
     memory->destroy(REBO_numneigh);
     memory->sfree(REBO_firstneigh);
+    memory->destroy(skin_numneigh);
+    memory->sfree(skin_firstneigh);
     memory->destroy(nC);
     memory->destroy(nH);
     memory->create(REBO_numneigh,maxlocal,"AIREBO:numneigh");
     REBO_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
                                                "AIREBO:firstneigh");
+    memory->create(skin_numneigh,maxlocal,"AIREBO:skin_numneigh");
+    skin_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
+                                               "AIREBO:skin_firstneigh");
     memory->create(nC,maxlocal,"AIREBO:nC");
     memory->create(nH,maxlocal,"AIREBO:nH");
+    skin_ncalls = -1;
   }
 
   allnum = list->inum + list->gnum;
@@ -372,9 +394,68 @@ void PairAIREBO::REBO_neigh()
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
-  // store all REBO neighs of owned and ghost atoms
+  // store neighs within rcmax + skin of owned and ghost atoms
+  // only when the full neighbor list was rebuilt,
+  //   until then no REBO neigh can come from outside this list
   // scan full neighbor list of I
 
+  if (neighbor->ncalls != skin_ncalls) {
+    skin_ncalls = neighbor->ncalls;
+
+    double rcskinsq[2][2];
+    for (itype = 0; itype < 2; itype++)
+      for (jtype = 0; jtype < 2; jtype++) {
+        double rcskin = rcmax[itype][jtype] + neighbor->skin;
+        rcskinsq[itype][jtype] = rcskin*rcskin;
+      }
+
+    skinpage->reset();
+
+    for (ii = 0; ii < allnum; ii++) {
+      i = ilist[ii];
+
+      n = 0;
+      neighptr = skinpage->vget();
+
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      itype = map[type[i]];
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+
+      for (jj = 0; jj < jnum; jj++) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+        jtype = map[type[j]];
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < rcskinsq[itype][jtype]) neighptr[n++] = j;
+      }
+
+      skin_firstneigh[i] = neighptr;
+      skin_numneigh[i] = n;
+      skinpage->vgot(n);
+      if (skinpage->status())
+        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+    }
+  }
+
+  // store all REBO neighs of owned and ghost atoms
+  // scan skin list of I
+  // nC,nH are summed anew every step, since all weights of pairs in
+  //   the switching region change when atoms move, and running sums
+  //   updated by differences would drift and depend on the history
+  // pairs closer than rcmin have weight 1, so skip sqrt() and Sp()
+
+  double rcminsq[2][2];
+  for (itype = 0; itype < 2; itype++)
+    for (jtype = 0; jtype < 2; jtype++)
+      rcminsq[itype][jtype] = rcmin[itype][jtype]*rcmin[itype][jtype];
+
   ipage->reset();
 
   for (ii = 0; ii < allnum; ii++) {
@@ -388,12 +469,11 @@ void PairAIREBO::REBO_neigh()
     ztmp = x[i][2];
     itype = map[type[i]];
     nC[i] = nH[i] = 0.0;
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
+    jlist = skin_firstneigh[i];
+    jnum = skin_numneigh[i];
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
-      j &= NEIGHMASK;
       jtype = map[type[j]];
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
@@ -402,10 +482,10 @@ void PairAIREBO::REBO_neigh()
 
       if (rsq < rcmaxsq[itype][jtype]) {
         neighptr[n++] = j;
-        if (jtype == 0)
-          nC[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
-        else
-          nH[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
+        if (rsq < rcminsq[itype][jtype]) wij = 1.0;
+        else wij = Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
+        if (jtype == 0) nC[i] += wij;
+        else nH[i] += wij;
       }
     }
 
@@ -4498,11 +4578,12 @@ void PairAIREBO::spline_init()
 double PairAIREBO::memory_usage()
 {
   double bytes = 0.0;
-  bytes += (double)maxlocal * sizeof(int);
-  bytes += (double)maxlocal * sizeof(int *);
+  bytes += (double)2*maxlocal * sizeof(int);
+  bytes += (double)2*maxlocal * sizeof(int *);
 
   for (int i = 0; i < comm->nthreads; i++)
     bytes += ipage[i].size();
+  if (skinpage) bytes += skinpage->size();
 
   bytes += (double)2*maxlocal * sizeof(double);
   return bytes;
@@ -62,6 +62,11 @@ class PairAIREBO : public Pair {
   int *REBO_numneigh;       // # of pair neighbors for each atom
   int **REBO_firstneigh;    // ptr to 1st neighbor of each atom
 
+  bigint skin_ncalls;       // neighbor->ncalls when skin list was built
+  MyPage<int> *skinpage;    // pages of REBO neighbors within rcmax + skin
+  int *skin_numneigh;       // # of skin neighbors for each atom
+  int **skin_firstneigh;    // ptr to 1st skin neighbor of each atom
+
   double *closestdistsq;    // closest owned atom dist to each ghost
   double *nC, *nH;          // sum of weighting fns with REBO neighs
 
@@ -52,6 +52,12 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   numforce = nullptr;
   type2frho = nullptr;
 
+  cacheflag = 1;
+  paircache = 1;
+  maxpair = 0;
+  pairgeom = nullptr;
+  pairbin = nullptr;
+
   nfuncfl = 0;
   funcfl = nullptr;
 
@@ -68,6 +74,8 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   frho_spline = nullptr;
   rhor_spline = nullptr;
   z2r_spline = nullptr;
+  rhor_value = nullptr;
+  rhor_deriv = nullptr;
 
   // set comm size needed by this Pair
 
@@ -86,6 +94,8 @@ PairEAM::~PairEAM()
   memory->destroy(rho);
   memory->destroy(fp);
   memory->destroy(numforce);
+  memory->destroy(pairgeom);
+  memory->destroy(pairbin);
 
   if (allocated) {
     memory->destroy(setflag);
@@ -137,16 +147,18 @@ PairEAM::~PairEAM()
   memory->destroy(frho_spline);
   memory->destroy(rhor_spline);
   memory->destroy(z2r_spline);
+  memory->destroy(rhor_value);
+  memory->destroy(rhor_deriv);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairEAM::compute(int eflag, int vflag)
 {
-  int i,j,ii,jj,m,inum,jnum,itype,jtype;
+  int i,j,ii,jj,m,n,inum,jnum,itype,jtype,npair;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
-  double *coeff;
+  double *coeff,*geom;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
   evdwl = 0.0;
@@ -183,8 +195,28 @@ void PairEAM::compute(int eflag, int vflag)
     for (i = 0; i < nall; i++) rho[i] = 0.0;
   } else for (i = 0; i < nlocal; i++) rho[i] = 0.0;
 
+  // with pair cache, presize per-pair arrays for all neighbors
+  //   since neighbors within the cutoff cannot be more
+
+  if (paircache) {
+    npair = 0;
+    for (ii = 0; ii < inum; ii++) npair += numneigh[ilist[ii]];
+    if (npair > maxpair) {
+      memory->destroy(pairgeom);
+      memory->destroy(pairbin);
+      maxpair = npair;
+      memory->create(pairgeom,maxpair,5,"pair:pairgeom");
+      memory->create(pairbin,maxpair,2,"pair:pairbin");
+    }
+  }
+
   // rho = density at each atom
   // loop over neighbors of my atoms
+  // with pair cache, store distance and spline position of each pair
+  //   within cutoff in order of the neighbor list
+  // numforce = # of such pairs of each atom
+
+  npair = 0;
 
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
@@ -194,6 +226,7 @@ void PairEAM::compute(int eflag, int vflag)
     itype = type[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
+    numforce[i] = 0;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
@@ -206,17 +239,31 @@ void PairEAM::compute(int eflag, int vflag)
 
       if (rsq < cutforcesq) {
         jtype = type[j];
-        p = sqrt(rsq)*rdr + 1.0;
+        r = sqrt(rsq);
+        p = r*rdr + 1.0;
         m = static_cast<int> (p);
         m = MIN(m,nr-1);
         p -= m;
         p = MIN(p,1.0);
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rho[i] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+        coeff = rhor_value[type2rhor[jtype][itype]][m];
+        rho[i] += ((coeff[0]*p + coeff[1])*p + coeff[2])*p + coeff[3];
         if (newton_pair || j < nlocal) {
-          coeff = rhor_spline[type2rhor[itype][jtype]][m];
-          rho[j] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+          coeff = rhor_value[type2rhor[itype][jtype]][m];
+          rho[j] += ((coeff[0]*p + coeff[1])*p + coeff[2])*p + coeff[3];
+        }
+
+        if (paircache) {
+          geom = pairgeom[npair];
+          geom[0] = delx;
+          geom[1] = dely;
+          geom[2] = delz;
+          geom[3] = r;
+          geom[4] = p;
+          pairbin[npair][0] = j;
+          pairbin[npair][1] = m;
+          npair++;
         }
+        numforce[i]++;
       }
     }
   }
@@ -254,7 +301,10 @@ void PairEAM::compute(int eflag, int vflag)
   embedstep = update->ntimestep;
 
   // compute forces on each atom
-  // loop over neighbors of my atoms
+  // loop over pairs within cutoff stored by density pass
+  //   or over neighbors of my atoms without pair cache
+
+  n = 0;
 
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
@@ -263,67 +313,79 @@ void PairEAM::compute(int eflag, int vflag)
     ztmp = x[i][2];
     itype = type[i];
 
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
-    numforce[i] = 0;
+    if (paircache) jnum = numforce[i];
+    else {
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+    }
 
     for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
+      if (paircache) {
+        geom = pairgeom[n];
+        delx = geom[0];
+        dely = geom[1];
+        delz = geom[2];
+        r = geom[3];
+        p = geom[4];
+        j = pairbin[n][0];
+        m = pairbin[n][1];
+        n++;
+      } else {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+        if (rsq >= cutforcesq) continue;
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq < cutforcesq) {
-        ++numforce[i];
-        jtype = type[j];
         r = sqrt(rsq);
         p = r*rdr + 1.0;
         m = static_cast<int> (p);
         m = MIN(m,nr-1);
         p -= m;
         p = MIN(p,1.0);
-
-        // rhoip = derivative of (density at atom j due to atom i)
-        // rhojp = derivative of (density at atom i due to atom j)
-        // phi = pair potential energy
-        // phip = phi'
-        // z2 = phi * r
-        // z2p = (phi * r)' = (phi' r) + phi
-        // psip needs both fp[i] and fp[j] terms since r_ij appears in two
-        //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
-        //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
-        // scale factor can be applied by thermodynamic integration
-
-        coeff = rhor_spline[type2rhor[itype][jtype]][m];
-        rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = z2r_spline[type2z2r[itype][jtype]][m];
-        z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
-        z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
-
-        recip = 1.0/r;
-        phi = z2*recip;
-        phip = z2p*recip - phi*recip;
-        psip = fp[i]*rhojp + fp[j]*rhoip + phip;
-        fpair = -scale[itype][jtype]*psip*recip;
-
-        f[i][0] += delx*fpair;
-        f[i][1] += dely*fpair;
-        f[i][2] += delz*fpair;
-        if (newton_pair || j < nlocal) {
-          f[j][0] -= delx*fpair;
-          f[j][1] -= dely*fpair;
-          f[j][2] -= delz*fpair;
-        }
-
-        if (eflag) evdwl = scale[itype][jtype]*phi;
-        if (evflag) ev_tally(i,j,nlocal,newton_pair,
-                             evdwl,0.0,fpair,delx,dely,delz);
       }
+      jtype = type[j];
+
+      // rhoip = derivative of (density at atom j due to atom i)
+      // rhojp = derivative of (density at atom i due to atom j)
+      // phi = pair potential energy
+      // phip = phi'
+      // z2 = phi * r
+      // z2p = (phi * r)' = (phi' r) + phi
+      // psip needs both fp[i] and fp[j] terms since r_ij appears in two
+      //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
+      //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
+      // scale factor can be applied by thermodynamic integration
+
+      coeff = rhor_deriv[type2rhor[itype][jtype]][m];
+      rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = rhor_deriv[type2rhor[jtype][itype]][m];
+      rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = z2r_spline[type2z2r[itype][jtype]][m];
+      z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+      z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+      recip = 1.0/r;
+      phi = z2*recip;
+      phip = z2p*recip - phi*recip;
+      psip = fp[i]*rhojp + fp[j]*rhoip + phip;
+      fpair = -scale[itype][jtype]*psip*recip;
+
+      f[i][0] += delx*fpair;
+      f[i][1] += dely*fpair;
+      f[i][2] += delz*fpair;
+      if (newton_pair || j < nlocal) {
+        f[j][0] -= delx*fpair;
+        f[j][1] -= dely*fpair;
+        f[j][2] -= delz*fpair;
+      }
+
+      if (eflag) evdwl = scale[itype][jtype]*phi;
+      if (evflag) ev_tally(i,j,nlocal,newton_pair,
+                           evdwl,0.0,fpair,delx,dely,delz);
     }
   }
 
@@ -360,9 +422,21 @@ void PairEAM::allocate()
    global settings
 ------------------------------------------------------------------------- */
 
-void PairEAM::settings(int narg, char **/*arg*/)
+void PairEAM::settings(int narg, char **arg)
 {
-  if (narg > 0) error->all(FLERR,"Illegal pair_style command");
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"cache") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal pair_style command");
+      if (!cacheflag)
+        error->all(FLERR,"Pair style {} does not support keyword cache",
+                   force->pair_style);
+      if (strcmp(arg[iarg+1],"yes") == 0) paircache = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) paircache = 0;
+      else error->all(FLERR,"Illegal pair_style command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal pair_style command");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -767,6 +841,22 @@ void PairEAM::array2spline()
 
   for (int i = 0; i < nz2r; i++)
     interpolate(nr,dr,z2r[i],z2r_spline[i]);
+
+  // copy rhor splines into separate contiguous tables of
+  // value coeffs (density pass) and derivative coeffs (force pass)
+  // derivative rows are padded to 4 so each row is 32 bytes
+
+  memory->destroy(rhor_value);
+  memory->destroy(rhor_deriv);
+  memory->create(rhor_value,nrhor,nr+1,4,"pair:rhor_value");
+  memory->create(rhor_deriv,nrhor,nr+1,4,"pair:rhor_deriv");
+
+  for (int i = 0; i < nrhor; i++)
+    for (int m = 0; m <= nr; m++) {
+      for (int k = 0; k < 4; k++) rhor_value[i][m][k] = rhor_spline[i][m][k+3];
+      for (int k = 0; k < 3; k++) rhor_deriv[i][m][k] = rhor_spline[i][m][k];
+      rhor_deriv[i][m][3] = 0.0;
+    }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -915,6 +1005,9 @@ double PairEAM::memory_usage()
   double bytes = (double)maxeatom * sizeof(double);
   bytes += (double)maxvatom*6 * sizeof(double);
   bytes += (double)2 * nmax * sizeof(double);
+  bytes += (double)nmax * sizeof(int);
+  bytes += (double)maxpair * (5*sizeof(double) + sizeof(double *) +
+                              2*sizeof(int) + sizeof(int *));
   return bytes;
 }
 
@@ -72,6 +72,19 @@ class PairEAM : public Pair {
   double *rho, *fp;
   int *numforce;
 
+  // per-pair data of the density pass, reused by the force pass
+
+  int cacheflag;      // 1 if compute() supports the cache keyword
+  int paircache;      // 1 if density pass stores pairs for force pass
+  int maxpair;        // allocated size of per-pair arrays
+  double **pairgeom;  // delx, dely, delz, r, p of each pair within cutoff
+  int **pairbin;      // J and spline bin m of each pair within cutoff
+
+  // rhor splines split into value and derivative coefficients
+  // so that each pass only loads the coefficients it uses
+
+  double ***rhor_value, ***rhor_deriv;
+
   // potentials as file data
 
   struct Funcfl {
@@ -122,6 +135,11 @@ Self-explanatory.  Check the input script syntax and compare to the
 documentation for the command.  You can use -echo screen as a
 command-line option when running LAMMPS to see the offending line.
 
+E: Pair style %s does not support keyword cache
+
+Only the eam, eam/alloy, and eam/fs styles without accelerator suffix
+store pair data between the density and force loops.
+
 E: Incorrect args for pair coefficients
 
 Self-explanatory.  Check the input script or data file.
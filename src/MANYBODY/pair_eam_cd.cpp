@@ -41,6 +41,7 @@ using namespace LAMMPS_NS;
 PairEAMCD::PairEAMCD(LAMMPS *lmp, int _cdeamVersion)
   : PairEAM(lmp), PairEAMAlloy(lmp), cdeamVersion(_cdeamVersion)
 {
+  cacheflag = 0;
   single_enable = 0;
   restartinfo = 0;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
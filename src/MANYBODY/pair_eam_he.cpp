@@ -33,6 +33,7 @@ using namespace LAMMPS_NS;
 
 PairEAMHE::PairEAMHE(LAMMPS *lmp) : PairEAM(lmp), PairEAMFS(lmp)
 {
+  cacheflag = 0;
   he_flag = 1;
 }
 
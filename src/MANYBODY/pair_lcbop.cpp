@@ -55,6 +55,11 @@ PairLCBOP::PairLCBOP(LAMMPS *lmp) : Pair(lmp)
   ipage = nullptr;
   pgsize = oneatom = 0;
 
+  skin_ncalls = -1;
+  skinpage = nullptr;
+  skin_numneigh = nullptr;
+  skin_firstneigh = nullptr;
+
   N = nullptr;
   M = nullptr;
 }
@@ -68,6 +73,9 @@ PairLCBOP::~PairLCBOP()
   memory->destroy(SR_numneigh);
   memory->sfree(SR_firstneigh);
   delete [] ipage;
+  memory->destroy(skin_numneigh);
+  memory->sfree(skin_firstneigh);
+  delete skinpage;
   memory->destroy(N);
   memory->destroy(M);
 
@@ -175,7 +183,15 @@ void PairLCBOP::init_style()
     ipage = new MyPage<int>[nmypage];
     for (int i = 0; i < nmypage; i++)
       ipage[i].init(oneatom,pgsize,PGDELTA);
+
+    delete skinpage;
+    skinpage = new MyPage<int>;
+    skinpage->init(oneatom,pgsize,PGDELTA);
   }
+
+  // force rebuild of skin list at start of run, skin may have changed
+
+  skin_ncalls = -1;
 }
 
 /* ----------------------------------------------------------------------
@@ -229,13 +245,19 @@ void PairLCBOP::SR_neigh()
     maxlocal = atom->nmax;      // for atoms and ghosts allocated
     memory->destroy(SR_numneigh);
     memory->sfree(SR_firstneigh);
+    memory->destroy(skin_numneigh);
+    memory->sfree(skin_firstneigh);
     memory->destroy(N);
     memory->destroy(M);
     memory->create(SR_numneigh,maxlocal,"LCBOP:numneigh");
     SR_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
                            "LCBOP:firstneigh");
+    memory->create(skin_numneigh,maxlocal,"LCBOP:skin_numneigh");
+    skin_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
+                           "LCBOP:skin_firstneigh");
     memory->create(N,maxlocal,"LCBOP:N");
     memory->create(M,maxlocal,"LCBOP:M");
+    skin_ncalls = -1;
   }
 
   allnum = list->inum + list->gnum;
@@ -243,9 +265,53 @@ void PairLCBOP::SR_neigh()
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
-  // store all SR neighs of owned and ghost atoms
+  // store neighs within r_2 + skin of owned and ghost atoms
+  // only when the full neighbor list was rebuilt,
+  //   until then no SR neigh can come from outside this list
   // scan full neighbor list of I
 
+  if (neighbor->ncalls != skin_ncalls) {
+    skin_ncalls = neighbor->ncalls;
+
+    double rskin = r_2 + neighbor->skin;
+    double rskinsq = rskin*rskin;
+
+    skinpage->reset();
+
+    for (ii = 0; ii < allnum; ii++) {
+      i = ilist[ii];
+
+      n = 0;
+      neighptr = skinpage->vget();
+
+      xtmp = x[i][0];
+      ytmp = x[i][1];
+      ztmp = x[i][2];
+      jlist = firstneigh[i];
+      jnum = numneigh[i];
+
+      for (jj = 0; jj < jnum; jj++) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < rskinsq) neighptr[n++] = j;
+      }
+
+      skin_firstneigh[i] = neighptr;
+      skin_numneigh[i] = n;
+      skinpage->vgot(n);
+      if (skinpage->status())
+        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+    }
+  }
+
+  // store all SR neighs of owned and ghost atoms
+  // scan skin list of I
+
   ipage->reset();
 
   for (ii = 0; ii < allnum; ii++) {
@@ -258,12 +324,11 @@ void PairLCBOP::SR_neigh()
     ytmp = x[i][1];
     ztmp = x[i][2];
     N[i] = 0.0;
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
+    jlist = skin_firstneigh[i];
+    jnum = skin_numneigh[i];
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
-      j &= NEIGHMASK;
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
       delz = ztmp - x[j][2];
@@ -1229,11 +1294,12 @@ void PairLCBOP::spline_init() {
 double PairLCBOP::memory_usage()
 {
   double bytes = 0.0;
-  bytes += (double)maxlocal * sizeof(int);
-  bytes += (double)maxlocal * sizeof(int *);
+  bytes += (double)2*maxlocal * sizeof(int);
+  bytes += (double)2*maxlocal * sizeof(int *);
 
   for (int i = 0; i < comm->nthreads; i++)
     bytes += ipage[i].size();
+  if (skinpage) bytes += skinpage->size();
 
   bytes += (double)3*maxlocal * sizeof(double);
   return bytes;
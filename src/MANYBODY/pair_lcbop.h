@@ -53,6 +53,11 @@ class PairLCBOP : public Pair {
   int *SR_numneigh;       // # of pair neighbors for each atom
   int **SR_firstneigh;    // ptr to 1st neighbor of each atom
 
+  bigint skin_ncalls;     // neighbor->ncalls when skin list was built
+  MyPage<int> *skinpage;  // pages of SR neighbors within r_2 + skin
+  int *skin_numneigh;     // # of skin neighbors for each atom
+  int **skin_firstneigh;  // ptr to 1st skin neighbor of each atom
+
   double *N;    // sum of cutoff fns ( f_C ) with SR neighs
   double *M;    // sum_j f_C_ij*F(N_j - f_C_ij)
 
@@ -53,6 +53,12 @@ class PairSW : public Pair {
   Param *params;      // parameter set for an I-J-K interaction
   int maxshort;       // size of short neighbor list array
   int *neighshort;    // short neighbor list array
+  int *shorttype;     // element of each short neighbor
+  double **shortsoa;  // per short neighbor values for three-body loop
+
+  // three-body parameters in SoA form, indexed by I-J-K parameter set
+
+  double *costheta3, *lambda_epsilon3, *lambda_epsilon23;
 
   virtual void allocate();
   void read_file(char *);
@@ -59,6 +59,8 @@ PairTersoff::PairTersoff(LAMMPS *lmp) : Pair(lmp)
 
   maxshort = 10;
   neighshort = nullptr;
+  shorttype = nullptr;
+  shortvec = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -76,6 +78,8 @@ PairTersoff::~PairTersoff()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(shorttype);
+    memory->destroy(shortvec);
   }
 }
 
@@ -114,13 +118,12 @@ template <int SHIFT_FLAG, int EVFLAG, int EFLAG, int VFLAG_ATOM>
 void PairTersoff::eval()
 {
   int i,j,k,ii,jj,kk,inum,jnum;
-  int itype,jtype,ktype,iparam_ij,iparam_ijk;
+  int itype,jtype,iparam_ij,iparam_ijk;
   tagint itag,jtag;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double fforce;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fi[3],fj[3],fk[3];
-  double r1_hat[3],r2_hat[3];
+  double fi[3],fj[3],fk[3];
   double zeta_ij,prefactor;
   double forceshiftfac;
   int *ilist,*jlist,*numneigh,**firstneigh;
@@ -181,6 +184,8 @@ void PairTersoff::eval()
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(shorttype,maxshort,"pair:shorttype");
+          memory->grow(shortvec,maxshort,8,"pair:shortvec");
         }
       }
 
@@ -216,27 +221,44 @@ void PairTersoff::eval()
                            evdwl,0.0,fpair,delx,dely,delz);
     }
 
+    // geometry of each short neighbor, computed once and
+    // reused by the zeta and attractive loops of every I-J pair
+
+    for (kk = 0; kk < numshort; kk++) {
+      k = neighshort[kk];
+      double *vk = shortvec[kk];
+      shorttype[kk] = map[type[k]];
+
+      vk[0] = x[k][0] - xtmp;
+      vk[1] = x[k][1] - ytmp;
+      vk[2] = x[k][2] - ztmp;
+      rsq2 = vk[0]*vk[0] + vk[1]*vk[1] + vk[2]*vk[2];
+
+      if (SHIFT_FLAG)
+        rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
+
+      vk[3] = rsq2;
+      vk[7] = 1.0/sqrt(dot3(vk, vk));
+      scale3(vk[7], vk, &vk[4]);
+    }
+
     // three-body interactions
     // skip immediately if I-J is not within cutoff
     double fjxtmp,fjytmp,fjztmp;
 
     for (jj = 0; jj < numshort; jj++) {
       j = neighshort[jj];
-      jtype = map[type[j]];
+      jtype = shorttype[jj];
       iparam_ij = elem3param[itype][jtype][jtype];
 
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
-
-      if (SHIFT_FLAG)
-        rsq1 += shift*shift + 2*sqrt(rsq1)*shift;
-
+      double *vj = shortvec[jj];
+      rsq1 = vj[3];
       if (rsq1 >= params[iparam_ij].cutsq) continue;
 
-      const double r1inv = 1.0/sqrt(dot3(delr1, delr1));
-      scale3(r1inv, delr1, r1_hat);
+      double * const delr1 = vj;
+      double * const r1_hat = &vj[4];
+      const double r1inv = vj[7];
+      const int * const ijkrow = elem3param[itype][jtype];
 
       // accumulate bondorder zeta for each i-j interaction via loop over k
 
@@ -245,24 +267,11 @@ void PairTersoff::eval()
 
       for (kk = 0; kk < numshort; kk++) {
         if (jj == kk) continue;
-        k = neighshort[kk];
-        ktype = map[type[k]];
-        iparam_ijk = elem3param[itype][jtype][ktype];
-
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
-        if (rsq2 >= params[iparam_ijk].cutsq) continue;
+        iparam_ijk = ijkrow[shorttype[kk]];
+        double *vk = shortvec[kk];
+        if (vk[3] >= params[iparam_ijk].cutsq) continue;
 
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
-
-        zeta_ij += zeta(&params[iparam_ijk],rsq1,rsq2,r1_hat,r2_hat);
+        zeta_ij += zeta(&params[iparam_ijk],rsq1,vk[3],r1_hat,&vk[4]);
       }
 
       // pairwise force due to zeta
@@ -285,25 +294,13 @@ void PairTersoff::eval()
 
       for (kk = 0; kk < numshort; kk++) {
         if (jj == kk) continue;
+        iparam_ijk = ijkrow[shorttype[kk]];
+        double *vk = shortvec[kk];
+        if (vk[3] >= params[iparam_ijk].cutsq) continue;
         k = neighshort[kk];
-        ktype = map[type[k]];
-        iparam_ijk = elem3param[itype][jtype][ktype];
-
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
-        if (rsq2 >= params[iparam_ijk].cutsq) continue;
-
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
 
         attractive(&params[iparam_ijk],prefactor,
-                   rsq1,rsq2,r1_hat,r2_hat,fi,fj,fk);
+                   rsq1,vk[3],r1_hat,&vk[4],fi,fj,fk);
 
         fxtmp += fi[0];
         fytmp += fi[1];
@@ -315,7 +312,7 @@ void PairTersoff::eval()
         f[k][1] += fk[1];
         f[k][2] += fk[2];
 
-        if (VFLAG_ATOM) v_tally3(i,j,k,fj,fk,delr1,delr2);
+        if (VFLAG_ATOM) v_tally3(i,j,k,fj,fk,delr1,vk);
       }
       f[j][0] += fjxtmp;
       f[j][1] += fjytmp;
@@ -339,6 +336,8 @@ void PairTersoff::allocate()
   memory->create(setflag,n+1,n+1,"pair:setflag");
   memory->create(cutsq,n+1,n+1,"pair:cutsq");
   memory->create(neighshort,maxshort,"pair:neighshort");
+  memory->create(shorttype,maxshort,"pair:shorttype");
+  memory->create(shortvec,maxshort,8,"pair:shortvec");
   map = new int[n+1];
 }
 
@@ -60,6 +60,8 @@ class PairTersoff : public Pair {
   double cutmax;      // max cutoff for all elements
   int maxshort;       // size of short neighbor list array
   int *neighshort;    // short neighbor list array
+  int *shorttype;     // element of each short neighbor
+  double **shortvec;  // delr, rsq, r_hat, 1/r of each short neighbor
 
   int shift_flag;    // flag to turn on/off shift
   double shift;      // negative change in equilibrium bond length
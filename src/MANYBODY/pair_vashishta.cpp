@@ -38,6 +38,10 @@ using namespace LAMMPS_NS;
 
 #define DELTA 4
 
+// rows of per short neighbor array for three-body loop
+
+enum{SDELX,SDELY,SDELZ,SR,SRINVSQ,SGSRAINVSQ,SEXPGSRAINV,SFX,SFY,SFZ,NSHORTSOA};
+
 /* ---------------------------------------------------------------------- */
 
 PairVashishta::PairVashishta(LAMMPS *lmp) : Pair(lmp)
@@ -54,6 +58,9 @@ PairVashishta::PairVashishta(LAMMPS *lmp) : Pair(lmp)
   r0max = 0.0;
   maxshort = 10;
   neighshort = nullptr;
+  shorttype = nullptr;
+  shortsoa = nullptr;
+  costheta3 = bigc3 = bigb3 = big2b3 = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -66,11 +73,17 @@ PairVashishta::~PairVashishta()
 
   memory->destroy(params);
   memory->destroy(elem3param);
+  memory->destroy(costheta3);
+  memory->destroy(bigc3);
+  memory->destroy(bigb3);
+  memory->destroy(big2b3);
 
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(shorttype);
+    memory->destroy(shortsoa);
   }
 }
 
@@ -135,6 +148,9 @@ void PairVashishta::compute(int eflag, int vflag)
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(shorttype,maxshort,"pair:shorttype");
+          memory->destroy(shortsoa);
+          memory->create(shortsoa,NSHORTSOA,maxshort,"pair:shortsoa");
         }
       }
 
@@ -168,24 +184,78 @@ void PairVashishta::compute(int eflag, int vflag)
 
     jnumm1 = numshort - 1;
 
-    for (jj = 0; jj < jnumm1; jj++) {
-      j = neighshort[jj];
-      jtype = map[type[j]];
-      ijparam = elem3param[itype][jtype][jtype];
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
-      if (rsq1 >= params[ijparam].cutsq2) continue;
-
-      double fjxtmp,fjytmp,fjztmp;
-      fjxtmp = fjytmp = fjztmp = 0.0;
+    // three-body interactions
+    // tally energy and virial one triplet at a time via threebody()
+
+    if (evflag) {
+      for (jj = 0; jj < jnumm1; jj++) {
+        j = neighshort[jj];
+        jtype = map[type[j]];
+        ijparam = elem3param[itype][jtype][jtype];
+        delr1[0] = x[j][0] - xtmp;
+        delr1[1] = x[j][1] - ytmp;
+        delr1[2] = x[j][2] - ztmp;
+        rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+        if (rsq1 >= params[ijparam].cutsq2) continue;
+
+        double fjxtmp,fjytmp,fjztmp;
+        fjxtmp = fjytmp = fjztmp = 0.0;
+
+        for (kk = jj+1; kk < numshort; kk++) {
+          k = neighshort[kk];
+          ktype = map[type[k]];
+          ikparam = elem3param[itype][ktype][ktype];
+          ijkparam = elem3param[itype][jtype][ktype];
+
+          delr2[0] = x[k][0] - xtmp;
+          delr2[1] = x[k][1] - ytmp;
+          delr2[2] = x[k][2] - ztmp;
+          rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
+          if (rsq2 >= params[ikparam].cutsq2) continue;
+
+          threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
+                    rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+
+          fxtmp -= fj[0] + fk[0];
+          fytmp -= fj[1] + fk[1];
+          fztmp -= fj[2] + fk[2];
+          fjxtmp += fj[0];
+          fjytmp += fj[1];
+          fjztmp += fj[2];
+          f[k][0] += fk[0];
+          f[k][1] += fk[1];
+          f[k][2] += fk[2];
+
+          ev_tally3(i,j,k,evdwl,0.0,fj,fk,delr1,delr2);
+        }
+        f[j][0] += fjxtmp;
+        f[j][1] += fjytmp;
+        f[j][2] += fjztmp;
+      }
 
-      for (kk = jj+1; kk < numshort; kk++) {
+    } else if (numshort > 1) {
+
+      // precompute terms that depend only on one neighbor and
+      // compact list to neighbors within three-body cutoff,
+      // then loop over K of each J-K pair with no calls or stores to f,
+      //   so the compiler can vectorize it
+
+      double * const sdelx = shortsoa[SDELX];
+      double * const sdely = shortsoa[SDELY];
+      double * const sdelz = shortsoa[SDELZ];
+      double * const sr = shortsoa[SR];
+      double * const srinvsq = shortsoa[SRINVSQ];
+      double * const sgsrainvsq = shortsoa[SGSRAINVSQ];
+      double * const sexpgsrainv = shortsoa[SEXPGSRAINV];
+      double * const sfx = shortsoa[SFX];
+      double * const sfy = shortsoa[SFY];
+      double * const sfz = shortsoa[SFZ];
+
+      int num3 = 0;
+      for (kk = 0; kk < numshort; kk++) {
         k = neighshort[kk];
         ktype = map[type[k]];
         ikparam = elem3param[itype][ktype][ktype];
-        ijkparam = elem3param[itype][jtype][ktype];
 
         delr2[0] = x[k][0] - xtmp;
         delr2[1] = x[k][1] - ytmp;
@@ -193,24 +263,86 @@ void PairVashishta::compute(int eflag, int vflag)
         rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
         if (rsq2 >= params[ikparam].cutsq2) continue;
 
-        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
-                  rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+        const double r2 = sqrt(rsq2);
+        const double rainv2 = 1.0/(r2 - params[ikparam].r0);
+        const double gsrainv2 = params[ikparam].gamma * rainv2;
+        neighshort[num3] = k;
+        shorttype[num3] = ktype;
+        sdelx[num3] = delr2[0];
+        sdely[num3] = delr2[1];
+        sdelz[num3] = delr2[2];
+        sr[num3] = r2;
+        srinvsq[num3] = 1.0/rsq2;
+        sgsrainvsq[num3] = gsrainv2*rainv2/r2;
+        sexpgsrainv[num3] = exp(gsrainv2);
+        sfx[num3] = sfy[num3] = sfz[num3] = 0.0;
+        num3++;
+      }
 
-        fxtmp -= fj[0] + fk[0];
-        fytmp -= fj[1] + fk[1];
-        fztmp -= fj[2] + fk[2];
-        fjxtmp += fj[0];
-        fjytmp += fj[1];
-        fjztmp += fj[2];
-        f[k][0] += fk[0];
-        f[k][1] += fk[1];
-        f[k][2] += fk[2];
+      for (jj = 0; jj < num3-1; jj++) {
+        const int * const ijkrow = elem3param[itype][shorttype[jj]];
+        const double delx1 = sdelx[jj];
+        const double dely1 = sdely[jj];
+        const double delz1 = sdelz[jj];
+        const double r1 = sr[jj];
+        const double rinvsq1 = srinvsq[jj];
+        const double gsrainvsq1 = sgsrainvsq[jj];
+        const double expgsrainv1 = sexpgsrainv[jj];
+
+        double fjxtmp,fjytmp,fjztmp;
+        fjxtmp = fjytmp = fjztmp = 0.0;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+:fxtmp,fytmp,fztmp,fjxtmp,fjytmp,fjztmp)
+#endif
+        for (kk = jj+1; kk < num3; kk++) {
+          const int m = ijkrow[shorttype[kk]];
+          const double rinv12 = 1.0/(r1*sr[kk]);
+          const double cs = (delx1*sdelx[kk] + dely1*sdely[kk] +
+                             delz1*sdelz[kk]) * rinv12;
+          const double delcs = cs - costheta3[m];
+          const double delcssq = delcs*delcs;
+          const double pcsinv = bigc3[m]*delcssq + 1.0;
+          const double pcsinvsq = pcsinv*pcsinv;
+          const double pcs = delcssq/pcsinv;
+          const double facexp = expgsrainv1*sexpgsrainv[kk];
+          const double facrad = bigb3[m] * facexp * pcs;
+          const double frad1 = facrad*gsrainvsq1;
+          const double frad2 = facrad*sgsrainvsq[kk];
+          const double facang = big2b3[m] * facexp * delcs/pcsinvsq;
+          const double facang12 = rinv12*facang;
+          const double csfacang = cs*facang;
+          const double csfac1 = rinvsq1*csfacang;
+          const double csfac2 = srinvsq[kk]*csfacang;
+
+          const double fjx = delx1*(frad1+csfac1)-sdelx[kk]*facang12;
+          const double fjy = dely1*(frad1+csfac1)-sdely[kk]*facang12;
+          const double fjz = delz1*(frad1+csfac1)-sdelz[kk]*facang12;
+          const double fkx = sdelx[kk]*(frad2+csfac2)-delx1*facang12;
+          const double fky = sdely[kk]*(frad2+csfac2)-dely1*facang12;
+          const double fkz = sdelz[kk]*(frad2+csfac2)-delz1*facang12;
+
+          fxtmp -= fjx + fkx;
+          fytmp -= fjy + fky;
+          fztmp -= fjz + fkz;
+          fjxtmp += fjx;
+          fjytmp += fjy;
+          fjztmp += fjz;
+          sfx[kk] += fkx;
+          sfy[kk] += fky;
+          sfz[kk] += fkz;
+        }
+        sfx[jj] += fjxtmp;
+        sfy[jj] += fjytmp;
+        sfz[jj] += fjztmp;
+      }
 
-        if (evflag) ev_tally3(i,j,k,evdwl,0.0,fj,fk,delr1,delr2);
+      for (kk = 0; kk < num3; kk++) {
+        k = neighshort[kk];
+        f[k][0] += sfx[kk];
+        f[k][1] += sfy[kk];
+        f[k][2] += sfz[kk];
       }
-      f[j][0] += fjxtmp;
-      f[j][1] += fjytmp;
-      f[j][2] += fjztmp;
     }
     f[i][0] += fxtmp;
     f[i][1] += fytmp;
@@ -230,6 +362,8 @@ void PairVashishta::allocate()
   memory->create(setflag,n+1,n+1,"pair:setflag");
   memory->create(cutsq,n+1,n+1,"pair:cutsq");
   memory->create(neighshort,maxshort,"pair:neighshort");
+  memory->create(shorttype,maxshort,"pair:shorttype");
+  memory->create(shortsoa,NSHORTSOA,maxshort,"pair:shortsoa");
 
   map = new int[n+1];
 }
@@ -468,6 +602,24 @@ void PairVashishta::setup_params()
     params[m].c0 = params[m].cut*params[m].dvrc - params[m].vrc;
   }
 
+  // copy three-body parameters into contiguous arrays for vectorized loop
+
+  memory->destroy(costheta3);
+  memory->destroy(bigc3);
+  memory->destroy(bigb3);
+  memory->destroy(big2b3);
+  memory->create(costheta3,nparams,"pair:costheta3");
+  memory->create(bigc3,nparams,"pair:bigc3");
+  memory->create(bigb3,nparams,"pair:bigb3");
+  memory->create(big2b3,nparams,"pair:big2b3");
+
+  for (m = 0; m < nparams; m++) {
+    costheta3[m] = params[m].costheta;
+    bigc3[m] = params[m].bigc;
+    bigb3[m] = params[m].bigb;
+    big2b3[m] = params[m].big2b;
+  }
+
   // set cutmax to max of all cutoff params. r0max only for r0
 
   cutmax = 0.0;
@@ -53,6 +53,12 @@ class PairVashishta : public Pair {
   double r0max;       // largest value of r0
   int maxshort;       // size of short neighbor list array
   int *neighshort;    // short neighbor list array
+  int *shorttype;     // element of each short neighbor
+  double **shortsoa;  // per short neighbor values for three-body loop
+
+  // three-body parameters in SoA form, indexed by I-J-K parameter set
+
+  double *costheta3, *bigc3, *bigb3, *big2b3;
 
   void allocate();
   void read_file(char *);
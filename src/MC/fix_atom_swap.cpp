@@ -34,6 +34,7 @@
 #include "kspace.h"
 #include "memory.h"
 #include "modify.h"
+#include "near_bins.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "random_park.h"
@@ -55,7 +56,7 @@ FixAtomSwap::FixAtomSwap(LAMMPS *lmp, int narg, char **arg) :
   idregion(nullptr), type_list(nullptr), mu(nullptr), qtype(nullptr),
   sqrt_mass_ratio(nullptr), local_swap_iatom_list(nullptr),
   local_swap_jatom_list(nullptr), local_swap_atom_list(nullptr),
-  random_equal(nullptr), random_unequal(nullptr), c_pe(nullptr)
+  random_equal(nullptr), random_unequal(nullptr), bins(nullptr), c_pe(nullptr)
 {
   if (narg < 10) error->all(FLERR,"Illegal fix atom/swap command");
 
@@ -96,6 +97,10 @@ FixAtomSwap::FixAtomSwap(LAMMPS *lmp, int narg, char **arg) :
 
   random_unequal = new RanPark(lmp,seed);
 
+  // bins for local energies
+
+  bins = new NearBins(lmp);
+
   // set up reneighboring
 
   force_reneighbor = 1;
@@ -128,6 +133,7 @@ FixAtomSwap::~FixAtomSwap()
   memory->destroy(sqrt_mass_ratio);
   memory->destroy(local_swap_iatom_list);
   memory->destroy(local_swap_jatom_list);
+  delete bins;
   if (regionflag) delete [] idregion;
   delete random_equal;
   delete random_unequal;
@@ -147,6 +153,7 @@ void FixAtomSwap::options(int narg, char **arg)
   nswaptypes = 0;
   nmutypes = 0;
   iregion = -1;
+  full_flag = false;
 
   int iarg = 0;
   while (iarg < narg) {
@@ -170,6 +177,9 @@ void FixAtomSwap::options(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"yes") == 0) semi_grand_flag = 1;
       else error->all(FLERR,"Illegal fix atom/swap command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"full_energy") == 0) {
+      full_flag = true;
+      iarg += 1;
     } else if (strcmp(arg[iarg],"types") == 0) {
       if (iarg+3 > narg) error->all(FLERR,"Illegal fix atom/swap command");
       iarg++;
@@ -276,6 +286,50 @@ void FixAtomSwap::init()
         if (cutsq[type_list[iswaptype]][ktype] != cutsq[type_list[jswaptype]][ktype])
           unequal_cutoffs = true;
 
+  // decide whether to use the full_energy option
+  // local energies require pairwise energies of atoms which do not
+  //   interact with their own periodic images
+  // fixes which contribute to the potential energy also require it
+  // kspace energy of swaps can be computed incrementally
+  //   if the kspace style supports it
+
+  kspace_delta = 0;
+  if (!full_flag) {
+    if (force->kspace && force->kspace->energy_delta_enable &&
+        !force->kspace->slabflag) kspace_delta = 1;
+
+    int imageflag = 0;
+    if (force->pair) {
+      double *h_inv = domain->h_inv;
+      double width[3];
+      width[0] = 1.0/sqrt(h_inv[0]*h_inv[0] + h_inv[5]*h_inv[5] + h_inv[4]*h_inv[4]);
+      width[1] = 1.0/sqrt(h_inv[1]*h_inv[1] + h_inv[3]*h_inv[3]);
+      width[2] = 1.0/h_inv[2];
+      for (int dim = 0; dim < domain->dimension; dim++)
+        if (domain->periodicity[dim] && force->pair->cutforce >= width[dim])
+          imageflag = 1;
+    }
+
+    int fixflag = 0;
+    for (int m = 0; m < modify->nfix; m++)
+      if (modify->fix[m]->energy_global_flag && modify->fix[m]->thermo_energy)
+        fixflag = 1;
+
+    if ((force->kspace && !kspace_delta) ||
+        (force->pair == nullptr) ||
+        (force->pair->single_enable == 0) ||
+        (force->pair_match("^hybrid",0)) ||
+        (force->pair_match("^eam",0)) ||
+        (force->pair->tail_flag) ||
+        (atom->molecular != Atom::ATOMIC) ||
+        (atom->tag_enable == 0) || imageflag || fixflag) {
+      full_flag = true;
+      kspace_delta = 0;
+    }
+  }
+
+  if (!full_flag) bins->init_atoms(force->pair->cutforce);
+
   // check that no swappable atoms are in atom->firstgroup
   // swapping such an atom might not leave firstgroup atoms first
 
@@ -310,24 +364,37 @@ void FixAtomSwap::pre_exchange()
   comm->exchange();
   comm->borders();
   if (domain->triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
-  if (modify->n_pre_neighbor) modify->pre_neighbor();
-  neighbor->build(1);
 
-  energy_stored = energy_full();
+  // atoms do not move during swaps, so bins are built once
+
+  if (full_flag) {
+    if (modify->n_pre_neighbor) modify->pre_neighbor();
+    neighbor->build(1);
+    energy_stored = energy_full();
+  } else {
+    bins->build_atoms();
+    if (kspace_delta) force->kspace->setup_delta();
+  }
 
   int nsuccess = 0;
   if (semi_grand_flag) {
     update_semi_grand_atoms_list();
-    for (int i = 0; i < ncycles; i++) nsuccess += attempt_semi_grand();
+    for (int i = 0; i < ncycles; i++) {
+      if (full_flag) nsuccess += attempt_semi_grand();
+      else nsuccess += attempt_semi_grand_local();
+    }
   } else {
     update_swap_atoms_list();
-    for (int i = 0; i < ncycles; i++) nsuccess += attempt_swap();
+    for (int i = 0; i < ncycles; i++) {
+      if (full_flag) nsuccess += attempt_swap();
+      else nsuccess += attempt_swap_local();
+    }
   }
 
   nswap_attempts += ncycles;
   nswap_successes += nsuccess;
 
-  energy_full();
+  if (full_flag) energy_full();
   next_reneighbor = update->ntimestep + nevery;
 }
 
@@ -492,6 +559,161 @@ int FixAtomSwap::attempt_swap()
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   semi-grand move using only the local energy of the changed atom
+   atom charges are assumed equal and so are not updated
+------------------------------------------------------------------------- */
+
+int FixAtomSwap::attempt_semi_grand_local()
+{
+  if (nswap == 0) return 0;
+
+  int itype,jtype,jswaptype;
+  double epartner;
+
+  int i = pick_semi_grand_atom();
+
+  int success = 0;
+  if (i >= 0) {
+    jswaptype = static_cast<int> (nswaptypes*random_unequal->uniform());
+    jtype = type_list[jswaptype];
+    itype = atom->type[i];
+    while (itype == jtype) {
+      jswaptype = static_cast<int> (nswaptypes*random_unequal->uniform());
+      jtype = type_list[jswaptype];
+    }
+
+    double energy_before = energy_local(i,itype,0,epartner);
+    double energy_after = energy_local(i,jtype,0,epartner);
+
+    if (random_unequal->uniform() <
+        exp(beta*(energy_before - energy_after
+                  + mu[jtype] - mu[itype]))) {
+      atom->type[i] = jtype;
+      if (conserve_ke_flag) {
+        atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+      }
+      success = 1;
+    }
+  }
+
+  int success_all = 0;
+  MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
+
+  if (success_all) {
+    comm->forward_comm_fix(this);
+    update_semi_grand_atoms_list();
+    return 1;
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   swap move using only the local energies of the two swapped atoms
+   the i-j interaction is in both local energies, so it is removed once
+------------------------------------------------------------------------- */
+
+int FixAtomSwap::attempt_swap_local()
+{
+  if ((niswap == 0) || (njswap == 0)) return 0;
+
+  int i = pick_i_swap_atom();
+  int j = pick_j_swap_atom();
+  int itype = type_list[0];
+  int jtype = type_list[1];
+
+  int *type = atom->type;
+  double *q = atom->q;
+  double epartner;
+
+  tagint tags[2],tags_all[2];
+  tags[0] = (i >= 0) ? atom->tag[i] : 0;
+  tags[1] = (j >= 0) ? atom->tag[j] : 0;
+  MPI_Allreduce(tags,tags_all,2,MPI_LMP_TAGINT,MPI_MAX,world);
+
+  double denergy = 0.0;
+  if (i >= 0) {
+    denergy -= energy_local(i,itype,tags_all[1],epartner);
+    denergy += epartner;
+  }
+  if (j >= 0) denergy -= energy_local(j,jtype,tags_all[0],epartner);
+
+  if (i >= 0) {
+    type[i] = jtype;
+    if (atom->q_flag) q[i] = qtype[1];
+  }
+  if (j >= 0) {
+    type[j] = itype;
+    if (atom->q_flag) q[j] = qtype[0];
+  }
+  comm->forward_comm_fix(this);
+
+  if (i >= 0) {
+    denergy += energy_local(i,jtype,tags_all[1],epartner);
+    denergy -= epartner;
+  }
+  if (j >= 0) denergy += energy_local(j,itype,tags_all[0],epartner);
+
+  double denergy_all;
+  MPI_Allreduce(&denergy,&denergy_all,1,MPI_DOUBLE,MPI_SUM,world);
+
+  // kspace energy change of exchanging the two charges
+  // every proc computes it for both sites
+
+  int kspace_flag = kspace_delta && atom->q_flag && qtype[0] != qtype[1];
+  if (kspace_flag) {
+    double xsites[6],xsites_all[6];
+    for (int m = 0; m < 6; m++) xsites[m] = 0.0;
+    if (i >= 0) {
+      xsites[0] = atom->x[i][0];
+      xsites[1] = atom->x[i][1];
+      xsites[2] = atom->x[i][2];
+    }
+    if (j >= 0) {
+      xsites[3] = atom->x[j][0];
+      xsites[4] = atom->x[j][1];
+      xsites[5] = atom->x[j][2];
+    }
+    MPI_Allreduce(xsites,xsites_all,6,MPI_DOUBLE,MPI_SUM,world);
+
+    double *xsite[2] = {&xsites_all[0],&xsites_all[3]};
+    double qold[2] = {qtype[0],qtype[1]};
+    double qnew[2] = {qtype[1],qtype[0]};
+    denergy_all += force->kspace->energy_delta(2,xsite,qold,qnew);
+  }
+
+  if (random_equal->uniform() < exp(-beta*denergy_all)) {
+    update_swap_atoms_list();
+    if (kspace_flag) force->kspace->accept_delta(comm->me == 0);
+    if (conserve_ke_flag) {
+      if (i >= 0) {
+        atom->v[i][0] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][1] *= sqrt_mass_ratio[itype][jtype];
+        atom->v[i][2] *= sqrt_mass_ratio[itype][jtype];
+      }
+      if (j >= 0) {
+        atom->v[j][0] *= sqrt_mass_ratio[jtype][itype];
+        atom->v[j][1] *= sqrt_mass_ratio[jtype][itype];
+        atom->v[j][2] *= sqrt_mass_ratio[jtype][itype];
+      }
+    }
+    return 1;
+  }
+
+  if (i >= 0) {
+    type[i] = itype;
+    if (atom->q_flag) q[i] = qtype[0];
+  }
+  if (j >= 0) {
+    type[j] = jtype;
+    if (atom->q_flag) q[j] = qtype[1];
+  }
+  comm->forward_comm_fix(this);
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    compute system potential energy
 ------------------------------------------------------------------------- */
@@ -524,6 +746,56 @@ double FixAtomSwap::energy_full()
   return total_energy;
 }
 
+/* ----------------------------------------------------------------------
+   compute interaction energy of atom i as type itype with all other atoms
+   epartner = part of it due to interactions with atom ID jtag, 0 for none
+------------------------------------------------------------------------- */
+
+double FixAtomSwap::energy_local(int i, int itype, tagint jtag, double &epartner)
+{
+  double delx,dely,delz,rsq,eng;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  tagint *tag = atom->tag;
+  class Pair *pair = force->pair;
+  double **cutsq = force->pair->cutsq;
+
+  double fpair = 0.0;
+  double factor_coul = 1.0;
+  double factor_lj = 1.0;
+
+  double total_energy = 0.0;
+  epartner = 0.0;
+
+  // only atoms in bins around atom i can be within the cutoff
+
+  int *binhead = bins->binhead;
+  int *next = bins->next;
+  int stencil[27];
+  int nstencil = bins->stencil(x[i],stencil);
+
+  for (int s = 0; s < nstencil; s++) {
+    for (int j = binhead[stencil[s]]; j >= 0; j = next[j]) {
+      if (i == j) continue;
+
+      delx = x[i][0] - x[j][0];
+      dely = x[i][1] - x[j][1];
+      delz = x[i][2] - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      int jtype = type[j];
+
+      if (rsq < cutsq[itype][jtype]) {
+        eng = pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+        total_energy += eng;
+        if (tag[j] == jtag) epartner += eng;
+      }
+    }
+  }
+
+  return total_energy;
+}
+
 /* ----------------------------------------------------------------------
 ------------------------------------------------------------------------- */
 
@@ -756,6 +1028,7 @@ double FixAtomSwap::compute_vector(int n)
 double FixAtomSwap::memory_usage()
 {
   double bytes = (double)atom_swap_nmax * sizeof(int);
+  bytes += bins->memory_usage();
   return bytes;
 }
 
@@ -33,7 +33,10 @@ class FixAtomSwap : public Fix {
   void pre_exchange();
   int attempt_semi_grand();
   int attempt_swap();
+  int attempt_semi_grand_local();
+  int attempt_swap_local();
   double energy_full();
+  double energy_local(int, int, tagint, double &);
   int pick_semi_grand_atom();
   int pick_i_swap_atom();
   int pick_j_swap_atom();
@@ -69,6 +72,8 @@ class FixAtomSwap : public Fix {
   double nswap_successes;
 
   bool unequal_cutoffs;
+  bool full_flag;        // true if doing full system energy calculations
+  int kspace_delta;      // 1 if kspace energy is computed incrementally
 
   int atom_swap_nmax;
   double beta;
@@ -81,6 +86,7 @@ class FixAtomSwap : public Fix {
 
   class RanPark *random_equal;
   class RanPark *random_unequal;
+  class NearBins *bins;    // bins for local energies
 
   class Compute *c_pe;
 
@@ -37,6 +37,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
+#include "near_bins.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "random_park.h"
@@ -70,7 +71,7 @@ FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg),
   idregion(nullptr), full_flag(0), ngroups(0), groupstrings(nullptr), ngrouptypes(0), grouptypestrings(nullptr),
   grouptypebits(nullptr), grouptypes(nullptr), local_gas_list(nullptr), molcoords(nullptr), molq(nullptr), molimage(nullptr),
-  random_equal(nullptr), random_unequal(nullptr),
+  random_equal(nullptr), random_unequal(nullptr), bins(nullptr),
   fixrigid(nullptr), fixshake(nullptr), idrigid(nullptr), idshake(nullptr)
 {
   if (narg < 11) error->all(FLERR,"Illegal fix gcmc command");
@@ -118,6 +119,10 @@ FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
 
   random_unequal = new RanPark(lmp,seed);
 
+  // bins for local energies and overlap checks
+
+  bins = new NearBins(lmp);
+
   // error checks on region and its extent being inside simulation box
 
   region_xlo = region_xhi = region_ylo = region_yhi =
@@ -400,6 +405,7 @@ FixGCMC::~FixGCMC()
   if (regionflag) delete [] idregion;
   delete random_equal;
   delete random_unequal;
+  delete bins;
 
   memory->destroy(local_gas_list);
   memory->destroy(molcoords);
@@ -470,20 +476,34 @@ void FixGCMC::init()
   }
 
   // decide whether to switch to the full_energy option
+  // kspace energy of atom exchanges and moves can be computed
+  //   incrementally if the kspace style supports it
+
+  kspace_delta = 0;
+  if (!full_flag && force->kspace && force->kspace->energy_delta_enable &&
+      !force->kspace->slabflag && exchmode == EXCHATOM && movemode == MOVEATOM)
+    kspace_delta = 1;
 
   if (!full_flag) {
-    if ((force->kspace) ||
+    if ((force->kspace && !kspace_delta) ||
         (force->pair == nullptr) ||
         (force->pair->single_enable == 0) ||
         (force->pair_match("^hybrid",0)) ||
         (force->pair_match("^eam",0)) ||
         (force->pair->tail_flag)) {
       full_flag = true;
+      kspace_delta = 0;
       if (comm->me == 0)
         error->warning(FLERR,"Fix gcmc using full_energy option");
     }
   }
 
+  // bins must hold all atoms within pair cutoff or overlap cutoff
+
+  double cutbin = sqrt(overlap_cutoffsq);
+  if (force->pair) cutbin = MAX(cutbin,force->pair->cutforce);
+  bins->init_atoms(cutbin);
+
   if (full_flag) c_pe = modify->compute[modify->find_compute("thermo_pe")];
 
   int *type = atom->type;
@@ -765,6 +785,8 @@ void FixGCMC::pre_exchange()
 
   } else {
 
+    if (kspace_delta) force->kspace->setup_delta();
+
     for (int i = 0; i < ncycles; i++) {
       int ixm = static_cast<int>(random_equal->uniform()*ncycles) + 1;
       if (ixm <= nmcmoves) {
@@ -836,6 +858,12 @@ void FixGCMC::attempt_atomic_translation()
       error->one(FLERR,"Fix gcmc put atom outside box");
 
     double energy_after = energy(i,ngcmc_type,-1,coord);
+    if (kspace_delta && energy_after < MAXENERGYTEST) {
+      double *xsite[2] = {x[i],coord};
+      double qold[2] = {atom->q[i],0.0};
+      double qnew[2] = {0.0,atom->q[i]};
+      energy_after += force->kspace->energy_delta(2,xsite,qold,qnew);
+    }
 
     if (energy_after < MAXENERGYTEST &&
         random_unequal->uniform() <
@@ -858,6 +886,7 @@ void FixGCMC::attempt_atomic_translation()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    if (kspace_delta) force->kspace->accept_delta(success);
     ntranslation_successes += 1.0;
   }
 }
@@ -876,6 +905,11 @@ void FixGCMC::attempt_atomic_deletion()
   int success = 0;
   if (i >= 0) {
     double deletion_energy = energy(i,ngcmc_type,-1,atom->x[i]);
+    if (kspace_delta) {
+      double qnew = 0.0;
+      deletion_energy -=
+        force->kspace->energy_delta(1,&atom->x[i],&atom->q[i],&qnew);
+    }
     if (random_unequal->uniform() <
         ngas*exp(beta*deletion_energy)/(zz*volume)) {
       atom->avec->copy(atom->nlocal-1,i,1);
@@ -897,6 +931,7 @@ void FixGCMC::attempt_atomic_deletion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    if (kspace_delta) force->kspace->accept_delta(success);
     ndeletion_successes += 1.0;
   }
 }
@@ -971,12 +1006,18 @@ void FixGCMC::attempt_atomic_insertion()
       atom->q[ii] = charge;
     }
     double insertion_energy = energy(ii,ngcmc_type,-1,coord);
+    if (kspace_delta && charge_flag && insertion_energy < MAXENERGYTEST) {
+      double *xsite = coord;
+      double qold = 0.0;
+      insertion_energy += force->kspace->energy_delta(1,&xsite,&qold,&charge);
+    }
 
     if (insertion_energy < MAXENERGYTEST &&
         random_unequal->uniform() <
         zz*volume*exp(-beta*insertion_energy)/(ngas+1)) {
       atom->avec->create_atom(ngcmc_type,coord);
       int m = atom->nlocal - 1;
+      if (charge_flag) atom->q[m] = charge;
 
       // add to groups
       // optionally add to type-based groups
@@ -1010,6 +1051,7 @@ void FixGCMC::attempt_atomic_insertion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    if (kspace_delta) force->kspace->accept_delta(success && charge_flag);
     ninsertion_successes += 1.0;
   }
 }
@@ -2185,7 +2227,6 @@ double FixGCMC::energy(int i, int itype, tagint imolecule, double *coord)
   double **x = atom->x;
   int *type = atom->type;
   tagint *molecule = atom->molecule;
-  int nall = atom->nlocal + atom->nghost;
   pair = force->pair;
   cutsq = force->pair->cutsq;
 
@@ -2195,27 +2236,37 @@ double FixGCMC::energy(int i, int itype, tagint imolecule, double *coord)
 
   double total_energy = 0.0;
 
-  for (int j = 0; j < nall; j++) {
+  // only atoms in bins around coord can be within the cutoff
 
-    if (i == j) continue;
-    if (exchmode == EXCHMOL || movemode == MOVEMOL)
-      if (imolecule == molecule[j]) continue;
+  bins->update();
+  int *binhead = bins->binhead;
+  int *next = bins->next;
+  int stencil[27];
+  int nstencil = bins->stencil(coord,stencil);
 
-    delx = coord[0] - x[j][0];
-    dely = coord[1] - x[j][1];
-    delz = coord[2] - x[j][2];
-    rsq = delx*delx + dely*dely + delz*delz;
-    int jtype = type[j];
+  for (int s = 0; s < nstencil; s++) {
+    for (int j = binhead[stencil[s]]; j >= 0; j = next[j]) {
 
-    // if overlap check requested, if overlap,
-    // return signal value for energy
+      if (i == j) continue;
+      if (exchmode == EXCHMOL || movemode == MOVEMOL)
+        if (imolecule == molecule[j]) continue;
 
-    if (overlap_flag && rsq < overlap_cutoffsq)
-      return MAXENERGYSIGNAL;
+      delx = coord[0] - x[j][0];
+      dely = coord[1] - x[j][1];
+      delz = coord[2] - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      int jtype = type[j];
 
-    if (rsq < cutsq[itype][jtype])
-      total_energy +=
-        pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+      // if overlap check requested, if overlap,
+      // return signal value for energy
+
+      if (overlap_flag && rsq < overlap_cutoffsq)
+        return MAXENERGYSIGNAL;
+
+      if (rsq < cutsq[itype][jtype])
+        total_energy +=
+          pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+    }
   }
 
   return total_energy;
@@ -2268,23 +2319,35 @@ double FixGCMC::energy_full()
     double delx,dely,delz,rsq;
     double **x = atom->x;
     tagint *molecule = atom->molecule;
-    int nall = atom->nlocal + atom->nghost;
+
+    // only pairs of atoms in neighboring bins can overlap
+
+    bins->build_atoms();
+    int *binhead = bins->binhead;
+    int *next = bins->next;
+    int stencil[27];
+
     for (int i = 0; i < atom->nlocal; i++) {
       if (exchmode == EXCHMOL || movemode == MOVEMOL)
         imolecule = molecule[i];
-      for (int j = i+1; j < nall; j++) {
-        if (exchmode == EXCHMOL || movemode == MOVEMOL)
-          if (imolecule == molecule[j]) continue;
-
-        delx = x[i][0] - x[j][0];
-        dely = x[i][1] - x[j][1];
-        delz = x[i][2] - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq < overlap_cutoffsq) {
-          overlaptest = 1;
-          break;
+      int nstencil = bins->stencil(x[i],stencil);
+      for (int s = 0; s < nstencil; s++) {
+        for (int j = binhead[stencil[s]]; j >= 0; j = next[j]) {
+          if (j <= i) continue;
+          if (exchmode == EXCHMOL || movemode == MOVEMOL)
+            if (imolecule == molecule[j]) continue;
+
+          delx = x[i][0] - x[j][0];
+          dely = x[i][1] - x[j][1];
+          delz = x[i][2] - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+
+          if (rsq < overlap_cutoffsq) {
+            overlaptest = 1;
+            break;
+          }
         }
+        if (overlaptest) break;
       }
       if (overlaptest) break;
     }
@@ -2402,6 +2465,10 @@ void FixGCMC::update_gas_atoms_list()
   tagint *molecule = atom->molecule;
   double **x = atom->x;
 
+  // called whenever atoms were changed, so bins must be rebuilt
+
+  bins->invalidate();
+
   if (atom->nmax > gcmc_nmax) {
     memory->sfree(local_gas_list);
     gcmc_nmax = atom->nmax;
@@ -2503,6 +2570,7 @@ double FixGCMC::compute_vector(int n)
 double FixGCMC::memory_usage()
 {
   double bytes = (double)gcmc_nmax * sizeof(int);
+  bytes += bins->memory_usage();
   return bytes;
 }
 
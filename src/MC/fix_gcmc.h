@@ -76,6 +76,7 @@ class FixGCMC : public Fix {
   bool pressure_flag;    // true if user specified reservoir pressure
   bool charge_flag;      // true if user specified atomic charge
   bool full_flag;        // true if doing full system energy calculations
+  int kspace_delta;      // 1 if kspace energy is computed incrementally
 
   int natoms_per_molecule;    // number of atoms in each inserted molecule
   int nmaxmolatoms;           // number of atoms allocated for molecule arrays
@@ -128,6 +129,7 @@ class FixGCMC : public Fix {
 
   class RanPark *random_equal;
   class RanPark *random_unequal;
+  class NearBins *bins;    // bins for local energies and overlap checks
 
   class Atom *model_atom;
 
@@ -37,6 +37,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
+#include "near_bins.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "random_park.h"
@@ -61,7 +62,7 @@ FixWidom::FixWidom(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg),
   idregion(nullptr), full_flag(0),
   local_gas_list(nullptr), molcoords(nullptr), molq(nullptr), molimage(nullptr),
-  random_equal(nullptr)
+  random_equal(nullptr), bins(nullptr)
 {
   if (narg < 8) error->all(FLERR,"Illegal fix widom command");
 
@@ -101,6 +102,10 @@ FixWidom::FixWidom(LAMMPS *lmp, int narg, char **arg) :
 
   random_equal = new RanPark(lmp,seed);
 
+  // bins for local energies
+
+  bins = new NearBins(lmp);
+
   // error checks on region and its extent being inside simulation box
 
   region_xlo = region_xhi = region_ylo = region_yhi =
@@ -250,6 +255,7 @@ FixWidom::~FixWidom()
 {
   if (regionflag) delete [] idregion;
   delete random_equal;
+  delete bins;
 
   memory->destroy(local_gas_list);
   memory->destroy(molcoords);
@@ -280,19 +286,30 @@ void FixWidom::init()
   else volume = domain->xprd * domain->yprd * domain->zprd;
 
   // decide whether to switch to the full_energy option
+  // kspace energy of atom insertions can be computed
+  //   incrementally if the kspace style supports it
+
+  kspace_delta = 0;
+  if (!full_flag && force->kspace && force->kspace->energy_delta_enable &&
+      !force->kspace->slabflag && exchmode == EXCHATOM)
+    kspace_delta = 1;
+
   if (!full_flag) {
-    if ((force->kspace) ||
+    if ((force->kspace && !kspace_delta) ||
         (force->pair == nullptr) ||
         (force->pair->single_enable == 0) ||
         (force->pair_match("hybrid",0)) ||
         (force->pair_match("eam",0)) ||
         (force->pair->tail_flag)) {
       full_flag = true;
+      kspace_delta = 0;
       if (comm->me == 0)
         error->warning(FLERR,"Fix widom using full_energy option");
     }
   }
 
+  if (force->pair) bins->init_atoms(force->pair->cutforce);
+
   if (full_flag) c_pe = modify->compute[modify->find_compute("thermo_pe")];
 
   if (exchmode == EXCHATOM) {
@@ -467,6 +484,8 @@ void FixWidom::pre_exchange()
 
   } else {
 
+    if (kspace_delta) force->kspace->setup_delta();
+
     if (exchmode == EXCHATOM) {
       attempt_atomic_insertion();
     } else {
@@ -545,6 +564,11 @@ void FixWidom::attempt_atomic_insertion()
         atom->q[ii] = charge;
       }
       double insertion_energy = energy(ii,nwidom_type,-1,coord);
+      if (kspace_delta && charge_flag) {
+        double *xsite = coord;
+        double qold = 0.0;
+        insertion_energy += force->kspace->energy_delta(1,&xsite,&qold,&charge);
+      }
       double inst_chem_pot = exp(-insertion_energy*beta);
       double incr_chem_pot = (inst_chem_pot - ave_widom_chemical_potential);
       ave_widom_chemical_potential += incr_chem_pot / (imove + 1);
@@ -961,7 +985,6 @@ double FixWidom::energy(int i, int itype, tagint imolecule, double *coord)
   double **x = atom->x;
   int *type = atom->type;
   tagint *molecule = atom->molecule;
-  int nall = atom->nlocal + atom->nghost;
   pair = force->pair;
   cutsq = force->pair->cutsq;
 
@@ -971,21 +994,31 @@ double FixWidom::energy(int i, int itype, tagint imolecule, double *coord)
 
   double total_energy = 0.0;
 
-  for (int j = 0; j < nall; j++) {
+  // only atoms in bins around coord can be within the cutoff
+
+  bins->update();
+  int *binhead = bins->binhead;
+  int *next = bins->next;
+  int stencil[27];
+  int nstencil = bins->stencil(coord,stencil);
+
+  for (int s = 0; s < nstencil; s++) {
+    for (int j = binhead[stencil[s]]; j >= 0; j = next[j]) {
 
-    if (i == j) continue;
-    if (exchmode == EXCHMOL)
-      if (imolecule == molecule[j]) continue;
+      if (i == j) continue;
+      if (exchmode == EXCHMOL)
+        if (imolecule == molecule[j]) continue;
 
-    delx = coord[0] - x[j][0];
-    dely = coord[1] - x[j][1];
-    delz = coord[2] - x[j][2];
-    rsq = delx*delx + dely*dely + delz*delz;
-    int jtype = type[j];
+      delx = coord[0] - x[j][0];
+      dely = coord[1] - x[j][1];
+      delz = coord[2] - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      int jtype = type[j];
 
-    if (rsq < cutsq[itype][jtype])
-      total_energy +=
-        pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+      if (rsq < cutsq[itype][jtype])
+        total_energy +=
+          pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+    }
   }
 
   return total_energy;
@@ -1077,6 +1110,10 @@ void FixWidom::update_gas_atoms_list()
   tagint *molecule = atom->molecule;
   double **x = atom->x;
 
+  // called whenever atoms were changed, so bins must be rebuilt
+
+  bins->invalidate();
+
   if (atom->nmax > widom_nmax) {
     memory->sfree(local_gas_list);
     widom_nmax = atom->nmax;
@@ -1172,6 +1209,7 @@ double FixWidom::compute_vector(int n)
 double FixWidom::memory_usage()
 {
   double bytes = (double)widom_nmax * sizeof(int);
+  bytes += bins->memory_usage();
   return bytes;
 }
 
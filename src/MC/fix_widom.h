@@ -62,6 +62,7 @@ class FixWidom : public Fix {
   char *idregion;      // widom region id
   bool charge_flag;    // true if user specified atomic charge
   bool full_flag;      // true if doing full system energy calculations
+  int kspace_delta;    // 1 if kspace energy is computed incrementally
 
   int natoms_per_molecule;    // number of atoms in each inserted molecule
   int nmaxmolatoms;           // number of atoms allocated for molecule arrays
@@ -91,6 +92,7 @@ class FixWidom : public Fix {
   class Pair *pair;
 
   class RanPark *random_equal;
+  class NearBins *bins;    // bins for local energies
 
   class Atom *model_atom;
 
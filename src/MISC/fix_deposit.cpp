@@ -26,6 +26,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
+#include "near_bins.h"
 #include "random_park.h"
 #include "region.h"
 #include "update.h"
@@ -47,7 +48,7 @@ enum{DIST_UNIFORM,DIST_GAUSSIAN};
 FixDeposit::FixDeposit(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg), idregion(nullptr), idrigid(nullptr),
   idshake(nullptr), onemols(nullptr), molfrac(nullptr), coords(nullptr), imageflags(nullptr),
-  fixrigid(nullptr), fixshake(nullptr), random(nullptr)
+  fixrigid(nullptr), fixshake(nullptr), bins(nullptr), random(nullptr)
 {
   if (narg < 7) error->all(FLERR,"Illegal fix deposit command");
 
@@ -204,6 +205,7 @@ FixDeposit::FixDeposit(LAMMPS *lmp, int narg, char **arg) :
 FixDeposit::~FixDeposit()
 {
   delete random;
+  delete bins;
   delete [] molfrac;
   delete [] idrigid;
   delete [] idshake;
@@ -343,6 +345,33 @@ void FixDeposit::pre_exchange()
 
   if (!idnext) find_maxid();
 
+  // bin my atoms for the near distance test, they do not move between
+  //   attempts, so each attempt only checks atoms in nearby bins
+  // binned volume covers my sub-domain and all my atoms
+  // triclinic boxes check all my atoms
+
+  int binflag = 0;
+  if (nearsq > 0.0 && domain->triclinic == 0) {
+    if (!bins) bins = new NearBins(lmp);
+
+    double **x = atom->x;
+    int nlocal = atom->nlocal;
+    double bboxlo[3],bboxhi[3];
+    for (m = 0; m < 3; m++) {
+      bboxlo[m] = domain->sublo[m];
+      bboxhi[m] = domain->subhi[m];
+    }
+    for (i = 0; i < nlocal; i++)
+      for (m = 0; m < 3; m++) {
+        bboxlo[m] = MIN(bboxlo[m],x[i][m]);
+        bboxhi[m] = MAX(bboxhi[m],x[i][m]);
+      }
+
+    bins->setup(sqrt(nearsq),bboxlo,bboxhi,nlocal);
+    for (i = 0; i < nlocal; i++) bins->add(x[i],0.0);
+    binflag = 1;
+  }
+
   // attempt an insertion until successful
 
   int dimension = domain->dimension;
@@ -462,22 +491,34 @@ void FixDeposit::pre_exchange()
     // if less than near, try again
     // use minimum_image() to account for PBC
 
-    double **x = atom->x;
-    int nlocal = atom->nlocal;
+    // no test needed if near is not set, since rsq < 0 is impossible
 
-    flag = 0;
-    for (m = 0; m < natom; m++) {
-      for (i = 0; i < nlocal; i++) {
-        delx = coords[m][0] - x[i][0];
-        dely = coords[m][1] - x[i][1];
-        delz = coords[m][2] - x[i][2];
-        domain->minimum_image(delx,dely,delz);
-        rsq = delx*delx + dely*dely + delz*delz;
-        if (rsq < nearsq) flag = 1;
+    if (nearsq > 0.0) {
+      flag = 0;
+      if (binflag) {
+        for (m = 0; m < natom; m++)
+          if (bins->within(coords[m],nearsq)) {
+            flag = 1;
+            break;
+          }
+      } else {
+        double **x = atom->x;
+        int nlocal = atom->nlocal;
+
+        for (m = 0; m < natom; m++) {
+          for (i = 0; i < nlocal; i++) {
+            delx = coords[m][0] - x[i][0];
+            dely = coords[m][1] - x[i][1];
+            delz = coords[m][2] - x[i][2];
+            domain->minimum_image(delx,dely,delz);
+            rsq = delx*delx + dely*dely + delz*delz;
+            if (rsq < nearsq) flag = 1;
+          }
+        }
       }
+      MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+      if (flagall) continue;
     }
-    MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
-    if (flagall) continue;
 
     // proceed with insertion
 
@@ -54,6 +54,7 @@ class FixDeposit : public Fix {
   imageint *imageflags;
   class Fix *fixrigid, *fixshake;
   double oneradius;
+  class NearBins *bins;    // bins of my atoms for near distance test
 
   int ninserted;
   bigint nfirst;
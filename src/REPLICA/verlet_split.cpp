@@ -45,6 +45,9 @@ using namespace LAMMPS_NS;
 VerletSplit::VerletSplit(LAMMPS *lmp, int narg, char **arg) :
   Verlet(lmp, narg, arg), qsize(nullptr), qdisp(nullptr), xsize(nullptr), xdisp(nullptr), f_kspace(nullptr)
 {
+  if (overlap)
+    error->universe_all(FLERR,"Verlet/split does not support overlap yes");
+
   // error checks on partitions
 
   if (universe->nworlds != 2)
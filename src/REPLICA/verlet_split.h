@@ -57,6 +57,11 @@ class VerletSplit : public Verlet {
 
 /* ERROR/WARNING messages:
 
+E: Verlet/split does not support overlap yes
+
+Overlap of communication and pair forces is only available for run
+style verlet.
+
 E: Verlet/split requires 2 partitions
 
 See the -partition command-line switch.
@@ -357,6 +357,48 @@ int MPI_Get_count(MPI_Status *status, MPI_Datatype datatype, int *count)
 
 /* ---------------------------------------------------------------------- */
 
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                  MPI_Comm comm, MPI_Request *request)
+{
+  static int callcount = 0;
+  if (callcount == 0) {
+    printf("MPI Stub WARNING: Should not send message to self\n");
+    ++callcount;
+  }
+  *request = MPI_REQUEST_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request)
+{
+  static int callcount = 0;
+  if (callcount == 0) {
+    printf("MPI Stub WARNING: Should not recv message from self\n");
+    ++callcount;
+  }
+  *request = MPI_REQUEST_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Start(MPI_Request *request)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Startall(int count, MPI_Request *request)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm *comm_out)
 {
   *comm_out = comm + 1;
@@ -365,6 +407,15 @@ int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm *comm_out)
 
 /* ---------------------------------------------------------------------- */
 
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm *comm_out)
+{
+  *comm_out = comm + 1;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int MPI_Comm_dup(MPI_Comm comm, MPI_Comm *comm_out)
 {
   *comm_out = comm + 1;
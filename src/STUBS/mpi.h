@@ -51,6 +51,9 @@
 
 #define MPI_UNDEFINED -1
 #define MPI_COMM_NULL -1
+#define MPI_REQUEST_NULL -1
+#define MPI_INFO_NULL -1
+#define MPI_COMM_TYPE_SHARED 1
 #define MPI_GROUP_EMPTY -1
 
 #define MPI_ANY_SOURCE -1
@@ -62,6 +65,7 @@
 #define MPI_Op int
 #define MPI_Fint int
 #define MPI_Group int
+#define MPI_Info int
 #define MPI_Offset long
 
 #define MPI_IN_PLACE NULL
@@ -111,8 +115,16 @@ int MPI_Sendrecv(const void *sbuf, int scount, MPI_Datatype sdatatype, int dest,
                  void *rbuf, int rcount, MPI_Datatype rdatatype, int source, int rtag,
                  MPI_Comm comm, MPI_Status *status);
 int MPI_Get_count(MPI_Status *status, MPI_Datatype datatype, int *count);
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                  MPI_Comm comm, MPI_Request *request);
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request);
+int MPI_Start(MPI_Request *request);
+int MPI_Startall(int count, MPI_Request *request);
 
 int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm *comm_out);
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm *comm_out);
 int MPI_Comm_dup(MPI_Comm comm, MPI_Comm *comm_out);
 int MPI_Comm_free(MPI_Comm *comm);
 MPI_Fint MPI_Comm_c2f(MPI_Comm comm);
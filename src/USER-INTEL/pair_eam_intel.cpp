@@ -43,6 +43,7 @@ using namespace LAMMPS_NS;
 
 PairEAMIntel::PairEAMIntel(LAMMPS *lmp) : PairEAM(lmp)
 {
+  cacheflag = 0;
   suffix_flag |= Suffix::INTEL;
   fp_float = 0;
 }
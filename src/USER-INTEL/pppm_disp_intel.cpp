@@ -300,7 +300,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
               density_brick, density_fft, work1,remap);
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1, work2, density_fft, fft1, fft2,
+      poisson_ad(work1, work2, density_fft, fft1, fft2, r2c_flag,
                  nx_pppm, ny_pppm, nz_pppm, nfft,
                  nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft,
                  nxlo_in, nylo_in, nzlo_in, nxhi_in, nyhi_in, nzhi_in,
@@ -323,7 +323,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
                                 gc_buf1,gc_buf2,MPI_FFT_SCALAR);
 
     } else {
-      poisson_ik(work1, work2, density_fft, fft1, fft2,
+      poisson_ik(work1, work2, density_fft, fft1, fft2, r2c_flag,
                  nx_pppm, ny_pppm, nz_pppm, nfft,
                  nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft,
                  nxlo_in, nylo_in, nzlo_in, nxhi_in, nyhi_in, nzhi_in,
@@ -384,7 +384,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
               density_brick_g, density_fft_g, work1_6,remap_6);
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1_6, work2_6, density_fft_g, fft1_6, fft2_6,
+      poisson_ad(work1_6, work2_6, density_fft_g, fft1_6, fft2_6, r2c_flag_6,
                  nx_pppm_6, ny_pppm_6, nz_pppm_6, nfft_6,
                  nxlo_fft_6, nylo_fft_6, nzlo_fft_6, nxhi_fft_6,
                  nyhi_fft_6, nzhi_fft_6, nxlo_in_6, nylo_in_6, nzlo_in_6,
@@ -408,7 +408,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
                                  gc6_buf1,gc6_buf2,MPI_FFT_SCALAR);
 
     } else {
-      poisson_ik(work1_6, work2_6, density_fft_g, fft1_6, fft2_6,
+      poisson_ik(work1_6, work2_6, density_fft_g, fft1_6, fft2_6, r2c_flag_6,
                  nx_pppm_6, ny_pppm_6, nz_pppm_6, nfft_6, nxlo_fft_6,
                  nylo_fft_6, nzlo_fft_6, nxhi_fft_6, nyhi_fft_6, nzhi_fft_6,
                  nxlo_in_6, nylo_in_6, nzlo_in_6, nxhi_in_6, nyhi_in_6,
@@ -468,7 +468,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
     brick2fft_a();
 
     if (differentiation_flag == 1) {
-      poisson_ad(work1_6, work2_6, density_fft_a3, fft1_6, fft2_6,
+      poisson_ad(work1_6, work2_6, density_fft_a3, fft1_6, fft2_6, r2c_flag_6,
                  nx_pppm_6, ny_pppm_6, nz_pppm_6, nfft_6, nxlo_fft_6,
                  nylo_fft_6, nzlo_fft_6, nxhi_fft_6, nyhi_fft_6, nzhi_fft_6,
                  nxlo_in_6, nylo_in_6, nzlo_in_6, nxhi_in_6, nyhi_in_6,
@@ -504,7 +504,7 @@ void PPPMDispIntel::compute(int eflag, int vflag)
                                  gc6_buf1,gc6_buf2,MPI_FFT_SCALAR);
 
     }  else {
-      poisson_ik(work1_6, work2_6, density_fft_a3, fft1_6, fft2_6,
+      poisson_ik(work1_6, work2_6, density_fft_a3, fft1_6, fft2_6, r2c_flag_6,
                  nx_pppm_6, ny_pppm_6, nz_pppm_6, nfft_6, nxlo_fft_6,
                  nylo_fft_6, nzlo_fft_6, nxhi_fft_6, nyhi_fft_6, nzhi_fft_6,
                  nxlo_in_6, nylo_in_6, nzlo_in_6, nxhi_in_6, nyhi_in_6,
@@ -63,6 +63,9 @@ enum{FORWARD_IK,FORWARD_AD,FORWARD_IK_PERATOM,FORWARD_AD_PERATOM};
 PPPMIntel::PPPMIntel(LAMMPS *lmp) : PPPM(lmp)
 {
   suffix_flag |= Suffix::INTEL;
+  r2c_support = 0;
+  gridsort_support = 0;
+  fft_single_support = 0;
 
   order = 7; //sets default stencil size to 7
 
@@ -45,6 +45,8 @@ using namespace LAMMPS_NS;
 
 VerletLRTIntel::VerletLRTIntel(LAMMPS *lmp, int narg, char **arg) :
   Verlet(lmp, narg, arg) {
+  if (overlap)
+    error->all(FLERR,"Run style verlet/lrt/intel does not support overlap yes");
   #if defined(_LMP_INTEL_LRT_PTHREAD)
   pthread_mutex_init(&_kmutex,nullptr);
   #endif
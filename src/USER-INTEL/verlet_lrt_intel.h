@@ -71,6 +71,11 @@ class VerletLRTIntel : public Verlet {
 
 /* ERROR/WARNING messages:
 
+E: Run style verlet/lrt/intel does not support overlap yes
+
+Overlap of communication and pair forces is only available for run
+style verlet.
+
 E: LRT otion for Intel package disabled at compile time
 
 This option cannot be used with the Intel package because LAMMPS was not built
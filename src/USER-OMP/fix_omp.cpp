@@ -21,6 +21,7 @@
 #include "thr_data.h"
 
 #include "atom.h"
+#include "atom_vec.h"
 #include "comm.h"
 #include "error.h"
 #include "force.h"
@@ -63,7 +64,8 @@ static int get_tid()
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(nullptr), last_omp_style(nullptr), last_pair_hybrid(nullptr),
-     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
+     color_style(nullptr), _nthr(-1), _neighbor(true), _mixed(false),
+     _reduced(true), _color(false), _color_active(false),
      _pair_compute_flag(false), _kspace_compute_flag(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
@@ -103,6 +105,12 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) _neighbor = false;
       else error->all(FLERR,"Illegal package omp command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"color") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      if (strcmp(arg[iarg+1],"yes") == 0) _color = true;
+      else if (strcmp(arg[iarg+1],"no") == 0) _color = false;
+      else error->all(FLERR,"Illegal package omp command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
@@ -214,6 +222,7 @@ void FixOMP::init()
   else _kspace_compute_flag = false;
 
   int check_hybrid, kspace_split;
+  int nomp = 0;
   last_pair_hybrid = nullptr;
   last_omp_style = nullptr;
   const char *last_omp_name = nullptr;
@@ -242,6 +251,7 @@ void FixOMP::init()
          (strcmp(force->name ## _style,"hybrid/overlay") == 0) )        \
       check_hybrid=1;                                                   \
     if (force->name->suffix_flag & Suffix::OMP) {                       \
+      ++nomp;                                                           \
       last_force_name = (const char *) #name;                           \
       last_omp_name = force->name ## _style;                            \
       last_omp_style = (void *) force->name;                            \
@@ -253,6 +263,7 @@ void FixOMP::init()
     Class ## Hybrid *style = (Class ## Hybrid *) force->name; \
     for (int i=0; i < style->nstyles; i++) {                  \
       if (style->styles[i]->suffix_flag & Suffix::OMP) {      \
+        ++nomp;                                               \
         last_force_name = (const char *) #name;               \
         last_omp_name = style->keywords[i];                   \
         last_omp_style = style->styles[i];                    \
@@ -289,6 +300,31 @@ void FixOMP::init()
 #undef CheckHybridForOMP
   set_neighbor_omp();
 
+  // threads can share the force array only if a single non-hybrid
+  // pair style computes all threaded forces and registered during its
+  // init_style() that it processes atoms by tile colors
+
+  _color_active = false;
+  if (_color) {
+    if ((nomp == 1) && (last_omp_style == (void *) force->pair)
+        && (color_style == last_omp_style) && (last_pair_hybrid == nullptr)
+        && !utils::strmatch(update->integrate_style,"^respa"))
+      _color_active = true;
+    else if (comm->me == 0)
+      error->warning(FLERR,"Package omp color is not supported by the "
+                     "current force styles");
+  }
+  color_style = nullptr;
+
+  // with colored tiles no per-thread copies of the force array are
+  // needed. regrow it when this changes, atom->nmax stays the same.
+
+  const int fshared = _color_active ? 1 : 0;
+  if (atom->fshared != fshared) {
+    atom->fshared = fshared;
+    if (atom->nmax > 0) atom->avec->grow(atom->nmax);
+  }
+
   // diagnostic output
   if (comm->me == 0) {
     if (last_omp_style) {
@@ -304,6 +340,12 @@ void FixOMP::init()
       if (logfile)
         fprintf(logfile,"Last active /omp style is %s_style %s\n",
                 last_force_name, last_omp_name);
+      if (_color_active) {
+        if (screen)
+          fprintf(screen,"Using colored tiles for shared force accumulation\n");
+        if (logfile)
+          fprintf(logfile,"Using colored tiles for shared force accumulation\n");
+      }
     } else {
       if (screen)
         fprintf(screen,"No /omp style for force computation currently active\n");
@@ -345,7 +387,9 @@ void FixOMP::setup(int)
 
 /* ---------------------------------------------------------------------- */
 
-// adjust size and clear out per thread accumulator arrays
+// adjust size and clear out per thread accumulator arrays.
+// with colored tiles all threads accumulate into the first
+// force array, so only thread 0 clears it.
 void FixOMP::pre_force(int)
 {
   const int nall = atom->nlocal + atom->nghost;
@@ -362,7 +406,10 @@ void FixOMP::pre_force(int)
   {
     const int tid = get_tid();
     thr[tid]->check_tid(tid);
-    thr[tid]->init_force(nall,f,torque,erforce,desph,drho);
+    if (_color_active && (tid > 0)) {
+      thr[tid]->init_force(nall,nullptr,torque,erforce,desph,drho);
+      thr[tid]->_f = f;
+    } else thr[tid]->init_force(nall,f,torque,erforce,desph,drho);
   } // end of omp parallel region
 
   _reduced = false;
@@ -53,6 +53,8 @@ class FixOMP : public Fix {
                              // to do the general force reduction
   void *last_pair_hybrid;    // pointer to the pair style that needs
                              // to call virial_fdot_compute()
+  void *color_style;         // pointer to the pair style that can
+                             // accumulate forces by tile colors
   // signal that an /omp style did the force reduction. needed by respa/omp
   void did_reduce() { _reduced = true; }
 
@@ -63,12 +65,15 @@ class FixOMP : public Fix {
   bool get_neighbor() const { return _neighbor; }
   bool get_mixed() const { return _mixed; }
   bool get_reduced() const { return _reduced; }
+  bool get_color() const { return _color_active; }
 
  private:
   int _nthr;                    // number of currently active ThrData objects
   bool _neighbor;               // en/disable threads for neighbor list construction
   bool _mixed;                  // whether to prefer mixed precision compute kernels
   bool _reduced;                // whether forces have been reduced for this step
+  bool _color;                  // whether colored force accumulation was requested
+  bool _color_active;           // whether threads share the force array this run
   bool _pair_compute_flag;      // whether pair_compute is called
   bool _kspace_compute_flag;    // whether kspace_compute is called
 
@@ -79,3 +84,13 @@ class FixOMP : public Fix {
 
 #endif
 #endif
+
+/* ERROR/WARNING messages:
+
+W: Package omp color is not supported by the current force styles
+
+Colored force accumulation requires that the only /omp force style
+is a non-hybrid pair style that supports it and that no r-RESPA
+integrator is used.  Per-thread force copies are used instead.
+
+*/
@@ -32,6 +32,7 @@ using namespace LAMMPS_NS;
 PairEAMOMP::PairEAMOMP(LAMMPS *lmp) :
   PairEAM(lmp), ThrOMP(lmp, THR_PAIR)
 {
+  cacheflag = 0;
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
 }
@@ -46,6 +47,8 @@ void PairEAMOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
 
+  if (fix->get_color()) color_setup(list);
+
   // grow energy and fp arrays if necessary
   // need to be atom->nmax in length
 
@@ -97,15 +100,12 @@ template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
 void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
 {
   int i,j,ii,jj,m,jnum,itype,jtype;
-  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
-  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
+  double xtmp,ytmp,ztmp,delx,dely,delz;
+  double rsq,p,phi;
   double *coeff;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
-  evdwl = 0.0;
-
   const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
-  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
   double * const rho_t = thr->get_rho();
   const int tid = thr->get_tid();
   const int nthreads = comm->nthreads;
@@ -114,8 +114,6 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   const int nlocal = atom->nlocal;
   const int nall = nlocal + atom->nghost;
 
-  double fxtmp,fytmp,fztmp;
-
   ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
@@ -222,6 +220,45 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   sync_threads();
 
   // compute forces on each atom
+  // with colored tiles all threads update the shared force array,
+  //   tiles of one color are processed concurrently
+
+  if (fix->get_color()) {
+    for (int c = 0; c < NCOLOR; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+      for (int t = color_first[c]; t < color_first[c+1]; ++t)
+        eval_force<EVFLAG,EFLAG,NEWTON_PAIR>(color_tile[t], color_tile[t+1],
+                                             color_ilist, thr);
+    }
+  } else eval_force<EVFLAG,EFLAG,NEWTON_PAIR>(iifrom, iito, ilist, thr);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairEAMOMP::eval_force(int iifrom, int iito, const int * _noalias const ilist,
+                            ThrData * const thr)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
+  double *coeff;
+  int *jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+
+  const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
+  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const int nlocal = atom->nlocal;
+
+  double fxtmp,fytmp,fztmp;
+
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
   // loop over neighbors of my atoms
 
   for (ii = iifrom; ii < iito; ii++) {
@@ -300,6 +337,16 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   }
 }
 
+/* ----------------------------------------------------------------------
+   forces can be accumulated by tile colors without per-thread copies
+------------------------------------------------------------------------- */
+
+void PairEAMOMP::init_style()
+{
+  PairEAM::init_style();
+  color_request((Pair *) this);
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairEAMOMP::memory_usage()
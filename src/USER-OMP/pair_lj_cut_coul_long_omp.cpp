@@ -53,6 +53,9 @@ void PairLJCutCoulLongOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  const bool color = fix->get_color();
+
+  if (color) color_setup(list);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -65,18 +68,18 @@ void PairLJCutCoulLongOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
-      } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+    // with colored tiles all threads update the shared force array,
+    // tiles of one color are processed concurrently
+
+    if (color) {
+      for (int c = 0; c < NCOLOR; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+        for (int t = color_first[c]; t < color_first[c+1]; ++t)
+          eval_thr(color_tile[t], color_tile[t+1], color_ilist, eflag, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
-    }
+    } else eval_thr(ifrom, ito, list->ilist, eflag, thr);
 
     thr->timer(Timer::PAIR);
     reduce_thr(this, eflag, vflag, thr);
@@ -85,15 +88,35 @@ void PairLJCutCoulLongOMP::compute(int eflag, int vflag)
 
 /* ---------------------------------------------------------------------- */
 
+void PairLJCutCoulLongOMP::eval_thr(int ifrom, int ito, const int *ilist,
+                                    int eflag, ThrData * const thr)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) eval<1,1,1>(ifrom, ito, ilist, thr);
+      else eval<1,1,0>(ifrom, ito, ilist, thr);
+    } else {
+      if (force->newton_pair) eval<1,0,1>(ifrom, ito, ilist, thr);
+      else eval<1,0,0>(ifrom, ito, ilist, thr);
+    }
+  } else {
+    if (force->newton_pair) eval<0,0,1>(ifrom, ito, ilist, thr);
+    else eval<0,0,0>(ifrom, ito, ilist, thr);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
 template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
-void PairLJCutCoulLongOMP::eval(int iifrom, int iito, ThrData * const thr)
+void PairLJCutCoulLongOMP::eval(int iifrom, int iito, const int * _noalias const ilist,
+                                ThrData * const thr)
 {
   int i,j,ii,jj,jnum,itype,jtype,itable;
   double qtmp,xtmp,ytmp,ztmp,delx,dely,delz,evdwl,ecoul,fpair;
   double fraction,table;
   double r,rsq,r2inv,r6inv,forcecoul,forcelj,factor_coul,factor_lj;
   double grij,expm2,prefactor,t,erfc;
-  int *ilist,*jlist,*numneigh,**firstneigh;
+  int *jlist,*numneigh,**firstneigh;
 
   evdwl = ecoul = 0.0;
 
@@ -107,7 +130,6 @@ void PairLJCutCoulLongOMP::eval(int iifrom, int iito, ThrData * const thr)
   const double qqrd2e = force->qqrd2e;
   double fxtmp,fytmp,fztmp;
 
-  ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
@@ -211,6 +233,16 @@ void PairLJCutCoulLongOMP::eval(int iifrom, int iito, ThrData * const thr)
   }
 }
 
+/* ----------------------------------------------------------------------
+   forces can be accumulated by tile colors without per-thread copies
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulLongOMP::init_style()
+{
+  PairLJCutCoulLong::init_style();
+  color_request((Pair *) this);
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairLJCutCoulLongOMP::memory_usage()
@@ -35,11 +35,13 @@ class PairLJCutCoulLongOMP : public PairLJCutCoulLong, public ThrOMP {
   PairLJCutCoulLongOMP(class LAMMPS *);
 
   virtual void compute(int, int);
+  virtual void init_style();
   virtual double memory_usage();
 
  private:
+  void eval_thr(int ifrom, int ito, const int *ilist, int eflag, ThrData *const thr);
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
-  void eval(int ifrom, int ito, ThrData *const thr);
+  void eval(int ifrom, int ito, const int *ilist, ThrData *const thr);
 };
 
 }    // namespace LAMMPS_NS
@@ -31,6 +31,7 @@ PairLJCutOMP::PairLJCutOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  overlap_enable = 0;
   cut_respa = nullptr;
 }
 
@@ -43,6 +44,9 @@ void PairLJCutOMP::compute(int eflag, int vflag)
   const int nall = atom->nlocal + atom->nghost;
   const int nthreads = comm->nthreads;
   const int inum = list->inum;
+  const bool color = fix->get_color();
+
+  if (color) color_setup(list);
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
@@ -55,31 +59,53 @@ void PairLJCutOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
 
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
-      } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+    // with colored tiles all threads update the shared force array,
+    // tiles of one color are processed concurrently
+
+    if (color) {
+      for (int c = 0; c < NCOLOR; ++c) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic,1)
+#endif
+        for (int t = color_first[c]; t < color_first[c+1]; ++t)
+          eval_thr(color_tile[t], color_tile[t+1], color_ilist, eflag, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
-    }
+    } else eval_thr(ifrom, ito, list->ilist, eflag, thr);
+
     thr->timer(Timer::PAIR);
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
 }
 
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutOMP::eval_thr(int ifrom, int ito, const int *ilist,
+                            int eflag, ThrData * const thr)
+{
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) eval<1,1,1>(ifrom, ito, ilist, thr);
+      else eval<1,1,0>(ifrom, ito, ilist, thr);
+    } else {
+      if (force->newton_pair) eval<1,0,1>(ifrom, ito, ilist, thr);
+      else eval<1,0,0>(ifrom, ito, ilist, thr);
+    }
+  } else {
+    if (force->newton_pair) eval<0,0,1>(ifrom, ito, ilist, thr);
+    else eval<0,0,0>(ifrom, ito, ilist, thr);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
 template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
-void PairLJCutOMP::eval(int iifrom, int iito, ThrData * const thr)
+void PairLJCutOMP::eval(int iifrom, int iito, const int * _noalias const ilist,
+                        ThrData * const thr)
 {
   const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
   dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
   const int * _noalias const type = atom->type;
   const double * _noalias const special_lj = force->special_lj;
-  const int * _noalias const ilist = list->ilist;
   const int * _noalias const numneigh = list->numneigh;
   const int * const * const firstneigh = list->firstneigh;
 
@@ -151,6 +177,16 @@ void PairLJCutOMP::eval(int iifrom, int iito, ThrData * const thr)
   }
 }
 
+/* ----------------------------------------------------------------------
+   forces can be accumulated by tile colors without per-thread copies
+------------------------------------------------------------------------- */
+
+void PairLJCutOMP::init_style()
+{
+  PairLJCut::init_style();
+  color_request((Pair *) this);
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairLJCutOMP::memory_usage()
@@ -141,10 +141,10 @@ void PPPMDispOMP::compute_gf()
     double argx,argy,argz,wx,wy,wz,sx,sy,sz,qx,qy,qz;
     double numerator,denominator;
 
-    const int nnx = nxhi_fft-nxlo_fft+1;
+    const int nnx = nxhi_kfft-nxlo_fft+1;
     const int nny = nyhi_fft-nylo_fft+1;
 
-    loop_setup_thr(nnfrom, nnto, tid, nfft, comm->nthreads);
+    loop_setup_thr(nnfrom, nnto, tid, nkfft, comm->nthreads);
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
 
@@ -170,7 +170,7 @@ void PPPMDispOMP::compute_gf()
         if (argy != 0.0) wy = pow(sin(argy)/argy,order);
         wy *= wy;
 
-        for (k = nxlo_fft; k <= nxhi_fft; k++) {
+        for (k = nxlo_fft; k <= nxhi_kfft; k++) {
 
           /* only compute the part designated to this thread */
           nn = k-nxlo_fft + nnx*(l-nylo_fft + nny*(m-nzlo_fft));
@@ -243,10 +243,10 @@ void PPPMDispOMP::compute_gf_6()
 
     numerator = -MY_PI*rtpi*g_ewald_6*g_ewald_6*g_ewald_6/(3.0);
 
-    const int nnx = nxhi_fft_6-nxlo_fft_6+1;
+    const int nnx = nxhi_kfft_6-nxlo_fft_6+1;
     const int nny = nyhi_fft_6-nylo_fft_6+1;
 
-    loop_setup_thr(nnfrom, nnto, tid, nfft_6, comm->nthreads);
+    loop_setup_thr(nnfrom, nnto, tid, nkfft_6, comm->nthreads);
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
 
@@ -272,7 +272,7 @@ void PPPMDispOMP::compute_gf_6()
         if (argy != 0.0) wy = pow(sin(argy)/argy,order_6);
         wy *= wy;
 
-        for (k = nxlo_fft_6; k <= nxhi_fft_6; k++) {
+        for (k = nxlo_fft_6; k <= nxhi_kfft_6; k++) {
 
           /* only compute the part designated to this thread */
           nn = k-nxlo_fft_6 + nnx*(l-nylo_fft_6 + nny*(m-nzlo_fft_6));
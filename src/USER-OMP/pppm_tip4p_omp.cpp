@@ -121,7 +121,7 @@ void PPPMTIP4POMP::compute_gf_ik()
                                     pow(-log(EPS_HOC),0.25));
   const int nbz = static_cast<int> ((g_ewald*zprd_slab/(MY_PI*nz_pppm)) *
                                     pow(-log(EPS_HOC),0.25));
-  const int numk = nxhi_fft - nxlo_fft + 1;
+  const int numk = nxhi_kfft - nxlo_fft + 1;
   const int numl = nyhi_fft - nylo_fft + 1;
 
   const int twoorder = 2*order;
@@ -138,7 +138,7 @@ void PPPMTIP4POMP::compute_gf_ik()
 
     int k,l,m,nx,ny,nz,kper,lper,mper,n,nfrom,nto,tid;
 
-    loop_setup_thr(nfrom, nto, tid, nfft, comm->nthreads);
+    loop_setup_thr(nfrom, nto, tid, nkfft, comm->nthreads);
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
 
@@ -214,7 +214,7 @@ void PPPMTIP4POMP::compute_gf_ad()
   const double unitky = (MY_2PI/yprd);
   const double unitkz = (MY_2PI/zprd_slab);
 
-  const int numk = nxhi_fft - nxlo_fft + 1;
+  const int numk = nxhi_kfft - nxlo_fft + 1;
   const int numl = nyhi_fft - nylo_fft + 1;
 
   const int twoorder = 2*order;
@@ -229,7 +229,7 @@ void PPPMTIP4POMP::compute_gf_ad()
     double numerator,denominator;
     int k,l,m,kper,lper,mper,n,nfrom,nto,tid;
 
-    loop_setup_thr(nfrom, nto, tid, nfft, comm->nthreads);
+    loop_setup_thr(nfrom, nto, tid, nkfft, comm->nthreads);
     ThrData *thr = fix->get_thr(tid);
     thr->timer(Timer::START);
 
@@ -269,20 +269,20 @@ void PPPMTIP4POMP::compute_gf_ad()
         numerator = MY_4PI/sqk;
         denominator = gf_denom(snx,sny,snz);
         greensfn[n] = numerator*sx*sy*sz*wx*wy*wz/denominator;
-        sf0 += sf_precoeff1[n]*greensfn[n];
-        sf1 += sf_precoeff2[n]*greensfn[n];
-        sf2 += sf_precoeff3[n]*greensfn[n];
-        sf3 += sf_precoeff4[n]*greensfn[n];
-        sf4 += sf_precoeff5[n]*greensfn[n];
-        sf5 += sf_precoeff6[n]*greensfn[n];
+        sf0 += kxweight[k]*sf_precoeff1[n]*greensfn[n];
+        sf1 += kxweight[k]*sf_precoeff2[n]*greensfn[n];
+        sf2 += kxweight[k]*sf_precoeff3[n]*greensfn[n];
+        sf3 += kxweight[k]*sf_precoeff4[n]*greensfn[n];
+        sf4 += kxweight[k]*sf_precoeff5[n]*greensfn[n];
+        sf5 += kxweight[k]*sf_precoeff6[n]*greensfn[n];
       } else {
         greensfn[n] = 0.0;
-        sf0 += sf_precoeff1[n]*greensfn[n];
-        sf1 += sf_precoeff2[n]*greensfn[n];
-        sf2 += sf_precoeff3[n]*greensfn[n];
-        sf3 += sf_precoeff4[n]*greensfn[n];
-        sf4 += sf_precoeff5[n]*greensfn[n];
-        sf5 += sf_precoeff6[n]*greensfn[n];
+        sf0 += kxweight[k]*sf_precoeff1[n]*greensfn[n];
+        sf1 += kxweight[k]*sf_precoeff2[n]*greensfn[n];
+        sf2 += kxweight[k]*sf_precoeff3[n]*greensfn[n];
+        sf3 += kxweight[k]*sf_precoeff4[n]*greensfn[n];
+        sf4 += kxweight[k]*sf_precoeff5[n]*greensfn[n];
+        sf5 += kxweight[k]*sf_precoeff6[n]*greensfn[n];
       }
     }
     thr->timer(Timer::KSPACE);
@@ -21,9 +21,12 @@
 
 #include "atom.h"
 #include "comm.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
+#include "memory.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 
 
@@ -44,7 +47,9 @@ using namespace MathConst;
 /* ---------------------------------------------------------------------- */
 
 ThrOMP::ThrOMP(LAMMPS *ptr, int style)
-  : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0)
+  : lmp(ptr), fix(nullptr), thr_style(style), thr_error(0),
+    color_ilist(nullptr), color_tile(nullptr), color_slot(nullptr),
+    color_maxatom(0), color_maxtile(0), color_ncalls(-1)
 {
   // register fix omp with this class
   int ifix = lmp->modify->find_fix("package_omp");
@@ -57,7 +62,9 @@ ThrOMP::ThrOMP(LAMMPS *ptr, int style)
 
 ThrOMP::~ThrOMP()
 {
-  // nothing to do?
+  lmp->memory->destroy(color_ilist);
+  lmp->memory->destroy(color_tile);
+  lmp->memory->destroy(color_slot);
 }
 
 /* ----------------------------------------------------------------------
@@ -199,12 +206,16 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
     if (lmp->force->pair->vflag_fdotr) {
 
-      // this is a non-hybrid pair style. compute per thread fdotr
+      // this is a non-hybrid pair style. compute per thread fdotr.
+      // with colored tiles all threads share one force array,
+      // so only thread 0 computes it.
       if (fix->last_pair_hybrid == nullptr) {
-        if (lmp->neighbor->includegroup == 0)
-          thr->virial_fdotr_compute(x, nlocal, nghost, -1);
-        else
-          thr->virial_fdotr_compute(x, nlocal, nghost, nfirst);
+        if (!fix->get_color() || (tid == 0)) {
+          if (lmp->neighbor->includegroup == 0)
+            thr->virial_fdotr_compute(x, nlocal, nghost, -1);
+          else
+            thr->virial_fdotr_compute(x, nlocal, nghost, nfirst);
+        }
       } else {
         if (style == fix->last_pair_hybrid) {
           // pair_style hybrid will compute fdotr for us
@@ -451,7 +462,8 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
 
   if (style == fix->last_omp_style) {
     if (need_force_reduce) {
-      data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
+      if (!fix->get_color())
+        data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
       fix->did_reduce();
     }
 
@@ -461,6 +473,129 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
   thr->timer(Timer::COMM);
 }
 
+/* ----------------------------------------------------------------------
+   register a style that can loop over atoms by tile colors.
+   must be called from init_style(), FixOMP::init() then decides
+   whether all threads share the force array during the run.
+------------------------------------------------------------------------- */
+
+void ThrOMP::color_request(void *style)
+{
+  fix->color_style = style;
+  color_ncalls = -1;
+}
+
+/* ----------------------------------------------------------------------
+   sort the atoms of a neighbor list into tiles that are at least twice
+   the neighbor cutoff wide and color tiles by the parity of their
+   index in each dim. tiles of the same color are then a full tile
+   apart, so threads working on different tiles of one color never
+   update the force on the same owned or ghost atom. periodic images
+   are separate ghost atoms and do not conflict. tiles are rebuilt
+   whenever the neighbor lists were rebuilt.
+------------------------------------------------------------------------- */
+
+void ThrOMP::color_setup(NeighList *list)
+{
+  Neighbor *neighbor = lmp->neighbor;
+  if (color_ncalls == neighbor->ncalls) return;
+  color_ncalls = neighbor->ncalls;
+
+  double **x = lmp->atom->x;
+  const int inum = list->inum;
+  const int * const ilist = list->ilist;
+  const int dimension = lmp->domain->dimension;
+  int i,ii,dim;
+
+  // bounding box of the atoms in the list
+
+  double lo[3],hi[3];
+  lo[0] = lo[1] = lo[2] = hi[0] = hi[1] = hi[2] = 0.0;
+  if (inum) {
+    i = ilist[0];
+    for (dim = 0; dim < 3; dim++) lo[dim] = hi[dim] = x[i][dim];
+  }
+  for (ii = 1; ii < inum; ii++) {
+    i = ilist[ii];
+    for (dim = 0; dim < 3; dim++) {
+      if (x[i][dim] < lo[dim]) lo[dim] = x[i][dim];
+      else if (x[i][dim] > hi[dim]) hi[dim] = x[i][dim];
+    }
+  }
+
+  // tile size >= 2x cutoff, coarsened if there would be more tiles than atoms
+
+  int ntile[3];
+  double tileinv[3];
+  double tilesize = 2.0*neighbor->cutneighmax;
+  while (true) {
+    for (dim = 0; dim < 3; dim++) {
+      const double extent = hi[dim] - lo[dim];
+      ntile[dim] = 1;
+      if ((dim < dimension) && (tilesize > 0.0) && (extent > tilesize))
+        ntile[dim] = static_cast<int>(MIN(extent/tilesize,(double) MAXSMALLINT));
+      tileinv[dim] = (extent > 0.0) ? ntile[dim]/extent : 0.0;
+    }
+    if ((bigint) ntile[0]*ntile[1]*ntile[2] <= MAX(inum,1)) break;
+    tilesize = (tilesize > 0.0) ? 2.0*tilesize : 1.0;
+  }
+
+  const int ntiles = ntile[0]*ntile[1]*ntile[2];
+  if (ntiles+1 > color_maxtile) {
+    color_maxtile = ntiles+1;
+    lmp->memory->destroy(color_tile);
+    lmp->memory->destroy(color_slot);
+    lmp->memory->create(color_tile,color_maxtile,"thr_omp:color_tile");
+    lmp->memory->create(color_slot,color_maxtile,"thr_omp:color_slot");
+  }
+  if (inum > color_maxatom) {
+    color_maxatom = lmp->atom->nmax;
+    lmp->memory->destroy(color_ilist);
+    lmp->memory->create(color_ilist,color_maxatom,"thr_omp:color_ilist");
+  }
+
+  // order tiles by color, tiles of one color keep their relative order
+
+  int c,t,it[3];
+  for (c = 0; c <= NCOLOR; c++) color_first[c] = 0;
+  for (it[2] = 0; it[2] < ntile[2]; it[2]++)
+    for (it[1] = 0; it[1] < ntile[1]; it[1]++)
+      for (it[0] = 0; it[0] < ntile[0]; it[0]++)
+        color_first[(it[0] & 1) + 2*(it[1] & 1) + 4*(it[2] & 1) + 1]++;
+  for (c = 0; c < NCOLOR; c++) color_first[c+1] += color_first[c];
+
+  int next[NCOLOR];
+  for (c = 0; c < NCOLOR; c++) next[c] = color_first[c];
+  t = 0;
+  for (it[2] = 0; it[2] < ntile[2]; it[2]++)
+    for (it[1] = 0; it[1] < ntile[1]; it[1]++)
+      for (it[0] = 0; it[0] < ntile[0]; it[0]++)
+        color_slot[t++] = next[(it[0] & 1) + 2*(it[1] & 1) + 4*(it[2] & 1)]++;
+
+  // bucket sort atoms by tile, atoms of one tile keep their list order
+
+  for (t = 0; t <= ntiles; t++) color_tile[t] = 0;
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    for (dim = 0; dim < 3; dim++)
+      it[dim] = MIN(static_cast<int>((x[i][dim] - lo[dim])*tileinv[dim]),ntile[dim]-1);
+    color_tile[color_slot[(it[2]*ntile[1] + it[1])*ntile[0] + it[0]] + 1]++;
+  }
+  for (t = 0; t < ntiles; t++) color_tile[t+1] += color_tile[t];
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    for (dim = 0; dim < 3; dim++)
+      it[dim] = MIN(static_cast<int>((x[i][dim] - lo[dim])*tileinv[dim]),ntile[dim]-1);
+    color_ilist[color_tile[color_slot[(it[2]*ntile[1] + it[1])*ntile[0] + it[0]]]++] = i;
+  }
+
+  // filling advanced each offset to the start of the next tile
+
+  for (t = ntiles; t > 0; t--) color_tile[t] = color_tile[t-1];
+  color_tile[0] = 0;
+}
+
 /* ----------------------------------------------------------------------
    tally eng_vdwl and eng_coul into per thread global and per-atom accumulators
 ------------------------------------------------------------------------- */
@@ -1537,5 +1672,7 @@ double ThrOMP::memory_usage_thr()
 {
   double bytes=0.0;
 
+  bytes += (double)color_maxatom*sizeof(int);
+  bytes += (double)2*color_maxtile*sizeof(int);
   return bytes;
 }
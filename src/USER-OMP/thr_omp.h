@@ -44,6 +44,16 @@ class ThrOMP {
   const int thr_style;
   int thr_error;
 
+  // spatial tiles of the atoms in a neighbor list, grouped by color.
+  // tiles of the same color never update forces of the same atoms.
+  enum { NCOLOR = 8 };
+  int *color_ilist;              // atom indices grouped by tile
+  int *color_tile;               // offset of each tile in color_ilist
+  int *color_slot;               // position of each tile in color order
+  int color_first[NCOLOR + 1];   // first tile of each color
+  int color_maxatom, color_maxtile;
+  bigint color_ncalls;           // neighbor->ncalls when tiles were built
+
  public:
   ThrOMP(LAMMPS *, int);
   virtual ~ThrOMP();
@@ -84,6 +94,10 @@ class ThrOMP {
   // reduce per thread data as needed
   void reduce_thr(void *const style, const int eflag, const int vflag, ThrData *const thr);
 
+  // support for threads sharing the force array by processing tiles of one color
+  void color_request(void *const style);
+  void color_setup(class NeighList *);
+
   // thread safe variant error abort support.
   // signals an error condition in any thread by making
   // thr_error > 0, if condition "cond" is true.
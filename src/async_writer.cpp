@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   background writer thread for file output
+   caller fills a buffer via append() and hands it off via submit()
+   a single worker thread fwrite()s queued buffers in submission order
+   at most maxqueue buffers are queued, submit() blocks when full
+   written buffers are recycled so steady state does no allocation
+------------------------------------------------------------------------- */
+
+#include "async_writer.h"
+
+#include <utility>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+AsyncWriter::AsyncWriter(int nqueue) :
+  maxqueue(nqueue > 0 ? nqueue : 1), busy(0), done(0), errflag(0),
+  busyfp(nullptr)
+{
+  worker = std::thread(&AsyncWriter::loop,this);
+}
+
+/* ----------------------------------------------------------------------
+   write out all queued buffers, then stop worker thread
+------------------------------------------------------------------------- */
+
+AsyncWriter::~AsyncWriter()
+{
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    done = 1;
+  }
+  cv_work.notify_one();
+  worker.join();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AsyncWriter::append(const char *str, int n)
+{
+  if (n > 0) fill.insert(fill.end(),str,str+n);
+}
+
+/* ----------------------------------------------------------------------
+   queue current fill buffer for writing to fp
+   flush = 1 to fflush() fp after writing
+   close = NOCLOSE, FCLOSE, PCLOSE to close fp after writing
+   fp may be closed by worker, so caller must not use it afterwards
+------------------------------------------------------------------------- */
+
+void AsyncWriter::submit(FILE *fp, int flush, int close)
+{
+  std::unique_lock<std::mutex> lock(mtx);
+  cv_idle.wait(lock,[this]{ return (int) queue.size() < maxqueue; });
+
+  Job job;
+  job.fp = fp;
+  job.flush = flush;
+  job.close = close;
+  job.data.swap(fill);
+  queue.push_back(std::move(job));
+
+  if (!spare.empty()) {
+    fill.swap(spare.back());
+    spare.pop_back();
+  }
+
+  lock.unlock();
+  cv_work.notify_one();
+}
+
+/* ----------------------------------------------------------------------
+   block until no queued or in-progress job writes to fp
+   fp = nullptr waits for all jobs
+------------------------------------------------------------------------- */
+
+void AsyncWriter::wait(FILE *fp)
+{
+  std::unique_lock<std::mutex> lock(mtx);
+  cv_idle.wait(lock,[this,fp]{ return pending(fp) == 0; });
+}
+
+/* ----------------------------------------------------------------------
+   # of queued or in-progress jobs for fp, all jobs if fp = nullptr
+   caller must hold mtx
+------------------------------------------------------------------------- */
+
+int AsyncWriter::pending(FILE *fp)
+{
+  int n = 0;
+  if (busy && (fp == nullptr || busyfp == fp)) n++;
+  for (auto &job : queue)
+    if (fp == nullptr || job.fp == fp) n++;
+  return n;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AsyncWriter::loop()
+{
+  std::unique_lock<std::mutex> lock(mtx);
+
+  while (true) {
+    cv_work.wait(lock,[this]{ return done || !queue.empty(); });
+    if (queue.empty()) break;
+
+    Job job = std::move(queue.front());
+    queue.pop_front();
+    busy = 1;
+    busyfp = job.fp;
+    lock.unlock();
+
+    int err = 0;
+    size_t n = job.data.size();
+    if (n && fwrite(job.data.data(),sizeof(char),n,job.fp) != n) err = 1;
+    if (job.flush && fflush(job.fp)) err = 1;
+    if (job.close == FCLOSE) {
+      if (fclose(job.fp)) err = 1;
+    } else if (job.close == PCLOSE) {
+#ifdef _WIN32
+      if (_pclose(job.fp)) err = 1;
+#else
+      if (pclose(job.fp)) err = 1;
+#endif
+    }
+
+    lock.lock();
+    if (err) errflag = 1;
+    job.data.clear();
+    spare.push_back(std::move(job.data));
+    busy = 0;
+    busyfp = nullptr;
+    cv_idle.notify_all();
+  }
+}
@@ -0,0 +1,65 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_ASYNC_WRITER_H
+#define LMP_ASYNC_WRITER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class AsyncWriter {
+ public:
+  enum { NOCLOSE, FCLOSE, PCLOSE };
+
+  AsyncWriter(int);
+  ~AsyncWriter();
+
+  void append(const char *, int);    // add chars to current fill buffer
+  void submit(FILE *, int, int);     // queue fill buffer for writing
+  void wait(FILE *fp = nullptr);     // wait until writes to fp are done
+  int failed() const { return errflag; }
+
+ private:
+  struct Job {
+    FILE *fp;
+    int flush;
+    int close;
+    std::vector<char> data;
+  };
+
+  int maxqueue;                          // max # of queued buffers
+  int busy;                              // 1 if worker is writing a job
+  int done;                              // 1 when worker should exit
+  int errflag;                           // 1 if a write or close failed
+  FILE *busyfp;                          // file the worker is writing to
+  std::vector<char> fill;                // buffer being filled by caller
+  std::deque<Job> queue;                 // buffers waiting to be written
+  std::vector<std::vector<char>> spare;  // recycled buffers
+  std::mutex mtx;
+  std::condition_variable cv_work;       // signals worker: job or exit
+  std::condition_variable cv_idle;       // signals caller: job finished
+  std::thread worker;
+
+  int pending(FILE *);
+  void loop();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -29,6 +29,7 @@
 #include "modify.h"
 #include "molecule.h"
 #include "neighbor.h"
+#include "omp_compat.h"
 #include "update.h"
 #include "variable.h"
 
@@ -36,7 +37,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <utility>
+#include <vector>
 
 #ifdef LMP_USER_INTEL
 #include "neigh_request.h"
@@ -52,6 +56,7 @@ using namespace MathConst;
 #define DELTA 1
 #define DELTA_PERATOM 64
 #define EPSILON 1.0e-6
+#define BIG 1.0e20
 
 /* ---------------------------------------------------------------------- */
 
@@ -86,6 +91,7 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
 {
   natoms = 0;
   nlocal = nghost = nmax = 0;
+  fshared = 0;
   ntypes = 0;
   nellipsoids = nlines = ntris = nbodies = 0;
   nbondtypes = nangletypes = ndihedraltypes = nimpropertypes = 0;
@@ -95,8 +101,12 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_BIN;
+  sortboundary = 0;
   maxbin = maxnext = 0;
-  binhead = nullptr;
+  binhead = binheadbnd = binorder = nullptr;
+  ordernx = orderny = ordernz = 0;
+  ordersort = SORT_BIN;
   next = permute = nullptr;
 
   // data structure with info on per-atom vectors/arrays
@@ -273,6 +283,8 @@ Atom::~Atom()
 
   delete [] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binheadbnd);
+  memory->destroy(binorder);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -343,6 +355,8 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
+  sortboundary = old->sortboundary;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -824,6 +838,19 @@ void Atom::modify_params(int narg, char **arg)
         error->all(FLERR,"Atom_modify sort and first options "
                    "cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort/order") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"bin") == 0) sortorder = SORT_BIN;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR,"Illegal atom_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"sort/boundary") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) sortboundary = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) sortboundary = 0;
+      else error->all(FLERR,"Illegal atom_modify command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command");
   }
 }
@@ -2054,11 +2081,32 @@ void Atom::sort()
 
   if (nlocal == nmax) avec->grow(0);
 
-  // bin atoms in reverse order so linked list will be in forward order
+  // with sortboundary, atoms within ghost cutoff of a sub-domain face
+  //   go into separate per-bin lists, so they end up at end of atom list
+  // only for orthogonal boxes, since cutghost is in lamda units otherwise
 
-  for (i = 0; i < nbins; i++) binhead[i] = -1;
+  int boundary = (sortboundary && !domain->triclinic) ? 1 : 0;
+  double blo[3],bhi[3];
+  if (boundary) {
+    for (int dim = 0; dim < 3; dim++) {
+      blo[dim] = domain->sublo[dim] + comm->cutghost[dim];
+      bhi[dim] = domain->subhi[dim] - comm->cutghost[dim];
+    }
+    if (domain->dimension == 2) {
+      blo[2] = -BIG;
+      bhi[2] = BIG;
+    }
+    for (i = 0; i < nbins; i++) binheadbnd[i] = -1;
+  }
 
-  for (i = nlocal-1; i >= 0; i--) {
+  // bin of each atom, computed by threads and stored in permute for now
+  // atoms for boundary lists are flagged by adding nbins to their bin
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(boundary,blo,bhi) \
+  private(ix,iy,iz) schedule(static) if(nlocal >= THREAD_MINATOM)
+#endif
+  for (i = 0; i < nlocal; i++) {
     ix = static_cast<int> ((x[i][0]-bboxlo[0])*bininvx);
     iy = static_cast<int> ((x[i][1]-bboxlo[1])*bininvy);
     iz = static_cast<int> ((x[i][2]-bboxlo[2])*bininvz);
@@ -2068,22 +2116,52 @@ void Atom::sort()
     ix = MIN(ix,nbinx-1);
     iy = MIN(iy,nbiny-1);
     iz = MIN(iz,nbinz-1);
-    ibin = iz*nbiny*nbinx + iy*nbinx + ix;
-    next[i] = binhead[ibin];
-    binhead[ibin] = i;
+    permute[i] = iz*nbiny*nbinx + iy*nbinx + ix;
+    if (boundary && (x[i][0] < blo[0] || x[i][0] >= bhi[0] ||
+                     x[i][1] < blo[1] || x[i][1] >= bhi[1] ||
+                     x[i][2] < blo[2] || x[i][2] >= bhi[2]))
+      permute[i] += nbins;
+  }
+
+  // bin atoms in reverse order so linked list will be in forward order
+
+  for (i = 0; i < nbins; i++) binhead[i] = -1;
+
+  for (i = nlocal-1; i >= 0; i--) {
+    ibin = permute[i];
+    if (ibin >= nbins) {
+      ibin -= nbins;
+      next[i] = binheadbnd[ibin];
+      binheadbnd[ibin] = i;
+    } else {
+      next[i] = binhead[ibin];
+      binhead[ibin] = i;
+    }
   }
 
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
+  // bins are traversed in space-filling curve order if requested
+
+  const int *order = (sortorder == SORT_BIN) ? nullptr : binorder;
 
   n = 0;
   for (m = 0; m < nbins; m++) {
-    i = binhead[m];
+    i = binhead[order ? order[m] : m];
     while (i >= 0) {
       permute[n++] = i;
       i = next[i];
     }
   }
+  if (boundary) {
+    for (m = 0; m < nbins; m++) {
+      i = binheadbnd[order ? order[m] : m];
+      while (i >= 0) {
+        permute[n++] = i;
+        i = next[i];
+      }
+    }
+  }
 
   // current = current permutation, just reuse next vector
   // current[I] = J means Ith current atom is Jth old atom
@@ -2258,9 +2336,106 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binheadbnd);
+    memory->destroy(binorder);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    memory->create(binheadbnd,maxbin,"atom:binheadbnd");
+    memory->create(binorder,maxbin,"atom:binorder");
+    ordernx = orderny = ordernz = 0;
+  }
+
+  if (sortorder != SORT_BIN) setup_sort_order();
+}
+
+/* ----------------------------------------------------------------------
+   index of a point on a Morton (Z-order) or Hilbert curve
+   crd = ndim integer coords with nbits bits each, overwritten for Hilbert
+   Hilbert uses the transpose algorithm of J. Skilling,
+     AIP Conf. Proc. 707, 381 (2004), followed by bit interleaving
+------------------------------------------------------------------------- */
+
+static uint64_t curve_index(int hilbert, int nbits, int ndim, uint32_t *crd)
+{
+  if (hilbert) {
+    const uint32_t top = 1U << (nbits-1);
+    uint32_t p,q,t;
+
+    // inverse undo excess work
+
+    for (q = top; q > 1; q >>= 1) {
+      p = q - 1;
+      for (int i = 0; i < ndim; i++) {
+        if (crd[i] & q) crd[0] ^= p;
+        else {
+          t = (crd[0] ^ crd[i]) & p;
+          crd[0] ^= t;
+          crd[i] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+
+    for (int i = 1; i < ndim; i++) crd[i] ^= crd[i-1];
+    t = 0;
+    for (q = top; q > 1; q >>= 1)
+      if (crd[ndim-1] & q) t ^= q - 1;
+    for (int i = 0; i < ndim; i++) crd[i] ^= t;
   }
+
+  // interleave bits, most significant first
+
+  uint64_t index = 0;
+  for (int b = nbits-1; b >= 0; b--)
+    for (int i = 0; i < ndim; i++)
+      index = (index << 1) | ((crd[i] >> b) & 1U);
+  return index;
+}
+
+/* ----------------------------------------------------------------------
+   set binorder = list of sort bins in Morton or Hilbert curve order
+   called from setup_sort_bins() at init and, if the box changes, before
+     each sort, but only recomputed when the number of bins in some
+     dimension or the sort order changed
+   falls back to plain bin order if curve index would overflow 64 bits
+------------------------------------------------------------------------- */
+
+void Atom::setup_sort_order()
+{
+  if (nbinx == ordernx && nbiny == orderny && nbinz == ordernz &&
+      sortorder == ordersort) return;
+  ordernx = nbinx;
+  orderny = nbiny;
+  ordernz = nbinz;
+  ordersort = sortorder;
+
+  const int ndim = (domain->dimension == 2) ? 2 : 3;
+  const int nmaxdim = MAX(nbinx,MAX(nbiny,nbinz));
+  int nbits = 1;
+  while ((1 << nbits) < nmaxdim && nbits < 31) nbits++;
+
+  if (nbits*ndim > 63) {
+    for (int m = 0; m < nbins; m++) binorder[m] = m;
+    return;
+  }
+
+  std::vector<std::pair<uint64_t,int>> keys(nbins);
+  uint32_t crd[3];
+  int ibin = 0;
+  for (int iz = 0; iz < nbinz; iz++)
+    for (int iy = 0; iy < nbiny; iy++)
+      for (int ix = 0; ix < nbinx; ix++) {
+        crd[0] = ix;
+        crd[1] = iy;
+        crd[2] = iz;
+        keys[ibin].first = curve_index(sortorder == SORT_HILBERT,nbits,ndim,crd);
+        keys[ibin].second = ibin;
+        ibin++;
+      }
+
+  std::sort(keys.begin(),keys.end());
+  for (int m = 0; m < nbins; m++) binorder[m] = keys[m].second;
 }
 
 /* ----------------------------------------------------------------------
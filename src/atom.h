@@ -32,6 +32,7 @@ class Atom : protected Pointers {
   enum { DOUBLE, INT, BIGINT };
   enum { GROW = 0, RESTART = 1, BORDER = 2 };
   enum { ATOMIC = 0, MOLECULAR = 1, TEMPLATE = 2 };
+  enum { SORT_BIN = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
 
   // atom counts
@@ -40,6 +41,7 @@ class Atom : protected Pointers {
                          // natoms may not be current if atoms lost
   int nlocal, nghost;    // # of owned and ghost atoms on this proc
   int nmax;              // max # of owned+ghost in arrays on this proc
+  int fshared;           // 1 if all threads share one force array
   int tag_enable;        // 0/1 if atom ID tags are defined
   int molecular;         // 0 = atomic, 1 = standard molecular system,
                          // 2 = molecule template system
@@ -256,6 +258,8 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins: BIN, MORTON, HILBERT
+  int sortboundary;      // 1 if sort atoms near sub-domain faces last
 
   // indices of atoms with same ID
 
@@ -395,6 +399,10 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binheadbnd;                     // 1st boundary atom in each bin
+  int *binorder;                       // bins in space-filling curve order
+  int ordernx, orderny, ordernz;       // bins in each dimension of binorder
+  int ordersort;                       // sortorder binorder was set up for
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
@@ -402,6 +410,7 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  void setup_sort_order();
   int next_prime(int);
 
  private:
@@ -23,6 +23,7 @@
 #include "math_const.h"
 #include "memory.h"
 #include "modify.h"
+#include "omp_compat.h"
 #include "tokenizer.h"
 
 #include <cstring>
@@ -56,6 +57,7 @@ AtomVec::AtomVec(LAMMPS *lmp) : Pointers(lmp)
   x = v = f = nullptr;
 
   threads = nullptr;
+  comm_kernel = border_kernel = 0;
 
   // peratom variables auto-included in corresponding child style fields string
   // these fields cannot be specified in the fields string
@@ -151,6 +153,9 @@ void AtomVec::init()
   deform_groupbit = domain->deform_groupbit;
   h_rate = domain->h_rate;
 
+  comm_kernel = select_kernel(ncomm,mcomm);
+  border_kernel = select_kernel(nborder,mborder);
+
   if (lmp->kokkos != nullptr && !kokkosable)
     error->all(FLERR,"KOKKOS package requires a kokkos enabled atom_style");
 }
@@ -172,12 +177,22 @@ bigint AtomVec::roundup(bigint n)
 
 /* ----------------------------------------------------------------------
    grow nmax so it is a multiple of DELTA
+   grow by at least memory->growfactor if set by memory_modify growth
 ------------------------------------------------------------------------- */
 
 void AtomVec::grow_nmax()
 {
-  nmax = nmax/DELTA * DELTA;
-  nmax += DELTA;
+  bigint newmax = nmax/DELTA * DELTA + DELTA;
+
+  // optional geometric growth reduces reallocations for growing systems
+
+  if (memory->growfactor > 1.0) {
+    bigint geom = static_cast<bigint> (nmax * memory->growfactor);
+    if (geom % DELTA) geom = geom/DELTA * DELTA + DELTA;
+    if (geom > MAXSMALLINT) geom = MAXSMALLINT;
+    newmax = MAX(newmax,geom);
+  }
+  nmax = newmax;
 }
 
 static constexpr bigint DELTA_BONUS=8192;
@@ -216,7 +231,8 @@ void AtomVec::grow(int n)
   image = memory->grow(atom->image,nmax,"atom:image");
   x = memory->grow(atom->x,nmax,3,"atom:x");
   v = memory->grow(atom->v,nmax,3,"atom:v");
-  f = memory->grow(atom->f,nmax*comm->nthreads,3,"atom:f");
+  const int fthreads = atom->fshared ? 1 : comm->nthreads;
+  f = memory->grow(atom->f,nmax*fthreads,3,"atom:f");
 
   for (int i = 0; i < ngrow; i++) {
     pdata = mgrow.pdata[i];
@@ -356,7 +372,9 @@ int AtomVec::pack_comm(int n, int *list, double *buf,
   void *pdata;
 
   m = 0;
-  if (pbc_flag == 0) {
+  if (comm_kernel) {
+    m = pack_select<0>(comm_kernel,n,list,buf,pbc_flag,pbc,mcomm);
+  } else if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
       j = list[i];
       buf[m++] = x[j][0];
@@ -381,7 +399,7 @@ int AtomVec::pack_comm(int n, int *list, double *buf,
     }
   }
 
-  if (ncomm) {
+  if (ncomm && !comm_kernel) {
     for (nn = 0; nn < ncomm; nn++) {
       pdata = mcomm.pdata[nn];
       datatype = mcomm.datatype[nn];
@@ -570,13 +588,17 @@ void AtomVec::unpack_comm(int n, int first, double *buf)
 
   m = 0;
   last = first + n;
-  for (i = first; i < last; i++) {
-    x[i][0] = buf[m++];
-    x[i][1] = buf[m++];
-    x[i][2] = buf[m++];
+  if (comm_kernel) {
+    m = unpack_select<0>(comm_kernel,n,first,buf,mcomm);
+  } else {
+    for (i = first; i < last; i++) {
+      x[i][0] = buf[m++];
+      x[i][1] = buf[m++];
+      x[i][2] = buf[m++];
+    }
   }
 
-  if (ncomm) {
+  if (ncomm && !comm_kernel) {
     for (nn = 0; nn < ncomm; nn++) {
       pdata = mcomm.pdata[nn];
       datatype = mcomm.datatype[nn];
@@ -691,13 +713,17 @@ int AtomVec::pack_reverse(int n, int first, double *buf)
   int i,m,last,mm,nn,datatype,cols;
   void *pdata;
 
-  m = 0;
   last = first + n;
-  for (i = first; i < last; i++) {
-    buf[m++] = f[i][0];
-    buf[m++] = f[i][1];
-    buf[m++] = f[i][2];
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,first,buf) \
+  schedule(static) if(n >= THREAD_MINATOM)
+#endif
+  for (int ii = 0; ii < n; ii++) {
+    buf[3*ii] = f[first+ii][0];
+    buf[3*ii+1] = f[first+ii][1];
+    buf[3*ii+2] = f[first+ii][2];
   }
+  m = 3*n;
 
   if (nreverse) {
     for (nn = 0; nn < nreverse; nn++) {
@@ -757,13 +783,19 @@ void AtomVec::unpack_reverse(int n, int *list, double *buf)
   int i,j,m,mm,nn,datatype,cols;
   void *pdata;
 
-  m = 0;
-  for (i = 0; i < n; i++) {
-    j = list[i];
-    f[j][0] += buf[m++];
-    f[j][1] += buf[m++];
-    f[j][2] += buf[m++];
+  // each atom appears only once in a swap list, so threads update distinct atoms
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,list,buf) \
+  schedule(static) if(n >= THREAD_MINATOM)
+#endif
+  for (int ii = 0; ii < n; ii++) {
+    const int jj = list[ii];
+    f[jj][0] += buf[3*ii];
+    f[jj][1] += buf[3*ii+1];
+    f[jj][2] += buf[3*ii+2];
   }
+  m = 3*n;
 
   if (nreverse) {
     for (nn = 0; nn < nreverse; nn++) {
@@ -829,7 +861,9 @@ int AtomVec::pack_border(int n, int *list, double *buf, int pbc_flag, int *pbc)
   void *pdata;
 
   m = 0;
-  if (pbc_flag == 0) {
+  if (border_kernel) {
+    m = pack_select<1>(border_kernel,n,list,buf,pbc_flag,pbc,mborder);
+  } else if (pbc_flag == 0) {
     for (i = 0; i < n; i++) {
       j = list[i];
       buf[m++] = x[j][0];
@@ -860,7 +894,7 @@ int AtomVec::pack_border(int n, int *list, double *buf, int pbc_flag, int *pbc)
     }
   }
 
-  if (nborder) {
+  if (nborder && !border_kernel) {
     for (nn = 0; nn < nborder; nn++) {
       pdata = mborder.pdata[nn];
       datatype = mborder.datatype[nn];
@@ -1068,16 +1102,20 @@ void AtomVec::unpack_border(int n, int first, double *buf)
   last = first + n;
   while (last > nmax) grow(0);
 
-  for (i = first; i < last; i++) {
-    x[i][0] = buf[m++];
-    x[i][1] = buf[m++];
-    x[i][2] = buf[m++];
-    tag[i] = (tagint) ubuf(buf[m++]).i;
-    type[i] = (int) ubuf(buf[m++]).i;
-    mask[i] = (int) ubuf(buf[m++]).i;
+  if (border_kernel) {
+    m = unpack_select<1>(border_kernel,n,first,buf,mborder);
+  } else {
+    for (i = first; i < last; i++) {
+      x[i][0] = buf[m++];
+      x[i][1] = buf[m++];
+      x[i][2] = buf[m++];
+      tag[i] = (tagint) ubuf(buf[m++]).i;
+      type[i] = (int) ubuf(buf[m++]).i;
+      mask[i] = (int) ubuf(buf[m++]).i;
+    }
   }
 
-  if (nborder) {
+  if (nborder && !border_kernel) {
     for (nn = 0; nn < nborder; nn++) {
       pdata = mborder.pdata[nn];
       datatype = mborder.datatype[nn];
@@ -2290,7 +2328,7 @@ double AtomVec::memory_usage()
   bytes += memory->usage(image,nmax);
   bytes += memory->usage(x,nmax,3);
   bytes += memory->usage(v,nmax,3);
-  bytes += memory->usage(f,nmax*comm->nthreads,3);
+  bytes += memory->usage(f,nmax*(atom->fshared ? 1 : comm->nthreads),3);
 
   for (int i = 0; i < ngrow; i++) {
     pdata = mgrow.pdata[i];
@@ -2520,6 +2558,192 @@ void AtomVec::init_method(int nfield, Method *method)
   }
 }
 
+/* ----------------------------------------------------------------------
+   select specialized pack/unpack kernel for a set of comm or border fields
+   return 0 for generic loops, if fields are not all scalar,
+     more than 2 leading doubles or more than 1 trailing int
+   else return 1 + ND + 3*ITYPE, ITYPE = 0/1/2 for no/int/bigint field
+   no fields also use a kernel, so coords alone are packed by threads
+------------------------------------------------------------------------- */
+
+int AtomVec::select_kernel(int nfield, Method &method)
+{
+  if (nfield == 0) return 1;
+
+  int nd = 0;
+  while (nd < nfield && method.datatype[nd] == Atom::DOUBLE &&
+         method.cols[nd] == 0) nd++;
+  if (nd > 2) return 0;
+
+  int itype = 0;
+  if (nfield-nd > 1) return 0;
+  if (nfield-nd == 1) {
+    if (method.cols[nd] != 0) return 0;
+    if (method.datatype[nd] == Atom::INT) itype = 1;
+    else if (method.datatype[nd] == Atom::BIGINT) itype = 2;
+    else return 0;
+  }
+
+  return 1 + nd + 3*itype;
+}
+
+/* ----------------------------------------------------------------------
+   dispatch to kernel selected by select_kernel()
+------------------------------------------------------------------------- */
+
+template <int BORDER>
+int AtomVec::pack_select(int kernel, int n, int *list, double *buf,
+                         int pbc_flag, int *pbc, Method &method)
+{
+  switch (kernel) {
+  case 1: return pack_kernel<BORDER,0,0,int>(n,list,buf,pbc_flag,pbc,method);
+  case 2: return pack_kernel<BORDER,1,0,int>(n,list,buf,pbc_flag,pbc,method);
+  case 3: return pack_kernel<BORDER,2,0,int>(n,list,buf,pbc_flag,pbc,method);
+  case 4: return pack_kernel<BORDER,0,1,int>(n,list,buf,pbc_flag,pbc,method);
+  case 5: return pack_kernel<BORDER,1,1,int>(n,list,buf,pbc_flag,pbc,method);
+  case 6: return pack_kernel<BORDER,2,1,int>(n,list,buf,pbc_flag,pbc,method);
+  case 7: return pack_kernel<BORDER,0,1,bigint>(n,list,buf,pbc_flag,pbc,method);
+  case 8: return pack_kernel<BORDER,1,1,bigint>(n,list,buf,pbc_flag,pbc,method);
+  case 9: return pack_kernel<BORDER,2,1,bigint>(n,list,buf,pbc_flag,pbc,method);
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int BORDER>
+int AtomVec::unpack_select(int kernel, int n, int first, double *buf,
+                           Method &method)
+{
+  switch (kernel) {
+  case 1: return unpack_kernel<BORDER,0,0,int>(n,first,buf,method);
+  case 2: return unpack_kernel<BORDER,1,0,int>(n,first,buf,method);
+  case 3: return unpack_kernel<BORDER,2,0,int>(n,first,buf,method);
+  case 4: return unpack_kernel<BORDER,0,1,int>(n,first,buf,method);
+  case 5: return unpack_kernel<BORDER,1,1,int>(n,first,buf,method);
+  case 6: return unpack_kernel<BORDER,2,1,int>(n,first,buf,method);
+  case 7: return unpack_kernel<BORDER,0,1,bigint>(n,first,buf,method);
+  case 8: return unpack_kernel<BORDER,1,1,bigint>(n,first,buf,method);
+  case 9: return unpack_kernel<BORDER,2,1,bigint>(n,first,buf,method);
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   pack coords (plus tag, type, mask if BORDER) and ND double + NI int fields
+     of each atom in one pass, so each atom's data is gathered only once
+   each atom has a fixed slot in buf, so large lists are packed by threads
+     and the buffer is the same as with one thread
+   PBC shift is same as in pack_comm() or pack_border()
+------------------------------------------------------------------------- */
+
+template <int BORDER, int ND, int NI, typename TI>
+int AtomVec::pack_kernel(int n, int *list, double *buf,
+                         int pbc_flag, int *pbc, Method &method)
+{
+  const int size = 3 + 3*BORDER + ND + NI;
+  double dx,dy,dz;
+  double *dvec[ND+1];
+  TI *ivec[NI+1];
+
+  for (int k = 0; k < ND; k++) dvec[k] = *((double **) method.pdata[k]);
+  for (int k = 0; k < NI; k++) ivec[k] = *((TI **) method.pdata[ND+k]);
+
+  if (pbc_flag == 0) {
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,list,buf,dvec,ivec) \
+  schedule(static) if(n >= THREAD_MINATOM)
+#endif
+    for (int i = 0; i < n; i++) {
+      const int j = list[i];
+      double *b = &buf[i*size];
+      int m = 0;
+      b[m++] = x[j][0];
+      b[m++] = x[j][1];
+      b[m++] = x[j][2];
+      if (BORDER) {
+        b[m++] = ubuf(tag[j]).d;
+        b[m++] = ubuf(type[j]).d;
+        b[m++] = ubuf(mask[j]).d;
+      }
+      for (int k = 0; k < ND; k++) b[m++] = dvec[k][j];
+      for (int k = 0; k < NI; k++) b[m++] = ubuf(ivec[k][j]).d;
+    }
+  } else {
+    if (domain->triclinic == 0) {
+      dx = pbc[0]*domain->xprd;
+      dy = pbc[1]*domain->yprd;
+      dz = pbc[2]*domain->zprd;
+    } else if (BORDER) {
+      dx = pbc[0];
+      dy = pbc[1];
+      dz = pbc[2];
+    } else {
+      dx = pbc[0]*domain->xprd + pbc[5]*domain->xy + pbc[4]*domain->xz;
+      dy = pbc[1]*domain->yprd + pbc[3]*domain->yz;
+      dz = pbc[2]*domain->zprd;
+    }
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,list,buf,dvec,ivec,dx,dy,dz) \
+  schedule(static) if(n >= THREAD_MINATOM)
+#endif
+    for (int i = 0; i < n; i++) {
+      const int j = list[i];
+      double *b = &buf[i*size];
+      int m = 0;
+      b[m++] = x[j][0] + dx;
+      b[m++] = x[j][1] + dy;
+      b[m++] = x[j][2] + dz;
+      if (BORDER) {
+        b[m++] = ubuf(tag[j]).d;
+        b[m++] = ubuf(type[j]).d;
+        b[m++] = ubuf(mask[j]).d;
+      }
+      for (int k = 0; k < ND; k++) b[m++] = dvec[k][j];
+      for (int k = 0; k < NI; k++) b[m++] = ubuf(ivec[k][j]).d;
+    }
+  }
+
+  return n*size;
+}
+
+/* ----------------------------------------------------------------------
+   unpack data packed by pack_kernel() with same template arguments
+------------------------------------------------------------------------- */
+
+template <int BORDER, int ND, int NI, typename TI>
+int AtomVec::unpack_kernel(int n, int first, double *buf, Method &method)
+{
+  const int size = 3 + 3*BORDER + ND + NI;
+  double *dvec[ND+1];
+  TI *ivec[NI+1];
+
+  for (int k = 0; k < ND; k++) dvec[k] = *((double **) method.pdata[k]);
+  for (int k = 0; k < NI; k++) ivec[k] = *((TI **) method.pdata[ND+k]);
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE LMP_SHARED(n,first,buf,dvec,ivec) \
+  schedule(static) if(n >= THREAD_MINATOM)
+#endif
+  for (int ii = 0; ii < n; ii++) {
+    const int i = first + ii;
+    const double *b = &buf[ii*size];
+    int m = 0;
+    x[i][0] = b[m++];
+    x[i][1] = b[m++];
+    x[i][2] = b[m++];
+    if (BORDER) {
+      tag[i] = (tagint) ubuf(b[m++]).i;
+      type[i] = (int) ubuf(b[m++]).i;
+      mask[i] = (int) ubuf(b[m++]).i;
+    }
+    for (int k = 0; k < ND; k++) dvec[k][i] = b[m++];
+    for (int k = 0; k < NI; k++) ivec[k][i] = (TI) ubuf(b[m++]).i;
+  }
+
+  return n*size;
+}
+
 /* ----------------------------------------------------------------------
    Method class members
 ------------------------------------------------------------------------- */
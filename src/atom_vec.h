@@ -216,6 +216,12 @@ class AtomVec : protected Pointers {
 
   bool *threads;
 
+  // specialized single-pass pack/unpack for forward and border comm
+  // used if extra fields are ND scalar doubles followed by NI scalar ints
+  // 0 = generic field-by-field loops, else encodes ND, NI, and int type
+
+  int comm_kernel, border_kernel;
+
   // local methods
 
   void grow_nmax();
@@ -223,6 +229,16 @@ class AtomVec : protected Pointers {
   void setup_fields();
   int process_fields(char *, const char *, Method *);
   void init_method(int, Method *);
+  int select_kernel(int, Method &);
+
+  template <int BORDER>
+  int pack_select(int, int, int *, double *, int, int *, Method &);
+  template <int BORDER>
+  int unpack_select(int, int, int, double *, Method &);
+  template <int BORDER, int ND, int NI, typename TI>
+  int pack_kernel(int, int *, double *, int, int *, Method &);
+  template <int BORDER, int ND, int NI, typename TI>
+  int unpack_kernel(int, int, double *, Method &);
 };
 
 }    // namespace LAMMPS_NS
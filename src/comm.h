@@ -76,6 +76,8 @@ class Comm : protected Pointers {
 
   virtual void setup() = 0;                        // setup 3d comm pattern
   virtual void forward_comm(int dummy = 0) = 0;    // forward comm of atom coords
+  virtual void forward_comm_start() { forward_comm(); }    // split-phase forward
+  virtual void forward_comm_finish() {}                    // comm of atom coords
   virtual void reverse_comm() = 0;                 // reverse comm of forces
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
@@ -27,6 +27,7 @@
 #include "fix.h"
 #include "memory.h"
 #include "neighbor.h"
+#include "omp_compat.h"
 #include "pair.h"
 
 #include <cmath>
@@ -39,6 +40,65 @@ using namespace LAMMPS_NS;
 #define BUFMIN 1024
 #define BIG 1.0e20
 
+/* ----------------------------------------------------------------------
+   thread-parallel search for atoms first to last-1 by coord in dim
+   INSIDE = 1: lo <= x <= hi, for border atoms
+   INSIDE = 0: x < lo or x >= hi, for atoms leaving the sub-domain
+   atoms are split into nchunk contiguous chunks, one per thread
+   slab_count() sets offset[c] = # of selected atoms in chunks before c
+   slab_fill() then stores selected atoms in list in ascending order,
+     so the list is the same as from a serial loop
+------------------------------------------------------------------------- */
+
+template <int INSIDE>
+static inline int slab_member(double coord, double lo, double hi)
+{
+  if (INSIDE) return (coord >= lo && coord <= hi);
+  return (coord < lo || coord >= hi);
+}
+
+template <int INSIDE>
+static void slab_count(double **x, int dim, double lo, double hi,
+                       int first, int last, int nchunk, int *offset)
+{
+  const int delta = (last-first)/nchunk + 1;
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE \
+  LMP_SHARED(x,dim,lo,hi,first,last,nchunk,offset) schedule(static,1)
+#endif
+  for (int c = 0; c < nchunk; c++) {
+    const int ifrom = first + c*delta;
+    const int ito = MIN(ifrom+delta,last);
+    int n = 0;
+    for (int i = ifrom; i < ito; i++)
+      if (slab_member<INSIDE>(x[i][dim],lo,hi)) n++;
+    offset[c+1] = n;
+  }
+
+  offset[0] = 0;
+  for (int c = 0; c < nchunk; c++) offset[c+1] += offset[c];
+}
+
+template <int INSIDE>
+static void slab_fill(double **x, int dim, double lo, double hi,
+                      int first, int last, int nchunk, int *offset, int *list)
+{
+  const int delta = (last-first)/nchunk + 1;
+
+#if defined(_OPENMP)
+#pragma omp parallel for LMP_DEFAULT_NONE \
+  LMP_SHARED(x,dim,lo,hi,first,last,nchunk,offset,list) schedule(static,1)
+#endif
+  for (int c = 0; c < nchunk; c++) {
+    const int ifrom = first + c*delta;
+    const int ito = MIN(ifrom+delta,last);
+    int n = offset[c];
+    for (int i = ifrom; i < ito; i++)
+      if (slab_member<INSIDE>(x[i][dim],lo,hi)) list[n++] = i;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 CommBrick::CommBrick(LAMMPS *lmp) :
@@ -78,6 +138,11 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  memory->destroy(chunkoffset);
+  memory->destroy(exchlist);
+
+  free_persistent();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -112,12 +177,22 @@ void CommBrick::init_buffers()
 
   buf_send = buf_recv = nullptr;
   maxsend = maxrecv = BUFMIN;
+
+  chunkoffset = exchlist = nullptr;
+  maxchunk = maxexchlist = 0;
   grow_send(maxsend,2);
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
   nswap = 0;
   maxswap = 6;
   allocate_swap(maxswap);
+  nswap_start = 0;
+  nrequest_start = -1;
+
+  npersist = 0;
+  request_forward = request_reverse = nullptr;
+  x_persist = f_persist = nullptr;
+  buf_send_persist = buf_recv_persist = nullptr;
 
   sendlist = (int **) memory->smalloc(maxswap*sizeof(int *),"comm:sendlist");
   memory->create(maxsendlist,maxswap,"comm:maxsendlist");
@@ -542,24 +617,22 @@ void CommBrick::forward_comm(int /*dummy*/)
   MPI_Request request;
   AtomVec *avec = atom->avec;
   double **x = atom->x;
-  double *buf;
 
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
+  //   via persistent requests, which are recreated if x or buf_send changed
+
+  if (comm_x_only && !persistent_current()) setup_persistent();
 
   for (int iswap = 0; iswap < nswap; iswap++) {
     if (sendproc[iswap] != me) {
       if (comm_x_only) {
-        if (size_forward_recv[iswap]) {
-          buf = x[firstrecv[iswap]];
-          MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,
-                    recvproc[iswap],0,world,&request);
-        }
+        if (size_forward_recv[iswap]) MPI_Start(&request_forward[2*iswap]);
         n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
                             buf_send,pbc_flag[iswap],pbc[iswap]);
-        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (n) MPI_Start(&request_forward[2*iswap+1]);
+        MPI_Waitall(2,&request_forward[2*iswap],MPI_STATUSES_IGNORE);
       } else if (ghost_velocity) {
         if (size_forward_recv[iswap])
           MPI_Irecv(buf_recv,size_forward_recv[iswap],MPI_DOUBLE,
@@ -598,6 +671,80 @@ void CommBrick::forward_comm(int /*dummy*/)
   }
 }
 
+/* ----------------------------------------------------------------------
+   start split-phase forward communication of atom coords
+   leading swaps send only owned atoms, so they can all be in flight at once
+     while owned atoms are used, e.g. for pair forces on interior atoms
+   only done when coords are received directly into x, else comm is blocking
+   forward_comm_finish() must be called before ghost coords are used
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  if (!comm_x_only || ghost_velocity) {
+    forward_comm();
+    nrequest_start = -1;
+    return;
+  }
+
+  int n;
+  int offset = 0;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  nrequest_start = 0;
+  for (int iswap = 0; iswap < nswap_start; iswap++) {
+    if (sendproc[iswap] != me) {
+      if (size_forward_recv[iswap])
+        MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                  recvproc[iswap],0,world,&request_start[nrequest_start++]);
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                          &buf_send[offset],pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Isend(&buf_send[offset],n,MPI_DOUBLE,sendproc[iswap],0,world,
+                       &request_start[nrequest_start++]);
+      offset += n;
+    } else {
+      if (sendnum[iswap])
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                        x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   complete split-phase forward communication of atom coords
+   wait for leading swaps, then perform remaining swaps which may
+     send ghost atoms received in earlier swaps
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  if (nrequest_start < 0) return;
+  if (nrequest_start)
+    MPI_Waitall(nrequest_start,request_start,MPI_STATUSES_IGNORE);
+  nrequest_start = -1;
+
+  int n;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  if (!persistent_current()) setup_persistent();
+
+  for (int iswap = nswap_start; iswap < nswap; iswap++) {
+    if (sendproc[iswap] != me) {
+      if (size_forward_recv[iswap]) MPI_Start(&request_forward[2*iswap]);
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                          buf_send,pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Start(&request_forward[2*iswap+1]);
+      MPI_Waitall(2,&request_forward[2*iswap],MPI_STATUSES_IGNORE);
+    } else {
+      if (sendnum[iswap])
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                        x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    reverse communication of forces on atoms every timestep
    other per-atom attributes may also be sent via pack/unpack routines
@@ -609,24 +756,20 @@ void CommBrick::reverse_comm()
   MPI_Request request;
   AtomVec *avec = atom->avec;
   double **f = atom->f;
-  double *buf;
 
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
+  //   via persistent requests, which are recreated if f or buf_recv changed
+
+  if (comm_f_only && !persistent_current()) setup_persistent();
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     if (sendproc[iswap] != me) {
       if (comm_f_only) {
-        if (size_reverse_recv[iswap])
-          MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
-                    sendproc[iswap],0,world,&request);
-        if (size_reverse_send[iswap]) {
-          buf = f[firstrecv[iswap]];
-          MPI_Send(buf,size_reverse_send[iswap],MPI_DOUBLE,
-                   recvproc[iswap],0,world);
-        }
-        if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_reverse_recv[iswap]) MPI_Start(&request_reverse[2*iswap]);
+        if (size_reverse_send[iswap]) MPI_Start(&request_reverse[2*iswap+1]);
+        MPI_Waitall(2,&request_reverse[2*iswap],MPI_STATUSES_IGNORE);
       } else {
         if (size_reverse_recv[iswap])
           MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
@@ -714,13 +857,46 @@ void CommBrick::exchange()
     nlocal = atom->nlocal;
     i = nsend = 0;
 
-    while (i < nlocal) {
-      if (x[i][dim] < lo || x[i][dim] >= hi) {
-        if (nsend > maxsend) grow_send(nsend,1);
-        nsend += avec->pack_exchange(i,&buf_send[nsend]);
-        avec->copy(nlocal-1,i,1);
-        nlocal--;
-      } else i++;
+    // with threads, find leaving atoms first, then pack and delete them
+    //   in the same order as the serial loop: when an atom leaves, the
+    //   last atom is copied into its place and checked next
+
+    int nchunk = slab_chunks(nlocal);
+    if (nchunk > 1) {
+      slab_count<0>(x,dim,lo,hi,0,nlocal,nchunk,chunkoffset);
+      int nleave = chunkoffset[nchunk];
+      if (nleave > maxexchlist) {
+        maxexchlist = static_cast<int> (BUFFACTOR * nleave);
+        memory->destroy(exchlist);
+        memory->create(exchlist,maxexchlist,"comm:exchlist");
+      }
+      slab_fill<0>(x,dim,lo,hi,0,nlocal,nchunk,chunkoffset,exchlist);
+
+      int ifirst = 0;
+      int ilast = nleave-1;
+      while (ifirst <= ilast) {
+        i = exchlist[ifirst++];
+        while (true) {
+          if (nsend > maxsend) grow_send(nsend,1);
+          nsend += avec->pack_exchange(i,&buf_send[nsend]);
+          int lastleave = (nlocal-1 > i && ifirst <= ilast &&
+                           exchlist[ilast] == nlocal-1);
+          avec->copy(nlocal-1,i,1);
+          nlocal--;
+          if (!lastleave) break;
+          ilast--;
+        }
+      }
+
+    } else {
+      while (i < nlocal) {
+        if (x[i][dim] < lo || x[i][dim] >= hi) {
+          if (nsend > maxsend) grow_send(nsend,1);
+          nsend += avec->pack_exchange(i,&buf_send[nsend]);
+          avec->copy(nlocal-1,i,1);
+          nlocal--;
+        } else i++;
+      }
     }
     atom->nlocal = nlocal;
 
@@ -788,7 +964,7 @@ void CommBrick::borders()
 {
   int i,n,itype,icollection,iswap,dim,ineed,twoneed;
   int nsend,nrecv,sendflag,nfirst,nlast,ngroup,nprior;
-  double lo,hi;
+  double lo = 0.0, hi = 0.0;
   int *type;
   int *collection;
   double **x;
@@ -803,6 +979,7 @@ void CommBrick::borders()
 
   iswap = 0;
   smax = rmax = 0;
+  nswap_start = 0;
 
   for (dim = 0; dim < 3; dim++) {
     nlast = 0;
@@ -850,11 +1027,20 @@ void CommBrick::borders()
       if (sendflag) {
         if (!bordergroup || ineed >= 2) {
           if (mode == Comm::SINGLE) {
-            for (i = nfirst; i < nlast; i++)
-              if (x[i][dim] >= lo && x[i][dim] <= hi) {
-                if (nsend == maxsendlist[iswap]) grow_list(iswap,nsend);
-                sendlist[iswap][nsend++] = i;
-              }
+            int nchunk = slab_chunks(nlast-nfirst);
+            if (nchunk > 1) {
+              slab_count<1>(x,dim,lo,hi,nfirst,nlast,nchunk,chunkoffset);
+              nsend = chunkoffset[nchunk];
+              if (nsend > maxsendlist[iswap]) grow_list(iswap,nsend);
+              slab_fill<1>(x,dim,lo,hi,nfirst,nlast,nchunk,chunkoffset,
+                           sendlist[iswap]);
+            } else {
+              for (i = nfirst; i < nlast; i++)
+                if (x[i][dim] >= lo && x[i][dim] <= hi) {
+                  if (nsend == maxsendlist[iswap]) grow_list(iswap,nsend);
+                  sendlist[iswap][nsend++] = i;
+                }
+            }
           } else if (mode == Comm::MULTI) {
             for (i = nfirst; i < nlast; i++) {
               icollection = collection[i];
@@ -973,6 +1159,10 @@ void CommBrick::borders()
       atom->nghost += nrecv;
       if (neighbor->style == Neighbor::MULTI) neighbor->build_collection(nprior);
 
+      // first 2 swaps in x only send owned atoms, see forward_comm_start()
+
+      if (dim == 0 && ineed < 2) nswap_start = iswap+1;
+
       iswap++;
     }
   }
@@ -987,11 +1177,20 @@ void CommBrick::borders()
 
   // insure send/recv buffers are long enough for all forward & reverse comm
 
+  // leading swaps of forward_comm_start() pack into disjoint parts of buf_send
+
   int max = MAX(maxforward*smax,maxreverse*rmax);
+  n = 0;
+  for (iswap = 0; iswap < nswap_start; iswap++) n += sendnum[iswap];
+  max = MAX(max,maxforward*n);
   if (max > maxsend) grow_send(max,0);
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // persistent requests for the new swap pattern
+
+  setup_persistent();
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
@@ -1469,6 +1668,90 @@ int CommBrick::exchange_variable(int n, double *inbuf, double *&outbuf)
   return nrecv;
 }
 
+/* ----------------------------------------------------------------------
+   create persistent requests for forward comm of x and reverse comm of f
+   requests are bound to the current swap pattern and to x, f, and
+     the send/recv buffers, so must be recreated when any of them change
+   only done if comm is performed directly from/to x or f
+   swaps with self or without data get MPI_REQUEST_NULL
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_persistent()
+{
+  free_persistent();
+  if (!comm_x_only && !comm_f_only) return;
+
+  double **x = atom->x;
+  double **f = atom->f;
+
+  request_forward = new MPI_Request[2*nswap];
+  request_reverse = new MPI_Request[2*nswap];
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    MPI_Request *fwd = &request_forward[2*iswap];
+    MPI_Request *rev = &request_reverse[2*iswap];
+    fwd[0] = fwd[1] = rev[0] = rev[1] = MPI_REQUEST_NULL;
+    if (sendproc[iswap] == me) continue;
+
+    if (comm_x_only) {
+      if (size_forward_recv[iswap])
+        MPI_Recv_init(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&fwd[0]);
+      if (sendnum[iswap])
+        MPI_Send_init(buf_send,sendnum[iswap]*size_forward,MPI_DOUBLE,
+                      sendproc[iswap],0,world,&fwd[1]);
+    }
+    if (comm_f_only) {
+      if (size_reverse_recv[iswap])
+        MPI_Recv_init(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,
+                      sendproc[iswap],0,world,&rev[0]);
+      if (size_reverse_send[iswap])
+        MPI_Send_init(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                      recvproc[iswap],0,world,&rev[1]);
+    }
+  }
+
+  npersist = nswap;
+  x_persist = x ? x[0] : nullptr;
+  f_persist = f ? f[0] : nullptr;
+  buf_send_persist = buf_send;
+  buf_recv_persist = buf_recv;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommBrick::free_persistent()
+{
+  if (request_forward) {
+    for (int i = 0; i < 2*npersist; i++) {
+      if (request_forward[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_forward[i]);
+      if (request_reverse[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_reverse[i]);
+    }
+  }
+  delete [] request_forward;
+  delete [] request_reverse;
+  request_forward = request_reverse = nullptr;
+  npersist = 0;
+  x_persist = f_persist = nullptr;
+  buf_send_persist = buf_recv_persist = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   check if persistent requests match current swap pattern and buffers
+   requests point into the per-atom data blocks, which Memory::grow()
+     reallocs separately from the row pointers, so compare the data blocks
+------------------------------------------------------------------------- */
+
+int CommBrick::persistent_current()
+{
+  return (request_forward && npersist == nswap &&
+          atom->x && x_persist == atom->x[0] &&
+          atom->f && f_persist == atom->f[0] &&
+          buf_send_persist == buf_send && buf_recv_persist == buf_recv);
+}
+
 /* ----------------------------------------------------------------------
    realloc the size of the send buffer as needed with BUFFACTOR and bufextra
    flag = 0, don't need to realloc with copy, just free/malloc w/ BUFFACTOR
@@ -1512,6 +1795,25 @@ void CommBrick::grow_list(int iswap, int n)
   memory->grow(sendlist[iswap],maxsendlist[iswap],"comm:sendlist[iswap]");
 }
 
+/* ----------------------------------------------------------------------
+   return # of thread chunks to search n atoms for border or exchange atoms
+   1 = use serial loop
+------------------------------------------------------------------------- */
+
+int CommBrick::slab_chunks(int n)
+{
+  int nchunk = 1;
+#if defined(_OPENMP)
+  if (n >= THREAD_MINATOM) nchunk = nthreads;
+#endif
+  if (nchunk > 1 && nchunk+1 > maxchunk) {
+    maxchunk = nchunk+1;
+    memory->destroy(chunkoffset);
+    memory->create(chunkoffset,maxchunk,"comm:chunkoffset");
+  }
+  return nchunk;
+}
+
 /* ----------------------------------------------------------------------
    realloc the buffers needed for swaps
 ------------------------------------------------------------------------- */
@@ -1665,5 +1967,7 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += (double)maxchunk * sizeof(int);
+  bytes += (double)maxexchlist * sizeof(int);
   return bytes;
 }
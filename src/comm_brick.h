@@ -27,6 +27,8 @@ class CommBrick : public Comm {
   virtual void init();
   virtual void setup();                        // setup 3d comm pattern
   virtual void forward_comm(int dummy = 0);    // forward comm of atom coords
+  virtual void forward_comm_start();           // post 1st swaps of forward comm
+  virtual void forward_comm_finish();          // complete forward comm
   virtual void reverse_comm();                 // reverse comm of forces
   virtual void exchange();                     // move atoms to new procs
   virtual void borders();                      // setup list of atoms to comm
@@ -73,11 +75,30 @@ class CommBrick : public Comm {
   int *localsendlist;    // indexed list of local sendlist atoms
   int *maxsendlist;      // max size of send list for each swap
 
+  int nswap_start;                 // # of leading swaps that send only owned atoms
+  int nrequest_start;              // # of pending requests, -1 if comm is complete
+  MPI_Request request_start[4];    // send/recv requests of leading swaps
+
+  // persistent requests for forward comm of x and reverse comm of f
+  // 2 per swap (recv,send), created in borders() for current swap pattern
+  // valid as long as arrays and buffers they are bound to are not realloced
+
+  int npersist;                    // # of swaps with persistent requests
+  MPI_Request *request_forward;    // forward comm requests
+  MPI_Request *request_reverse;    // reverse comm requests
+  double *x_persist, *f_persist;   // data blocks of x and f
+  double *buf_send_persist, *buf_recv_persist;
+
   double *buf_send;        // send buffer for all comm
   double *buf_recv;        // recv buffer for all comm
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  int *chunkoffset;    // 1st selected atom of each thread's chunk in a slab search
+  int maxchunk;        // allocated size of chunkoffset
+  int *exchlist;       // owned atoms leaving in one dim in exchange()
+  int maxexchlist;     // allocated size of exchlist
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -93,6 +114,10 @@ class CommBrick : public Comm {
   virtual void free_swap();               // free swap arrays
   virtual void free_multi();              // free multi arrays
   virtual void free_multiold();           // free multi/old arrays
+  void setup_persistent();                // create persistent requests
+  void free_persistent();                 // free persistent requests
+  int persistent_current();               // check if requests are still valid
+  int slab_chunks(int);                   // # of thread chunks for a slab search
 };
 
 }    // namespace LAMMPS_NS
@@ -85,6 +85,7 @@ CommTiled::~CommTiled()
   memory->sfree(rcbinfo);
   memory->destroy(cutghostmulti);
   memory->destroy(cutghostmultiold);
+  free_persistent();
 }
 
 /* ----------------------------------------------------------------------
@@ -109,6 +110,13 @@ void CommTiled::init_buffers()
   // Note this may skip growing multi arrays, will call again in init()
   maxswap = 6;
   allocate_swap(maxswap);
+
+  npersist = nrecv_persist = nsend_persist = 0;
+  persist_recvfirst = persist_sendfirst = nullptr;
+  request_forward_recv = request_forward_send = nullptr;
+  request_reverse_recv = request_reverse_send = nullptr;
+  x_persist = f_persist = nullptr;
+  buf_send_persist = buf_recv_persist = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -728,22 +736,26 @@ void CommTiled::forward_comm(int /*dummy*/)
   // copy data to self if sendself is set
   // wait on all procs except self and unpack received data
   // if comm_x_only set, exchange or copy directly to x, don't unpack
+  //   via persistent requests, which are recreated if x or buf_send changed
+  //   sends from buf_send complete before it is packed for the next proc
+
+  MPI_Request *rrequest,*srequest;
+  if (comm_x_only && !persistent_current()) setup_persistent();
 
   for (int iswap = 0; iswap < nswap; iswap++) {
     nsend = nsendproc[iswap] - sendself[iswap];
     nrecv = nrecvproc[iswap] - sendself[iswap];
 
     if (comm_x_only) {
-      if (recvother[iswap]) {
-        for (i = 0; i < nrecv; i++)
-          MPI_Irecv(x[firstrecv[iswap][i]],size_forward_recv[iswap][i],
-                    MPI_DOUBLE,recvproc[iswap][i],0,world,&requests[i]);
-      }
+      rrequest = &request_forward_recv[persist_recvfirst[iswap]];
+      srequest = &request_forward_send[persist_sendfirst[iswap]];
+      if (recvother[iswap]) MPI_Startall(nrecv,rrequest);
       if (sendother[iswap]) {
         for (i = 0; i < nsend; i++) {
-          n = avec->pack_comm(sendnum[iswap][i],sendlist[iswap][i],
-                              buf_send,pbc_flag[iswap][i],pbc[iswap][i]);
-          MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap][i],0,world);
+          avec->pack_comm(sendnum[iswap][i],sendlist[iswap][i],
+                          buf_send,pbc_flag[iswap][i],pbc[iswap][i]);
+          MPI_Start(&srequest[i]);
+          MPI_Wait(&srequest[i],MPI_STATUS_IGNORE);
         }
       }
       if (sendself[iswap]) {
@@ -751,7 +763,7 @@ void CommTiled::forward_comm(int /*dummy*/)
                         x[firstrecv[iswap][nrecv]],pbc_flag[iswap][nsend],
                         pbc[iswap][nsend]);
       }
-      if (recvother[iswap]) MPI_Waitall(nrecv,requests,MPI_STATUS_IGNORE);
+      if (recvother[iswap]) MPI_Waitall(nrecv,rrequest,MPI_STATUS_IGNORE);
 
     } else if (ghost_velocity) {
       if (recvother[iswap]) {
@@ -831,31 +843,28 @@ void CommTiled::reverse_comm()
   // copy data to self if sendself is set
   // wait on all procs except self and unpack received data
   // if comm_f_only set, exchange or copy directly from f, don't pack
+  //   via persistent requests, which are recreated if f or buf_recv changed
+
+  MPI_Request *rrequest,*srequest;
+  if (comm_f_only && !persistent_current()) setup_persistent();
 
   for (int iswap = nswap-1; iswap >= 0; iswap--) {
     nsend = nsendproc[iswap] - sendself[iswap];
     nrecv = nrecvproc[iswap] - sendself[iswap];
 
     if (comm_f_only) {
-      if (sendother[iswap]) {
-        for (i = 0; i < nsend; i++) {
-          MPI_Irecv(&buf_recv[size_reverse*reverse_recv_offset[iswap][i]],
-                    size_reverse_recv[iswap][i],MPI_DOUBLE,
-                    sendproc[iswap][i],0,world,&requests[i]);
-        }
-      }
-      if (recvother[iswap]) {
-        for (i = 0; i < nrecv; i++)
-          MPI_Send(f[firstrecv[iswap][i]],size_reverse_send[iswap][i],
-                   MPI_DOUBLE,recvproc[iswap][i],0,world);
-      }
+      rrequest = &request_reverse_recv[persist_sendfirst[iswap]];
+      srequest = &request_reverse_send[persist_recvfirst[iswap]];
+      if (sendother[iswap]) MPI_Startall(nsend,rrequest);
+      if (recvother[iswap]) MPI_Startall(nrecv,srequest);
       if (sendself[iswap]) {
         avec->unpack_reverse(sendnum[iswap][nsend],sendlist[iswap][nsend],
                              f[firstrecv[iswap][nrecv]]);
       }
+      if (recvother[iswap]) MPI_Waitall(nrecv,srequest,MPI_STATUS_IGNORE);
       if (sendother[iswap]) {
         for (i = 0; i < nsend; i++) {
-          MPI_Waitany(nsend,requests,&irecv,MPI_STATUS_IGNORE);
+          MPI_Waitany(nsend,rrequest,&irecv,MPI_STATUS_IGNORE);
           avec->unpack_reverse(sendnum[iswap][irecv],sendlist[iswap][irecv],
                                &buf_recv[size_reverse*
                                          reverse_recv_offset[iswap][irecv]]);
@@ -1366,6 +1375,10 @@ void CommTiled::borders()
   max = MAX(maxforward*rmaxall,maxreverse*smaxall);
   if (max > maxrecv) grow_recv(max);
 
+  // persistent requests for the new swap pattern
+
+  setup_persistent();
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
@@ -2214,6 +2227,133 @@ int CommTiled::coord2proc(double *x, int &igx, int &igy, int &igz)
   return point_drop_tiled_recurse(x,0,nprocs-1);
 }
 
+/* ----------------------------------------------------------------------
+   create persistent requests for forward comm of x and reverse comm of f
+   requests are bound to the current swap pattern and to x, f, and
+     the send/recv buffers, so must be recreated when any of them change
+   only done if comm is performed directly from/to x or f
+   only procs other than self get requests, self is always last
+------------------------------------------------------------------------- */
+
+void CommTiled::setup_persistent()
+{
+  int i,iswap,nsend,nrecv;
+
+  free_persistent();
+  if (!comm_x_only && !comm_f_only) return;
+
+  double **x = atom->x;
+  double **f = atom->f;
+
+  persist_recvfirst = new int[nswap];
+  persist_sendfirst = new int[nswap];
+  int nrecvall = 0;
+  int nsendall = 0;
+  for (iswap = 0; iswap < nswap; iswap++) {
+    persist_recvfirst[iswap] = nrecvall;
+    persist_sendfirst[iswap] = nsendall;
+    nrecvall += nrecvproc[iswap] - sendself[iswap];
+    nsendall += nsendproc[iswap] - sendself[iswap];
+  }
+
+  request_forward_recv = new MPI_Request[nrecvall];
+  request_reverse_send = new MPI_Request[nrecvall];
+  request_forward_send = new MPI_Request[nsendall];
+  request_reverse_recv = new MPI_Request[nsendall];
+  for (i = 0; i < nrecvall; i++)
+    request_forward_recv[i] = request_reverse_send[i] = MPI_REQUEST_NULL;
+  for (i = 0; i < nsendall; i++)
+    request_forward_send[i] = request_reverse_recv[i] = MPI_REQUEST_NULL;
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+    nsend = nsendproc[iswap] - sendself[iswap];
+    nrecv = nrecvproc[iswap] - sendself[iswap];
+    MPI_Request *rrequest = &request_forward_recv[persist_recvfirst[iswap]];
+    MPI_Request *srequest = &request_forward_send[persist_sendfirst[iswap]];
+
+    if (comm_x_only) {
+      if (recvother[iswap])
+        for (i = 0; i < nrecv; i++)
+          MPI_Recv_init(x[firstrecv[iswap][i]],size_forward_recv[iswap][i],
+                        MPI_DOUBLE,recvproc[iswap][i],0,world,&rrequest[i]);
+      if (sendother[iswap])
+        for (i = 0; i < nsend; i++)
+          MPI_Send_init(buf_send,sendnum[iswap][i]*size_forward,MPI_DOUBLE,
+                        sendproc[iswap][i],0,world,&srequest[i]);
+    }
+
+    rrequest = &request_reverse_recv[persist_sendfirst[iswap]];
+    srequest = &request_reverse_send[persist_recvfirst[iswap]];
+
+    if (comm_f_only) {
+      if (sendother[iswap])
+        for (i = 0; i < nsend; i++)
+          MPI_Recv_init(&buf_recv[size_reverse*reverse_recv_offset[iswap][i]],
+                        size_reverse_recv[iswap][i],MPI_DOUBLE,
+                        sendproc[iswap][i],0,world,&rrequest[i]);
+      if (recvother[iswap])
+        for (i = 0; i < nrecv; i++)
+          MPI_Send_init(f[firstrecv[iswap][i]],size_reverse_send[iswap][i],
+                        MPI_DOUBLE,recvproc[iswap][i],0,world,&srequest[i]);
+    }
+  }
+
+  npersist = nswap;
+  nrecv_persist = nrecvall;
+  nsend_persist = nsendall;
+  x_persist = x ? x[0] : nullptr;
+  f_persist = f ? f[0] : nullptr;
+  buf_send_persist = buf_send;
+  buf_recv_persist = buf_recv;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommTiled::free_persistent()
+{
+  if (persist_recvfirst) {
+    for (int i = 0; i < nrecv_persist; i++) {
+      if (request_forward_recv[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_forward_recv[i]);
+      if (request_reverse_send[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_reverse_send[i]);
+    }
+    for (int i = 0; i < nsend_persist; i++) {
+      if (request_forward_send[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_forward_send[i]);
+      if (request_reverse_recv[i] != MPI_REQUEST_NULL)
+        MPI_Request_free(&request_reverse_recv[i]);
+    }
+  }
+
+  delete [] persist_recvfirst;
+  delete [] persist_sendfirst;
+  delete [] request_forward_recv;
+  delete [] request_forward_send;
+  delete [] request_reverse_recv;
+  delete [] request_reverse_send;
+  persist_recvfirst = persist_sendfirst = nullptr;
+  request_forward_recv = request_forward_send = nullptr;
+  request_reverse_recv = request_reverse_send = nullptr;
+  npersist = nrecv_persist = nsend_persist = 0;
+  x_persist = f_persist = nullptr;
+  buf_send_persist = buf_recv_persist = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   check if persistent requests match current swap pattern and buffers
+   requests point into the per-atom data blocks, which Memory::grow()
+     reallocs separately from the row pointers, so compare the data blocks
+------------------------------------------------------------------------- */
+
+int CommTiled::persistent_current()
+{
+  return (persist_recvfirst && npersist == nswap &&
+          atom->x && x_persist == atom->x[0] &&
+          atom->f && f_persist == atom->f[0] &&
+          buf_send_persist == buf_send && buf_recv_persist == buf_recv);
+}
+
 /* ----------------------------------------------------------------------
    realloc the size of the send buffer as needed with BUFFACTOR and bufextra
    flag = 0, don't need to realloc with copy, just free/malloc w/ BUFFACTOR
@@ -101,6 +101,21 @@ class CommTiled : public Comm {
   int maxrequest;    // max size of Request vector
   MPI_Request *requests;
 
+  // persistent requests for forward comm of x and reverse comm of f
+  // created in borders() for current swap pattern, indexed per swap
+  //   by persist_recvfirst + recv proc or persist_sendfirst + send proc
+  // valid as long as arrays and buffers they are bound to are not realloced
+
+  int npersist;                   // # of swaps with persistent requests
+  int nrecv_persist;              // # of recv proc requests of each kind
+  int nsend_persist;              // # of send proc requests of each kind
+  int *persist_recvfirst;         // 1st index of each swap in recv proc requests
+  int *persist_sendfirst;         // 1st index of each swap in send proc requests
+  MPI_Request *request_forward_recv, *request_forward_send;
+  MPI_Request *request_reverse_recv, *request_reverse_send;
+  double *x_persist, *f_persist;  // data blocks of x and f
+  double *buf_send_persist, *buf_recv_persist;
+
   struct RCBinfo {
     double mysplit[3][2];    // fractional RCB bounding box for one proc
     double cutfrac;          // fractional position of cut this proc owns
@@ -154,6 +169,9 @@ class CommTiled : public Comm {
   void grow_swap_send_multi(int, int);    // grow multi swap arrays for send and recv
   void grow_swap_recv(int, int);
   void deallocate_swap(int);    // deallocate swap arrays
+  void setup_persistent();      // create persistent requests
+  void free_persistent();       // free persistent requests
+  int persistent_current();     // check if requests are still valid
 };
 
 }    // namespace LAMMPS_NS
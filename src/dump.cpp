@@ -14,6 +14,7 @@
 
 #include "dump.h"
 
+#include "async_writer.h"
 #include "atom.h"
 #include "compute.h"
 #include "domain.h"
@@ -78,6 +79,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_flag = 0;
+  writer = nullptr;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -124,6 +127,11 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) : Pointers(lmp)
   if (me == 0) filewriter = 1;
   fileproc = 0;
   multiname = nullptr;
+  nodeflag = 0;
+
+  maxnodebuf = 0;
+  nodebuf = nullptr;
+  nodecounts = nodedispls = nullptr;
 
   char *ptr;
   if ((ptr = strchr(filename,'%'))) {
@@ -176,6 +184,9 @@ Dump::~Dump()
   delete irregular;
 
   memory->destroy(sbuf);
+  memory->destroy(nodebuf);
+  memory->destroy(nodecounts);
+  memory->destroy(nodedispls);
 
   if (pbcflag) {
     memory->destroy(xpbc);
@@ -193,6 +204,10 @@ Dump::~Dump()
     delete[] nameslist;
   }
 
+  // finish pending background writes before closing file
+
+  delete writer;
+
   // XTC style sets fp to a null pointer since it closes file in its destructor
 
   if (multifile == 0 && fp != nullptr) {
@@ -209,8 +224,21 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  if (async_flag && (!buffer_flag || binary))
+    error->all(FLERR,"Dump_modify async yes requires dump_modify buffer yes");
+
   init_style();
 
+  // background writer thread for buffered text output on file writers
+
+  if (async_flag && filewriter) {
+    if (!writer) writer = new AsyncWriter(2);
+    else async_wait();
+  } else {
+    delete writer;
+    writer = nullptr;
+  }
+
   if (!sort_flag) {
     memory->destroy(bufsort);
     memory->destroy(ids);
@@ -378,7 +406,13 @@ void Dump::write()
   if (multiproc)
     MPI_Allreduce(&bnme,&nheader,1,MPI_LMP_BIGINT,MPI_SUM,clustercomm);
 
-  if (filewriter) write_header(nheader);
+  // with a background writer the header is deferred until
+  //   prior writes to this file have completed
+
+  int async = 0;
+  if (writer && buffer_flag && !binary && fp) async = 1;
+
+  if (filewriter && !async) write_header(nheader);
 
   // insure buf is sized for packing and communicating
   // use nmax to insure filewriter proc can receive info from others
@@ -460,10 +494,18 @@ void Dump::write()
 
   // comm and output buf of doubles
 
+  // for node clusters, gather all data of the node to filewriter at once
+
   if (buffer_flag == 0 || binary) {
+    if (nodeflag) gather_node(buf,nme*size_one,MPI_DOUBLE,sizeof(double));
+
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
-        if (iproc) {
+        double *mybuf = buf;
+        if (nodeflag) {
+          mybuf = (double *) nodebuf + nodedispls[iproc];
+          nlines = nodecounts[iproc] / size_one;
+        } else if (iproc) {
           MPI_Irecv(buf,maxbuf*size_one,MPI_DOUBLE,me+iproc,0,world,&request);
           MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
           MPI_Wait(&request,&status);
@@ -471,32 +513,60 @@ void Dump::write()
           nlines /= size_one;
         } else nlines = nme;
 
-        write_data(nlines,buf);
+        write_data(nlines,mybuf);
       }
       if (flush_flag && fp) fflush(fp);
 
-    } else {
+    } else if (!nodeflag) {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
       MPI_Rsend(buf,nme*size_one,MPI_DOUBLE,fileproc,0,world);
     }
 
   // comm and output sbuf = one big string of formatted values per proc
 
+  // with a background writer, strings are copied into its fill buffer
+  //   and the writer thread does the fwrite(), fflush(), and
+  //   for one file per snapshot, also closes the file
+  // only the file I/O is overlapped: convert_string() has already run
+  //   on every proc, since it writes into sbuf and may grow it, which
+  //   must not happen outside the main thread
+
   } else {
+    if (nodeflag) gather_node(sbuf,nsme,MPI_CHAR,sizeof(char));
+
     if (filewriter) {
+      if (async) {
+        writer->wait(fp);
+        if (writer->failed())
+          error->one(FLERR,"Error writing dump file in background");
+        write_header(nheader);
+      }
+
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
-        if (iproc) {
+        char *mysbuf = sbuf;
+        if (nodeflag) {
+          mysbuf = nodebuf + nodedispls[iproc];
+          nchars = nodecounts[iproc];
+        } else if (iproc) {
           MPI_Irecv(sbuf,maxsbuf,MPI_CHAR,me+iproc,0,world,&request);
           MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
           MPI_Wait(&request,&status);
           MPI_Get_count(&status,MPI_CHAR,&nchars);
         } else nchars = nsme;
 
-        write_data(nchars,(double *) sbuf);
+        if (async) writer->append(mysbuf,nchars);
+        else write_data(nchars,(double *) mysbuf);
       }
-      if (flush_flag && fp) fflush(fp);
 
-    } else {
+      if (async) {
+        int close = AsyncWriter::NOCLOSE;
+        if (multifile)
+          close = compressed ? AsyncWriter::PCLOSE : AsyncWriter::FCLOSE;
+        writer->submit(fp,flush_flag,close);
+        if (multifile) fp = nullptr;
+      } else if (flush_flag && fp) fflush(fp);
+
+    } else if (!nodeflag) {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
       MPI_Rsend(sbuf,nsme,MPI_CHAR,fileproc,0,world);
     }
@@ -527,6 +597,49 @@ void Dump::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   gather n values of given datatype and byte size from each proc
+     in my node cluster into nodebuf on the filewriter of the node
+   uses one collective on clustercomm, which MPI maps to shared memory
+   sets nodecounts and nodedispls in units of datatype
+------------------------------------------------------------------------- */
+
+void Dump::gather_node(void *mybuf, int n, MPI_Datatype datatype, int size)
+{
+  MPI_Gather(&n,1,MPI_INT,nodecounts,1,MPI_INT,0,clustercomm);
+
+  if (filewriter) {
+    bigint ntotal = 0;
+    for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+      nodedispls[iproc] = ntotal;
+      ntotal += nodecounts[iproc];
+      if (ntotal*size > MAXSMALLINT)
+        error->one(FLERR,"Too much per-node info for dump");
+    }
+    if (ntotal*size > maxnodebuf) {
+      maxnodebuf = ntotal*size;
+      memory->destroy(nodebuf);
+      memory->create(nodebuf,maxnodebuf,"dump:nodebuf");
+    }
+  }
+
+  MPI_Gatherv(mybuf,n,datatype,nodebuf,nodecounts,nodedispls,datatype,0,
+              clustercomm);
+}
+
+/* ----------------------------------------------------------------------
+   wait for background writer to finish all pending output
+   called before output is written by other means and at end of run
+------------------------------------------------------------------------- */
+
+void Dump::async_wait()
+{
+  if (!writer) return;
+  writer->wait();
+  if (writer->failed())
+    error->one(FLERR,"Error writing dump file in background");
+}
+
 /* ----------------------------------------------------------------------
    generic opening of a dump file
    ASCII or binary or gzipped
@@ -925,6 +1038,15 @@ void Dump::modify_params(int narg, char **arg)
         error->all(FLERR,"Dump_modify buffer yes not allowed for this style");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) async_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) async_flag = 0;
+      else error->all(FLERR,"Illegal dump_modify command");
+      if (async_flag && buffer_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"delay") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
       delaystep = utils::bnumeric(FLERR,arg[iarg+1],false,lmp);
@@ -954,6 +1076,42 @@ void Dump::modify_params(int narg, char **arg)
       if (!multiproc)
         error->all(FLERR,"Cannot use dump_modify fileper "
                    "without % in dump file name");
+
+      // one file per shared-memory node, written by lowest rank on node
+      // icluster = index of node, ordered by world rank of its filewriter
+
+      if (strcmp(arg[iarg+1],"node") == 0) {
+        MPI_Comm_free(&clustercomm);
+        MPI_Comm_split_type(world,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,
+                            &clustercomm);
+        int noderank;
+        MPI_Comm_rank(clustercomm,&noderank);
+        MPI_Comm_size(clustercomm,&nclusterprocs);
+        if (noderank == 0) filewriter = 1;
+        else filewriter = 0;
+        fileproc = me;
+        MPI_Bcast(&fileproc,1,MPI_INT,0,clustercomm);
+        int icluster;
+        MPI_Scan(&filewriter,&icluster,1,MPI_INT,MPI_SUM,world);
+        icluster--;
+        MPI_Bcast(&icluster,1,MPI_INT,0,clustercomm);
+        MPI_Allreduce(&filewriter,&multiproc,1,MPI_INT,MPI_SUM,world);
+
+        nodeflag = 1;
+        memory->destroy(nodecounts);
+        memory->destroy(nodedispls);
+        memory->create(nodecounts,nclusterprocs,"dump:nodecounts");
+        memory->create(nodedispls,nclusterprocs,"dump:nodedispls");
+
+        delete [] multiname;
+        char *ptr = strchr(filename,'%');
+        *ptr = '\0';
+        multiname = utils::strdup(fmt::format("{}{}{}", filename, icluster, ptr+1));
+        *ptr = '%';
+        iarg += 2;
+        continue;
+      }
+
       int nper = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
       if (nper <= 0) error->all(FLERR,"Illegal dump_modify command");
 
@@ -965,6 +1123,7 @@ void Dump::modify_params(int narg, char **arg)
       if (me == fileproc) filewriter = 1;
       else filewriter = 0;
       int icluster = fileproc/nper;
+      nodeflag = 0;
 
       MPI_Comm_free(&clustercomm);
       MPI_Comm_split(world,icluster,0,&clustercomm);
@@ -1063,6 +1222,7 @@ void Dump::modify_params(int narg, char **arg)
       nclusterprocs = fileprocnext - fileproc;
       if (me == fileproc) filewriter = 1;
       else filewriter = 0;
+      nodeflag = 0;
 
       MPI_Comm_free(&clustercomm);
       MPI_Comm_split(world,icluster,0,&clustercomm);
@@ -1158,6 +1318,8 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,size_one*maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  bytes += (double)maxnodebuf;
+  if (nodeflag) bytes += (double)2*nclusterprocs * sizeof(int);
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
@@ -47,6 +47,7 @@ class Dump : protected Pointers {
   virtual void unpack_reverse_comm(int, int *, double *) {}
 
   void modify_params(int, char **);
+  void async_wait();
   virtual double memory_usage();
 
  protected:
@@ -62,6 +63,7 @@ class Dump : protected Pointers {
   int fileproc;            // ID of proc in my cluster who writes to file
   char *multiname;         // filename with % converted to cluster ID
   MPI_Comm clustercomm;    // MPI communicator within my cluster of procs
+  int nodeflag;            // 1 if clusters are shared-memory nodes
 
   int header_flag;          // 0 = item, 2 = xyz
   int flush_flag;           // 0 if no flush, 1 if flush every dump
@@ -69,6 +71,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_flag;           // 1 if file I/O, not formatting, done by thread
+  class AsyncWriter *writer;    // background writer, only on filewriter
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -123,6 +127,11 @@ class Dump : protected Pointers {
   int maxsbuf;    // size of sbuf
   char *sbuf;     // memory for atom quantities in string format
 
+  bigint maxnodebuf;         // size of nodebuf in bytes
+  char *nodebuf;             // data gathered from my node, on filewriter
+  int *nodecounts;           // # of values from each proc in my node
+  int *nodedispls;           // offset of each proc's values in nodebuf
+
   int maxids;     // size of ids
   int maxsort;    // size of bufsort, idsort, index
   int maxproc;    // size of proclist
@@ -146,6 +155,7 @@ class Dump : protected Pointers {
   virtual int convert_string(int, double *) { return 0; }
   virtual void write_data(int, double *) = 0;
   void pbc_allocate();
+  void gather_node(void *, int, MPI_Datatype, int);
   double compute_time();
 
   void sort();
@@ -221,6 +231,26 @@ E: Dump_modify buffer yes not allowed for this style
 
 Self-explanatory.
 
+E: Too much per-node info for dump
+
+The data gathered from all processors on a node for a dump snapshot
+exceeds the size of an MPI message.  Use dump_modify fileper or nfile
+to write more files.
+
+E: Dump_modify async yes not allowed for this style
+
+Self-explanatory.
+
+E: Dump_modify async yes requires dump_modify buffer yes
+
+Background writing is only supported for dump styles that format
+their output into text buffers.
+
+E: Error writing dump file in background
+
+The background writer thread could not write, flush, or close the
+dump file.  Check that the disk is not full.
+
 E: Cannot use dump_modify fileper without % in dump file name
 
 Self-explanatory.
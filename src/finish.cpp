@@ -27,6 +27,7 @@
 #include "neigh_list.h"
 #include "neigh_request.h"
 #include "neighbor.h"           // IWYU pragma: keep
+#include "output.h"
 #include "timer.h"              // IWYU pragma: keep
 #include "universe.h"
 #include "update.h"
@@ -74,6 +75,10 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // complete any dump output still pending in background writers
+
+  output->flush_dumps();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -587,10 +592,21 @@ void Finish::end(int flag)
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
+      if (neighbor->dist_check && neighbor->predict)
+        mesg += fmt::format("Skipped distance checks = {}\n",neighbor->nskip);
       utils::logmesg(lmp,mesg);
     }
   }
 
+  // neighbor skin tuning from pair + neigh time of this run
+
+  if (neighbor->skintune && update->whichflag == 1 && update->nsteps > 0
+      && timer->has_normal() && flag <= 1) {
+    double cost = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH);
+    MPI_Allreduce(&cost,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+    neighbor->tune_skin(tmp/nprocs/update->nsteps);
+  }
+
   if (logfile) fflush(logfile);
 }
 
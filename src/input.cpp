@@ -753,6 +753,7 @@ int Input::execute_command()
   else if (!strcmp(command,"kspace_style")) kspace_style();
   else if (!strcmp(command,"lattice")) lattice();
   else if (!strcmp(command,"mass")) mass();
+  else if (!strcmp(command,"memory_modify")) memory_modify();
   else if (!strcmp(command,"min_modify")) min_modify();
   else if (!strcmp(command,"min_style")) min_style();
   else if (!strcmp(command,"molecule")) molecule();
@@ -1591,6 +1592,13 @@ void Input::mass()
 
 /* ---------------------------------------------------------------------- */
 
+void Input::memory_modify()
+{
+  memory->modify_params(narg,arg);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Input::min_modify()
 {
   update->minimize->modify_params(narg,arg);
@@ -118,6 +118,7 @@ class Input : protected Pointers {
   void kspace_style();
   void lattice();
   void mass();
+  void memory_modify();
   void min_modify();
   void min_style();
   void molecule();
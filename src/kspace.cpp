@@ -21,6 +21,7 @@
 #include "error.h"
 #include "force.h"
 #include "memory.h"
+#include "omp_compat.h"
 #include "pair.h"
 #include "suffix.h"
 
@@ -40,10 +41,14 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   virial[0] = virial[1] = virial[2] = virial[3] = virial[4] = virial[5] = 0.0;
 
   triclinic_support = 1;
+  r2c_support = 0;
+  gridsort_support = 0;
+  fft_single_support = 0;
   ewaldflag = pppmflag = msmflag = dispersionflag = tip4pflag =
     dipoleflag = spinflag = 0;
   compute_flag = 1;
   group_group_enable = 0;
+  energy_delta_enable = 0;
   stagger_flag = 0;
 
   order = 5;
@@ -61,6 +66,10 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   collective_flag = 0;
 #endif
 
+  r2c_flag = 0;
+  gridsort_flag = 0;
+  fft_single_flag = 0;
+
   kewaldflag = 0;
 
   order_6 = 5;
@@ -298,7 +307,7 @@ void KSpace::qsum_qsq(int warning_flag)
   double qsum_local(0.0), qsqsum_local(0.0);
 
 #if defined(_OPENMP)
-#pragma omp parallel for default(shared) reduction(+:qsum_local,qsqsum_local)
+#pragma omp parallel for LMP_DEFAULT_NONE reduction(+:qsum_local,qsqsum_local)
 #endif
   for (int i = 0; i < nlocal; i++) {
     qsum_local += q[i];
@@ -549,7 +558,32 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) collective_flag = 1;
       else if (strcmp(arg[iarg+1],"no") == 0) collective_flag = 0;
+      else if (strcmp(arg[iarg+1],"node") == 0) collective_flag = 2;
+      else error->all(FLERR,"Illegal kspace_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/r2c") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) r2c_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) r2c_flag = 0;
+      else error->all(FLERR,"Illegal kspace_modify command");
+      if (r2c_flag && !r2c_support)
+        error->all(FLERR,"KSpace style does not support kspace_modify fft/r2c");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fft/single") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) fft_single_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) fft_single_flag = 0;
+      else error->all(FLERR,"Illegal kspace_modify command");
+      if (fft_single_flag && !fft_single_support)
+        error->all(FLERR,"KSpace style does not support kspace_modify fft/single");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"grid/sort") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) gridsort_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) gridsort_flag = 0;
       else error->all(FLERR,"Illegal kspace_modify command");
+      if (gridsort_flag && !gridsort_support)
+        error->all(FLERR,"KSpace style does not support kspace_modify grid/sort");
       iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
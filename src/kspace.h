@@ -38,6 +38,9 @@ class KSpace : protected Pointers {
   double e2group;            // accumulated group-group energy
   double f2group[3];         // accumulated group-group force
   int triclinic_support;     // 1 if supports triclinic geometries
+  int r2c_support;           // 1 if supports real-to-complex FFTs
+  int gridsort_support;      // 1 if supports grid-sorted particle mapping
+  int fft_single_support;    // 1 if supports single-precision FFT grids
 
   int ewaldflag;         // 1 if a Ewald solver
   int pppmflag;          // 1 if a PPPM solver
@@ -80,6 +83,7 @@ class KSpace : protected Pointers {
   int nx_msm_max, ny_msm_max, nz_msm_max;
 
   int group_group_enable;    // 1 if style supports group/group calculation
+  int energy_delta_enable;   // 1 if style supports incremental energy_delta()
 
   int centroidstressflag;    // centroid stress compared to two-body stress
                              // CENTROID_SAME = same as two-body stress
@@ -95,6 +99,10 @@ class KSpace : protected Pointers {
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
+                          // 2 if use node-aware all-to-all for FFT/remap
+  int r2c_flag;           // 1 if use real-to-complex FFTs
+  int gridsort_flag;      // 1 if map particles to grid in grid cell order
+  int fft_single_flag;    // 1 if use single-precision FFT grids and FFTs
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -127,6 +135,12 @@ class KSpace : protected Pointers {
   virtual void compute(int, int) = 0;
   virtual void compute_group_group(int, int, int){};
 
+  // incremental energy of changing a few charges, used by MC fixes
+
+  virtual void setup_delta(){};
+  virtual double energy_delta(int, double **, double *, double *) { return 0.0; }
+  virtual void accept_delta(int){};
+
   virtual void pack_forward_grid(int, void *, int, int *){};
   virtual void unpack_forward_grid(int, void *, int, int *){};
   virtual void pack_reverse_grid(int, void *, int, int *){};
@@ -286,6 +300,21 @@ E: Bad kspace_modify kmax/ewald parameter
 
 Kspace_modify values for the kmax/ewald keyword must be integers > 0
 
+E: KSpace style does not support kspace_modify fft/r2c
+
+Only the plain PPPM solver and its OPENMP variants can use
+real-to-complex FFTs.
+
+E: KSpace style does not support kspace_modify grid/sort
+
+Only the plain PPPM solver can map particles to the grid in sorted
+order.
+
+E: KSpace style does not support kspace_modify fft/single
+
+Only PPPM solvers that use the plain PPPM Poisson solver can use
+single-precision FFT grids.
+
 E: Kspace_modify eigtol must be smaller than one
 
 Self-explanatory.
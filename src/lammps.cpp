@@ -41,6 +41,7 @@
 #include "modify.h"
 #include "group.h"
 #include "output.h"
+#include "variable.h"
 #include "citeme.h"
 #include "accelerator_kokkos.h"
 #include "accelerator_omp.h"    // IWYU pragma: keep
@@ -887,6 +888,7 @@ void LAMMPS::init()
                          //     when force->pair->gran_history creates fix
                          //   atom_vec init uses deform_vremap
   modify->init();        // modify must come after update, force, atom, domain
+  input->variable->init(); // variable must come after modify
   neighbor->init();      // neighbor must come after force, modify
   comm->init();          // comm must come after force, modify, neighbor, atom
   output->init();        // output must come after domain, force, modify
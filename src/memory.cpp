@@ -14,8 +14,11 @@
 
 #include "memory.h"
 
+#include "comm.h"
 #include "error.h"
 
+#include <cstring>
+
 #if defined(LMP_USER_INTEL) && defined(__INTEL_COMPILER)
 #ifndef LMP_INTEL_NO_TBB
 #define LMP_USE_TBB_ALLOCATOR
@@ -34,11 +37,29 @@
 #define LAMMPS_MEMALIGN 64
 #endif
 
+// large block allocation modes and footprint tracking need Linux
+//   and malloc_usable_size() from glibc
+
+#if defined(__linux__) && defined(__GLIBC__) && !defined(LMP_USER_INTEL)
+#define LMP_MEMORY_LARGE
+#include <malloc.h>
+#include <sys/mman.h>
+#endif
+
 using namespace LAMMPS_NS;
 
+static constexpr bigint PAGESIZE = 4096;
+static constexpr bigint HUGEPAGESIZE = 2097152;
+
 /* ---------------------------------------------------------------------- */
 
-Memory::Memory(LAMMPS *lmp) : Pointers(lmp) {}
+Memory::Memory(LAMMPS *lmp) : Pointers(lmp)
+{
+  hugepage = firsttouch = 0;
+  minlarge = HUGEPAGESIZE;
+  growfactor = 1.0;
+  nbytes_inuse = 0;
+}
 
 /* ----------------------------------------------------------------------
    safe malloc
@@ -48,6 +69,17 @@ void *Memory::smalloc(bigint nbytes, const char *name)
 {
   if (nbytes == 0) return nullptr;
 
+#if defined(LMP_MEMORY_LARGE)
+  if ((hugepage || firsttouch) && nbytes >= minlarge) {
+    void *ptr = large_alloc(nbytes);
+    if (ptr == nullptr)
+      error->one(FLERR,"Failed to allocate {} bytes for array {}",
+                                   nbytes,name);
+    track(ptr,1);
+    return ptr;
+  }
+#endif
+
 #if defined(LAMMPS_MEMALIGN)
   void *ptr;
 
@@ -64,6 +96,7 @@ void *Memory::smalloc(bigint nbytes, const char *name)
   if (ptr == nullptr)
     error->one(FLERR,"Failed to allocate {} bytes for array {}",
                                  nbytes,name);
+  track(ptr,1);
   return ptr;
 }
 
@@ -78,6 +111,27 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
     return nullptr;
   }
 
+  // large blocks are moved to a new block to get alignment and placement
+
+#if defined(LMP_MEMORY_LARGE)
+  if ((hugepage || firsttouch) && nbytes >= minlarge) {
+    void *optr = ptr;
+    ptr = large_alloc(nbytes);
+    if (ptr == nullptr)
+      error->one(FLERR,"Failed to reallocate {} bytes for array {}",
+                                   nbytes,name);
+    track(ptr,1);
+    if (optr) {
+      bigint nold = malloc_usable_size(optr);
+      large_copy(ptr,optr,MIN(nold,nbytes));
+      sfree(optr);
+    }
+    return ptr;
+  }
+#endif
+
+  track(ptr,-1);
+
 #if defined(LMP_USE_TBB_ALLOCATOR)
   ptr = scalable_aligned_realloc(ptr, nbytes, LAMMPS_MEMALIGN);
 #elif defined(LMP_INTEL_NO_TBB) && defined(LAMMPS_MEMALIGN) && \
@@ -103,6 +157,7 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
   if (ptr == nullptr)
     error->one(FLERR,"Failed to reallocate {} bytes for array {}",
                                  nbytes,name);
+  track(ptr,1);
   return ptr;
 }
 
@@ -113,6 +168,7 @@ void *Memory::srealloc(void *ptr, bigint nbytes, const char *name)
 void Memory::sfree(void *ptr)
 {
   if (ptr == nullptr) return;
+  track(ptr,-1);
   #if defined(LMP_USE_TBB_ALLOCATOR)
   scalable_aligned_free(ptr);
   #else
@@ -120,6 +176,138 @@ void Memory::sfree(void *ptr)
   #endif
 }
 
+/* ----------------------------------------------------------------------
+   allocate a large block aligned to a page or huge page
+   if hugepage, advise the kernel to back it with transparent huge pages
+   if firsttouch, touch each page from the thread that will use it
+     with the same static schedule as threaded loops over atoms
+   return nullptr on failure
+------------------------------------------------------------------------- */
+
+void *Memory::large_alloc(bigint nbytes)
+{
+  void *ptr = nullptr;
+#if defined(LMP_MEMORY_LARGE)
+  const bigint align = hugepage ? HUGEPAGESIZE : PAGESIZE;
+  if (posix_memalign(&ptr, align, nbytes)) return nullptr;
+
+#if defined(MADV_HUGEPAGE)
+  if (hugepage) madvise(ptr, nbytes, MADV_HUGEPAGE);
+#endif
+
+  if (firsttouch) {
+    char *cptr = (char *) ptr;
+    const bigint npage = (nbytes + PAGESIZE - 1) / PAGESIZE;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (bigint i = 0; i < npage; i++) cptr[i*PAGESIZE] = 0;
+  }
+#endif
+  return ptr;
+}
+
+/* ----------------------------------------------------------------------
+   copy nbytes from a large block
+   with firsttouch, copy page by page with the same schedule as the touch
+------------------------------------------------------------------------- */
+
+void Memory::large_copy(void *dest, const void *src, bigint nbytes)
+{
+#if defined(LMP_MEMORY_LARGE)
+  if (firsttouch) {
+    char *cdest = (char *) dest;
+    const char *csrc = (const char *) src;
+    const bigint npage = (nbytes + PAGESIZE - 1) / PAGESIZE;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (bigint i = 0; i < npage; i++) {
+      const bigint offset = i*PAGESIZE;
+      memcpy(cdest + offset, csrc + offset, MIN(PAGESIZE, nbytes - offset));
+    }
+  } else memcpy(dest, src, nbytes);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   add (sign = 1) or remove (sign = -1) a block from the footprint
+   uses the size the allocator actually reserved for the block
+------------------------------------------------------------------------- */
+
+void Memory::track(void *ptr, int sign)
+{
+#if defined(LMP_MEMORY_LARGE)
+  if (ptr == nullptr) return;
+  const bigint n = sign * (bigint) malloc_usable_size(ptr);
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
+  nbytes_inuse += n;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   return # of bytes currently reserved for blocks from smalloc/srealloc
+     of this LAMMPS instance, tallied since its creation
+   return -1 if not tracked on this platform
+------------------------------------------------------------------------- */
+
+double Memory::footprint()
+{
+#if defined(LMP_MEMORY_LARGE)
+  return (double) nbytes_inuse;
+#else
+  return -1.0;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   set allocation modes from memory_modify command
+------------------------------------------------------------------------- */
+
+void Memory::modify_params(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR,"Illegal memory_modify command");
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"hugepage") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal memory_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) hugepage = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) hugepage = 0;
+      else error->all(FLERR,"Illegal memory_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"firsttouch") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal memory_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) firsttouch = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) firsttouch = 0;
+      else error->all(FLERR,"Illegal memory_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"threshold") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal memory_modify command");
+      double mbytes = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (mbytes <= 0.0) error->all(FLERR,"Illegal memory_modify command");
+      minlarge = static_cast<bigint> (mbytes*1024.0*1024.0);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"growth") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal memory_modify command");
+      growfactor = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (growfactor < 1.0) error->all(FLERR,"Illegal memory_modify command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal memory_modify command");
+  }
+
+#if !defined(LMP_MEMORY_LARGE)
+  if (hugepage || firsttouch) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Memory_modify hugepage or firsttouch is not "
+                     "supported on this platform");
+    hugepage = firsttouch = 0;
+  }
+#endif
+}
+
 /* ----------------------------------------------------------------------
    erroneous usage of templated create/grow functions
 ------------------------------------------------------------------------- */
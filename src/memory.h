@@ -22,10 +22,17 @@ class Memory : protected Pointers {
  public:
   Memory(class LAMMPS *);
 
+  int hugepage;         // 1 if large blocks are backed by huge pages
+  int firsttouch;       // 1 if large blocks are first touched by threads
+  bigint minlarge;      // min size in bytes of a large block
+  double growfactor;    // geometric growth factor for per-atom arrays
+
   void *smalloc(bigint n, const char *);
   void *srealloc(void *, bigint n, const char *);
   void sfree(void *);
   void fail(const char *);
+  void modify_params(int, char **);
+  double footprint();
 
   /* ----------------------------------------------------------------------
    create/grow/destroy vecs and multidim arrays with contiguous memory blocks
@@ -663,6 +670,13 @@ class Memory : protected Pointers {
     bytes += ((double) sizeof(TYPE ***)) * n1;
     return bytes;
   }
+
+ private:
+  bigint nbytes_inuse;    // bytes currently allocated by smalloc/srealloc
+
+  void *large_alloc(bigint);
+  void large_copy(void *, const void *, bigint);
+  void track(void *, int);
 };
 
 }    // namespace LAMMPS_NS
@@ -681,6 +695,15 @@ E: Failed to reallocate %ld bytes for array %s
 Your LAMMPS simulation has run out of memory.  You need to run a
 smaller simulation or on more processors.
 
+E: Illegal memory_modify command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+W: Memory_modify hugepage or firsttouch is not supported on this platform
+
+These settings require Linux and are ignored otherwise.
+
 E: Cannot create/grow a vector/array of pointers for %s
 
 LAMMPS code is making an illegal call to the templated memory
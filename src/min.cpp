@@ -217,6 +217,7 @@ void Min::setup(int flag)
     }
   }
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup extra global dof due to fixes
   // cannot be done in init() b/c update init() is before modify init()
@@ -351,6 +352,7 @@ void Min::setup(int flag)
 void Min::setup_minimal(int flag)
 {
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup domain, communication and neighboring
   // acquire ghosts
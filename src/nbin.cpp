@@ -32,6 +32,11 @@ NBin::NBin(LAMMPS *lmp) : Pointers(lmp)
   bins = nullptr;
   atom2bin = nullptr;
 
+  sortflag = 0;
+  maxsort = maxbinsort = 0;
+  binstart = atom2sort = sort2atom = typesort = nullptr;
+  xsort = ysort = zsort = nullptr;
+
   nbinx_multi = nullptr; nbiny_multi = nullptr; nbinz_multi = nullptr;
   mbins_multi = nullptr;
   mbinx_multi = nullptr; mbiny_multi = nullptr, mbinz_multi = nullptr;
@@ -63,6 +68,14 @@ NBin::~NBin()
   memory->destroy(bins);
   memory->destroy(atom2bin);
 
+  memory->destroy(binstart);
+  memory->destroy(atom2sort);
+  memory->destroy(sort2atom);
+  memory->destroy(typesort);
+  memory->destroy(xsort);
+  memory->destroy(ysort);
+  memory->destroy(zsort);
+
   if (!binhead_multi) return;
 
   memory->destroy(nbinx_multi);
@@ -38,6 +38,17 @@ class NBin : protected Pointers {
   int *bins;        // index of next atom in same bin
   int *atom2bin;    // bin assignment for each atom (local+ghost)
 
+  // bin-sorted copy of atom data, stored in same order as bin linked lists
+  // only created if an NPair class with NP_SORT uses this NBin
+
+  int sortflag;                     // 1 if bin-sorted data is stored
+  int *binstart;                    // index of first sorted atom in each bin
+                                    // binstart[mbins] = # of sorted atoms
+  int *atom2sort;                   // sorted index of each atom
+  int *sort2atom;                   // atom index of each sorted atom
+  int *typesort;                    // type of each sorted atom
+  double *xsort, *ysort, *zsort;    // coords of each sorted atom
+
   // Analogues for NBinMultimulti
 
   int *nbinx_multi, *nbiny_multi, *nbinz_multi;
@@ -84,6 +95,8 @@ class NBin : protected Pointers {
 
   int maxatom;    // size of bins array
   int maxbin;     // size of binhead array
+  int maxsort;       // size of bin-sorted per-atom arrays
+  int maxbinsort;    // size of binstart array
 
   // data for multi NBin
 
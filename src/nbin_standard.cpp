@@ -56,6 +56,32 @@ void NBinStandard::bin_atoms_setup(int nall)
     memory->destroy(atom2bin);
     memory->create(atom2bin,maxatom,"neigh:atom2bin");
   }
+
+  // bin-sorted arrays, binstart has one extra entry for end of last bin
+
+  if (!sortflag) return;
+
+  if (mbins+1 > maxbinsort) {
+    maxbinsort = mbins+1;
+    memory->destroy(binstart);
+    memory->create(binstart,maxbinsort,"neigh:binstart");
+  }
+
+  if (nall > maxsort) {
+    maxsort = nall;
+    memory->destroy(atom2sort);
+    memory->destroy(sort2atom);
+    memory->destroy(typesort);
+    memory->destroy(xsort);
+    memory->destroy(ysort);
+    memory->destroy(zsort);
+    memory->create(atom2sort,maxsort,"neigh:atom2sort");
+    memory->create(sort2atom,maxsort,"neigh:sort2atom");
+    memory->create(typesort,maxsort,"neigh:typesort");
+    memory->create(xsort,maxsort,"neigh:xsort");
+    memory->create(ysort,maxsort,"neigh:ysort");
+    memory->create(zsort,maxsort,"neigh:zsort");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -258,6 +284,37 @@ void NBinStandard::bin_atoms()
       binhead[ibin] = i;
     }
   }
+
+  if (sortflag) sort_atoms();
+}
+
+/* ----------------------------------------------------------------------
+   copy coords and types of binned atoms into bin-sorted arrays
+   atoms of each bin are contiguous, in same order as the bin's linked list,
+     so NPair classes can stream through stencil bins
+------------------------------------------------------------------------- */
+
+void NBinStandard::sort_atoms()
+{
+  int i,ibin;
+
+  double **x = atom->x;
+  int *type = atom->type;
+
+  int m = 0;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    binstart[ibin] = m;
+    for (i = binhead[ibin]; i >= 0; i = bins[i]) {
+      atom2sort[i] = m;
+      sort2atom[m] = i;
+      typesort[m] = type[i];
+      xsort[m] = x[i][0];
+      ysort[m] = x[i][1];
+      zsort[m] = x[i][2];
+      m++;
+    }
+  }
+  binstart[mbins] = m;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -267,5 +324,8 @@ double NBinStandard::memory_usage()
   double bytes = 0;
   bytes += (double)maxbin*sizeof(int);
   bytes += (double)2*maxatom*sizeof(int);
+  bytes += (double)maxbinsort*sizeof(int);
+  bytes += (double)3*maxsort*sizeof(int);
+  bytes += (double)3*maxsort*sizeof(double);
   return bytes;
 }
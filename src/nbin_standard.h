@@ -34,6 +34,9 @@ class NBinStandard : public NBin {
   void setup_bins(int);
   void bin_atoms();
   double memory_usage();
+
+ protected:
+  void sort_atoms();
 };
 
 }    // namespace LAMMPS_NS
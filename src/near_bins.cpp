@@ -0,0 +1,319 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   spatial bins for finding all points or atoms within a cutoff of a point
+   bins are at least as large as the cutoff, so every point within the
+   cutoff of a point is found in the 27 bins around the point's bin
+   stored points with a radius are used for overlap tests of inserted
+     particles, they can be added one at a time between tests,
+     periodic dims are binned over the whole box and wrap around,
+     non-periodic dims are binned over a given range
+   owned and ghost atoms are used for local energies of MC moves,
+     they are binned over their bounding box without wrap around
+------------------------------------------------------------------------- */
+
+#include "near_bins.h"
+
+#include "atom.h"
+#include "domain.h"
+#include "memory.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+// cap on # of bins per expected point, larger bins are used if exceeded
+
+#define BINS_PER_POINT 8
+#define MINBINS 1000
+#define DELTA 1024
+
+/* ---------------------------------------------------------------------- */
+
+NearBins::NearBins(LAMMPS *lmp) : Pointers(lmp),
+  binhead(nullptr), next(nullptr), xp(nullptr)
+{
+  cutbin = 0.0;
+  nbin[0] = nbin[1] = nbin[2] = 1;
+  periodic[0] = periodic[1] = periodic[2] = 0;
+  maxbin = maxnext = 0;
+  npoint = maxpoint = 0;
+  stale = 1;
+  binlo[0] = binlo[1] = binlo[2] = 0.0;
+  bininv[0] = bininv[1] = bininv[2] = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+NearBins::~NearBins()
+{
+  memory->destroy(binhead);
+  memory->destroy(next);
+  memory->destroy(xp);
+}
+
+/* ----------------------------------------------------------------------
+   remove all points and set up empty bins
+   cut = largest interaction distance of any two points
+   lo,hi = range of binned volume in non-periodic dims
+   nexpect = expected # of points, used to cap the # of bins
+------------------------------------------------------------------------- */
+
+void NearBins::setup(double cut, double *lo, double *hi, int nexpect)
+{
+  cutbin = cut;
+  npoint = 0;
+
+  double extent[3];
+  for (int dim = 0; dim < 3; dim++) {
+    periodic[dim] = domain->periodicity[dim];
+    if (periodic[dim]) {
+      binlo[dim] = domain->boxlo[dim];
+      extent[dim] = domain->prd[dim];
+    } else {
+      binlo[dim] = lo[dim];
+      extent[dim] = hi[dim] - lo[dim];
+    }
+  }
+  if (domain->dimension == 2) extent[2] = 0.0;
+
+  setup_bins(extent,nexpect);
+}
+
+/* ----------------------------------------------------------------------
+   add a point with coords x and radius rad
+------------------------------------------------------------------------- */
+
+void NearBins::add(double *x, double rad)
+{
+  if (npoint == maxpoint) {
+    maxpoint += DELTA;
+    memory->grow(xp,maxpoint,4,"near/bins:xp");
+  }
+  if (npoint == maxnext) {
+    maxnext = maxpoint;
+    memory->grow(next,maxnext,"near/bins:next");
+  }
+
+  xp[npoint][0] = x[0];
+  xp[npoint][1] = x[1];
+  xp[npoint][2] = x[2];
+  xp[npoint][3] = rad;
+
+  int ibin[3];
+  int m = coord2bin(x,ibin);
+  next[npoint] = binhead[m];
+  binhead[m] = npoint;
+  npoint++;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if a point of radius rad at x touches any stored point,
+   i.e. distance <= sum of radii, 0 if not
+   sum of radii must not exceed the cutoff
+   use minimum_image() to account for PBC
+------------------------------------------------------------------------- */
+
+int NearBins::overlap(double *x, double rad)
+{
+  int list[27];
+  int n = stencil(x,list);
+
+  for (int k = 0; k < n; k++) {
+    for (int j = binhead[list[k]]; j >= 0; j = next[j]) {
+      double delx = x[0] - xp[j][0];
+      double dely = x[1] - xp[j][1];
+      double delz = x[2] - xp[j][2];
+      domain->minimum_image(delx,dely,delz);
+      double rsq = delx*delx + dely*dely + delz*delz;
+      double radsum = rad + xp[j][3];
+      if (rsq <= radsum*radsum) return 1;
+    }
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if any stored point is closer than sqrt(cutsq) to x, 0 if not
+   cutsq must not exceed the squared cutoff
+   use minimum_image() to account for PBC
+------------------------------------------------------------------------- */
+
+int NearBins::within(double *x, double cutsq)
+{
+  int list[27];
+  int n = stencil(x,list);
+
+  for (int k = 0; k < n; k++) {
+    for (int j = binhead[list[k]]; j >= 0; j = next[j]) {
+      double delx = x[0] - xp[j][0];
+      double dely = x[1] - xp[j][1];
+      double delz = x[2] - xp[j][2];
+      domain->minimum_image(delx,dely,delz);
+      if (delx*delx + dely*dely + delz*delz < cutsq) return 1;
+    }
+  }
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   set cut = largest interaction distance of interest for binned atoms
+------------------------------------------------------------------------- */
+
+void NearBins::init_atoms(double cut)
+{
+  cutbin = cut;
+  stale = 1;
+}
+
+/* ----------------------------------------------------------------------
+   bin all owned and ghost atoms over their bounding box
+   binhead and next then refer to atom indices
+   must be called whenever coords or ghost atoms have changed
+------------------------------------------------------------------------- */
+
+void NearBins::build_atoms()
+{
+  double **x = atom->x;
+  int nall = atom->nlocal + atom->nghost;
+
+  double binhi[3];
+  if (nall) {
+    binlo[0] = binhi[0] = x[0][0];
+    binlo[1] = binhi[1] = x[0][1];
+    binlo[2] = binhi[2] = x[0][2];
+  } else binlo[0] = binlo[1] = binlo[2] = binhi[0] = binhi[1] = binhi[2] = 0.0;
+
+  for (int i = 1; i < nall; i++)
+    for (int dim = 0; dim < 3; dim++) {
+      if (x[i][dim] < binlo[dim]) binlo[dim] = x[i][dim];
+      else if (x[i][dim] > binhi[dim]) binhi[dim] = x[i][dim];
+    }
+
+  double extent[3];
+  for (int dim = 0; dim < 3; dim++) {
+    periodic[dim] = 0;
+    extent[dim] = binhi[dim] - binlo[dim];
+  }
+
+  setup_bins(extent,nall);
+
+  if (nall > maxnext) {
+    maxnext = atom->nmax;
+    memory->destroy(next);
+    memory->create(next,maxnext,"near/bins:next");
+  }
+
+  // loop in reverse so atoms in each bin are visited in ascending order
+
+  int ibin[3];
+  for (int i = nall-1; i >= 0; i--) {
+    int m = coord2bin(x[i],ibin);
+    next[i] = binhead[m];
+    binhead[m] = i;
+  }
+
+  stale = 0;
+}
+
+/* ----------------------------------------------------------------------
+   set up empty bins over a volume with extent in each dim from binlo
+   bin size >= cutbin, coarsened if # of bins would be excessive
+   nexpect = expected # of points, used to cap the # of bins
+------------------------------------------------------------------------- */
+
+void NearBins::setup_bins(double *extent, bigint nexpect)
+{
+  bigint binmax = MAX((bigint) BINS_PER_POINT*nexpect,MINBINS);
+  double binsize = cutbin;
+  while (true) {
+    for (int dim = 0; dim < 3; dim++) {
+      nbin[dim] = 1;
+      if (binsize > 0.0 && extent[dim] > binsize)
+        nbin[dim] = static_cast<int>(MIN(extent[dim]/binsize,(double) MAXSMALLINT));
+      bininv[dim] = (extent[dim] > 0.0) ? nbin[dim]/extent[dim] : 0.0;
+    }
+    if ((bigint) nbin[0]*nbin[1]*nbin[2] <= binmax) break;
+    binsize = (binsize > 0.0) ? 2.0*binsize : 1.0;
+  }
+
+  int mbins = nbin[0]*nbin[1]*nbin[2];
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(binhead);
+    memory->create(binhead,maxbin,"near/bins:binhead");
+  }
+  for (int m = 0; m < mbins; m++) binhead[m] = -1;
+}
+
+/* ----------------------------------------------------------------------
+   list of bins that can hold points or atoms within cutbin of coord
+   periodic dims wrap around, each bin is listed only once
+   return # of bins in list, at most 27
+------------------------------------------------------------------------- */
+
+int NearBins::stencil(double *coord, int *list)
+{
+  int ibin[3];
+  coord2bin(coord,ibin);
+
+  int range[3][3],nrange[3];
+  for (int dim = 0; dim < 3; dim++) {
+    nrange[dim] = 0;
+    if (nbin[dim] <= 3) {
+      for (int i = 0; i < nbin[dim]; i++) range[dim][nrange[dim]++] = i;
+    } else if (periodic[dim]) {
+      range[dim][nrange[dim]++] = (ibin[dim] + nbin[dim] - 1) % nbin[dim];
+      range[dim][nrange[dim]++] = ibin[dim];
+      range[dim][nrange[dim]++] = (ibin[dim] + 1) % nbin[dim];
+    } else {
+      for (int i = MAX(ibin[dim]-1,0); i <= MIN(ibin[dim]+1,nbin[dim]-1); i++)
+        range[dim][nrange[dim]++] = i;
+    }
+  }
+
+  int n = 0;
+  for (int k = 0; k < nrange[2]; k++)
+    for (int j = 0; j < nrange[1]; j++)
+      for (int i = 0; i < nrange[0]; i++)
+        list[n++] = (range[2][k]*nbin[1] + range[1][j])*nbin[0] + range[0][i];
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   bin index of coord
+   wrapped into the box in periodic dims, clamped to the range otherwise
+------------------------------------------------------------------------- */
+
+int NearBins::coord2bin(double *coord, int *ibin)
+{
+  for (int dim = 0; dim < 3; dim++) {
+    double delta = (coord[dim] - binlo[dim]) * bininv[dim];
+    if (periodic[dim]) {
+      int i = static_cast<int>(floor(delta)) % nbin[dim];
+      ibin[dim] = (i < 0) ? i + nbin[dim] : i;
+    } else if (delta <= 0.0) ibin[dim] = 0;
+    else if (delta >= nbin[dim]) ibin[dim] = nbin[dim] - 1;
+    else ibin[dim] = static_cast<int>(delta);
+  }
+  return (ibin[2]*nbin[1] + ibin[1])*nbin[0] + ibin[0];
+}
+
+/* ---------------------------------------------------------------------- */
+
+double NearBins::memory_usage()
+{
+  return (double)maxbin*sizeof(int) + (double)maxnext*sizeof(int) +
+    (double)maxpoint*4*sizeof(double);
+}
@@ -0,0 +1,64 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_NEAR_BINS_H
+#define LMP_NEAR_BINS_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+class NearBins : protected Pointers {
+ public:
+  int *binhead;    // index of first point or atom in each bin, -1 if empty
+  int *next;       // index of next point or atom in same bin, -1 at end
+
+  NearBins(class LAMMPS *);
+  ~NearBins();
+
+  // stored points with a radius, for overlap tests of inserted particles
+
+  void setup(double, double *, double *, int);
+  void add(double *, double);
+  int overlap(double *, double);
+  int within(double *, double);
+
+  // owned and ghost atoms, for local energies of MC moves
+
+  void init_atoms(double);
+  void build_atoms();
+  void invalidate() { stale = 1; }
+  void update() { if (stale) build_atoms(); }
+
+  int stencil(double *, int *);
+  double memory_usage();
+
+ private:
+  double cutbin;              // minimum bin size
+  int nbin[3];                // # of bins in each dim
+  int periodic[3];            // 1 if bins wrap around in dim
+  int maxbin;                 // allocated size of binhead
+  int maxnext;                // allocated size of next
+  double binlo[3];            // lower corner of binned volume
+  double bininv[3];           // inverse bin size in each dim
+  double **xp;                // coords and radius of each point
+  int npoint, maxpoint;       // # of stored and allocated points
+  int stale;                  // 1 if atoms changed since last build_atoms()
+
+  void setup_bins(double *, bigint);
+  int coord2bin(double *, int *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -21,6 +21,8 @@
 #include "my_page.h"
 #include "memory.h"
 
+#include <algorithm>
+
 using namespace LAMMPS_NS;
 
 #define PGDELTA 1
@@ -78,6 +80,13 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   ipage_inner = nullptr;
   ipage_middle = nullptr;
 
+  // interior/boundary partition
+
+  splitflag = 0;
+  ninterior = 0;
+  ilist_split = nullptr;
+  maxsplit = 0;
+
   // Kokkos package
 
   kokkos = 0;
@@ -118,6 +127,10 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  // a copy list only points to the partition of the list it copies from
+
+  if (!copy || kk2cpu) memory->destroy(ilist_split);
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -245,6 +258,52 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   partition I atoms into interior atoms, which have only owned neighbors,
+     and boundary atoms, which have at least one ghost neighbor
+   forces on interior atoms can be computed before ghost coords arrive
+   both parts keep the order of ilist
+   a copy list shares ilist with the list it copies from,
+     so partition that list and share its partition
+------------------------------------------------------------------------- */
+
+void NeighList::split()
+{
+  int i,ii,jj,jnum,nboundary;
+  int *jlist;
+
+  if (copy && !kk2cpu) {
+    listcopy->split();
+    ninterior = listcopy->ninterior;
+    ilist_split = listcopy->ilist_split;
+    return;
+  }
+
+  if (maxatom > maxsplit) {
+    maxsplit = maxatom;
+    memory->destroy(ilist_split);
+    memory->create(ilist_split,maxsplit,"neighlist:ilist_split");
+  }
+
+  int nlocal = atom->nlocal;
+
+  // boundary atoms are stored in reverse order at end, then flipped
+
+  ninterior = 0;
+  nboundary = 0;
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    for (jj = 0; jj < jnum; jj++)
+      if ((jlist[jj] & NEIGHMASK) >= nlocal) break;
+    if (jj == jnum) ilist_split[ninterior++] = i;
+    else ilist_split[inum - ++nboundary] = i;
+  }
+
+  std::reverse(ilist_split+ninterior,ilist_split+inum);
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -302,6 +361,7 @@ double NeighList::memory_usage()
   bytes += memory->usage(ilist,maxatom);
   bytes += memory->usage(numneigh,maxatom);
   bytes += (double)maxatom * sizeof(int *);
+  bytes += memory->usage(ilist_split,maxsplit);
 
   int nmypage = comm->nthreads;
 
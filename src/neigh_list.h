@@ -76,6 +76,13 @@ class NeighList : protected Pointers {
   MyPage<int> *ipage_inner;     // pages of neighbor indices for inner
   MyPage<int> *ipage_middle;    // pages of neighbor indices for middle
 
+  // partition of I atoms for overlap of forward comm and pair computation
+
+  int splitflag;       // 1 if partition is updated when list is built
+  int ninterior;       // # of I atoms with no ghost neighbors
+  int *ilist_split;    // I atoms, interior atoms first, then boundary atoms
+  int maxsplit;        // size of allocated ilist_split
+
   // atom types to skip when building list
   // copied info from corresponding request into realloced vec/array
 
@@ -106,6 +113,7 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
   void grow(int, int);           // grow all data structs
+  void split();                  // partition ilist into interior/boundary
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
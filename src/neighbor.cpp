@@ -59,6 +59,9 @@ using namespace NeighConst;
 #define DELTA_PERATOM 64
 
 #define BIG 1.0e20
+#define EPSILON 1.0e-10
+#define SKINTUNE_FAC 0.25
+#define SKINTUNE_STOP 0.02
 
 enum{NONE,ALL,PARTIAL,TEMPLATE};
 
@@ -119,10 +122,21 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   pgsize = 100000;
   oneatom = 2000;
   binsizeflag = 0;
+  binsort = 0;
   build_once = 0;
+  predict = 0;
+  predict_vmax = 0.0;
+  skintune = 0;
   cluster_check = 0;
   ago = -1;
 
+  check_next = check_skip = ago_last = 0;
+  disp_last = 0.0;
+  skin_init = skin_best = cost_best = 0.0;
+  skin_fac = SKINTUNE_FAC;
+  skin_dir = 1;
+  skin_count = 0;
+
   cutneighmax = 0.0;
   cutneighsq = nullptr;
   cutneighghostsq = nullptr;
@@ -159,6 +173,7 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   old_triclinic = 0;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_binsort = binsort;
 
   binclass = nullptr;
   binnames = nullptr;
@@ -285,7 +300,7 @@ void Neighbor::init()
 {
   int i,j,n;
 
-  ncalls = ndanger = 0;
+  ncalls = ndanger = nskip = 0;
   dimension = domain->dimension;
   triclinic = domain->triclinic;
   newton_pair = force->newton_pair;
@@ -298,6 +313,10 @@ void Neighbor::init()
   if (pgsize < 10*oneatom)
     error->all(FLERR,"Neighbor page size must be >= 10x the one atom setting");
 
+  if (predict && !dist_check && me == 0)
+    error->warning(FLERR,"Neighbor predict requires neigh_modify "
+                   "check yes and is ignored");
+
   // ------------------------------------------------------------------
   // settings
 
@@ -319,6 +338,8 @@ void Neighbor::init()
   // cutneighghost = pair cutghost if it requests it, else same as cutneigh
 
   triggersq = 0.25*skin*skin;
+  skin_init = skin;
+  check_next = 0;
   boxcheck = 0;
   if (domain->box_change && (domain->xperiodic || domain->yperiodic ||
                              (dimension == 3 && domain->zperiodic)))
@@ -772,6 +793,7 @@ int Neighbor::init_pair()
   if (triclinic != old_triclinic) same = 0;
   if (pgsize != old_pgsize) same = 0;
   if (oneatom != old_oneatom) same = 0;
+  if (binsort != old_binsort) same = 0;
 
   if (nrequest != old_nrequest) same = 0;
   else
@@ -975,6 +997,7 @@ int Neighbor::init_pair()
       neigh_pair[i]->nb = neigh_bin[requests[i]->index_bin];
       if (neigh_pair[i]->nb == nullptr)
         error->all(FLERR,"Could not assign bin method to neighbor pair");
+      if (pairmasks[flag-1] & NP_SORT) neigh_pair[i]->nb->sortflag = 1;
     }
     if (lists[i]->stencil_method > 0) {
       neigh_pair[i]->ns = neigh_stencil[requests[i]->index_stencil];
@@ -1711,6 +1734,7 @@ void Neighbor::requests_new2old()
   old_triclinic = triclinic;
   old_pgsize = pgsize;
   old_oneatom = oneatom;
+  old_binsort = binsort;
 }
 
 /* ----------------------------------------------------------------------
@@ -1877,6 +1901,23 @@ int Neighbor::choose_stencil(NeighRequest *rq)
 ------------------------------------------------------------------------- */
 
 int Neighbor::choose_pair(NeighRequest *rq)
+{
+  // if binsort is set, first look for a variant that uses bin-sorted atoms
+  // else or if none exists for this request, use a standard variant
+
+  if (binsort && style == Neighbor::BIN && !includegroup) {
+    int flag = match_pair(rq,1);
+    if (flag > 0) return flag;
+  }
+  return match_pair(rq,0);
+}
+
+/* ----------------------------------------------------------------------
+   match one NPair class for request rq
+   sortflag = 1 to match only bin-sorted variants, 0 to exclude them
+------------------------------------------------------------------------- */
+
+int Neighbor::match_pair(NeighRequest *rq, int sortflag)
 {
   // error check for includegroup with ghost neighbor request
 
@@ -1970,6 +2011,10 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->halffull != !(mask & NP_HALF_FULL)) continue;
     if (!rq->off2on != !(mask & NP_OFF2ON)) continue;
 
+    // bin-sorted variants match only when requested by sortflag
+
+    if (!sortflag != !(mask & NP_SORT)) continue;
+
     // neighbor style is one of NSQ, BIN, MULTI_OLD, or MULTI and must match
 
     if (style == Neighbor::NSQ) {
@@ -2090,6 +2135,11 @@ int Neighbor::decide()
   if (ago >= delay && ago % every == 0) {
     if (build_once) return 0;
     if (dist_check == 0) return 1;
+    if (ago < check_next && update->whichflag == 1) {
+      nskip++;
+      check_skip = 1;
+      return 0;
+    }
     return check_distance();
   } else return 0;
 }
@@ -2145,21 +2195,91 @@ int Neighbor::check_distance()
   int nlocal = atom->nlocal;
   if (includegroup) nlocal = atom->nfirst;
 
-  int flag = 0;
+  // branch-free max reduction so the loop vectorizes
+
+  double maxrsq = 0.0;
   for (int i = 0; i < nlocal; i++) {
     delx = x[i][0] - xhold[i][0];
     dely = x[i][1] - xhold[i][1];
     delz = x[i][2] - xhold[i][2];
     rsq = delx*delx + dely*dely + delz*delz;
-    if (rsq > deltasq) flag = 1;
+    maxrsq = MAX(maxrsq,rsq);
   }
 
-  int flagall;
-  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+  // prediction bounds displacements by speed, so it only applies to dynamics
+  //   minimizers move atoms without regard to velocities
+
+  if (!predict || boxcheck || update->whichflag != 1) {
+    double maxrsqall;
+    MPI_Allreduce(&maxrsq,&maxrsqall,1,MPI_DOUBLE,MPI_MAX,world);
+    int flagall = (maxrsqall > deltasq) ? 1 : 0;
+    if (flagall && ago == MAX(every,delay)) ndanger++;
+    return flagall;
+  }
+
+  // with prediction also reduce max speed of any atom
+  // skipped checks rely on no atom moving faster than predict_vmax,
+  //   so verify that both for the current speeds and for the
+  //   displacement since the previous check
+
+  double **v = atom->v;
+  double vsq;
+
+  double maxone[2],maxall[2];
+  maxone[0] = maxrsq;
+  maxone[1] = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    vsq = v[i][0]*v[i][0] + v[i][1]*v[i][1] + v[i][2]*v[i][2];
+    maxone[1] = MAX(maxone[1],vsq);
+  }
+  MPI_Allreduce(maxone,maxall,2,MPI_DOUBLE,MPI_MAX,world);
+
+  double dmax = sqrt(maxall[0]);
+  double dstep = predict_vmax*update->dt;
+  if (maxall[1] > predict_vmax*predict_vmax)
+    error->all(FLERR,"Atom speed exceeds maximum speed of neigh_modify predict");
+  if (check_skip) {
+    double bound = disp_last + (ago-ago_last)*dstep;
+    if (dmax > bound*(1.0+EPSILON))
+      error->all(FLERR,"Atom speed exceeds maximum speed of neigh_modify predict");
+    check_skip = 0;
+  }
+
+  int flagall = (maxall[0] > deltasq) ? 1 : 0;
   if (flagall && ago == MAX(every,delay)) ndanger++;
+  if (!flagall) predict_check(dmax,sqrt(deltasq));
   return flagall;
 }
 
+/* ----------------------------------------------------------------------
+   set check_next = earliest ago at which the next distance check is needed
+   dmax = current max displacement, dtrigger = displacement that triggers build
+   no atom moves more than predict_vmax*dt per step, so the displacement
+     after n more steps is at most dmax + n*predict_vmax*dt
+   checks are skipped while that bound stays below dtrigger,
+     since they cannot trigger a build
+------------------------------------------------------------------------- */
+
+void Neighbor::predict_check(double dmax, double dtrigger)
+{
+  ago_last = ago;
+  disp_last = dmax;
+
+  double steps = (dtrigger - dmax) / (predict_vmax*update->dt);
+  if (steps < MAXSMALLINT - ago) check_next = ago + static_cast<int> (steps);
+  else check_next = MAXSMALLINT;
+}
+
+/* ----------------------------------------------------------------------
+   forget predicted check skips, called at setup of a run or minimization
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_predict()
+{
+  check_next = check_skip = ago_last = 0;
+  disp_last = 0.0;
+}
+
 /* ----------------------------------------------------------------------
    build perpetual neighbor lists
    called at setup and every few timesteps during run or minimization
@@ -2173,6 +2293,7 @@ void Neighbor::build(int topoflag)
   ago = 0;
   ncalls++;
   lastcall = update->ntimestep;
+  reset_predict();
 
   int nlocal = atom->nlocal;
   int nall = nlocal + atom->nghost;
@@ -2242,6 +2363,7 @@ void Neighbor::build(int topoflag)
       lists[m]->grow(nlocal,nall);
     neigh_pair[m]->build_setup();
     neigh_pair[m]->build(lists[m]);
+    if (lists[m]->splitflag) lists[m]->split();
   }
 
   // build topology lists for bonds/angles/etc
@@ -2347,6 +2469,7 @@ void Neighbor::set(int narg, char **arg)
 
   skin = utils::numeric(FLERR,arg[0],false,lmp);
   if (skin < 0.0) error->all(FLERR,"Illegal neighbor command");
+  skin_count = 0;
 
   if (strcmp(arg[1],"nsq") == 0) style = Neighbor::NSQ;
   else if (strcmp(arg[1],"bin") == 0) style = Neighbor::BIN;
@@ -2360,6 +2483,39 @@ void Neighbor::set(int narg, char **arg)
   if (style == Neighbor::MULTI && lmp->citeme) lmp->citeme->add(cite_neigh_multi);
 }
 
+/* ----------------------------------------------------------------------
+   adjust skin between runs to minimize cost = pair + neigh time per step
+   called by Finish with cost of run just completed, same on all procs
+   pattern search: keep moving skin in one direction while cost decreases,
+     else reverse direction and halve the step, relative to best skin
+   new skin takes effect with the next init() at the start of a run
+------------------------------------------------------------------------- */
+
+void Neighbor::tune_skin(double cost)
+{
+  if (skin_count == 0) {
+    skin_fac = SKINTUNE_FAC;
+    skin_dir = 1;
+    skin_best = skin_init;
+    cost_best = cost;
+  } else if (cost < cost_best) {
+    skin_best = skin_init;
+    cost_best = cost;
+  } else {
+    skin_dir = -skin_dir;
+    skin_fac *= 0.5;
+  }
+  skin_count++;
+
+  if (skin_fac < SKINTUNE_STOP) skin = skin_best;
+  else skin = skin_best * (1.0 + skin_dir*skin_fac);
+
+  if (me == 0)
+    utils::logmesg(lmp,"Neighbor skin tune: skin {:.8g} cost {:.6g} "
+                   "secs/step, best skin {:.8g}, next skin {:.8g}\n",
+                   skin_init,cost,skin_best,skin);
+}
+
 /* ----------------------------------------------------------------------
    reset timestamps in all NeignBin, NStencil, NPair classes
    so that neighbor lists will rebuild properly with timestep change
@@ -2411,6 +2567,22 @@ void Neighbor::modify_params(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) build_once = 0;
       else error->all(FLERR,"Illegal neigh_modify command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"predict") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (strcmp(arg[iarg+1],"no") == 0) predict = 0;
+      else {
+        predict_vmax = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+        if (predict_vmax <= 0.0) error->all(FLERR,"Illegal neigh_modify command");
+        predict = 1;
+      }
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"skin/tune") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) skintune = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) skintune = 0;
+      else error->all(FLERR,"Illegal neigh_modify command");
+      skin_count = 0;
+      iarg += 2;
     } else if (strcmp(arg[iarg],"page") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
       old_pgsize = pgsize;
@@ -2427,6 +2599,12 @@ void Neighbor::modify_params(int narg, char **arg)
       if (binsize_user <= 0.0) binsizeflag = 0;
       else binsizeflag = 1;
       iarg += 2;
+    } else if (strcmp(arg[iarg],"binsort") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) binsort = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) binsort = 0;
+      else error->all(FLERR,"Illegal neigh_modify command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"cluster") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal neigh_modify command");
       if (strcmp(arg[iarg+1],"yes") == 0) cluster_check = 1;
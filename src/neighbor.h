@@ -30,6 +30,9 @@ class Neighbor : protected Pointers {
   int oneatom;         // max # of neighbors for one atom
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
+  int predict;         // 1 if skip distance checks bounded by max speed
+  double predict_vmax;    // user-declared max speed of any atom for predict
+  int skintune;        // 1 if adjust skin between runs to minimize cost
 
   double skin;                    // skin distance
   double cutneighmin;             // min neighbor cutoff for all type pairs
@@ -45,9 +48,11 @@ class Neighbor : protected Pointers {
 
   int binsizeflag;        // user-chosen bin size
   double binsize_user;    // set externally by some accelerator pkgs
+  int binsort;            // 1 if bins store atom coords contiguously
 
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
+  bigint nskip;       // # of distance checks skipped via prediction
   bigint lastcall;    // timestep of last neighbor::build() call
 
   // geometry and static info, used by other Neigh classes
@@ -122,6 +127,8 @@ class Neighbor : protected Pointers {
   int request(void *, int instance = 0);
   int decide();                     // decide whether to build or not
   virtual int check_distance();     // check max distance moved since last build
+  void reset_predict();             // forget predicted distance check skips
+  void predict_check(double, double);    // schedule next distance check
   void setup_bins();                // setup bins based on box and cutoff
   virtual void build(int);          // build all perpetual neighbor lists
   virtual void build_topology();    // pairwise topology neighbor lists
@@ -131,6 +138,7 @@ class Neighbor : protected Pointers {
   void reset_timestep(bigint);                // reset of timestep counter
   void modify_params(int, char **);           // modify params that control builds
   void modify_params(const std::string &);    // convenience overload
+  void tune_skin(double);                     // choose skin for next run
 
   void exclusion_group_group_delete(int, int);    // rm a group-group exclusion
   int exclude_setting();                          // return exclude value to accelerator pkg
@@ -157,6 +165,18 @@ class Neighbor : protected Pointers {
 
   double triggersq;    // trigger = build when atom moves this dist
 
+  int check_next;       // value of ago before which checks are skipped
+  int check_skip;       // 1 if checks were skipped since previous check
+  int ago_last;         // value of ago at previous distance check
+  double disp_last;     // max displacement at previous distance check
+
+  double skin_init;     // skin used by current settings
+  double skin_best;     // skin with lowest cost found by tuning
+  double cost_best;     // pair + neigh time per step for skin_best
+  double skin_fac;      // current relative skin change of tuning
+  int skin_dir;         // direction of next skin change, +1 or -1
+  int skin_count;       // # of runs evaluated by tuning
+
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
 
@@ -169,6 +189,7 @@ class Neighbor : protected Pointers {
 
   int old_style, old_triclinic;    // previous run info
   int old_pgsize, old_oneatom;     // used to avoid re-creating neigh lists
+  int old_binsort;
 
   int nstencil_perpetual;    // # of perpetual NeighStencil classes
   int npair_perpetual;       // #x of perpetual NeighPair classes
@@ -230,6 +251,7 @@ class Neighbor : protected Pointers {
   int choose_bin(class NeighRequest *);
   int choose_stencil(class NeighRequest *);
   int choose_pair(class NeighRequest *);
+  int match_pair(class NeighRequest *, int);
 
   template <typename T> static NBin *bin_creator(class LAMMPS *);
   template <typename T> static NStencil *stencil_creator(class LAMMPS *);
@@ -299,7 +321,8 @@ namespace NeighConst {
     NP_SKIP = 1 << 22,
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
-    NP_MULTI_OLD = 1 << 25
+    NP_MULTI_OLD = 1 << 25,
+    NP_SORT = 1 << 26
   };
 }    // namespace NeighConst
 
@@ -315,6 +338,19 @@ The delay and every parameters set via the neigh_modify command are
 inconsistent.  If the delay setting is non-zero, then it must be a
 multiple of the every setting.
 
+W: Neighbor predict requires neigh_modify check yes and is ignored
+
+Skipping distance checks is only possible when distance checks are
+performed at all.
+
+E: Atom speed exceeds maximum speed of neigh_modify predict
+
+The distance checks skipped with the neigh_modify predict setting rely
+on no atom moving faster than the given speed.  Either an atom was
+found to move faster at a distance check, or an atom moved further
+since the previous check than that speed allows.  Use a larger speed,
+or limit the speed of atoms, e.g. with fix nve/limit.
+
 E: Neighbor page size must be >= 10x the one atom setting
 
 This is required to prevent wasting too much memory.
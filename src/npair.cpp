@@ -141,6 +141,14 @@ void NPair::copy_bin_info()
   bins = nb->bins;
   binhead = nb->binhead;
 
+  binstart = nb->binstart;
+  atom2sort = nb->atom2sort;
+  sort2atom = nb->sort2atom;
+  typesort = nb->typesort;
+  xsort = nb->xsort;
+  ysort = nb->ysort;
+  zsort = nb->zsort;
+
   nbinx_multi = nb->nbinx_multi;
   nbiny_multi = nb->nbiny_multi;
   nbinz_multi = nb->nbinz_multi;
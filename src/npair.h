@@ -80,6 +80,8 @@ class NPair : protected Pointers {
   double bininvx, bininvy, bininvz;
   int *atom2bin, *bins;
   int *binhead;
+  int *binstart, *atom2sort, *sort2atom, *typesort;
+  double *xsort, *ysort, *zsort;
 
   int *nbinx_multi, *nbiny_multi, *nbinz_multi;
   int *mbins_multi;
@@ -55,3 +55,8 @@
 #  define LMP_DEFAULT_NONE default(none)
 #endif
 
+
+// loops of core classes over fewer atoms than this run on a single thread,
+// since starting the threads would cost more than they save
+
+#define THREAD_MINATOM 2048
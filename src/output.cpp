@@ -424,6 +424,16 @@ void Output::write_restart(bigint ntimestep)
   last_restart = ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   wait for dumps with background writers to finish all pending output
+   called by Finish at end of run or minimization
+------------------------------------------------------------------------- */
+
+void Output::flush_dumps()
+{
+  for (int idump = 0; idump < ndump; idump++) dump[idump]->async_wait();
+}
+
 /* ----------------------------------------------------------------------
    timestep is being changed, called by update->reset_timestep()
    reset next timestep values for dumps, restart, thermo output
@@ -820,4 +830,21 @@ void Output::memory_usage()
   if (comm->me == 0)
     utils::logmesg(lmp,"Per MPI rank memory allocation (min/avg/max) = "
                    "{:.4} | {:.4} | {:.4} Mbytes\n",mbmin,mbavg,mbmax);
+
+  // with non-default allocation modes also report what was actually
+  //   reserved by the allocator, including padding and geometric growth
+
+  if (memory->hugepage || memory->firsttouch || memory->growfactor > 1.0) {
+    mbytes = memory->footprint();
+    if (mbytes < 0.0) return;
+    mbytes /= 1024.0*1024.0;
+    MPI_Reduce(&mbytes,&mbavg,1,MPI_DOUBLE,MPI_SUM,0,world);
+    MPI_Reduce(&mbytes,&mbmin,1,MPI_DOUBLE,MPI_MIN,0,world);
+    MPI_Reduce(&mbytes,&mbmax,1,MPI_DOUBLE,MPI_MAX,0,world);
+    mbavg /= comm->nprocs;
+
+    if (comm->me == 0)
+      utils::logmesg(lmp,"Per MPI rank memory footprint (min/avg/max) = "
+                     "{:.4} | {:.4} | {:.4} Mbytes\n",mbmin,mbavg,mbmax);
+  }
 }
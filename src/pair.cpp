@@ -28,6 +28,7 @@
 #include "kspace.h"
 #include "math_const.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -62,6 +63,7 @@ Pair::Pair(LAMMPS *lmp) : Pointers(lmp)
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
+  overlap_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
@@ -106,6 +108,8 @@ Pair::Pair(LAMMPS *lmp) : Pointers(lmp)
   vatom = nullptr;
   cvatom = nullptr;
 
+  list = listhalf = listfull = nullptr;
+
   num_tally_compute = 0;
   list_tally_compute = nullptr;
 
@@ -722,6 +726,63 @@ void Pair::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   compute forces on interior atoms of neighbor list, which have no ghost
+     neighbors, so this can be done before ghost coords are current
+   global energy/virial are saved, b/c compute_boundary() clears them
+   fdotr virial is skipped, it is computed once from all forces
+     in compute_boundary()
+   per-atom energy/virial is not supported
+------------------------------------------------------------------------- */
+
+void Pair::compute_interior(int eflag, int vflag)
+{
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = list->ninterior;
+  list->ilist = list->ilist_split;
+
+  if (vflag & VIRIAL_FDOTR && no_virial_fdotr_compute == 0)
+    vflag &= ~VIRIAL_FDOTR;
+  compute(eflag,vflag);
+
+  list->inum = inum;
+  list->ilist = ilist;
+
+  eng_vdwl_split = eng_coul_split = 0.0;
+  if (eflag_global) {
+    eng_vdwl_split = eng_vdwl;
+    eng_coul_split = eng_coul;
+  }
+  for (int i = 0; i < 6; i++)
+    virial_split[i] = vflag_global ? virial[i] : 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   compute forces on boundary atoms of neighbor list after ghost comm
+   add global energy/virial saved by compute_interior()
+------------------------------------------------------------------------- */
+
+void Pair::compute_boundary(int eflag, int vflag)
+{
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = inum - list->ninterior;
+  list->ilist = list->ilist_split + list->ninterior;
+
+  compute(eflag,vflag);
+
+  list->inum = inum;
+  list->ilist = ilist;
+
+  if (eflag_global) {
+    eng_vdwl += eng_vdwl_split;
+    eng_coul += eng_coul_split;
+  }
+  if (vflag_global)
+    for (int i = 0; i < 6; i++) virial[i] += virial_split[i];
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Pair::read_restart(FILE *)
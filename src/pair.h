@@ -51,6 +51,7 @@ class Pair : protected Pointers {
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int overlap_enable;             // 1 if compute() works on a subset of ilist
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -132,6 +133,8 @@ class Pair : protected Pointers {
   void init_bitmap(double, double, int, int &, int &, int &, int &);
   virtual void modify_params(int, char **);
   void compute_dummy(int, int);
+  void compute_interior(int, int);
+  void compute_boundary(int, int);
 
   // need to be public, so can be called by pair_style reaxc
 
@@ -254,6 +257,9 @@ class Pair : protected Pointers {
   int vflag_fdotr;
   int maxeatom, maxvatom, maxcvatom;
 
+  double eng_vdwl_split, eng_coul_split;    // tallies of compute_interior()
+  double virial_split[6];
+
   int copymode;    // if set, do not deallocate during destruction
                    // required when classes are used as functors by Kokkos
 
@@ -395,6 +395,7 @@ void Respa::setup(int flag)
   }
 
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -472,6 +473,7 @@ void Respa::setup(int flag)
 void Respa::setup_minimal(int flag)
 {
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -41,6 +41,7 @@
 #include <cstring>
 #include <unistd.h>
 #include <unordered_map>
+#include <vector>
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
@@ -51,6 +52,7 @@ using namespace MathConst;
 #define CHUNK 1024
 #define VALUELENGTH 64               // also in python.cpp
 #define MAXFUNCARG 6
+#define MAXSTACK 32                  // max depth of compiled formula stack
 
 #define MYROUND(a) (( a-floor(a) ) >= .5) ? ceil(a) : floor(a)
 
@@ -66,7 +68,9 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      RANDOM,NORMAL,CEIL,FLOOR,ROUND,RAMP,STAGGER,LOGFREQ,LOGFREQ2,
      LOGFREQ3,STRIDE,STRIDE2,VDISPLACE,SWIGGLE,CWIGGLE,GMASK,RMASK,
      GRMASK,IS_ACTIVE,IS_DEFINED,IS_AVAILABLE,IS_FILE,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY,
+     COMPUTE_SCALAR,COMPUTE_VECTOR,COMPUTE_ARRAY,FIX_SCALAR,FIX_VECTOR,
+     FIX_ARRAY,VAR_INTERNAL,VAR_EQUAL,VAR_STRING,THERMO_KEYWORD};
 
 // customize by adding a special function
 
@@ -89,6 +93,53 @@ static std::unordered_map<std::string, double> constants = {
   {"false", 0 }
 };
 
+// math functions which can be compiled for equal-style variables
+// customize by adding a math function to compile() and execute()
+
+struct CompiledFunction {
+  const char *name;
+  int op;
+  int narg;
+};
+
+static const CompiledFunction compiled_functions[] = {
+  {"sqrt", SQRT, 1}, {"exp", EXP, 1}, {"ln", LN, 1}, {"log", LOG, 1},
+  {"abs", ABS, 1}, {"sin", SIN, 1}, {"cos", COS, 1}, {"tan", TAN, 1},
+  {"asin", ASIN, 1}, {"acos", ACOS, 1}, {"atan", ATAN, 1},
+  {"atan2", ATAN2, 2}, {"random", RANDOM, 3}, {"normal", NORMAL, 3},
+  {"ceil", CEIL, 1}, {"floor", FLOOR, 1}, {"round", ROUND, 1},
+  {"ramp", RAMP, 2}, {"stagger", STAGGER, 2}, {"vdisplace", VDISPLACE, 2},
+  {"swiggle", SWIGGLE, 3}, {"cwiggle", CWIGGLE, 3}, {nullptr, DONE, 0}
+};
+
+/* ----------------------------------------------------------------------
+   compiled form of an equal-style formula
+   flat list of stack machine instructions in postfix order
+   compute and fix references are resolved to their index and pointer
+------------------------------------------------------------------------- */
+
+struct Variable::Program {
+  struct Bytecode {
+    int op;                  // operation, see enum{} above
+    double value;            // constant for VALUE
+    int index;               // compute, fix, or variable index
+    void *ptr;               // Compute or Fix the index resolved to
+    tagint index1, index2;   // 1-based indices into global vector/array
+    std::string id;          // thermo keyword or compute/fix ID
+  };
+
+  int compiled;              // 1 if code is usable, 0 if must use evaluate()
+  std::vector<Bytecode> code;
+
+  Program() : compiled(0) {}
+
+  void emit(int op, double value = 0.0, int index = -1, void *ptr = nullptr,
+            tagint index1 = 0, tagint index2 = 0, const std::string &id = "")
+  {
+    code.push_back({op, value, index, ptr, index1, index2, id});
+  }
+};
+
 /* ---------------------------------------------------------------------- */
 
 Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
@@ -107,6 +158,7 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
   vecs = nullptr;
 
   eval_in_progress = nullptr;
+  program = nullptr;
 
   randomequal = nullptr;
   randomatom = nullptr;
@@ -139,6 +191,7 @@ Variable::~Variable()
     else for (int j = 0; j < num[i]; j++) delete [] data[i][j];
     delete [] data[i];
     if (style[i] == VECTOR) memory->destroy(vecs[i].values);
+    delete program[i];
   }
   memory->sfree(names);
   memory->destroy(style);
@@ -151,6 +204,7 @@ Variable::~Variable()
   memory->sfree(vecs);
 
   memory->destroy(eval_in_progress);
+  memory->sfree(program);
 
   delete randomequal;
   delete randomatom;
@@ -163,6 +217,10 @@ Variable::~Variable()
 
 void Variable::set(int narg, char **arg)
 {
+  // compiled formulas may refer to variables by index or style
+
+  clear_programs();
+
   if (narg < 2) error->all(FLERR,"Illegal variable command");
 
   int replaceflag = 0;
@@ -908,7 +966,7 @@ char *Variable::retrieve(const char *name)
     delete [] data[ivar][0];
     str = data[ivar][0] = utils::strdup(result);
   } else if (style[ivar] == EQUAL) {
-    double answer = evaluate(data[ivar][0],nullptr,ivar);
+    double answer = evaluate_equal(ivar);
     sprintf(data[ivar][1],"%.15g",answer);
     str = data[ivar][1];
   } else if (style[ivar] == FORMAT) {
@@ -960,7 +1018,7 @@ double Variable::compute_equal(int ivar)
   eval_in_progress[ivar] = 1;
 
   double value = 0.0;
-  if (style[ivar] == EQUAL) value = evaluate(data[ivar][0],nullptr,ivar);
+  if (style[ivar] == EQUAL) value = evaluate_equal(ivar);
   else if (style[ivar] == INTERNAL) value = dvalue[ivar];
   else if (style[ivar] == PYTHON) {
     int ifunc = python->find(data[ivar][0]);
@@ -1130,6 +1188,8 @@ void Variable::internal_set(int ivar, double value)
 
 void Variable::remove(int n)
 {
+  clear_programs();
+
   delete [] names[n];
   if (style[n] == LOOP || style[n] == ULOOP) delete [] data[n][0];
   else for (int i = 0; i < num[n]; i++) delete [] data[n][i];
@@ -1179,6 +1239,40 @@ void Variable::grow()
 
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
+
+  program = (Program **)
+    memory->srealloc(program,maxvar*sizeof(Program *),"var:program");
+  for (int i = old; i < maxvar; i++) program[i] = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   discard formulas that could not be compiled, so they are compiled again
+   on their next evaluation, once the computes and fixes they reference
+     are defined and initialized
+------------------------------------------------------------------------- */
+
+void Variable::init()
+{
+  for (int i = 0; i < nvar; i++) {
+    if (program[i] && !program[i]->compiled) {
+      delete program[i];
+      program[i] = nullptr;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   discard all compiled formulas
+   called whenever a variable is defined, redefined, or removed,
+     since compiled code refers to other variables by index and style
+------------------------------------------------------------------------- */
+
+void Variable::clear_programs()
+{
+  for (int i = 0; i < nvar; i++) {
+    delete program[i];
+    program[i] = nullptr;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -2322,6 +2416,748 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
   }
 }
 
+/* ----------------------------------------------------------------------
+   evaluate the formula of equal-style variable ivar
+   formula is compiled into a Program on first use and the compiled
+     code is executed on subsequent calls
+   formulas with items compile() does not handle use evaluate() instead,
+     until init() discards the failed Program before the next run
+------------------------------------------------------------------------- */
+
+double Variable::evaluate_equal(int ivar)
+{
+  Program *prog = program[ivar];
+
+  if (prog == nullptr || !check_program(prog)) {
+    delete prog;
+    prog = program[ivar] = new Program();
+    int depth = 0;
+    if (data[ivar][0] && compile(data[ivar][0],prog,depth,ivar))
+      prog->compiled = 1;
+    else prog->code.clear();
+  }
+
+  if (!prog->compiled) return evaluate(data[ivar][0],nullptr,ivar);
+  return execute(prog,ivar);
+}
+
+/* ----------------------------------------------------------------------
+   recursive compilation of an equal-style formula str into prog
+   follows the same syntax and operator precedence rules as evaluate()
+   depth = current depth of the execution stack, updated on return
+   return 1 if successful
+   return 0 if str contains items that are not compiled, including
+     group and special functions, atom values, per-atom or vector data,
+     and any syntax error, so that evaluate() can process the formula
+     and generate the appropriate error message
+------------------------------------------------------------------------- */
+
+int Variable::compile(char *str, Program *prog, int &depth, int ivar)
+{
+  int op,opprevious;
+  int opstack[MAXLEVEL];
+  int nopstack = 0;
+  int depth0 = depth;
+
+  int i = 0;
+  int expect = ARG;
+
+  while (1) {
+    char onechar = str[i];
+
+    // whitespace: just skip
+
+    if (isspace(onechar)) i++;
+
+    // parentheses: recursively compile contents of parens
+
+    else if (onechar == '(') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      char *contents = nullptr;
+      i = find_matching_paren(str,i,contents,ivar);
+      i++;
+
+      int flag = compile(contents,prog,depth,ivar);
+      delete [] contents;
+      if (!flag) return 0;
+
+    // number: push value onto stack
+
+    } else if (isdigit(onechar) || onechar == '.') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isdigit(str[i]) || str[i] == '.') i++;
+      if (str[i] == 'e' || str[i] == 'E') {
+        i++;
+        if (str[i] == '+' || str[i] == '-') i++;
+        while (isdigit(str[i])) i++;
+      }
+
+      std::string number(&str[istart],i-istart);
+      prog->emit(VALUE,atof(number.c_str()));
+      depth++;
+
+    // letter: c_ID, c_ID[], c_ID[][], f_ID, f_ID[], f_ID[][],
+    //         v_name, math function, constant, thermo keyword
+
+    } else if (isalpha(onechar)) {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isalnum(str[i]) || str[i] == '_') i++;
+      std::string word(&str[istart],i-istart);
+
+      // compute or fix with global scalar/vector/array value
+      // uppercase C_ID and F_ID always refer to vectors, which are not compiled
+
+      if (word.compare(0,2,"C_") == 0 || word.compare(0,2,"F_") == 0) {
+        return 0;
+
+      } else if (word.compare(0,2,"c_") == 0 || word.compare(0,2,"f_") == 0) {
+        if (domain->box_exist == 0) return 0;
+
+        tagint index1 = 0, index2 = 0;
+        int nbracket = 0;
+        if (str[i] == '[') {
+          if (!compile_index(str,i,index1)) return 0;
+          nbracket = 1;
+          if (str[i] == '[') {
+            if (!compile_index(str,i,index2)) return 0;
+            nbracket = 2;
+          }
+        }
+
+        if (word[0] == 'c') {
+          int icompute = modify->find_compute(word.substr(2));
+          if (icompute < 0) return 0;
+          Compute *compute = modify->compute[icompute];
+          if (nbracket == 0 && compute->scalar_flag) op = COMPUTE_SCALAR;
+          else if (nbracket == 1 && compute->vector_flag) op = COMPUTE_VECTOR;
+          else if (nbracket == 2 && compute->array_flag) op = COMPUTE_ARRAY;
+          else return 0;
+          prog->emit(op,0.0,icompute,compute,index1,index2,compute->id);
+        } else {
+          int ifix = modify->find_fix(word.substr(2));
+          if (ifix < 0) return 0;
+          Fix *fix = modify->fix[ifix];
+          if (nbracket == 0 && fix->scalar_flag) op = FIX_SCALAR;
+          else if (nbracket == 1 && fix->vector_flag) op = FIX_VECTOR;
+          else if (nbracket == 2 && fix->array_flag) op = FIX_ARRAY;
+          else return 0;
+          prog->emit(op,0.0,ifix,fix,index1,index2,fix->id);
+        }
+        depth++;
+
+      // variable with scalar value
+      // values of non-numeric styles are converted via retrieve() when run
+
+      } else if (word.compare(0,2,"v_") == 0) {
+        int jvar = find(word.c_str()+2);
+        if (jvar < 0 || str[i] == '[') return 0;
+
+        if (style[jvar] == INTERNAL) prog->emit(VAR_INTERNAL,0.0,jvar);
+        else if (style[jvar] == EQUAL) prog->emit(VAR_EQUAL,0.0,jvar);
+        else if (style[jvar] == ATOM || style[jvar] == ATOMFILE ||
+                 style[jvar] == VECTOR || style[jvar] == PYTHON) return 0;
+        else prog->emit(VAR_STRING,0.0,jvar);
+        depth++;
+
+      // math function
+
+      } else if (str[i] == '(') {
+        int ifunc;
+        for (ifunc = 0; compiled_functions[ifunc].name; ifunc++)
+          if (word == compiled_functions[ifunc].name) break;
+        if (compiled_functions[ifunc].name == nullptr) return 0;
+
+        char *contents = nullptr;
+        i = find_matching_paren(str,i,contents,ivar);
+        i++;
+
+        char *args[MAXFUNCARG];
+        int narg = parse_args(contents,args);
+        delete [] contents;
+
+        int flag = (narg == compiled_functions[ifunc].narg);
+        for (int iarg = 0; iarg < narg; iarg++) {
+          if (flag) flag = compile(args[iarg],prog,depth,ivar);
+          delete [] args[iarg];
+        }
+        if (!flag) return 0;
+
+        prog->emit(compiled_functions[ifunc].op);
+        depth -= narg-1;
+
+      // atom value or atom vector
+
+      } else if (str[i] == '[' || is_atom_vector((char *) word.c_str())) {
+        return 0;
+
+      // constant
+
+      } else if (constants.find(word) != constants.end()) {
+        prog->emit(VALUE,constants[word]);
+        depth++;
+
+      // thermo keyword, validity is checked when executed
+
+      } else {
+        if (domain->box_exist == 0) return 0;
+        prog->emit(THERMO_KEYWORD,0.0,-1,nullptr,0,0,word);
+        depth++;
+      }
+
+    // math operator, including end-of-string
+
+    } else if (strchr("+-*/^<>=!&|%\0",onechar)) {
+      if (onechar == '+') op = ADD;
+      else if (onechar == '-') op = SUBTRACT;
+      else if (onechar == '*') op = MULTIPLY;
+      else if (onechar == '/') op = DIVIDE;
+      else if (onechar == '%') op = MODULO;
+      else if (onechar == '^') op = CARAT;
+      else if (onechar == '=') {
+        if (str[i+1] != '=') return 0;
+        op = EQ;
+        i++;
+      } else if (onechar == '!') {
+        if (str[i+1] == '=') {
+          op = NE;
+          i++;
+        } else op = NOT;
+      } else if (onechar == '<') {
+        if (str[i+1] != '=') op = LT;
+        else {
+          op = LE;
+          i++;
+        }
+      } else if (onechar == '>') {
+        if (str[i+1] != '=') op = GT;
+        else {
+          op = GE;
+          i++;
+        }
+      } else if (onechar == '&') {
+        if (str[i+1] != '&') return 0;
+        op = AND;
+        i++;
+      } else if (onechar == '|') {
+        if (str[i+1] == '|') op = OR;
+        else if (str[i+1] == '^') op = XOR;
+        else return 0;
+        i++;
+      } else op = DONE;
+
+      i++;
+
+      if ((op == SUBTRACT || op == NOT) && expect == ARG) {
+        if (nopstack == MAXLEVEL) return 0;
+        opstack[nopstack++] = (op == SUBTRACT) ? UNARY : NOT;
+        continue;
+      }
+
+      if (expect == ARG) return 0;
+      expect = ARG;
+
+      // emit operations from stack as deep as possible while respecting
+      // precedence before pushing current op onto stack
+
+      while (nopstack && precedence[opstack[nopstack-1]] >= precedence[op]) {
+        opprevious = opstack[--nopstack];
+        prog->emit(opprevious);
+        if (opprevious != UNARY && opprevious != NOT) depth--;
+      }
+
+      if (op == DONE) break;
+
+      if (nopstack == MAXLEVEL) return 0;
+      opstack[nopstack++] = op;
+
+    } else return 0;
+
+    if (depth > MAXSTACK) return 0;
+  }
+
+  if (nopstack || depth != depth0+1) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   parse a positive integer between brackets for compile()
+   i initially points to left bracket, return it pointing past right bracket
+   return 0 if contents are not all digits, e.g. a v_name reference,
+     which int_between_brackets() evaluates each time
+------------------------------------------------------------------------- */
+
+int Variable::compile_index(char *str, int &i, tagint &index)
+{
+  int istart = ++i;
+  while (isdigit(str[i])) i++;
+  if (str[i] != ']' || i == istart) return 0;
+
+  std::string number(&str[istart],i-istart);
+  index = ATOTAGINT(number.c_str());
+  i++;
+  return (index > 0) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   check that computes and fixes referenced by prog still exist
+   with the same ID and still provide the referenced kind of data
+   return 0 if any was deleted or changed, so prog must be recompiled
+   a compute or fix re-created at the same address is caught by its flags
+     or ID, sizes are checked each time in execute()
+------------------------------------------------------------------------- */
+
+int Variable::check_program(Program *prog)
+{
+  for (const auto &bc : prog->code) {
+    if (bc.op == COMPUTE_SCALAR || bc.op == COMPUTE_VECTOR ||
+        bc.op == COMPUTE_ARRAY) {
+      if (bc.index >= modify->ncompute || modify->compute[bc.index] != bc.ptr)
+        return 0;
+      Compute *compute = modify->compute[bc.index];
+      if (bc.id != compute->id) return 0;
+      if (bc.op == COMPUTE_SCALAR && !compute->scalar_flag) return 0;
+      if (bc.op == COMPUTE_VECTOR && !compute->vector_flag) return 0;
+      if (bc.op == COMPUTE_ARRAY && !compute->array_flag) return 0;
+    } else if (bc.op == FIX_SCALAR || bc.op == FIX_VECTOR ||
+               bc.op == FIX_ARRAY) {
+      if (bc.index >= modify->nfix || modify->fix[bc.index] != bc.ptr)
+        return 0;
+      Fix *fix = modify->fix[bc.index];
+      if (bc.id != fix->id) return 0;
+      if (bc.op == FIX_SCALAR && !fix->scalar_flag) return 0;
+      if (bc.op == FIX_VECTOR && !fix->vector_flag) return 0;
+      if (bc.op == FIX_ARRAY && !fix->array_flag) return 0;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   execute compiled formula of equal-style variable ivar
+   performs the same checks and produces the same errors and
+     results as evaluate() does when parsing the formula string
+------------------------------------------------------------------------- */
+
+double Variable::execute(Program *prog, int ivar)
+{
+  double stack[MAXSTACK];
+  double value1,value2,value;
+  int n = 0;
+
+  for (const auto &bc : prog->code) {
+    switch (bc.op) {
+
+    case VALUE:
+      stack[n++] = bc.value;
+      break;
+
+    // compute and fix references
+
+    case COMPUTE_SCALAR: {
+      Compute *compute = (Compute *) bc.ptr;
+      if (update->whichflag == 0) {
+        if (compute->invoked_scalar != update->ntimestep)
+          print_var_error(FLERR,"Compute used in variable between "
+                          "runs is not current",ivar);
+      } else if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
+        compute->compute_scalar();
+        compute->invoked_flag |= Compute::INVOKED_SCALAR;
+      }
+      stack[n++] = compute->scalar;
+      break;
+    }
+
+    case COMPUTE_VECTOR: {
+      Compute *compute = (Compute *) bc.ptr;
+      if (bc.index1 > compute->size_vector &&
+          compute->size_vector_variable == 0)
+        print_var_error(FLERR,"Variable formula compute vector "
+                        "is accessed out-of-range",ivar,0);
+      if (update->whichflag == 0) {
+        if (compute->invoked_vector != update->ntimestep)
+          print_var_error(FLERR,"Compute used in variable between runs "
+                          "is not current",ivar);
+      } else if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
+        compute->compute_vector();
+        compute->invoked_flag |= Compute::INVOKED_VECTOR;
+      }
+      if (compute->size_vector_variable && bc.index1 > compute->size_vector)
+        stack[n++] = 0.0;
+      else stack[n++] = compute->vector[bc.index1-1];
+      break;
+    }
+
+    case COMPUTE_ARRAY: {
+      Compute *compute = (Compute *) bc.ptr;
+      if (bc.index1 > compute->size_array_rows &&
+          compute->size_array_rows_variable == 0)
+        print_var_error(FLERR,"Variable formula compute array "
+                        "is accessed out-of-range",ivar,0);
+      if (bc.index2 > compute->size_array_cols)
+        print_var_error(FLERR,"Variable formula compute array "
+                        "is accessed out-of-range",ivar,0);
+      if (update->whichflag == 0) {
+        if (compute->invoked_array != update->ntimestep)
+          print_var_error(FLERR,"Compute used in variable between runs "
+                          "is not current",ivar);
+      } else if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
+        compute->compute_array();
+        compute->invoked_flag |= Compute::INVOKED_ARRAY;
+      }
+      if (compute->size_array_rows_variable &&
+          bc.index1 > compute->size_array_rows) stack[n++] = 0.0;
+      else stack[n++] = compute->array[bc.index1-1][bc.index2-1];
+      break;
+    }
+
+    case FIX_SCALAR: {
+      Fix *fix = (Fix *) bc.ptr;
+      if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+        print_var_error(FLERR,"Fix in variable not computed "
+                        "at a compatible time",ivar);
+      stack[n++] = fix->compute_scalar();
+      break;
+    }
+
+    case FIX_VECTOR: {
+      Fix *fix = (Fix *) bc.ptr;
+      if (bc.index1 > fix->size_vector && fix->size_vector_variable == 0)
+        print_var_error(FLERR,"Variable formula fix vector is "
+                        "accessed out-of-range",ivar,0);
+      if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+        print_var_error(FLERR,"Fix in variable not computed "
+                        "at a compatible time",ivar);
+      stack[n++] = fix->compute_vector(bc.index1-1);
+      break;
+    }
+
+    case FIX_ARRAY: {
+      Fix *fix = (Fix *) bc.ptr;
+      if (bc.index1 > fix->size_array_rows &&
+          fix->size_array_rows_variable == 0)
+        print_var_error(FLERR,"Variable formula fix array is "
+                        "accessed out-of-range",ivar,0);
+      if (bc.index2 > fix->size_array_cols)
+        print_var_error(FLERR,"Variable formula fix array is "
+                        "accessed out-of-range",ivar,0);
+      if (update->whichflag > 0 && update->ntimestep % fix->global_freq)
+        print_var_error(FLERR,"Fix in variable not computed at a "
+                        "compatible time",ivar);
+      stack[n++] = fix->compute_array(bc.index1-1,bc.index2-1);
+      break;
+    }
+
+    // variable references
+    // EQUAL style is rounded to 15 digits like retrieve() does
+
+    case VAR_INTERNAL:
+      if (eval_in_progress[bc.index])
+        print_var_error(FLERR,"has a circular dependency",bc.index);
+      stack[n++] = dvalue[bc.index];
+      break;
+
+    case VAR_EQUAL: {
+      int jvar = bc.index;
+      if (eval_in_progress[jvar])
+        print_var_error(FLERR,"has a circular dependency",jvar);
+      eval_in_progress[jvar] = 1;
+      value = evaluate_equal(jvar);
+      sprintf(data[jvar][1],"%.15g",value);
+      eval_in_progress[jvar] = 0;
+      stack[n++] = atof(data[jvar][1]);
+      break;
+    }
+
+    case VAR_STRING: {
+      if (eval_in_progress[bc.index])
+        print_var_error(FLERR,"has a circular dependency",bc.index);
+      char *var = retrieve(names[bc.index]);
+      if (var == nullptr)
+        print_var_error(FLERR,"Invalid variable evaluation in "
+                        "variable formula",bc.index);
+      stack[n++] = atof(var);
+      break;
+    }
+
+    case THERMO_KEYWORD:
+      if (domain->box_exist == 0)
+        print_var_error(FLERR,"Variable evaluation before "
+                        "simulation box is defined",ivar);
+      if (output->thermo->evaluate_keyword(bc.id.c_str(),&value))
+        print_var_error(FLERR,fmt::format("Invalid thermo keyword '{}' in "
+                                          "variable formula",bc.id),ivar);
+      stack[n++] = value;
+      break;
+
+    // unary operators
+
+    case UNARY:
+      stack[n-1] = -stack[n-1];
+      break;
+
+    case NOT:
+      stack[n-1] = (stack[n-1] == 0.0) ? 1.0 : 0.0;
+      break;
+
+    // binary operators
+
+    case ADD:
+      value2 = stack[--n];
+      stack[n-1] += value2;
+      break;
+
+    case SUBTRACT:
+      value2 = stack[--n];
+      stack[n-1] -= value2;
+      break;
+
+    case MULTIPLY:
+      value2 = stack[--n];
+      stack[n-1] *= value2;
+      break;
+
+    case DIVIDE:
+      value2 = stack[--n];
+      if (value2 == 0.0)
+        print_var_error(FLERR,"Divide by 0 in variable formula",ivar,0);
+      stack[n-1] /= value2;
+      break;
+
+    case MODULO:
+      value2 = stack[--n];
+      if (value2 == 0.0)
+        print_var_error(FLERR,"Modulo 0 in variable formula",ivar,0);
+      stack[n-1] = fmod(stack[n-1],value2);
+      break;
+
+    case CARAT:
+      value2 = stack[--n];
+      value1 = stack[n-1];
+      if (value2 == 0.0) stack[n-1] = 1.0;
+      else if ((value1 == 0.0) && (value2 < 0.0))
+        print_var_error(FLERR,"Invalid power expression in "
+                        "variable formula",ivar,0);
+      else stack[n-1] = pow(value1,value2);
+      break;
+
+    case EQ:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] == value2) ? 1.0 : 0.0;
+      break;
+
+    case NE:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] != value2) ? 1.0 : 0.0;
+      break;
+
+    case LT:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] < value2) ? 1.0 : 0.0;
+      break;
+
+    case LE:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] <= value2) ? 1.0 : 0.0;
+      break;
+
+    case GT:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] > value2) ? 1.0 : 0.0;
+      break;
+
+    case GE:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] >= value2) ? 1.0 : 0.0;
+      break;
+
+    case AND:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] != 0.0 && value2 != 0.0) ? 1.0 : 0.0;
+      break;
+
+    case OR:
+      value2 = stack[--n];
+      stack[n-1] = (stack[n-1] != 0.0 || value2 != 0.0) ? 1.0 : 0.0;
+      break;
+
+    case XOR:
+      value2 = stack[--n];
+      value1 = stack[n-1];
+      stack[n-1] = ((value1 == 0.0 && value2 != 0.0) ||
+                    (value1 != 0.0 && value2 == 0.0)) ? 1.0 : 0.0;
+      break;
+
+    // math functions with one argument
+
+    case SQRT:
+      if (stack[n-1] < 0.0)
+        print_var_error(FLERR,"Sqrt of negative value in "
+                        "variable formula",ivar,0);
+      stack[n-1] = sqrt(stack[n-1]);
+      break;
+
+    case EXP:
+      stack[n-1] = exp(stack[n-1]);
+      break;
+
+    case LN:
+      if (stack[n-1] <= 0.0)
+        print_var_error(FLERR,"Log of zero/negative value in "
+                        "variable formula",ivar,0);
+      stack[n-1] = log(stack[n-1]);
+      break;
+
+    case LOG:
+      if (stack[n-1] <= 0.0)
+        print_var_error(FLERR,"Log of zero/negative value in "
+                        "variable formula",ivar,0);
+      stack[n-1] = log10(stack[n-1]);
+      break;
+
+    case ABS:
+      stack[n-1] = fabs(stack[n-1]);
+      break;
+
+    case SIN:
+      stack[n-1] = sin(stack[n-1]);
+      break;
+
+    case COS:
+      stack[n-1] = cos(stack[n-1]);
+      break;
+
+    case TAN:
+      stack[n-1] = tan(stack[n-1]);
+      break;
+
+    case ASIN:
+      if (stack[n-1] < -1.0 || stack[n-1] > 1.0)
+        print_var_error(FLERR,"Arcsin of invalid value in variable formula",ivar,0);
+      stack[n-1] = asin(stack[n-1]);
+      break;
+
+    case ACOS:
+      if (stack[n-1] < -1.0 || stack[n-1] > 1.0)
+        print_var_error(FLERR,"Arccos of invalid value in variable formula",ivar,0);
+      stack[n-1] = acos(stack[n-1]);
+      break;
+
+    case ATAN:
+      stack[n-1] = atan(stack[n-1]);
+      break;
+
+    case CEIL:
+      stack[n-1] = ceil(stack[n-1]);
+      break;
+
+    case FLOOR:
+      stack[n-1] = floor(stack[n-1]);
+      break;
+
+    case ROUND:
+      stack[n-1] = MYROUND(stack[n-1]);
+      break;
+
+    // math functions with two or three arguments
+
+    case ATAN2:
+      value2 = stack[--n];
+      stack[n-1] = atan2(stack[n-1],value2);
+      break;
+
+    case RANDOM:
+    case NORMAL: {
+      n -= 2;
+      value1 = stack[n-1];
+      value2 = stack[n];
+      if (bc.op == NORMAL && value2 < 0.0)
+        print_var_error(FLERR,"Invalid math function in variable formula",ivar);
+      if (randomequal == nullptr) {
+        int seed = static_cast<int> (stack[n+1]);
+        if (seed <= 0)
+          print_var_error(FLERR,"Invalid math function in variable formula",ivar);
+        randomequal = new RanMars(lmp,seed);
+      }
+      if (bc.op == RANDOM)
+        stack[n-1] = randomequal->uniform()*(value2-value1) + value1;
+      else stack[n-1] = value1 + value2*randomequal->gaussian();
+      break;
+    }
+
+    case RAMP: {
+      if (update->whichflag == 0)
+        print_var_error(FLERR,"Cannot use ramp in "
+                        "variable formula between runs",ivar);
+      value2 = stack[--n];
+      value1 = stack[n-1];
+      double delta = update->ntimestep - update->beginstep;
+      if (delta != 0.0) delta /= update->endstep - update->beginstep;
+      stack[n-1] = value1 + delta*(value2-value1);
+      break;
+    }
+
+    case STAGGER: {
+      value2 = stack[--n];
+      value1 = stack[n-1];
+      bigint ivalue1 = static_cast<bigint> (value1);
+      bigint ivalue2 = static_cast<bigint> (value2);
+      if (ivalue1 <= 0 || ivalue2 <= 0 || ivalue1 <= ivalue2)
+        print_var_error(FLERR,"Invalid math function in variable formula",ivar);
+      bigint lower = update->ntimestep/ivalue1 * ivalue1;
+      bigint delta = update->ntimestep - lower;
+      if (delta < ivalue2) value = lower+ivalue2;
+      else value = lower+ivalue1;
+      stack[n-1] = value;
+      break;
+    }
+
+    case VDISPLACE: {
+      if (update->whichflag == 0)
+        print_var_error(FLERR,"Cannot use vdisplace in "
+                        "variable formula between runs",ivar);
+      value2 = stack[--n];
+      value1 = stack[n-1];
+      double delta = update->ntimestep - update->beginstep;
+      stack[n-1] = value1 + value2*delta*update->dt;
+      break;
+    }
+
+    case SWIGGLE:
+    case CWIGGLE: {
+      if (update->whichflag == 0) {
+        if (bc.op == SWIGGLE)
+          print_var_error(FLERR,"Cannot use swiggle in "
+                          "variable formula between runs",ivar);
+        else
+          print_var_error(FLERR,"Cannot use cwiggle in "
+                          "variable formula between runs",ivar);
+      }
+      n -= 2;
+      value1 = stack[n-1];
+      value2 = stack[n];
+      if (stack[n+1] == 0.0)
+        print_var_error(FLERR,"Invalid math function in variable formula",ivar);
+      double delta = update->ntimestep - update->beginstep;
+      double omega = 2.0*MY_PI/stack[n+1];
+      if (bc.op == SWIGGLE)
+        stack[n-1] = value1 + value2*sin(omega*delta*update->dt);
+      else stack[n-1] = value1 + value2*(1.0-cos(omega*delta*update->dt));
+      break;
+    }
+    }
+  }
+
+  return stack[0];
+}
+
 /* ----------------------------------------------------------------------
    one-time collapse of an atom-style variable parse tree
    tree was created by one-time parsing of formula string via evaluate()
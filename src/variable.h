@@ -29,6 +29,7 @@ class Variable : protected Pointers {
   void set(char *, int, char **);
   int set_string(const char *, const char *);
   int next(int, char **);
+  void init();
 
   int find(const char *);
   void set_arrays(int);
@@ -121,11 +122,20 @@ class Variable : protected Pointers {
     }
   };
 
+  struct Program;        // compiled bytecode for an equal-style formula
+  Program **program;     // per-variable program, nullptr until first use
+
   int compute_python(int);
   void remove(int);
   void grow();
   void copy(int, char **, char **);
   double evaluate(char *, Tree **, int);
+  double evaluate_equal(int);
+  int compile(char *, Program *, int &, int);
+  int compile_index(char *, int &, tagint &);
+  int check_program(Program *);
+  double execute(Program *, int);
+  void clear_programs();
   double collapse_tree(Tree *);
   double eval_tree(Tree *, int);
   int size_tree_vector(Tree *);
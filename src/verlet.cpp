@@ -26,6 +26,7 @@
 #include "improper.h"
 #include "kspace.h"
 #include "modify.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "output.h"
 #include "pair.h"
@@ -39,7 +40,22 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 Verlet::Verlet(LAMMPS *lmp, int narg, char **arg) :
-  Integrate(lmp, narg, arg) {}
+  Integrate(lmp, narg, arg)
+{
+  overlap = 0;
+  splitflag = 0;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"overlap") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal run_style verlet command");
+      if (strcmp(arg[iarg+1],"yes") == 0) overlap = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) overlap = 0;
+      else error->all(FLERR,"Illegal run_style verlet command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal run_style verlet command");
+  }
+}
 
 /* ----------------------------------------------------------------------
    initialization before run
@@ -103,6 +119,7 @@ void Verlet::setup(int flag)
     error->all(FLERR,"KOKKOS package requires run_style verlet/kk");
 
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -122,6 +139,7 @@ void Verlet::setup(int flag)
   domain->image_check();
   domain->box_too_small_check();
   modify->setup_pre_neighbor();
+  setup_overlap();
   neighbor->build(1);
   modify->setup_post_neighbor();
   neighbor->ncalls = 0;
@@ -166,10 +184,14 @@ void Verlet::setup(int flag)
 void Verlet::setup_minimal(int flag)
 {
   update->setupflag = 1;
+  neighbor->reset_predict();
 
   // setup domain, communication and neighboring
   // acquire ghosts
   // build neighbor lists
+  // if lists are not rebuilt, partition pair list here if needed
+
+  setup_overlap();
 
   if (flag) {
     modify->setup_pre_exchange();
@@ -187,7 +209,7 @@ void Verlet::setup_minimal(int flag)
     neighbor->build(1);
     modify->setup_post_neighbor();
     neighbor->ncalls = 0;
-  }
+  } else if (splitflag) force->pair->list->split();
 
   // compute all forces
 
@@ -239,6 +261,10 @@ void Verlet::run(int n)
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
 
+  // split = 1 if pair forces are computed while ghost coords are in flight
+
+  int split;
+
   for (int i = 0; i < n; i++) {
     if (timer->check_timeout(i)) {
       update->nsteps = i;
@@ -259,9 +285,17 @@ void Verlet::run(int n)
 
     nflag = neighbor->decide();
 
+    // per-atom energy/virial of the 2 partial pair computations cannot be
+    // accumulated, since each call of Pair::compute() clears them
+
+    split = 0;
+    if (splitflag && nflag == 0 && !(eflag & ENERGY_ATOM) &&
+        !(vflag & (VIRIAL_ATOM | VIRIAL_CENTROID))) split = 1;
+
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (split) comm->forward_comm_start();
+      else comm->forward_comm();
       timer->stamp(Timer::COMM);
     } else {
       if (n_pre_exchange) {
@@ -308,7 +342,14 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
-    if (pair_compute_flag) {
+    if (split) {
+      force->pair->compute_interior(eflag,vflag);
+      timer->stamp(Timer::PAIR);
+      comm->forward_comm_finish();
+      timer->stamp(Timer::COMM);
+      force->pair->compute_boundary(eflag,vflag);
+      timer->stamp(Timer::PAIR);
+    } else if (pair_compute_flag) {
       force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
@@ -362,6 +403,28 @@ void Verlet::cleanup()
   modify->post_run();
   domain->box_too_small_check();
   update->update_time();
+
+  if (splitflag) {
+    force->pair->list->splitflag = 0;
+    splitflag = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   decide if forward comm of coords can overlap with pair forces
+   requires a pair style that can compute forces for a subset of its list
+     and no pre_force fixes, which may need ghost atoms
+   if so, Neighbor::build() partitions pair list into interior atoms
+     with only owned neighbors and boundary atoms with ghost neighbors
+------------------------------------------------------------------------- */
+
+void Verlet::setup_overlap()
+{
+  splitflag = 0;
+  if (overlap && pair_compute_flag && force->pair->overlap_enable &&
+      force->pair->list && modify->n_pre_force == 0) splitflag = 1;
+  if (force->pair && force->pair->list)
+    force->pair->list->splitflag = splitflag;
 }
 
 /* ----------------------------------------------------------------------
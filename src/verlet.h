@@ -37,8 +37,11 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+  int overlap;      // 1 if user requested overlap of comm and pair forces
+  int splitflag;    // 1 if overlap is possible for this run
 
   virtual void force_clear();
+  void setup_overlap();
 };
 
 }    // namespace LAMMPS_NS
@@ -53,6 +56,12 @@ W: No fixes defined, atoms won't move
 If you are not using a fix like nve, nvt, npt then atom velocities and
 coordinates will not be updated during timestepping.
 
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
 E: KOKKOS package requires run_style verlet/kk
 
 The KOKKOS package requires the Kokkos version of run_style verlet; the
@@ -0,0 +1,282 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "atom.h"
+#include "force.h"
+#include "info.h"
+#include "kspace.h"
+#include "pair.h"
+#include "utils.h"
+#include "fmt/format.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../testing/core.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+using LAMMPS_NS::utils::split_words;
+
+namespace LAMMPS_NS {
+
+#define CACHE_FILE "kspace_commands_test.cache"
+
+class KSpaceCommandsTest : public LAMMPSTest {
+protected:
+    void InitSystem() override
+    {
+        if (!info->has_style("kspace", "pppm")) return;
+
+        // charge neutral system without time integration,
+        //   so energies of all steps can be compared
+        // accuracy is for forces, energies of different kspace settings
+        //   are compared with a looser tolerance
+
+        HIDE_OUTPUT([&] {
+            command("units           lj");
+            command("atom_style      charge");
+            command("lattice         sc 0.5");
+            command("region          box block 0 6 0 6 0 6");
+            command("create_box      2 box");
+            command("create_atoms    1 box");
+            command("mass            * 1.0");
+            command("set             type 1 type/ratio 2 0.5 4982");
+            command("set             type 1 charge 0.5");
+            command("set             type 2 charge -0.5");
+            command("displace_atoms  all random 0.1 0.1 0.1 8729");
+            command("pair_style      lj/cut/coul/long 2.5");
+            command("pair_coeff      * * 1.0 1.0");
+            command("kspace_style    pppm 1.0e-4");
+            command("thermo          0");
+            command("variable        pe equal pe");
+        });
+    }
+
+    void TearDown() override
+    {
+        LAMMPSTest::TearDown();
+        remove(CACHE_FILE);
+    }
+
+    void Restart()
+    {
+        HIDE_OUTPUT([&] {
+            command("clear");
+        });
+        InitSystem();
+    }
+
+    double RunEnergy(const std::string &run)
+    {
+        HIDE_OUTPUT([&] {
+            command(run);
+        });
+        return get_variable_value("pe");
+    }
+
+    std::vector<std::string> CacheLines()
+    {
+        std::vector<std::string> lines;
+        std::ifstream in(CACHE_FILE);
+        std::string line;
+        while (std::getline(in, line))
+            if (!line.empty()) lines.push_back(line);
+        return lines;
+    }
+
+    double CutCoul()
+    {
+        int dim;
+        return *(double *)lmp->force->pair->extract("cut_coul", dim);
+    }
+};
+
+TEST_F(KSpaceCommandsTest, TuneKSpaceOrderCache)
+{
+    if (!info->has_style("fix", "tune/kspace")) GTEST_SKIP();
+
+    double eref = RunEnergy("run 0 post no");
+    Restart();
+
+    // search kspace style, cutoff, and order until done, then store it
+
+    HIDE_OUTPUT([&] {
+        command("fix tune all tune/kspace 2 order yes cache " CACHE_FILE);
+    });
+    double etuned = RunEnergy("run 400 post no");
+
+    auto lines = CacheLines();
+    ASSERT_EQ(lines.size(), 1);
+    auto words = split_words(lines[0]);
+    ASSERT_GT(words.size(), 3);
+    std::string style = words[words.size() - 3];
+    ASSERT_THAT(style, ::testing::MatchesRegex("ewald|pppm|msm"));
+    ASSERT_THAT(lmp->force->kspace_style, ::testing::StartsWith(style));
+    ASSERT_EQ(std::stoi(words.back()), lmp->force->kspace->order);
+    if (style == "pppm") {
+        EXPECT_GE(lmp->force->kspace->order, 3);
+        EXPECT_LE(lmp->force->kspace->order, 7);
+    }
+    EXPECT_NEAR(etuned, eref, 5.0e-3 * fabs(eref));
+
+    // a run of the same system uses the stored settings right away
+
+    Restart();
+    HIDE_OUTPUT([&] {
+        command("fix tune all tune/kspace 2 order yes cache " CACHE_FILE);
+    });
+    double ecached = RunEnergy("run 2 post no");
+    EXPECT_THAT(lmp->force->kspace_style, ::testing::StartsWith(style));
+    EXPECT_DOUBLE_EQ(CutCoul(), std::stod(words[words.size() - 2]));
+    EXPECT_EQ(std::stoi(words.back()), lmp->force->kspace->order);
+    EXPECT_EQ(CacheLines().size(), 1);
+    EXPECT_NEAR(ecached, eref, 5.0e-3 * fabs(eref));
+}
+
+TEST_F(KSpaceCommandsTest, TuneKSpaceCachedOrder)
+{
+    if (!info->has_style("fix", "tune/kspace")) GTEST_SKIP();
+
+    double eref = RunEnergy("run 0 post no");
+    Restart();
+
+    // tuning the selected style and order depends on timings,
+    //   so replace the stored settings with a fixed choice
+
+    HIDE_OUTPUT([&] {
+        command("fix tune all tune/kspace 2 cache " CACHE_FILE);
+    });
+    RunEnergy("run 400 post no");
+    auto lines = CacheLines();
+    ASSERT_EQ(lines.size(), 1);
+    auto words = split_words(lines[0]);
+    ASSERT_GT(words.size(), 3);
+    std::string signature = words[0];
+    for (std::size_t i = 1; i < words.size() - 3; ++i)
+        signature += " " + words[i];
+    FILE *fp = fopen(CACHE_FILE, "a");
+    fprintf(fp, "%s pppm 3.0 6\n", signature.c_str());
+    fclose(fp);
+
+    // the last matching entry is used for the pppm order, and
+    //   the kspace style sets the grid to maintain the accuracy
+
+    Restart();
+    HIDE_OUTPUT([&] {
+        command("fix tune all tune/kspace 2 cache " CACHE_FILE);
+    });
+    double ecached = RunEnergy("run 2 post no");
+    EXPECT_THAT(lmp->force->kspace_style, ::testing::StartsWith("pppm"));
+    EXPECT_EQ(lmp->force->kspace->order, 6);
+    EXPECT_DOUBLE_EQ(CutCoul(), 3.0);
+    EXPECT_EQ(CacheLines().size(), 2);
+    EXPECT_NEAR(ecached, eref, 5.0e-3 * fabs(eref));
+}
+
+TEST_F(KSpaceCommandsTest, MSMThreads)
+{
+    if (!info->has_style("kspace", "msm") || !LAMMPS::is_installed_pkg("USER-OMP"))
+        GTEST_SKIP();
+
+    // the grid direct sums, restriction, and prolongation of plain msm
+    //   are threaded, which may only change results at round-off level
+    // the per-atom virial requires the separate per-atom direct sum
+
+    for (auto boundary : {"p p p", "f f f"}) {
+        std::vector<double> fref, vref;
+        double eref = 0.0;
+        for (int nthreads : {1, 4}) {
+            HIDE_OUTPUT([&] {
+                command("clear");
+                command(fmt::format("package omp {}", nthreads));
+                command("units           lj");
+                command("atom_style      charge");
+                command(std::string("boundary        ") + boundary);
+                command("lattice         sc 0.5");
+                command("region          box block 0 7 0 7 0 7");
+                command("create_box      2 box");
+                command("region          inner block 0.5 6.5 0.5 6.5 0.5 6.5");
+                command("create_atoms    1 region inner");
+                command("mass            * 1.0");
+                command("set             type 1 type/ratio 2 0.5 4982");
+                command("set             type 1 charge 0.5");
+                command("set             type 2 charge -0.5");
+                command("displace_atoms  all random 0.1 0.1 0.1 8729");
+                command("pair_style      lj/cut/coul/msm 1.2");
+                command("pair_coeff      * * 1.0 1.0");
+                command("kspace_style    msm 1.0e-4");
+                command("kspace_modify   mesh 16 16 16 order 6 pressure/scalar no");
+                command("compute         sa all stress/atom NULL");
+                command("compute         vs all reduce sum c_sa[1]");
+                command("thermo_style    custom step pe c_vs");
+                command("run 0 post no");
+            });
+            KSpace *kspace = lmp->force->kspace;
+            std::vector<double> f, v;
+            for (int i = 0; i < lmp->atom->nlocal; ++i) {
+                for (int k = 0; k < 3; ++k)
+                    f.push_back(lmp->atom->f[i][k]);
+                for (int k = 0; k < 6; ++k)
+                    v.push_back(kspace->vatom[i][k]);
+            }
+            if (nthreads == 1) {
+                eref = kspace->energy;
+                fref = f;
+                vref = v;
+                continue;
+            }
+
+            EXPECT_NEAR(kspace->energy, eref, 1.0e-12 * fabs(eref)) << boundary;
+            ASSERT_EQ(f.size(), fref.size());
+            for (std::size_t i = 0; i < f.size(); ++i)
+                EXPECT_NEAR(f[i], fref[i], 1.0e-10) << boundary;
+            ASSERT_EQ(v.size(), vref.size());
+            for (std::size_t i = 0; i < v.size(); ++i)
+                EXPECT_NEAR(v[i], vref[i], 1.0e-10) << boundary;
+        }
+    }
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,208 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://lammps.sandia.gov/, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// unit tests for local and incremental energies in Monte Carlo fixes
+
+#include "lammps.h"
+
+#include "fix.h"
+#include "force.h"
+#include "info.h"
+#include "kspace.h"
+#include "modify.h"
+#include "update.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../testing/core.h"
+
+#include <cmath>
+#include <cstring>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class MCEnergyTest : public LAMMPSTest {
+protected:
+    void InitSystem() override
+    {
+        if (!info->has_style("fix", "gcmc") || !info->has_style("kspace", "ewald")) return;
+
+        // charge neutral mix of +/- charges in a periodic box
+        // fixed Ewald parameters, so energies of different configurations compare
+
+        HIDE_OUTPUT([&] {
+            command("units           lj");
+            command("atom_style      charge");
+            command("lattice         sc 0.1");
+            command("region          box block 0 4 0 4 0 4");
+            command("create_box      2 box");
+            command("create_atoms    1 box");
+            command("mass            * 1.0");
+            command("group           odd id 1:64:2");
+            command("set             type 1 charge 0.5");
+            command("set             group odd charge -0.5");
+            command("displace_atoms  all random 0.3 0.3 0.3 4987");
+            command("pair_style      lj/cut/coul/long 2.5 3.0");
+            command("pair_coeff      * * 1.0 1.0");
+            command("kspace_style    ewald 1.0e-6");
+            command("kspace_modify   gewald 0.9 kmax/ewald 6 6 6");
+            command("thermo_modify   lost ignore");
+        });
+    }
+
+    // restore the initial configuration for a second run
+
+    void Restart()
+    {
+        HIDE_OUTPUT([&] {
+            command("clear");
+        });
+        InitSystem();
+    }
+
+    Fix *find_fix(const std::string &id)
+    {
+        int ifix = lmp->modify->find_fix(id);
+        return (ifix < 0) ? nullptr : lmp->modify->fix[ifix];
+    }
+};
+
+TEST_F(MCEnergyTest, EwaldEnergyDelta)
+{
+    if (!info->has_style("kspace", "ewald")) GTEST_SKIP();
+
+    // energy change of an added charge vs. full Ewald energies before and after
+
+    HIDE_OUTPUT([&] {
+        command("run 0 post no");
+    });
+    KSpace *kspace = lmp->force->kspace;
+    double ebefore = kspace->energy;
+
+    double site[3] = {1.3, 2.9, 4.1};
+    double *xsite  = site;
+    double qold = 0.0, qnew = 0.7;
+    kspace->setup_delta();
+    double delta = kspace->energy_delta(1, &xsite, &qold, &qnew);
+
+    HIDE_OUTPUT([&] {
+        command("create_atoms 2 single 1.3 2.9 4.1 units box");
+        command("set type 2 charge 0.7");
+        command("run 0 post no");
+    });
+    double eafter = lmp->force->kspace->energy;
+    EXPECT_NEAR(delta, eafter - ebefore, 1.0e-10 * fabs(eafter));
+}
+
+TEST_F(MCEnergyTest, WidomKSpaceDelta)
+{
+    if (!info->has_style("fix", "widom") || !info->has_style("kspace", "ewald")) GTEST_SKIP();
+
+    // local pair energies and incremental Ewald vs. full energies
+    // widom does not change the system, so both see the same trial sites
+
+    double mu[2];
+    for (int full = 0; full < 2; ++full) {
+        if (full) Restart();
+        HIDE_OUTPUT([&] {
+            command(std::string("fix widom all widom 1 50 2 3827 1.0 charge 0.3") +
+                    (full ? " full_energy" : ""));
+            command("run 2 post no");
+        });
+        mu[full] = find_fix("widom")->compute_vector(0);
+    }
+    EXPECT_NEAR(mu[0], mu[1], 1.0e-8 * fabs(mu[1]));
+}
+
+TEST_F(MCEnergyTest, AtomSwapKSpaceDelta)
+{
+    if (!info->has_style("fix", "atom/swap") || !info->has_style("kspace", "ewald"))
+        GTEST_SKIP();
+
+    // swaps of atoms with different charges, local vs. full energies
+
+    double nsuccess[2], pe[2];
+    for (int full = 0; full < 2; ++full) {
+        if (full) Restart();
+        HIDE_OUTPUT([&] {
+            command("set             type 1 type/ratio 2 0.5 8311");
+            command("set             type 1 charge 0.4");
+            command("set             type 2 charge -0.4");
+            command(std::string("fix swap all atom/swap 1 20 2957 1.0 types 1 2") +
+                    (full ? " full_energy" : ""));
+            command("run 5 post no");
+            command("variable pe equal pe");
+        });
+        nsuccess[full] = find_fix("swap")->compute_vector(1);
+        pe[full]       = get_variable_value("pe");
+    }
+    EXPECT_GT(nsuccess[0], 0.0);
+    EXPECT_DOUBLE_EQ(nsuccess[0], nsuccess[1]);
+    EXPECT_NEAR(pe[0], pe[1], 1.0e-8 * fabs(pe[1]));
+}
+
+TEST_F(MCEnergyTest, GCMCKSpaceDelta)
+{
+    if (!info->has_style("fix", "gcmc") || !info->has_style("kspace", "ewald")) GTEST_SKIP();
+
+    // charged gas atoms are translated, while inserted atoms are neutral
+    // the incrementally updated structure factors must match fresh ones
+    // call the MC step directly, since a force evaluation resets them
+
+    HIDE_OUTPUT([&] {
+        command("fix mc all gcmc 1 200 200 1 29494 1.0 -2.0 0.3");
+        command("run 0 post no");
+    });
+    Fix *mc = find_fix("mc");
+    mc->next_reneighbor = lmp->update->ntimestep;
+    HIDE_OUTPUT([&] {
+        mc->pre_exchange();
+    });
+    ASSERT_GT(mc->compute_vector(1), 0.0);
+    ASSERT_GT(mc->compute_vector(3), 0.0);
+
+    KSpace *kspace = lmp->force->kspace;
+    double site[3] = {2.2, 7.5, 0.4};
+    double *xsite  = site;
+    double qold = 0.0, qnew = 1.0;
+    double delta = kspace->energy_delta(1, &xsite, &qold, &qnew);
+    kspace->setup_delta();
+    double fresh = kspace->energy_delta(1, &xsite, &qold, &qnew);
+    EXPECT_NEAR(delta, fresh, 1.0e-10 * fabs(fresh));
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -0,0 +1,257 @@
+// unit tests for checking LAMMPS MPI communication options
+
+#define LAMMPS_LIB_MPI 1
+#include "lammps.h"
+#include "atom.h"
+#include "atom_vec.h"
+#include "comm.h"
+#include "domain.h"
+#include "force.h"
+#include "input.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "pair.h"
+#include "update.h"
+#include "fmt/format.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS
+{
+
+class MPICommTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // start over with a fresh LAMMPS instance
+
+    void Reset()
+    {
+        TearDown();
+        SetUp();
+    }
+
+    void InitSystem(const std::string &pair, int ncell = 10)
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map array");
+        command("lattice         fcc 0.8442");
+        command(fmt::format("region          box block 0 {0} 0 {0} 0 {0}", ncell));
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("set             type 1 type/fraction 2 0.5 4982");
+        command("mass            * 1.0");
+        command("velocity        all create 1.44 87287 loop geom");
+        if (pair == "hybrid") {
+            command("pair_style      hybrid lj/cut 2.5 morse 2.5");
+            command("pair_coeff      * * lj/cut 1.0 1.0 2.5");
+            command("pair_coeff      2 2 morse 1.0 5.0 1.12");
+        } else {
+            command("pair_style      lj/cut 2.5");
+            command("pair_coeff      * * 1.0 1.0 2.5");
+        }
+        command("neighbor        0.3 bin");
+        command("neigh_modify    every 10 delay 0 check no");
+        command("fix             1 all nve");
+        command("thermo          0");
+    }
+
+    // forces of all atoms in order of atom IDs
+
+    std::vector<double> Forces()
+    {
+        bigint natoms = lmp->atom->natoms;
+        std::vector<double> fone(3 * natoms, 0.0), fall(3 * natoms, 0.0);
+        double **f = lmp->atom->f;
+        tagint *tag = lmp->atom->tag;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                fone[3 * (tag[i] - 1) + k] = f[i][k];
+        MPI_Allreduce(fone.data(), fall.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return fall;
+    }
+
+    std::vector<double> RunForces(const std::string &pair, const std::string &style)
+    {
+        Reset();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        InitSystem(pair);
+        command("run_style " + style);
+        command("run 25 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        return Forces();
+    }
+
+    // shift owned atoms, so ghost atoms are only correct after forward comm
+
+    void Displace()
+    {
+        double **x = lmp->atom->x;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                x[i][k] += 0.01 * (k + 1);
+    }
+
+    // largest distance of a ghost atom from the periodic image of its owner
+
+    double GhostError()
+    {
+        bigint natoms = lmp->atom->natoms;
+        std::vector<double> xone(3 * natoms, 0.0), xall(3 * natoms, 0.0);
+        double **x = lmp->atom->x;
+        tagint *tag = lmp->atom->tag;
+        int nlocal = lmp->atom->nlocal;
+        int nall = nlocal + lmp->atom->nghost;
+        for (int i = 0; i < nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                xone[3 * (tag[i] - 1) + k] = x[i][k];
+        MPI_Allreduce(xone.data(), xall.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+        double *prd = lmp->domain->prd;
+        double errone = 0.0, errall = 0.0;
+        for (int i = nlocal; i < nall; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                double delta = x[i][k] - xall[3 * (tag[i] - 1) + k];
+                delta -= prd[k] * std::round(delta / prd[k]);
+                errone = std::max(errone, std::fabs(delta));
+            }
+        }
+        MPI_Allreduce(&errone, &errall, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return errall;
+    }
+
+    // number of interior atoms summed over all procs
+
+    bigint Interior()
+    {
+        bigint one = lmp->force->pair->list->ninterior, all = 0;
+        MPI_Allreduce(&one, &all, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+};
+
+TEST_F(MPICommTest, verlet_overlap)
+{
+    auto fref = RunForces("lj/cut", "verlet overlap no");
+    EXPECT_EQ(Interior(), 0);
+    auto fnew = RunForces("lj/cut", "verlet overlap yes");
+    EXPECT_GT(Interior(), 0);
+
+    ASSERT_EQ(fref.size(), fnew.size());
+    for (std::size_t i = 0; i < fref.size(); ++i)
+        EXPECT_NEAR(fref[i], fnew[i], 1.0e-10);
+}
+
+TEST_F(MPICommTest, verlet_overlap_hybrid)
+{
+    // pair hybrid does not support overlap and must use the regular path
+
+    auto fref = RunForces("hybrid", "verlet overlap no");
+    auto fnew = RunForces("hybrid", "verlet overlap yes");
+
+    ASSERT_EQ(fref.size(), fnew.size());
+    for (std::size_t i = 0; i < fref.size(); ++i)
+        EXPECT_NEAR(fref[i], fnew[i], 1.0e-10);
+}
+
+TEST_F(MPICommTest, forward_comm_after_grow)
+{
+    // growing per-atom arrays between reneighborings must not leave
+    //   persistent forward comm requests bound to the old x array
+
+    for (auto style : {"brick", "tiled"}) {
+        Reset();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        InitSystem("lj/cut");
+        command(std::string("comm_style ") + style);
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        // warm up the persistent requests, then grow the arrays
+        //   far enough that the data block cannot be extended in place
+
+        lmp->comm->forward_comm();
+        ASSERT_LT(GhostError(), 1.0e-10);
+        lmp->atom->avec->grow(64 * lmp->atom->nmax);
+        Displace();
+        lmp->comm->forward_comm();
+        EXPECT_LT(GhostError(), 1.0e-10) << "comm_style " << style;
+
+        // Memory::grow() may move only the data block of x while
+        //   the row pointer array is extended in place, mimic that here
+
+        int nmax = lmp->atom->nmax;
+        double **x = lmp->atom->x;
+        double *xold = x[0];
+        auto xnew = (double *)lmp->memory->smalloc(3 * sizeof(double) * nmax, "test:x");
+        memcpy(xnew, xold, 3 * sizeof(double) * nmax);
+        for (int i = 0; i < nmax; ++i)
+            x[i] = &xnew[3 * i];
+        lmp->memory->sfree(xold);
+        Displace();
+        lmp->comm->forward_comm();
+        EXPECT_LT(GhostError(), 1.0e-10) << "comm_style " << style;
+    }
+}
+
+TEST_F(MPICommTest, omp_threads)
+{
+    if (!LAMMPS::is_installed_pkg("USER-OMP")) GTEST_SKIP();
+
+    // threaded border search, pack/unpack, exchange, and sort binning
+    //   must give the same trajectory as a single thread
+    // enough atoms per proc and per swap to exceed the threading thresholds
+
+    std::vector<double> fref;
+    for (int nthreads : {1, 4}) {
+        Reset();
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command(fmt::format("package omp {}", nthreads));
+        command("processors 4 1 1");
+        InitSystem("lj/cut", 20);
+        command("atom_modify sort 10 1.0");
+        command("run 50 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        if (nthreads == 1) {
+            fref = Forces();
+            continue;
+        }
+        auto fnew = Forces();
+
+        ASSERT_EQ(fref.size(), fnew.size());
+        for (std::size_t i = 0; i < fref.size(); ++i)
+            EXPECT_EQ(fref[i], fnew[i]);
+    }
+}
+
+} // namespace LAMMPS_NS
@@ -0,0 +1,229 @@
+// unit tests for checking LAMMPS KSpace grid communication in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "lammps.h"
+#include "atom.h"
+#include "info.h"
+#include "input.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS
+{
+
+class MPIKSpaceTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+    std::string output;    // screen output of the last run, only on rank 0
+
+    void Create(MPI_Comm comm)
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, comm);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void Destroy()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (lmp) Destroy();
+    }
+
+    // charged system in a small periodic box, so the ghost cells of
+    //   each proc wrap around to the same neighbor on both sides
+
+    void InitSystem(const std::string &layout, const std::string &extra)
+    {
+        if (layout.find("processors") == 0) command(layout);
+        command("units           lj");
+        command("atom_style      charge");
+        command("atom_modify     map array");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      2 box");
+        command("mass            * 1.0");
+
+        // place atoms one by one, so atom IDs do not depend on # of procs
+
+        unsigned int seed = 4982;
+        for (int i = 0; i < 80; ++i) {
+            double x[3];
+            for (int k = 0; k < 3; ++k) {
+                seed = 1103515245 * seed + 12345;
+                x[k] = 6.0 * ((seed >> 8) & 0xffff) / 65536.0;
+            }
+            command(fmt::format("create_atoms    {} single {} {} {} units box", i % 2 + 1, x[0],
+                                x[1], x[2]));
+        }
+        command("set             type 1 charge 0.5");
+        command("set             type 2 charge -0.5");
+        command("pair_style      lj/cut/coul/long 2.0");
+        command("pair_coeff      * * 0.0 1.0");
+        command("kspace_style    pppm 1.0e-5");
+        command("kspace_modify   mesh 10 10 10 order 7 " + extra);
+        if (layout == "tiled") {
+            command("comm_style      tiled");
+            command("balance         1.0 rcb");
+        }
+        command("thermo          0");
+    }
+
+    // forces of all atoms in order of atom IDs
+
+    std::vector<double> RunForces(MPI_Comm comm, const std::string &layout,
+                                  const std::string &extra = "")
+    {
+        Create(comm);
+        ::testing::internal::CaptureStdout();
+        InitSystem(layout, extra);
+        command("run 0 post no");
+        output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+
+        bigint natoms = lmp->atom->natoms;
+        std::vector<double> fone(3 * natoms, 0.0), fall(3 * natoms, 0.0);
+        double **f = lmp->atom->f;
+        tagint *tag = lmp->atom->tag;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                fone[3 * (tag[i] - 1) + k] = f[i][k];
+        MPI_Allreduce(fone.data(), fall.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, comm);
+        Destroy();
+        return fall;
+    }
+};
+
+TEST_F(MPIKSpaceTest, gridcomm_periodic)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs != 2) GTEST_SKIP();
+    Create(MPI_COMM_SELF);
+    bool has_pppm = Info(lmp).has_style("kspace", "pppm");
+    Destroy();
+    if (!has_pppm) GTEST_SKIP();
+
+    // pieces of equal size between the same 2 procs on both periodic sides
+    // must not be mixed up, and sums of ghost cells must be reproducible
+
+    auto fref = RunForces(MPI_COMM_SELF, "brick");
+    for (auto layout : {"brick", "tiled"}) {
+        auto fnew = RunForces(MPI_COMM_WORLD, layout);
+        auto fagain = RunForces(MPI_COMM_WORLD, layout);
+
+        ASSERT_EQ(fref.size(), fnew.size());
+        for (std::size_t i = 0; i < fref.size(); ++i) {
+            EXPECT_NEAR(fref[i], fnew[i], 1.0e-10) << "layout " << layout;
+            EXPECT_EQ(fnew[i], fagain[i]) << "layout " << layout;
+        }
+    }
+}
+
+TEST_F(MPIKSpaceTest, gridcomm_multihop)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs != 4) GTEST_SKIP();
+    Create(MPI_COMM_SELF);
+    bool has_pppm = Info(lmp).has_style("kspace", "pppm");
+    Destroy();
+    if (!has_pppm) GTEST_SKIP();
+
+    // with 4 procs in a dim, ghost cells of a 10 grid with order 7
+    //   reach beyond the adjacent procs, so owned and ghost extents
+    //   must be gathered from more than the 6 neighbor procs
+
+    auto fref = RunForces(MPI_COMM_SELF, "brick");
+    for (auto layout : {"processors 4 1 1", "processors 1 2 2", "processors 2 2 1"}) {
+        auto fnew = RunForces(MPI_COMM_WORLD, layout);
+        auto fagain = RunForces(MPI_COMM_WORLD, layout);
+
+        ASSERT_EQ(fref.size(), fnew.size());
+        for (std::size_t i = 0; i < fref.size(); ++i) {
+            EXPECT_NEAR(fref[i], fnew[i], 1.0e-10) << layout;
+            EXPECT_EQ(fnew[i], fagain[i]) << layout;
+        }
+    }
+}
+
+TEST_F(MPIKSpaceTest, remap_collective)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs != 2) GTEST_SKIP();
+    Create(MPI_COMM_SELF);
+    bool has_pppm = Info(lmp).has_style("kspace", "pppm");
+    Destroy();
+    if (!has_pppm) GTEST_SKIP();
+
+    // FFT remaps via flat or node-aware all-to-all only move data,
+    //   so forces must match the point-to-point remaps
+
+    auto fref = RunForces(MPI_COMM_WORLD, "brick", "collective no");
+    for (auto mode : {"yes", "node"}) {
+        auto fnew = RunForces(MPI_COMM_WORLD, "brick", std::string("collective ") + mode);
+
+        ASSERT_EQ(fref.size(), fnew.size());
+        for (std::size_t i = 0; i < fref.size(); ++i)
+            EXPECT_NEAR(fref[i], fnew[i], 1.0e-12) << "collective " << mode;
+    }
+}
+
+TEST_F(MPIKSpaceTest, fft_single)
+{
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (nprocs != 2) GTEST_SKIP();
+    Create(MPI_COMM_SELF);
+    bool has_pppm = Info(lmp).has_style("kspace", "pppm");
+    Destroy();
+    if (!has_pppm) GTEST_SKIP();
+
+    // single precision FFT grids, FFTs, and remaps change forces
+    //   only at the level of single precision
+    // nothing changes when FFTs are in single precision anyway
+
+    for (auto mode : {"no", "yes", "node"}) {
+        for (auto r2c : {"no", "yes"}) {
+            std::string extra = fmt::format("collective {} fft/r2c {}", mode, r2c);
+            auto fref = RunForces(MPI_COMM_WORLD, "brick", extra);
+            int me, fft_double = 0;
+            MPI_Comm_rank(MPI_COMM_WORLD, &me);
+            if (me == 0) fft_double = (output.find("using double precision") != std::string::npos);
+            MPI_Bcast(&fft_double, 1, MPI_INT, 0, MPI_COMM_WORLD);
+            auto fnew = RunForces(MPI_COMM_WORLD, "brick", extra + " fft/single yes");
+
+            ASSERT_EQ(fref.size(), fnew.size());
+            double maxdiff = 0.0;
+            for (std::size_t i = 0; i < fref.size(); ++i) {
+                EXPECT_NEAR(fref[i], fnew[i], 5.0e-5) << extra;
+                maxdiff = std::max(maxdiff, std::fabs(fref[i] - fnew[i]));
+            }
+            if (fft_double) EXPECT_GT(maxdiff, 0.0) << extra;
+        }
+    }
+}
+
+} // namespace LAMMPS_NS
@@ -13,11 +13,15 @@
 
 #include "lammps.h"
 
+#include "atom.h"
+#include "atom_vec.h"
 #include "citeme.h"
 #include "comm.h"
 #include "force.h"
 #include "info.h"
 #include "input.h"
+#include "memory.h"
+#include "neighbor.h"
 #include "output.h"
 #include "update.h"
 #include "utils.h"
@@ -28,6 +32,7 @@
 #include "../testing/core.h"
 #include "../testing/utils.h"
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
@@ -156,6 +161,170 @@ TEST_F(SimpleCommandsTest, Newton)
     ASSERT_EQ(lmp->force->newton_bond, 1);
 }
 
+TEST_F(SimpleCommandsTest, MemoryModify)
+{
+    auto memory = lmp->memory;
+    ASSERT_EQ(memory->hugepage, 0);
+    ASSERT_EQ(memory->firsttouch, 0);
+    ASSERT_DOUBLE_EQ(memory->growfactor, 1.0);
+
+    // the footprint is tallied from the start, where it is supported
+
+    double before = memory->footprint();
+    if (before >= 0.0) {
+        ASSERT_GT(before, 0.0);
+        auto data = (double *)memory->smalloc(1000 * sizeof(double), "test:data");
+        ASSERT_GE(memory->footprint(), before + 1000 * sizeof(double));
+        memory->sfree(data);
+        ASSERT_DOUBLE_EQ(memory->footprint(), before);
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory_modify growth 1.5 threshold 1.0");
+    command("region box block 0 2 0 2 0 2");
+    command("create_box 1 box");
+    command("create_atoms 1 single 1.0 1.0 1.0");
+    END_HIDE_OUTPUT();
+    ASSERT_DOUBLE_EQ(memory->growfactor, 1.5);
+    ASSERT_EQ(memory->minlarge, 1024 * 1024);
+
+    // per-atom arrays grow at least by the growth factor
+
+    int nmax = lmp->atom->nmax;
+    lmp->atom->avec->grow(0);
+    ASSERT_GE(lmp->atom->nmax, 1.5 * nmax);
+
+    // hugepage and firsttouch are ignored where large blocks are unsupported
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory_modify hugepage yes firsttouch yes");
+    END_HIDE_OUTPUT();
+    before = memory->footprint();
+    if (before >= 0.0) {
+        ASSERT_EQ(memory->hugepage, 1);
+        ASSERT_EQ(memory->firsttouch, 1);
+
+        // large blocks are aligned to huge pages and keep their data when grown
+
+        const int n = 1024 * 1024 / sizeof(double);
+        auto data   = (double *)memory->smalloc(n * sizeof(double), "test:data");
+        ASSERT_EQ((uintptr_t)data % (2 * 1024 * 1024), 0);
+        ASSERT_GE(memory->footprint(), before + n * sizeof(double));
+        for (int i = 0; i < n; ++i)
+            data[i] = i;
+        data = (double *)memory->srealloc(data, 2 * n * sizeof(double), "test:data");
+        ASSERT_EQ((uintptr_t)data % (2 * 1024 * 1024), 0);
+        ASSERT_GE(memory->footprint(), before + 2 * n * sizeof(double));
+        int nbad = 0;
+        for (int i = 0; i < n; ++i)
+            if (data[i] != i) ++nbad;
+        ASSERT_EQ(nbad, 0);
+        memory->sfree(data);
+        ASSERT_DOUBLE_EQ(memory->footprint(), before);
+    } else {
+        ASSERT_EQ(memory->hugepage, 0);
+        ASSERT_EQ(memory->firsttouch, 0);
+    }
+
+    BEGIN_HIDE_OUTPUT();
+    command("memory_modify hugepage no firsttouch no growth 1.0");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(memory->hugepage, 0);
+    ASSERT_EQ(memory->firsttouch, 0);
+    ASSERT_DOUBLE_EQ(memory->growfactor, 1.0);
+
+    TEST_FAILURE(".*ERROR: Illegal memory_modify command.*", command("memory_modify"););
+    TEST_FAILURE(".*ERROR: Illegal memory_modify command.*", command("memory_modify xxx"););
+    TEST_FAILURE(".*ERROR: Illegal memory_modify command.*",
+                 command("memory_modify hugepage maybe"););
+    TEST_FAILURE(".*ERROR: Illegal memory_modify command.*",
+                 command("memory_modify threshold 0"););
+    TEST_FAILURE(".*ERROR: Illegal memory_modify command.*",
+                 command("memory_modify growth 0.5"););
+}
+
+TEST_F(SimpleCommandsTest, NeighPredict)
+{
+    bigint ncalls[2], ndanger[2], nskip[2];
+    double xfinal[2];
+    auto setup = [&](const std::string &predict, const std::string &force) {
+        command("clear");
+        command("units lj");
+        command("region box block 0 10 0 10 0 10");
+        command("create_box 1 box");
+        command("create_atoms 1 single 1.0 5.0 5.0");
+        command("create_atoms 1 single 5.0 5.0 5.0");
+        command("mass 1 1.0");
+        command("pair_style zero 2.0");
+        command("pair_coeff * *");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 1 delay 0 check yes predict " + predict);
+        command("variable fx equal " + force);
+        command("fix 1 all nve");
+        command("fix 2 all addforce v_fx 0.0 0.0");
+    };
+    auto run = [&](const std::string &vmax, const std::string &force) {
+        for (int predict = 0; predict < 2; ++predict) {
+            BEGIN_HIDE_OUTPUT();
+            setup(predict ? vmax : "no", force);
+            command("run 1000");
+            END_HIDE_OUTPUT();
+            ncalls[predict]  = lmp->neighbor->ncalls;
+            ndanger[predict] = lmp->neighbor->ndanger;
+            nskip[predict]   = lmp->neighbor->nskip;
+            xfinal[predict]  = lmp->atom->x[0][0];
+        }
+    };
+
+    // atoms are at most 5.0 fast: skipping distance checks must neither
+    //   delay nor miss any neighbor list build, also when a force is
+    //   switched on while checks are skipped
+
+    for (auto force : {"1.0", "step>300"}) {
+        run("6.0", force);
+        ASSERT_EQ(nskip[0], 0);
+        ASSERT_GT(nskip[1], 0);
+        ASSERT_GT(ncalls[0], 1);
+        ASSERT_EQ(ncalls[1], ncalls[0]);
+        ASSERT_EQ(ndanger[0], 0);
+        ASSERT_EQ(ndanger[1], 0);
+        ASSERT_DOUBLE_EQ(xfinal[1], xfinal[0]);
+    }
+
+    // minimizers move atoms without velocities, so no checks are skipped
+
+    for (int predict = 0; predict < 2; ++predict) {
+        BEGIN_HIDE_OUTPUT();
+        setup(predict ? "1.0e-6" : "no", "1.0");
+        command("unfix 1");
+        command("fix 2 all addforce 1.0 0.0 0.0");
+        command("fix_modify 2 energy yes");
+        command("min_modify line backtrack");
+        command("minimize 0.0 0.0 100 1000");
+        END_HIDE_OUTPUT();
+        ncalls[predict] = lmp->neighbor->ncalls;
+        nskip[predict]  = lmp->neighbor->nskip;
+        xfinal[predict] = lmp->atom->x[0][0];
+    }
+    ASSERT_GT(ncalls[0], 1);
+    ASSERT_EQ(ncalls[1], ncalls[0]);
+    ASSERT_EQ(nskip[1], 0);
+    ASSERT_DOUBLE_EQ(xfinal[1], xfinal[0]);
+
+    // atoms faster than the declared maximum speed are an error
+
+    BEGIN_HIDE_OUTPUT();
+    setup("2.0", "1.0");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Atom speed exceeds maximum speed of neigh_modify predict.*",
+                 command("run 1000"););
+
+    TEST_FAILURE(".*ERROR: Expected floating point parameter instead of 'yes'.*",
+                 command("neigh_modify predict yes"););
+    TEST_FAILURE(".*ERROR: Illegal neigh_modify command.*",
+                 command("neigh_modify predict 0.0"););
+}
+
 TEST_F(SimpleCommandsTest, Partition)
 {
     BEGIN_HIDE_OUTPUT();
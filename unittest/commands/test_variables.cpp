@@ -384,6 +384,76 @@ TEST_F(VariableTest, Functions)
                  command("print \"${four}\""););
 }
 
+TEST_F(VariableTest, Compiled)
+{
+    atomic_system();
+
+    BEGIN_HIDE_OUTPUT();
+    command("variable one    internal  2.0");
+    command("variable two    equal     v_one*(3+4)-sqrt(16)/2^2");
+    command("variable three  equal     -(v_two-1)^2>100&&!(atoms<64)");
+    command("variable four   equal     c_xsum+atoms");
+    command("variable five   equal     f_ave*2");
+    command("variable six    equal     c_xsum*2");
+    command("variable seven  equal     c_xsum*3");
+    command("compute  xsum   all reduce sum x");
+    command("fix      ave    all ave/time 1 1 1 c_xsum mode scalar");
+    command("thermo_style    custom step c_xsum");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+
+    int ivar = variable->find("two");
+    ASSERT_DOUBLE_EQ(variable->compute_equal(ivar), 13.0);
+    ASSERT_DOUBLE_EQ(variable->compute_equal(ivar),
+                     variable->compute_equal("v_one*(3+4)-sqrt(16)/2^2"));
+    // unary minus binds tighter than ^ and the system has 64 atoms
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("three")), 1.0);
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("three")),
+                     variable->compute_equal("-(v_two-1)^2>100&&!(atoms<64)"));
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("four")),
+                     variable->compute_equal("c_xsum+atoms"));
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("five")),
+                     2.0 * variable->compute_equal("c_xsum"));
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("six")),
+                     2.0 * variable->compute_equal("c_xsum"));
+
+    // compiled code must follow changes of referenced values and formulas
+
+    variable->internal_set(variable->find("one"), 5.0);
+    ASSERT_DOUBLE_EQ(variable->compute_equal(ivar), 34.0);
+    BEGIN_HIDE_OUTPUT();
+    command("variable two    equal     atoms/2");
+    END_HIDE_OUTPUT();
+    ASSERT_DOUBLE_EQ(variable->compute_equal(variable->find("two")), 32.0);
+
+    // re-created compute is detected and the formula is recompiled
+    // a failed evaluation leaves the variable marked as in progress,
+    //   so each error is checked with a different variable
+
+    BEGIN_HIDE_OUTPUT();
+    command("uncompute xsum");
+    command("compute  xsum   all reduce sum y");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Variable four: Compute used in variable between runs is not current.*",
+                 variable->compute_equal(variable->find("four")););
+
+    // same ID but now a global vector: the scalar reference must not be
+    //   reused even when the new compute occupies the old slot and address
+
+    BEGIN_HIDE_OUTPUT();
+    command("uncompute xsum");
+    command("compute  xsum   all reduce sum x y");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Variable seven: Compute global vector in equal-style variable formula.*",
+                 variable->compute_equal(variable->find("seven")););
+    BEGIN_HIDE_OUTPUT();
+    command("uncompute xsum");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Variable six: Invalid compute ID 'xsum' in variable formula.*",
+                 variable->compute_equal(variable->find("six")););
+}
+
 TEST_F(VariableTest, IfCommand)
 {
     BEGIN_HIDE_OUTPUT();
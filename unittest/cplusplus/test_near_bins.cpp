@@ -0,0 +1,245 @@
+// unit tests for overlap and distance queries of the NearBins class
+
+#include "atom.h"
+#include "domain.h"
+#include "lammps.h"
+#include "near_bins.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+using utils::split_words;
+
+class NearBins_class : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "NearBins";
+        LAMMPSTest::SetUp();
+    }
+
+    void CreateBox(const std::string &boundary, int dimension = 3)
+    {
+        HIDE_OUTPUT([&] {
+            command(fmt::format("dimension {}", dimension));
+            command("boundary " + boundary);
+            if (dimension == 2)
+                command("region box block 0 10 0 8 -0.5 0.5");
+            else
+                command("region box block 0 10 0 8 0 6");
+            command("create_box 1 box");
+        });
+    }
+
+    // squared distance by brute force, shifted to the closest image in periodic dims
+
+    double distsq(const double *a, const double *b)
+    {
+        Domain *domain = lmp->domain;
+        double rsq     = 0.0;
+        for (int dim = 0; dim < 3; ++dim) {
+            double delta = a[dim] - b[dim];
+            if (domain->periodicity[dim])
+                delta -= domain->prd[dim] * std::round(delta / domain->prd[dim]);
+            rsq += delta * delta;
+        }
+        return rsq;
+    }
+
+    // add points in batches and compare queries after each batch to a brute force search
+    // points and queries extend beyond the box and the binned range,
+    //   so they are wrapped in periodic dims and clamped to the edge bins otherwise
+
+    void Compare(double cut, int npoint, int nexpect, double *lo, double *hi)
+    {
+        Domain *domain = lmp->domain;
+        NearBins bins(lmp);
+        bins.setup(cut, lo, hi, nexpect);
+
+        std::mt19937 rng(4982);
+        auto coord = [&](double *x) {
+            for (int dim = 0; dim < 3; ++dim) {
+                double xlo = domain->periodicity[dim] ? domain->boxlo[dim] : lo[dim];
+                double xhi = domain->periodicity[dim] ? domain->boxhi[dim] : hi[dim];
+                std::uniform_real_distribution<double> dist(xlo - 1.0, xhi + 1.0);
+                x[dim] = dist(rng);
+            }
+            if (domain->dimension == 2) x[2] = 0.0;
+        };
+        std::uniform_real_distribution<double> radius(0.0, 0.5 * cut);
+
+        std::vector<double> xp, rp;
+        int nfound = 0, noverlap = 0;
+        while ((int)rp.size() < npoint) {
+            for (int i = 0; i < 40; ++i) {
+                double x[3];
+                coord(x);
+                double rad = radius(rng);
+                bins.add(x, rad);
+                xp.insert(xp.end(), x, x + 3);
+                rp.push_back(rad);
+            }
+
+            for (int iquery = 0; iquery < 200; ++iquery) {
+                double x[3];
+                coord(x);
+                double rad   = radius(rng);
+                double cutsq = (iquery % 2) ? cut * cut : 0.3 * cut * cut;
+
+                int within = 0, overlap = 0;
+                for (std::size_t j = 0; j < rp.size(); ++j) {
+                    double rsq    = distsq(x, &xp[3 * j]);
+                    double radsum = rad + rp[j];
+                    if (rsq < cutsq) within = 1;
+                    if (rsq <= radsum * radsum) overlap = 1;
+                }
+                ASSERT_EQ(bins.within(x, cutsq), within)
+                    << "query " << x[0] << " " << x[1] << " " << x[2];
+                ASSERT_EQ(bins.overlap(x, rad), overlap)
+                    << "query " << x[0] << " " << x[1] << " " << x[2];
+                nfound += within;
+                noverlap += overlap;
+            }
+        }
+
+        // make sure both outcomes are tested
+
+        EXPECT_GT(nfound, 0);
+        EXPECT_GT(noverlap, 0);
+        EXPECT_LT(nfound, 200 * npoint / 40);
+        EXPECT_LT(noverlap, 200 * npoint / 40);
+    }
+};
+
+TEST_F(NearBins_class, periodic)
+{
+    CreateBox("p p p");
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {10.0, 8.0, 6.0};
+    Compare(1.3, 200, 200, lo, hi);
+}
+
+TEST_F(NearBins_class, non_periodic)
+{
+    // binned range differs from the box in the non-periodic dims
+
+    CreateBox("p f m");
+    double lo[3] = {0.0, -1.0, 1.0}, hi[3] = {10.0, 9.0, 4.5};
+    Compare(1.1, 200, 200, lo, hi);
+}
+
+TEST_F(NearBins_class, few_bins)
+{
+    // 3 bins or less in a dim are all searched, periodic or not
+
+    CreateBox("p f p");
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {10.0, 8.0, 6.0};
+    Compare(2.7, 120, 120, lo, hi);
+}
+
+TEST_F(NearBins_class, coarsened)
+{
+    // bins are coarsened beyond the cutoff when few points are expected
+
+    CreateBox("p p f");
+    double lo[3] = {0.0, 0.0, 0.0}, hi[3] = {10.0, 8.0, 6.0};
+    Compare(0.25, 400, 1, lo, hi);
+}
+
+TEST_F(NearBins_class, two_d)
+{
+    CreateBox("p f p", 2);
+    double lo[3] = {0.0, 0.0, -0.5}, hi[3] = {10.0, 8.0, 0.5};
+    Compare(0.9, 200, 200, lo, hi);
+}
+
+TEST_F(NearBins_class, atoms)
+{
+    // owned and ghost atoms within the cutoff of a point are all in the
+    //   stencil bins, without minimum image since ghosts are binned
+
+    CreateBox("p p f");
+    HIDE_OUTPUT([&] {
+        command("create_atoms 1 random 300 4982 NULL");
+        command("mass 1 1.0");
+        command("pair_style zero 1.4");
+        command("pair_coeff * *");
+        command("run 0 post no");
+    });
+
+    const double cut = 1.4;
+    NearBins bins(lmp);
+    bins.init_atoms(cut);
+    bins.build_atoms();
+
+    double **x = lmp->atom->x;
+    int nall   = lmp->atom->nlocal + lmp->atom->nghost;
+    ASSERT_GT(lmp->atom->nghost, 0);
+
+    std::mt19937 rng(4982);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    int nfound = 0;
+    for (int iquery = 0; iquery < 200; ++iquery) {
+        double xq[3];
+        for (int dim = 0; dim < 3; ++dim)
+            xq[dim] = lmp->domain->boxlo[dim] + dist(rng) * lmp->domain->prd[dim];
+
+        std::vector<int> brute, binned;
+        for (int j = 0; j < nall; ++j) {
+            double rsq = 0.0;
+            for (int dim = 0; dim < 3; ++dim)
+                rsq += (xq[dim] - x[j][dim]) * (xq[dim] - x[j][dim]);
+            if (rsq < cut * cut) brute.push_back(j);
+        }
+
+        int list[27];
+        int n = bins.stencil(xq, list);
+        for (int k = 0; k < n; ++k)
+            for (int j = bins.binhead[list[k]]; j >= 0; j = bins.next[j]) {
+                double rsq = 0.0;
+                for (int dim = 0; dim < 3; ++dim)
+                    rsq += (xq[dim] - x[j][dim]) * (xq[dim] - x[j][dim]);
+                if (rsq < cut * cut) binned.push_back(j);
+            }
+        std::sort(binned.begin(), binned.end());
+        ASSERT_EQ(binned, brute) << "query " << xq[0] << " " << xq[1] << " " << xq[2];
+        nfound += brute.size();
+    }
+    EXPECT_GT(nfound, 0);
+}
+
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -4792,6 +4792,90 @@ TEST_F(AtomStyleTest, property_atom)
     EXPECT_NEAR(three[GETIDX(2)], 0.5, EPSILON);
 }
 
+TEST_F(AtomStyleTest, pack_unpack_threads)
+{
+    if (!LAMMPS::is_installed_pkg("USER-OMP")) GTEST_SKIP();
+
+    // the comm, border and reverse pack/unpack loops of AtomVec are threaded
+    //   for lists of at least THREAD_MINATOM atoms and must produce the same
+    //   buffers and per-atom data as a single thread
+
+    for (auto style : {"full", "sphere"}) {
+        std::vector<double> ref, data;
+        for (int nthreads : {1, 4}) {
+            TearDown();
+            SetUp();
+            BEGIN_HIDE_OUTPUT();
+            command("package omp " + std::to_string(nthreads));
+            command(std::string("atom_style ") + style);
+            command("region big block -20 20 -20 20 -20 20");
+            command("create_box 2 big");
+            command("create_atoms 1 random 4000 4982 NULL");
+            command("pair_coeff * *");
+            command("variable val atom 0.5*x-y");
+            command("variable num atom 1+id%7");
+            if (strcmp(style, "full") == 0) {
+                command("mass * 1.0");
+                command("set group all charge v_val");
+                command("set group all mol v_num");
+            } else {
+                command("set group all diameter v_num");
+            }
+            command("run 0 post no");
+            END_HIDE_OUTPUT();
+
+            auto atom  = lmp->atom;
+            auto avec  = atom->avec;
+            const int n = atom->nlocal;
+            ASSERT_EQ(n, 4000);
+
+            // pack atoms in reverse order and unpack them in order
+            //   with a periodic shift
+
+            std::vector<int> list(n);
+            for (int i = 0; i < n; ++i)
+                list[i] = n - 1 - i;
+            std::vector<double> buf(20 * n);
+            int pbc[6] = {1, -1, 0, 0, 0, 0};
+            data.clear();
+
+            int m = avec->pack_comm(n, list.data(), buf.data(), 1, pbc);
+            data.insert(data.end(), buf.begin(), buf.begin() + m);
+            avec->unpack_comm(n, 0, buf.data());
+
+            m = avec->pack_border(n, list.data(), buf.data(), 1, pbc);
+            data.insert(data.end(), buf.begin(), buf.begin() + m);
+            avec->unpack_border(n, 0, buf.data());
+
+            for (int i = 0; i < n; ++i)
+                for (int k = 0; k < 3; ++k)
+                    atom->f[i][k] = atom->x[i][k];
+            m = avec->pack_reverse(n, 0, buf.data());
+            data.insert(data.end(), buf.begin(), buf.begin() + m);
+            avec->unpack_reverse(n, list.data(), buf.data());
+
+            for (int i = 0; i < n; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    data.push_back(atom->x[i][k]);
+                    data.push_back(atom->f[i][k]);
+                }
+                data.push_back(atom->tag[i]);
+                data.push_back(atom->type[i]);
+                data.push_back(atom->mask[i]);
+                if (atom->q) data.push_back(atom->q[i]);
+                if (atom->molecule) data.push_back(atom->molecule[i]);
+                if (atom->radius) data.push_back(atom->radius[i]);
+                if (atom->rmass) data.push_back(atom->rmass[i]);
+            }
+            if (nthreads == 1) ref = data;
+        }
+
+        ASSERT_EQ(ref.size(), data.size());
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            EXPECT_EQ(ref[i], data[i]) << style << " value " << i;
+    }
+}
+
 } // namespace LAMMPS_NS
 
 int main(int argc, char **argv)
@@ -478,6 +478,35 @@ TEST_F(DumpAtomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpAtomTest, async_run2)
+{
+    auto dump_file = "dump_async_run2.melt";
+    generate_dump(dump_file, "async yes", 2);
+
+    ASSERT_FILE_EXISTS(dump_file);
+    auto lines = read_lines(dump_file);
+    ASSERT_EQ(lines.size(), 123);
+    ASSERT_THAT(lines[41], Eq("ITEM: TIMESTEP"));
+    ASSERT_THAT(lines[82], Eq("ITEM: TIMESTEP"));
+    ASSERT_THAT(lines[90], Eq("ITEM: ATOMS id type xs ys zs"));
+    continue_dump(1);
+    ASSERT_EQ(count_lines(dump_file), 164);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpAtomTest, async_multi_file_run1)
+{
+    auto dump_file = "dump_async_run1_*.melt";
+    generate_dump(dump_file, "async yes", 1);
+
+    ASSERT_FILE_EXISTS("dump_async_run1_0.melt");
+    ASSERT_FILE_EXISTS("dump_async_run1_1.melt");
+    ASSERT_EQ(count_lines("dump_async_run1_0.melt"), 41);
+    ASSERT_EQ(count_lines("dump_async_run1_1.melt"), 41);
+    delete_file("dump_async_run1_0.melt");
+    delete_file("dump_async_run1_1.melt");
+}
+
 TEST_F(DumpAtomTest, rerun)
 {
     auto dump_file = "dump_rerun.melt";
@@ -542,6 +571,26 @@ TEST_F(DumpAtomTest, per_processor_multi_file_run1)
     delete_file("dump_run1_p0_1.melt");
 }
 
+TEST_F(DumpAtomTest, per_node_file_run1)
+{
+    auto dump_file = "dump_run1_n%.melt";
+    generate_dump(dump_file, "fileper node", 1);
+
+    ASSERT_FILE_EXISTS("dump_run1_n0.melt");
+    ASSERT_EQ(count_lines("dump_run1_n0.melt"), 82);
+    delete_file("dump_run1_n0.melt");
+}
+
+TEST_F(DumpAtomTest, per_node_file_no_buffer_run1)
+{
+    auto dump_file = "dump_run1_n%.melt";
+    generate_dump(dump_file, "fileper node buffer no", 1);
+
+    ASSERT_FILE_EXISTS("dump_run1_n0.melt");
+    ASSERT_EQ(count_lines("dump_run1_n0.melt"), 82);
+    delete_file("dump_run1_n0.melt");
+}
+
 TEST_F(DumpAtomTest, dump_modify_scale_invalid)
 {
     BEGIN_HIDE_OUTPUT();
@@ -551,6 +600,17 @@ TEST_F(DumpAtomTest, dump_modify_scale_invalid)
     TEST_FAILURE(".*Illegal dump_modify command.*", command("dump_modify id scale true"););
 }
 
+TEST_F(DumpAtomTest, dump_modify_async_no_buffer)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 dump.txt");
+    command("dump_modify id async yes buffer no");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*Dump_modify async yes requires dump_modify buffer yes.*",
+                 command("run 0 post no"););
+}
+
 TEST_F(DumpAtomTest, dump_modify_image_invalid)
 {
     BEGIN_HIDE_OUTPUT();